@@ -102,7 +102,7 @@ void DualSolver::checkDualSolutionCandidates()
                 break;
             }
 
-            env->output->outputDebug(fmt::format("        New dual bound {}, source: {}", C.objValue, sourceDesc));
+            env->output->outputDebug("        New dual bound {}, source: {}", C.objValue, sourceDesc);
         }
     }
 
@@ -126,8 +126,7 @@ void DualSolver::addHyperplane(Hyperplane& hyperplane)
     }
     else
     {
-        env->output->outputDebug(
-            fmt::format("        Hyperplane with hash {} has been added already.", hyperplane.pointHash));
+        env->output->outputDebug("        Hyperplane with hash {} has been added already.", hyperplane.pointHash);
     }
 }
 
@@ -194,6 +193,10 @@ void DualSolver::addGeneratedHyperplane(const Hyperplane& hyperplane)
 
     genHyperplane.isSourceConvex = hyperplane.isSourceConvex;
 
+    if(genHyperplane.isSourceConvex && hyperplane.sourceConstraint
+        && env->settings->getSetting<bool>("BoundTightening.OptimizationBased.Use", "Model"))
+        genHyperplane.generatedPoint = hyperplane.generatedPoint;
+
     if(!genHyperplane.isSourceConvex)
     {
         if(env->results->solutionIsGlobal)
@@ -205,15 +208,15 @@ void DualSolver::addGeneratedHyperplane(const Hyperplane& hyperplane)
 
     if(hasHyperplaneBeenAdded(genHyperplane.pointHash, genHyperplane.sourceConstraintIndex))
     {
-        env->output->outputTrace(fmt::format("        Not added hyperplane with hash {} to constraint {}",
-            genHyperplane.pointHash, genHyperplane.sourceConstraintIndex));
+        env->output->outputTrace("        Not added hyperplane with hash {} to constraint {}",
+            genHyperplane.pointHash, genHyperplane.sourceConstraintIndex);
         return;
     }
 
     if(hyperplane.sourceConstraint)
     {
-        env->output->outputTrace(fmt::format("        Added hyperplane with hash {} to constraint {}",
-            genHyperplane.pointHash, genHyperplane.sourceConstraint->index));
+        env->output->outputTrace("        Added hyperplane with hash {} to constraint {}",
+            genHyperplane.pointHash, genHyperplane.sourceConstraint->index);
     }
 
     generatedHyperplanes.push_back(genHyperplane);
@@ -223,7 +226,7 @@ void DualSolver::addGeneratedHyperplane(const Hyperplane& hyperplane)
     currentIteration->totNumHyperplanes++;
     env->solutionStatistics.iterationLastDualCutAdded = currentIteration->iterationNumber;
 
-    env->output->outputTrace("        Hyperplane generated from: " + source);
+    env->output->outputTrace("        Hyperplane generated from: {}", source);
 }
 
 bool DualSolver::hasHyperplaneBeenAdded(double hash, int constraintIndex)
@@ -266,8 +269,7 @@ void DualSolver::addIntegerCut(IntegerCut integerCut)
     if(!hasIntegerCutBeenAdded(integerCut.pointHash))
         this->integerCutWaitingList.push_back(integerCut);
     else
-        env->output->outputDebug(
-            fmt::format("        Integer cut with hash {} has been added already.", integerCut.pointHash));
+        env->output->outputDebug("        Integer cut with hash {} has been added already.", integerCut.pointHash);
 }
 
 void DualSolver::addGeneratedIntegerCut(IntegerCut integerCut)
@@ -292,7 +294,7 @@ void DualSolver::addGeneratedIntegerCut(IntegerCut integerCut)
         env->output->outputInfo("        Solution is no longer global since integer cut has been added.");
     }
 
-    env->output->outputDebug(fmt::format("        Added integer cut with hash {}", integerCut.pointHash));
+    env->output->outputDebug("        Added integer cut with hash {}", integerCut.pointHash);
 
     generatedIntegerCuts.push_back(integerCut);
 
@@ -302,7 +304,7 @@ void DualSolver::addGeneratedIntegerCut(IntegerCut integerCut)
 
     env->solutionStatistics.numberOfIntegerCuts++;
 
-    env->output->outputDebug("        Integer cut generated from: " + source);
+    env->output->outputDebug("        Integer cut generated from: {}", source);
 }
 
 bool DualSolver::hasIntegerCutBeenAdded(double hash)
@@ -14,6 +14,8 @@
 
 namespace SHOT
 {
+class RootsearchPrefetcher;
+
 class DualSolver
 {
 public:
@@ -43,6 +45,9 @@ public:
 
     std::vector<std::shared_ptr<InteriorPoint>> interiorPts;
 
+    // Only created if the root searches are started while the MIP solver is running
+    std::shared_ptr<RootsearchPrefetcher> rootsearchPrefetcher;
+
     double cutOffToUse;
     bool useCutOff = false;
     bool isSingleTree = false;
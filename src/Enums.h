@@ -166,6 +166,7 @@ enum class E_NLPSolutionStatus
     Unbounded,
     IterationLimit,
     TimeLimit,
+    Cutoff,
     Error
 };
 
@@ -275,6 +276,13 @@ enum class ES_InteriorPointStrategy
     IpoptMinimaxAndRelaxed
 };
 
+enum class ES_IpoptHessianApproximation
+{
+    Exact,
+    LimitedMemory,
+    Automatic
+};
+
 enum class ES_IpoptSolver
 {
     IpoptDefault,
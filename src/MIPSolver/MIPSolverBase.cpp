@@ -259,8 +259,8 @@ std::optional<std::pair<std::map<int, double>, double>> MIPSolverBase::createHyp
 
         constant += signFactor * (-G.second) * hyperplane.generatedPoint.at(variableIndex);
 
-        env->output->outputTrace("         Gradient for variable " + G.first->name + " in point "
-            + std::to_string(hyperplane.generatedPoint.at(variableIndex)) + ": " + std::to_string(coefficient));
+        env->output->outputTrace("         Gradient for variable {} in point {}: {}", G.first->name,
+            hyperplane.generatedPoint.at(variableIndex), coefficient);
     }
 
     std::optional<std::pair<std::map<int, double>, double>> optional;
@@ -363,7 +363,7 @@ void MIPSolverBase::presolveAndUpdateBounds()
 
         if(newLB)
         {
-            env->reformulatedProblem->getVariable(i)->lowerBound = newBounds.first.at(i);
+            env->reformulatedProblem->getVariable(i)->setLowerBound(newBounds.first.at(i));
             env->output->outputDebug("        Lower bound for variable (" + std::to_string(i) + ") updated from "
                 + Utilities::toString(currBounds.first) + " to " + Utilities::toString(newBounds.first.at(i)));
 
@@ -376,7 +376,7 @@ void MIPSolverBase::presolveAndUpdateBounds()
 
         if(newUB)
         {
-            env->reformulatedProblem->getVariable(i)->upperBound = newBounds.second.at(i);
+            env->reformulatedProblem->getVariable(i)->setUpperBound(newBounds.second.at(i));
             env->output->outputDebug("        Upper bound for variable (" + std::to_string(i) + ") updated from "
                 + Utilities::toString(currBounds.second) + " to " + Utilities::toString(newBounds.second.at(i)));
 
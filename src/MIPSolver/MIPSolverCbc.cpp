@@ -21,6 +21,8 @@
 
 #include "../Model/Problem.h"
 
+#include "../RootsearchMethod/RootsearchPrefetcher.h"
+
 #include "CoinBuild.hpp"
 #include "CoinModel.hpp"
 #include "CoinPragma.hpp"
@@ -48,6 +50,8 @@ bool MIPSolverCbc::initializeProblem()
 
     cachedSolutionHasChanged = true;
     isVariablesFixed = false;
+    isLPSolvedWithClp = false;
+    hasLPBasis = false;
 
     checkParameters();
 
@@ -353,6 +357,7 @@ void MIPSolverCbc::activateDiscreteVariables(bool activate)
         }
 
         discreteVariablesActivated = true;
+        isLPSolvedWithClp = false;
     }
     else
     {
@@ -372,6 +377,9 @@ void MIPSolverCbc::activateDiscreteVariables(bool activate)
 
 E_ProblemSolutionStatus MIPSolverCbc::getSolutionStatus()
 {
+    if(isLPSolvedWithClp)
+        return (getLPSolutionStatus());
+
     E_ProblemSolutionStatus MIPSolutionStatus;
 
     if(cbcModel->isProvenOptimal())
@@ -421,11 +429,92 @@ E_ProblemSolutionStatus MIPSolverCbc::getSolutionStatus()
     return (MIPSolutionStatus);
 }
 
+E_ProblemSolutionStatus MIPSolverCbc::getLPSolutionStatus()
+{
+    E_ProblemSolutionStatus LPSolutionStatus;
+
+    if(osiInterface->isProvenOptimal())
+    {
+        LPSolutionStatus = E_ProblemSolutionStatus::Optimal;
+    }
+    else if(osiInterface->isProvenPrimalInfeasible())
+    {
+        LPSolutionStatus = E_ProblemSolutionStatus::Infeasible;
+    }
+    else if(osiInterface->isProvenDualInfeasible())
+    {
+        LPSolutionStatus = E_ProblemSolutionStatus::Unbounded;
+    }
+    else if(osiInterface->isIterationLimitReached())
+    {
+        LPSolutionStatus = E_ProblemSolutionStatus::IterationLimit;
+    }
+    else if(osiInterface->isAbandoned())
+    {
+        LPSolutionStatus = E_ProblemSolutionStatus::Abort;
+    }
+    else
+    {
+        LPSolutionStatus = E_ProblemSolutionStatus::Error;
+        env->output->outputError("        LP solver return status unknown (Clp).");
+    }
+
+    return (LPSolutionStatus);
+}
+
+E_ProblemSolutionStatus MIPSolverCbc::solveLPWithWarmStart()
+{
+    try
+    {
+        if(!env->settings->getSetting<bool>("Console.DualSolver.Show", "Output"))
+            osiInterface->messageHandler()->setLogLevel(0);
+
+        osiInterface->getModelPtr()->setMaximumSeconds(this->timeLimit);
+
+        // Cuts and bound changes since the last call keep the basis valid, so that the dual simplex method only needs
+        // a few pivots to reoptimize
+        if(hasLPBasis)
+            osiInterface->resolve();
+        else
+            osiInterface->initialSolve();
+
+        isLPSolvedWithClp = true;
+        hasLPBasis = true;
+
+        return (getLPSolutionStatus());
+    }
+    catch(CoinError& e)
+    {
+        env->output->outputError("        Error when solving LP problem with Clp", e.message());
+    }
+    catch(std::exception& e)
+    {
+        env->output->outputError("        Error when solving LP problem with Clp", e.what());
+    }
+
+    isLPSolvedWithClp = false;
+    hasLPBasis = false;
+
+    return (E_ProblemSolutionStatus::Error);
+}
+
 E_ProblemSolutionStatus MIPSolverCbc::solveProblem()
 {
     E_ProblemSolutionStatus MIPSolutionStatus;
     cachedSolutionHasChanged = true;
 
+    if(useLPWarmStart && !discreteVariablesActivated)
+    {
+        MIPSolutionStatus = solveLPWithWarmStart();
+
+        // Infeasible or unbounded LP problems are handled by Cbc below
+        if(MIPSolutionStatus == E_ProblemSolutionStatus::Optimal
+            || MIPSolutionStatus == E_ProblemSolutionStatus::IterationLimit)
+            return (MIPSolutionStatus);
+    }
+
+    isLPSolvedWithClp = false;
+
     const int numArguments = 17;
     char* argv[numArguments];
     std::string arg;
@@ -568,6 +657,15 @@ E_ProblemSolutionStatus MIPSolverCbc::solveProblem()
             env->output->outputError("        Error when adding MIP start to Cbc", e.what());
         }
 
+        if(env->dualSolver->rootsearchPrefetcher && discreteVariablesActivated)
+        {
+            env->dualSolver->rootsearchPrefetcher->clear();
+
+            // Cbc stores a copy of the handler
+            CbcSolutionEventHandler solutionEventHandler(env);
+            cbcModel->passInEventHandler(&solutionEventHandler);
+        }
+
         CbcMain0(*cbcModel);
 
         if(!env->settings->getSetting<bool>("Console.DualSolver.Show", "Output"))
@@ -586,6 +684,10 @@ E_ProblemSolutionStatus MIPSolverCbc::solveProblem()
         MIPSolutionStatus = E_ProblemSolutionStatus::Error;
     }
 
+    // The root searches still running are completed so that no worker uses the model after the MIP solver returns
+    if(env->dualSolver->rootsearchPrefetcher)
+        env->dualSolver->rootsearchPrefetcher->finish();
+
     if(MIPSolutionStatus == E_ProblemSolutionStatus::Infeasible)
     {
         if(env->reformulatedProblem->objectiveFunction->properties.classification
@@ -1041,13 +1143,13 @@ void MIPSolverCbc::setCutOff(double cutOff)
     {
         this->cutOff = cutOff + cutOffTol;
 
-        env->output->outputDebug(fmt::format("        Setting cutoff value to  {} for minimization.", this->cutOff));
+        env->output->outputDebug("        Setting cutoff value to  {} for minimization.", this->cutOff);
     }
     else
     {
         this->cutOff = -1 * (cutOff + cutOffTol);
 
-        env->output->outputDebug(fmt::format("        Setting cutoff value to  {} for maximization.", this->cutOff));
+        env->output->outputDebug("        Setting cutoff value to  {} for maximization.", this->cutOff);
     }
 }
 
@@ -1409,6 +1511,12 @@ bool MIPSolverCbc::createIntegerCut(IntegerCut& integerCut)
 
 VectorDouble MIPSolverCbc::getVariableSolution(int solIdx)
 {
+    if(isLPSolvedWithClp)
+    {
+        auto tmpSol = osiInterface->getColSolution();
+        return (VectorDouble(tmpSol, tmpSol + osiInterface->getNumCols()));
+    }
+
     bool isMIP = getDiscreteVariableStatus();
     int numVar = cbcModel->getNumCols();
     VectorDouble solution(numVar);
@@ -1443,6 +1551,9 @@ VectorDouble MIPSolverCbc::getVariableSolution(int solIdx)
 
 int MIPSolverCbc::getNumberOfSolutions()
 {
+    if(isLPSolvedWithClp)
+        return (osiInterface->isProvenOptimal() ? 1 : 0);
+
     int numSols = 0;
 
     try
@@ -1592,6 +1703,9 @@ void MIPSolverCbc::checkParameters()
 
 int MIPSolverCbc::getNumberOfExploredNodes()
 {
+    if(isLPSolvedWithClp)
+        return (0);
+
     try
     {
         return (cbcModel->getNodeCount());
@@ -1619,4 +1733,42 @@ int CbcMessageHandler::print()
 
     return 0;
 }
+
+CbcEventHandler::CbcAction CbcSolutionEventHandler::event(CbcEvent whichEvent)
+{
+    if(whichEvent != solution && whichEvent != heuristicSolution)
+        return (noAction);
+
+    auto bestSolution = model_->bestSolution();
+
+    if(bestSolution == nullptr || !env->dualSolver->rootsearchPrefetcher)
+        return (noAction);
+
+    int numberOfVariables = env->reformulatedProblem->properties.numberOfVariables;
+
+    // With preprocessing, the columns in the branch and bound model can be permuted or removed, so the solution is
+    // mapped back to the original columns, and not used if the values of some of them are not known
+    auto originalColumns = model_->originalColumns();
+
+    VectorDouble point(numberOfVariables, 0.0);
+    std::vector<bool> isMapped(numberOfVariables, false);
+    int numberOfMappedColumns = 0;
+
+    for(int i = 0; i < model_->getNumCols(); i++)
+    {
+        int column = (originalColumns != nullptr) ? originalColumns[i] : i;
+
+        if(column >= 0 && column < numberOfVariables && !isMapped[column])
+        {
+            point[column] = bestSolution[i];
+            isMapped[column] = true;
+            numberOfMappedColumns++;
+        }
+    }
+
+    if(numberOfMappedColumns == numberOfVariables)
+        env->dualSolver->rootsearchPrefetcher->addPoint(std::move(point));
+
+    return (noAction);
+}
 } // namespace SHOT
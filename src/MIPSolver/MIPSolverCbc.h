@@ -15,6 +15,7 @@
 
 #include "CoinPackedVector.hpp"
 #include "CoinMessageHandler.hpp"
+#include "CbcEventHandler.hpp"
 
 class OsiClpSolverInterface;
 class CbcModel;
@@ -44,6 +45,31 @@ public:
     virtual int print();
 };
 
+// Passes the new integer solutions found by Cbc to the root search prefetcher, so that the root searches for the ESH
+// cuts are performed while the branch and bound continues
+class CbcSolutionEventHandler : public CbcEventHandler
+{
+private:
+    EnvironmentPtr env;
+
+public:
+    CbcSolutionEventHandler(EnvironmentPtr envPtr) : CbcEventHandler() { env = envPtr; }
+
+    CbcSolutionEventHandler(const CbcSolutionEventHandler& r) : CbcEventHandler(r) { env = r.env; }
+
+    CbcSolutionEventHandler& operator=(const CbcSolutionEventHandler& r)
+    {
+        CbcEventHandler::operator=(r);
+        env = r.env;
+        return *this;
+    }
+
+    CbcEventHandler* clone() const override { return new CbcSolutionEventHandler(*this); }
+
+    using CbcEventHandler::event;
+    CbcAction event(CbcEvent whichEvent) override;
+};
+
 class MIPSolverCbc : public IMIPSolver, MIPSolverBase
 {
 public:
@@ -179,6 +205,11 @@ public:
 
     std::string getSolverVersion() override;
 
+    // If set, LP problems are reoptimized with dual simplex in Clp from the previous basis instead of being solved
+    // with Cbc. This skips, e.g., the cutoff given to Cbc, so it is only used for the minimax problem in the interior
+    // point search where the problems only change by the added cuts.
+    bool useLPWarmStart = false;
+
 private:
     std::unique_ptr<OsiClpSolverInterface> osiInterface;
     std::unique_ptr<CbcModel> cbcModel;
@@ -194,6 +225,12 @@ private:
 
     std::vector<std::vector<std::pair<std::string, double>>> MIPStarts;
 
+    E_ProblemSolutionStatus solveLPWithWarmStart();
+    E_ProblemSolutionStatus getLPSolutionStatus();
+
+    bool isLPSolvedWithClp = false;
+    bool hasLPBasis = false;
+
     std::vector<E_VariableType> variableTypes;
 };
 
@@ -1037,12 +1037,12 @@ void MIPSolverCplex::setCutOff(double cutOff)
         if(isMinimizationProblem)
         {
             cplexInstance.setParam(IloCplex::Param::MIP::Tolerances::UpperCutoff, cutOff);
-            env->output->outputDebug(fmt::format("        Setting cutoff value to  {} for minimization.", cutOff));
+            env->output->outputDebug("        Setting cutoff value to  {} for minimization.", cutOff);
         }
         else
         {
             cplexInstance.setParam(IloCplex::Param::MIP::Tolerances::LowerCutoff, cutOff);
-            env->output->outputDebug(fmt::format("        Setting cutoff value to  {} for maximization.", cutOff));
+            env->output->outputDebug("        Setting cutoff value to  {} for maximization.", cutOff);
         }
     }
     catch(IloException& e)
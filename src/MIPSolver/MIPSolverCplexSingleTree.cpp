@@ -348,7 +348,7 @@ void CplexCallback::invoke(const IloCplex::Callback::Context& context)
                 }
 
                 if(addedIntegerCuts > 0)
-                    env->output->outputDebug(fmt::format("        Added {} integer cut(s)", addedIntegerCuts));
+                    env->output->outputDebug("        Added {} integer cut(s)", addedIntegerCuts);
 
                 env->dualSolver->integerCutWaitingList.clear();
             }
@@ -507,7 +507,7 @@ void CtCallbackI::main()
         }
 
         if(addedIntegerCuts > 0)
-            env->output->outputDebug(fmt::format("        Added {} integer cut(s)", addedIntegerCuts));
+            env->output->outputDebug("        Added {} integer cut(s)", addedIntegerCuts);
 
         env->dualSolver->integerCutWaitingList.clear();
     }
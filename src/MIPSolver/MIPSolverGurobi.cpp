@@ -1018,14 +1018,12 @@ void MIPSolverGurobi::setCutOff(double cutOff)
         if(isMinimizationProblem)
         {
             gurobiModel->getEnv().set(GRB_DoubleParam_Cutoff, cutOff + cutOffTol);
-            env->output->outputDebug(
-                fmt::format("        Setting cutoff value to  {} for maximization.", cutOff + cutOffTol));
+            env->output->outputDebug("        Setting cutoff value to  {} for maximization.", cutOff + cutOffTol);
         }
         else
         {
             gurobiModel->getEnv().set(GRB_DoubleParam_Cutoff, cutOff - cutOffTol);
-            env->output->outputDebug(
-                fmt::format("        Setting cutoff value to  {} for maximization.", cutOff - cutOffTol));
+            env->output->outputDebug("        Setting cutoff value to  {} for maximization.", cutOff - cutOffTol);
         }
     }
     catch(GRBException& e)
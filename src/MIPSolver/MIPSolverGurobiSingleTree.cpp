@@ -425,7 +425,7 @@ void GurobiCallbackSingleTree::callback()
                 }
 
                 if(addedIntegerCuts > 0)
-                    env->output->outputDebug(fmt::format("        Added {} integer cut(s)", addedIntegerCuts));
+                    env->output->outputDebug("        Added {} integer cut(s)", addedIntegerCuts);
 
                 env->dualSolver->integerCutWaitingList.clear();
             }
@@ -10,6 +10,9 @@
 
 #include "AuxiliaryVariables.h"
 
+#include <algorithm>
+#include <cmath>
+
 namespace SHOT
 {
 double AuxiliaryVariable::calculate(const VectorDouble& point) const
@@ -42,6 +45,447 @@ Interval AuxiliaryVariable::calculate(const IntervalVector& intervalVector) cons
     return interval;
 }
 
+namespace
+{
+    // These have the same special cases as the calculate methods of the corresponding expressions and terms
+
+    inline double calculatePower(double base, double exponent)
+    {
+        if(std::abs(base - 0.0) <= 1e-10 * std::abs(base))
+            return 0.0;
+
+        if(std::abs(base - 1.0) <= 1e-10 * std::abs(base))
+            return 1.0;
+
+        if(std::abs(exponent - 0.0) <= 1e-10 * std::abs(base))
+            return 1.0;
+
+        if(std::abs(exponent - 1.0) <= 1e-10 * std::abs(base))
+            return base;
+
+        return (pow(base, exponent));
+    }
+
+    inline Interval calculatePower(Interval base, Interval exponent)
+    {
+        if(exponent.l() < 0)
+        {
+            if(base.l() <= 0)
+                base.l(SHOT_DBL_EPS);
+        }
+        else if(exponent.l() == 0.0)
+        {
+            if(base.l() < 0)
+                base.l(0.0);
+            if(base.l() <= 0)
+                base.l(SHOT_DBL_EPS);
+        }
+
+        return (pow(base, exponent));
+    }
+
+    inline double calculateConstantPower(double base, double exponent) { return (calculatePower(base, exponent)); }
+
+    inline Interval calculateConstantPower(Interval base, double exponent)
+    {
+        double intpart;
+        bool isInteger = (std::modf(exponent, &intpart) == 0.0);
+        int integerValue = (int)round(intpart);
+        bool isEven = (integerValue % 2 == 0);
+
+        if(base.l() <= 0)
+        {
+            if(!isInteger)
+                base.l(SHOT_DBL_EPS);
+            else if(isInteger && exponent < 0)
+                base.l(SHOT_DBL_EPS);
+        }
+
+        Interval bounds;
+
+        if(isInteger)
+            bounds = pow(base, (int)exponent);
+        else
+            bounds = pow(base, exponent);
+
+        if(isInteger && isEven && bounds.l() <= 0.0)
+            bounds.l(0.0);
+
+        return (bounds);
+    }
+
+    inline double calculateSignomialFactor(double value, double power) { return (pow(value, power)); }
+
+    inline Interval calculateSignomialFactor(const Interval& value, double power)
+    {
+        return (calculateConstantPower(value, power));
+    }
+
+    inline double calculateLog(double value) { return (log(value)); }
+
+    inline Interval calculateLog(Interval value)
+    {
+        if(value.l() <= 0)
+            value.l(SHOT_DBL_EPS);
+
+        return (log(value));
+    }
+
+    inline double calculateSquare(double value) { return (value * value); }
+
+    inline Interval calculateSquare(const Interval& value) { return (pow(value, 2)); }
+
+    // A product of doubles is zero if any factor is, even if another one is not finite
+    inline bool isZero(double value) { return (value == 0.0); }
+
+    inline bool isZero(const Interval&) { return (false); }
+} // namespace
+
+AuxiliaryVariableProgram::AuxiliaryVariableProgram(
+    const AuxiliaryVariables& auxiliaryVariables, const AuxiliaryVariablePtr& auxiliaryObjectiveVariable)
+{
+    std::vector<AuxiliaryVariablePtr> variables(auxiliaryVariables.begin(), auxiliaryVariables.end());
+
+    if(auxiliaryObjectiveVariable)
+        variables.push_back(auxiliaryObjectiveVariable);
+
+    std::sort(variables.begin(), variables.end(),
+        [](const AuxiliaryVariablePtr& first, const AuxiliaryVariablePtr& second)
+        { return (first->index < second->index); });
+
+    for(auto& V : variables)
+    {
+        instructions.push_back({ E_Operation::Begin, V->constant });
+
+        for(auto& T : V->linearTerms)
+            instructions.push_back({ E_Operation::AddLinear, T->coefficient, T->variable->index });
+
+        for(auto& T : V->quadraticTerms)
+        {
+            instructions.push_back(
+                { E_Operation::AddQuadratic, T->coefficient, T->firstVariable->index, T->secondVariable->index });
+        }
+
+        for(auto& T : V->monomialTerms)
+        {
+            instructions.push_back({ E_Operation::AddMonomial, T->coefficient, (int)factorVariableIndexes.size(),
+                (int)T->variables.size() });
+
+            for(auto& F : T->variables)
+            {
+                factorVariableIndexes.push_back(F->index);
+                factorPowers.push_back(1.0);
+            }
+        }
+
+        for(auto& T : V->signomialTerms)
+        {
+            instructions.push_back({ E_Operation::AddSignomial, T->coefficient, (int)factorVariableIndexes.size(),
+                (int)T->elements.size() });
+
+            for(auto& E : T->elements)
+            {
+                factorVariableIndexes.push_back(E->variable->index);
+                factorPowers.push_back(E->power);
+            }
+        }
+
+        if(V->nonlinearExpression)
+        {
+            addExpression(V->nonlinearExpression, 0);
+            instructions.push_back({ E_Operation::AddExpression });
+        }
+
+        instructions.push_back({ E_Operation::Store, 0.0, V->index });
+        numberOfVariables = std::max(numberOfVariables, (size_t)V->index + 1);
+    }
+}
+
+// Adds the instructions that push the value of the expression to the stack, which contains stackSize values before
+void AuxiliaryVariableProgram::addExpression(const NonlinearExpressionPtr& expression, size_t stackSize)
+{
+    maxStackSize = std::max(maxStackSize, stackSize + 1);
+
+    switch(expression->getType())
+    {
+    case E_NonlinearExpressionTypes::Constant:
+        instructions.push_back(
+            { E_Operation::PushConstant, std::static_pointer_cast<ExpressionConstant>(expression)->constant });
+        return;
+
+    case E_NonlinearExpressionTypes::Variable:
+    {
+        int variableIndex = std::static_pointer_cast<ExpressionVariable>(expression)->variable->index;
+        instructions.push_back({ E_Operation::PushVariable, 0.0, variableIndex });
+        return;
+    }
+
+    case E_NonlinearExpressionTypes::Divide:
+    {
+        auto binary = std::static_pointer_cast<ExpressionBinary>(expression);
+        addExpression(binary->firstChild, stackSize);
+        addExpression(binary->secondChild, stackSize + 1);
+        instructions.push_back({ E_Operation::Divide });
+        return;
+    }
+
+    case E_NonlinearExpressionTypes::Power:
+    {
+        auto binary = std::static_pointer_cast<ExpressionBinary>(expression);
+        addExpression(binary->firstChild, stackSize);
+
+        if(binary->secondChild->getType() == E_NonlinearExpressionTypes::Constant)
+        {
+            instructions.push_back({ E_Operation::PowerConstant,
+                std::static_pointer_cast<ExpressionConstant>(binary->secondChild)->constant });
+            return;
+        }
+
+        addExpression(binary->secondChild, stackSize + 1);
+        instructions.push_back({ E_Operation::Power });
+        return;
+    }
+
+    case E_NonlinearExpressionTypes::Sum:
+    case E_NonlinearExpressionTypes::Product:
+    {
+        auto& children = std::static_pointer_cast<ExpressionGeneral>(expression)->children;
+
+        for(size_t i = 0; i < children.size(); i++)
+            addExpression(children[i], stackSize + i);
+
+        instructions.push_back({ expression->getType() == E_NonlinearExpressionTypes::Sum ? E_Operation::Sum
+                                                                                            : E_Operation::Product,
+            0.0, (int)children.size() });
+        return;
+    }
+
+    default:
+        break;
+    }
+
+    addExpression(std::static_pointer_cast<ExpressionUnary>(expression)->child, stackSize);
+
+    switch(expression->getType())
+    {
+    case E_NonlinearExpressionTypes::Negate:
+        instructions.push_back({ E_Operation::Negate });
+        break;
+    case E_NonlinearExpressionTypes::Invert:
+        instructions.push_back({ E_Operation::Invert });
+        break;
+    case E_NonlinearExpressionTypes::SquareRoot:
+        instructions.push_back({ E_Operation::SquareRoot });
+        break;
+    case E_NonlinearExpressionTypes::Log:
+        instructions.push_back({ E_Operation::Log });
+        break;
+    case E_NonlinearExpressionTypes::Exp:
+        instructions.push_back({ E_Operation::Exp });
+        break;
+    case E_NonlinearExpressionTypes::Square:
+        instructions.push_back({ E_Operation::Square });
+        break;
+    case E_NonlinearExpressionTypes::Sin:
+        instructions.push_back({ E_Operation::Sin });
+        break;
+    case E_NonlinearExpressionTypes::Cos:
+        instructions.push_back({ E_Operation::Cos });
+        break;
+    case E_NonlinearExpressionTypes::Tan:
+        instructions.push_back({ E_Operation::Tan });
+        break;
+    case E_NonlinearExpressionTypes::ArcSin:
+        instructions.push_back({ E_Operation::ArcSin });
+        break;
+    case E_NonlinearExpressionTypes::ArcCos:
+        instructions.push_back({ E_Operation::ArcCos });
+        break;
+    case E_NonlinearExpressionTypes::ArcTan:
+        instructions.push_back({ E_Operation::ArcTan });
+        break;
+    case E_NonlinearExpressionTypes::Abs:
+    default:
+        instructions.push_back({ E_Operation::Abs });
+        break;
+    }
+}
+
+template <typename T> void AuxiliaryVariableProgram::execute(std::vector<T>& values) const
+{
+    // The stack is reused between calls, so no memory is allocated after the first one
+    thread_local std::vector<T> stack;
+
+    if(stack.size() < maxStackSize)
+        stack.resize(maxStackSize);
+
+    if(values.size() < numberOfVariables)
+        values.resize(numberOfVariables);
+
+    T value(0.0);
+    size_t top = 0;
+
+    for(auto& I : instructions)
+    {
+        switch(I.operation)
+        {
+        case E_Operation::Begin:
+            value = T(I.coefficient);
+            break;
+
+        case E_Operation::AddLinear:
+            value += I.coefficient * values[I.firstIndex];
+            break;
+
+        case E_Operation::AddQuadratic:
+            value += I.coefficient * values[I.firstIndex] * values[I.secondIndex];
+            break;
+
+        case E_Operation::AddMonomial:
+        {
+            T term(I.coefficient);
+
+            for(int k = I.firstIndex; k < I.firstIndex + I.secondIndex; k++)
+                term *= values[factorVariableIndexes[k]];
+
+            value += term;
+            break;
+        }
+
+        case E_Operation::AddSignomial:
+        {
+            T term(I.coefficient);
+
+            for(int k = I.firstIndex; k < I.firstIndex + I.secondIndex; k++)
+                term *= calculateSignomialFactor(values[factorVariableIndexes[k]], factorPowers[k]);
+
+            value += term;
+            break;
+        }
+
+        case E_Operation::AddExpression:
+            value += stack[--top];
+            break;
+
+        case E_Operation::Store:
+            values[I.firstIndex] = value;
+            break;
+
+        case E_Operation::PushConstant:
+            stack[top++] = T(I.coefficient);
+            break;
+
+        case E_Operation::PushVariable:
+            stack[top++] = values[I.firstIndex];
+            break;
+
+        case E_Operation::Negate:
+            stack[top - 1] = -stack[top - 1];
+            break;
+
+        case E_Operation::Invert:
+            stack[top - 1] = 1.0 / stack[top - 1];
+            break;
+
+        case E_Operation::SquareRoot:
+            stack[top - 1] = sqrt(stack[top - 1]);
+            break;
+
+        case E_Operation::Log:
+            stack[top - 1] = calculateLog(stack[top - 1]);
+            break;
+
+        case E_Operation::Exp:
+            stack[top - 1] = exp(stack[top - 1]);
+            break;
+
+        case E_Operation::Square:
+            stack[top - 1] = calculateSquare(stack[top - 1]);
+            break;
+
+        case E_Operation::Sin:
+            stack[top - 1] = sin(stack[top - 1]);
+            break;
+
+        case E_Operation::Cos:
+            stack[top - 1] = cos(stack[top - 1]);
+            break;
+
+        case E_Operation::Tan:
+            stack[top - 1] = tan(stack[top - 1]);
+            break;
+
+        case E_Operation::ArcSin:
+            stack[top - 1] = asin(stack[top - 1]);
+            break;
+
+        case E_Operation::ArcCos:
+            stack[top - 1] = acos(stack[top - 1]);
+            break;
+
+        case E_Operation::ArcTan:
+            stack[top - 1] = atan(stack[top - 1]);
+            break;
+
+        case E_Operation::Abs:
+            stack[top - 1] = fabs(stack[top - 1]);
+            break;
+
+        case E_Operation::Divide:
+            top--;
+            stack[top - 1] = stack[top - 1] / stack[top];
+            break;
+
+        case E_Operation::Power:
+            top--;
+            stack[top - 1] = calculatePower(stack[top - 1], stack[top]);
+            break;
+
+        case E_Operation::PowerConstant:
+            stack[top - 1] = calculateConstantPower(stack[top - 1], I.coefficient);
+            break;
+
+        case E_Operation::Sum:
+        {
+            T sum(0.0);
+
+            for(size_t k = top - I.firstIndex; k < top; k++)
+                sum += stack[k];
+
+            top -= I.firstIndex;
+            stack[top++] = sum;
+            break;
+        }
+
+        case E_Operation::Product:
+        {
+            T product(1.0);
+
+            for(size_t k = top - I.firstIndex; k < top; k++)
+            {
+                if(isZero(stack[k]))
+                {
+                    product = T(0.0);
+                    break;
+                }
+
+                product = product * stack[k];
+            }
+
+            top -= I.firstIndex;
+            stack[top++] = product;
+            break;
+        }
+        }
+    }
+
+    assert(top == 0);
+}
+
+void AuxiliaryVariableProgram::lift(VectorDouble& point) const { execute(point); }
+
+void AuxiliaryVariableProgram::lift(IntervalVector& intervalVector) const { execute(intervalVector); }
+
 std::ostream& operator<<(std::ostream& stream, AuxiliaryVariablePtr var)
 {
     stream << "[" << var->index << "]:\t";
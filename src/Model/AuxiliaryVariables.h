@@ -106,6 +106,83 @@ public:
     }
 };
 
+// The definitions of the auxiliary variables compiled to one flat list of instructions, which is executed in the order
+// of the variable indexes. A point or an interval vector in the original space is lifted to the reformulated space in a
+// single pass, where the nonlinear expressions are evaluated in post order on a value stack. The values are the same
+// as the ones given by AuxiliaryVariable::calculate.
+class AuxiliaryVariableProgram
+{
+public:
+    AuxiliaryVariableProgram(
+        const AuxiliaryVariables& auxiliaryVariables, const AuxiliaryVariablePtr& auxiliaryObjectiveVariable);
+
+    // Writes the values of the auxiliary variables (including the objective one) to the point, which is extended if it
+    // only contains the original variables. An auxiliary variable can depend on the ones with lower indexes.
+    void lift(VectorDouble& point) const;
+    void lift(IntervalVector& intervalVector) const;
+
+    size_t getNumberOfInstructions() const { return (instructions.size()); }
+
+private:
+    enum class E_Operation
+    {
+        // Sets the value of the auxiliary variable being calculated to the coefficient
+        Begin,
+        AddLinear,
+        AddQuadratic,
+        AddMonomial,
+        AddSignomial,
+        // Adds the value on top of the stack
+        AddExpression,
+        Store,
+        // Operations on the value stack
+        PushConstant,
+        PushVariable,
+        Negate,
+        Invert,
+        SquareRoot,
+        Log,
+        Exp,
+        Square,
+        Sin,
+        Cos,
+        Tan,
+        ArcSin,
+        ArcCos,
+        ArcTan,
+        Abs,
+        Divide,
+        Power,
+        // A power with a constant exponent given by the coefficient, which has special cases for intervals
+        PowerConstant,
+        Sum,
+        Product
+    };
+
+    // The meaning of the indexes depends on the operation: the variable indexes for the terms, the position and number
+    // of elements in the factor lists for monomials and signomials, or the number of children for sums and products
+    struct Instruction
+    {
+        E_Operation operation;
+        double coefficient = 0.0;
+        int firstIndex = 0;
+        int secondIndex = 0;
+    };
+
+    std::vector<Instruction> instructions;
+    std::vector<int> factorVariableIndexes;
+    VectorDouble factorPowers;
+
+    size_t maxStackSize = 0;
+    size_t numberOfVariables = 0;
+
+    void addExpression(const NonlinearExpressionPtr& expression, size_t stackSize);
+
+    template <typename T> void execute(std::vector<T>& values) const;
+};
+
+using AuxiliaryVariableProgramPtr = std::shared_ptr<AuxiliaryVariableProgram>;
+
 std::ostream& operator<<(std::ostream& stream, AuxiliaryVariablePtr var);
 
 } // namespace SHOT
\ No newline at end of file
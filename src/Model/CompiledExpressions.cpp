@@ -0,0 +1,507 @@
+/**
+   The Supporting Hyperplane Optimization Toolkit (SHOT).
+
+   @author Andreas Lundell, Åbo Akademi University
+
+   @section LICENSE
+   This software is licensed under the Eclipse Public License 2.0.
+   Please see the README and LICENSE files for more information.
+*/
+
+#include "CompiledExpressions.h"
+
+#include "../Output.h"
+#include "../Settings.h"
+
+#include <cmath>
+#include <cstdlib>
+#include <fstream>
+#include <functional>
+#include <limits>
+#include <map>
+#include <random>
+#include <sstream>
+
+#include "spdlog/fmt/fmt.h"
+
+#ifdef _WIN32
+#include <process.h>
+#define getpid _getpid
+#else
+#include <dlfcn.h>
+#include <unistd.h>
+#endif
+
+#ifdef HAS_STD_FILESYSTEM
+#include <filesystem>
+namespace fs = std;
+#endif
+
+#ifdef HAS_STD_EXPERIMENTAL_FILESYSTEM
+#include <experimental/filesystem>
+namespace fs = std::experimental;
+#endif
+
+namespace SHOT
+{
+
+namespace
+{
+// The 64-bit FNV-1a hash, which unlike std::hash gives the same value for the same source in all builds and runs, so
+// it can be used as the name of the cached libraries
+uint64_t getStableHash(const std::string& text)
+{
+    uint64_t hash = 14695981039346656037ULL;
+
+    for(unsigned char C : text)
+    {
+        hash ^= C;
+        hash *= 1099511628211ULL;
+    }
+
+    return (hash);
+}
+
+    // Has the same special cases as ExpressionPower::calculate
+    const char* sourceHeader = R"(#include <math.h>
+
+static double shot_pow(double base, double exponent)
+{
+    if(fabs(base - 0.0) <= 1e-10 * fabs(base))
+        return 0.0;
+
+    if(fabs(base - 1.0) <= 1e-10 * fabs(base))
+        return 1.0;
+
+    if(fabs(exponent - 0.0) <= 1e-10 * fabs(base))
+        return 1.0;
+
+    if(fabs(exponent - 1.0) <= 1e-10 * fabs(base))
+        return base;
+
+    return pow(base, exponent);
+}
+
+)";
+
+    // A node in the flattened expression, the children are referenced by their position in the node list
+    struct CodeNode
+    {
+        E_NonlinearExpressionTypes type;
+        std::vector<size_t> children;
+        double constant = 0.0;
+        int variableIndex = -1;
+        int localVariableIndex = -1;
+    };
+
+    std::string formatConstant(double value)
+    {
+        if(std::isnan(value))
+            return ("NAN");
+
+        if(std::isinf(value))
+            return (value > 0 ? "HUGE_VAL" : "(-HUGE_VAL)");
+
+        std::ostringstream stream;
+        stream.precision(std::numeric_limits<double>::max_digits10);
+        stream << "(" << value << ")";
+        return (stream.str());
+    }
+
+    // Stores the expression tree in post order, i.e. the children always precede their parent
+    size_t addNodes(const NonlinearExpressionPtr& expression, const std::map<int, int>& localVariableIndexes,
+        std::vector<CodeNode>& nodes)
+    {
+        CodeNode node;
+        node.type = expression->getType();
+
+        switch(node.type)
+        {
+        case E_NonlinearExpressionTypes::Constant:
+            node.constant = std::static_pointer_cast<ExpressionConstant>(expression)->constant;
+            break;
+
+        case E_NonlinearExpressionTypes::Variable:
+            node.variableIndex = std::static_pointer_cast<ExpressionVariable>(expression)->variable->index;
+            node.localVariableIndex = localVariableIndexes.at(node.variableIndex);
+            break;
+
+        case E_NonlinearExpressionTypes::Divide:
+        case E_NonlinearExpressionTypes::Power:
+        {
+            auto binary = std::static_pointer_cast<ExpressionBinary>(expression);
+            node.children.push_back(addNodes(binary->firstChild, localVariableIndexes, nodes));
+            node.children.push_back(addNodes(binary->secondChild, localVariableIndexes, nodes));
+            break;
+        }
+
+        case E_NonlinearExpressionTypes::Sum:
+        case E_NonlinearExpressionTypes::Product:
+            for(auto& C : std::static_pointer_cast<ExpressionGeneral>(expression)->children)
+                node.children.push_back(addNodes(C, localVariableIndexes, nodes));
+            break;
+
+        default:
+            node.children.push_back(
+                addNodes(std::static_pointer_cast<ExpressionUnary>(expression)->child, localVariableIndexes, nodes));
+            break;
+        }
+
+        nodes.push_back(node);
+        return (nodes.size() - 1);
+    }
+
+    // Writes the forward pass, where the value of node k is stored in vk
+    void writeForwardPass(const std::vector<CodeNode>& nodes, std::ostream& stream)
+    {
+        for(size_t k = 0; k < nodes.size(); k++)
+        {
+            auto& N = nodes[k];
+            auto c = [&](size_t i) { return ("v" + std::to_string(N.children[i])); };
+
+            stream << "    double v" << k << " = ";
+
+            switch(N.type)
+            {
+            case E_NonlinearExpressionTypes::Constant:
+                stream << formatConstant(N.constant);
+                break;
+            case E_NonlinearExpressionTypes::Variable:
+                stream << "x[" << N.variableIndex << "]";
+                break;
+            case E_NonlinearExpressionTypes::Negate:
+                stream << "-" << c(0);
+                break;
+            case E_NonlinearExpressionTypes::Invert:
+                stream << "1.0 / " << c(0);
+                break;
+            case E_NonlinearExpressionTypes::SquareRoot:
+                stream << "sqrt(" << c(0) << ")";
+                break;
+            case E_NonlinearExpressionTypes::Log:
+                stream << "log(" << c(0) << ")";
+                break;
+            case E_NonlinearExpressionTypes::Exp:
+                stream << "exp(" << c(0) << ")";
+                break;
+            case E_NonlinearExpressionTypes::Square:
+                stream << c(0) << " * " << c(0);
+                break;
+            case E_NonlinearExpressionTypes::Cos:
+                stream << "cos(" << c(0) << ")";
+                break;
+            case E_NonlinearExpressionTypes::Sin:
+                stream << "sin(" << c(0) << ")";
+                break;
+            case E_NonlinearExpressionTypes::Tan:
+                stream << "tan(" << c(0) << ")";
+                break;
+            case E_NonlinearExpressionTypes::ArcCos:
+                stream << "acos(" << c(0) << ")";
+                break;
+            case E_NonlinearExpressionTypes::ArcSin:
+                stream << "asin(" << c(0) << ")";
+                break;
+            case E_NonlinearExpressionTypes::ArcTan:
+                stream << "atan(" << c(0) << ")";
+                break;
+            case E_NonlinearExpressionTypes::Abs:
+                stream << "fabs(" << c(0) << ")";
+                break;
+            case E_NonlinearExpressionTypes::Divide:
+                stream << c(0) << " / " << c(1);
+                break;
+            case E_NonlinearExpressionTypes::Power:
+                stream << "shot_pow(" << c(0) << ", " << c(1) << ")";
+                break;
+            case E_NonlinearExpressionTypes::Sum:
+                if(N.children.size() == 0)
+                    stream << "0.0";
+
+                for(size_t i = 0; i < N.children.size(); i++)
+                    stream << (i > 0 ? " + " : "") << c(i);
+
+                break;
+            case E_NonlinearExpressionTypes::Product:
+                // A zero factor gives zero regardless of the other factors, as in ExpressionProduct::calculate
+                stream << "1.0;\n";
+
+                for(size_t i = 0; i < N.children.size(); i++)
+                    stream << "    v" << k << " = (v" << k << " == 0.0 || " << c(i) << " == 0.0) ? 0.0 : v" << k
+                           << " * " << c(i) << ";\n";
+
+                continue;
+            }
+
+            stream << ";\n";
+        }
+    }
+
+    // Writes the reverse pass, where the adjoint of node k is accumulated in ak and the adjoints of the variable nodes
+    // are added to the gradient
+    void writeReversePass(const std::vector<CodeNode>& nodes, std::ostream& stream)
+    {
+        for(size_t k = 0; k < nodes.size(); k++)
+            stream << "    double a" << k << " = " << (k + 1 == nodes.size() ? "1.0" : "0.0") << ";\n";
+
+        for(size_t j = nodes.size(); j-- > 0;)
+        {
+            auto& N = nodes[j];
+            std::string a = "a" + std::to_string(j);
+            std::string v = "v" + std::to_string(j);
+            auto c = [&](size_t i) { return ("v" + std::to_string(N.children[i])); };
+            auto ac = [&](size_t i) { return ("    a" + std::to_string(N.children[i]) + " += "); };
+
+            switch(N.type)
+            {
+            case E_NonlinearExpressionTypes::Constant:
+                break;
+            case E_NonlinearExpressionTypes::Variable:
+                stream << "    g[" << N.localVariableIndex << "] += " << a << ";\n";
+                break;
+            case E_NonlinearExpressionTypes::Negate:
+                stream << ac(0) << "-" << a << ";\n";
+                break;
+            case E_NonlinearExpressionTypes::Invert:
+                stream << ac(0) << "-" << a << " * " << v << " * " << v << ";\n";
+                break;
+            case E_NonlinearExpressionTypes::SquareRoot:
+                stream << ac(0) << a << " * 0.5 / " << v << ";\n";
+                break;
+            case E_NonlinearExpressionTypes::Log:
+                stream << ac(0) << a << " / " << c(0) << ";\n";
+                break;
+            case E_NonlinearExpressionTypes::Exp:
+                stream << ac(0) << a << " * " << v << ";\n";
+                break;
+            case E_NonlinearExpressionTypes::Square:
+                stream << ac(0) << "2.0 * " << a << " * " << c(0) << ";\n";
+                break;
+            case E_NonlinearExpressionTypes::Cos:
+                stream << ac(0) << "-" << a << " * sin(" << c(0) << ");\n";
+                break;
+            case E_NonlinearExpressionTypes::Sin:
+                stream << ac(0) << a << " * cos(" << c(0) << ");\n";
+                break;
+            case E_NonlinearExpressionTypes::Tan:
+                stream << ac(0) << a << " * (1.0 + " << v << " * " << v << ");\n";
+                break;
+            case E_NonlinearExpressionTypes::ArcCos:
+                stream << ac(0) << "-" << a << " / sqrt(1.0 - " << c(0) << " * " << c(0) << ");\n";
+                break;
+            case E_NonlinearExpressionTypes::ArcSin:
+                stream << ac(0) << a << " / sqrt(1.0 - " << c(0) << " * " << c(0) << ");\n";
+                break;
+            case E_NonlinearExpressionTypes::ArcTan:
+                stream << ac(0) << a << " / (1.0 + " << c(0) << " * " << c(0) << ");\n";
+                break;
+            case E_NonlinearExpressionTypes::Abs:
+                stream << ac(0) << a << " * ((" << c(0) << " > 0.0) - (" << c(0) << " < 0.0));\n";
+                break;
+            case E_NonlinearExpressionTypes::Divide:
+                stream << ac(0) << a << " / " << c(1) << ";\n";
+                stream << ac(1) << "-" << a << " * " << v << " / " << c(1) << ";\n";
+                break;
+            case E_NonlinearExpressionTypes::Power:
+                stream << ac(0) << a << " * " << c(1) << " * pow(" << c(0) << ", " << c(1) << " - 1.0);\n";
+
+                // No derivative is needed with respect to a constant exponent
+                if(nodes[N.children[1]].type != E_NonlinearExpressionTypes::Constant)
+                    stream << "    if(" << c(0) << " > 0.0)\n    " << ac(1) << a << " * " << v << " * log(" << c(0)
+                           << ");\n";
+
+                break;
+            case E_NonlinearExpressionTypes::Sum:
+                for(size_t i = 0; i < N.children.size(); i++)
+                    stream << ac(i) << a << ";\n";
+
+                break;
+            case E_NonlinearExpressionTypes::Product:
+                for(size_t i = 0; i < N.children.size(); i++)
+                {
+                    stream << ac(i) << a;
+
+                    for(size_t l = 0; l < N.children.size(); l++)
+                    {
+                        if(l != i)
+                            stream << " * " << c(l);
+                    }
+
+                    stream << ";\n";
+                }
+
+                break;
+            }
+        }
+    }
+} // namespace
+
+CompiledExpressions::~CompiledExpressions()
+{
+#ifndef _WIN32
+    if(libraryHandle != nullptr)
+        dlclose(libraryHandle);
+#endif
+}
+
+std::string CompiledExpressions::generateSource(const NonlinearConstraints& constraints)
+{
+    std::ostringstream source;
+    source << sourceHeader;
+
+    for(auto& C : constraints)
+    {
+        if(!C->properties.hasNonlinearExpression || C->variablesInNonlinearExpression.size() == 0)
+            continue;
+
+        std::map<int, int> localVariableIndexes;
+
+        for(size_t i = 0; i < C->variablesInNonlinearExpression.size(); i++)
+            localVariableIndexes.emplace(C->variablesInNonlinearExpression[i]->index, (int)i);
+
+        std::vector<CodeNode> nodes;
+        addNodes(C->nonlinearExpression, localVariableIndexes, nodes);
+
+        source << "double shot_value_" << C->index << "(const double* x)\n{\n";
+        writeForwardPass(nodes, source);
+        source << "    return v" << nodes.size() - 1 << ";\n}\n\n";
+
+        source << "void shot_gradient_" << C->index << "(const double* x, double* g)\n{\n";
+        source << "    for(int i = 0; i < " << C->variablesInNonlinearExpression.size() << "; i++)\n";
+        source << "        g[i] = 0.0;\n\n";
+        writeForwardPass(nodes, source);
+        source << "\n";
+        writeReversePass(nodes, source);
+        source << "}\n\n";
+    }
+
+    return (source.str());
+}
+
+bool CompiledExpressions::compileSource(const std::string& source, const std::string& libraryFile)
+{
+    // The files are unique for each call, so that concurrent solver processes compiling the same source do not
+    // write to the same files
+    std::random_device randomDevice;
+    auto uniqueSuffix = fmt::format(".{}.{:08x}", getpid(), randomDevice());
+
+    std::string sourceFile = libraryFile + uniqueSuffix + ".c";
+    std::string temporaryFile = libraryFile + uniqueSuffix + ".tmp";
+
+    std::ofstream stream(sourceFile);
+
+    if(!stream)
+    {
+        env->output->outputWarning(fmt::format("  Could not write generated code to {}.", sourceFile));
+        return (false);
+    }
+
+    stream << source;
+    stream.close();
+
+    auto command = fmt::format("{} -O2 -shared -fPIC -o \"{}\" \"{}\" -lm",
+        env->settings->getSetting<std::string>("CodeGeneration.Compiler", "Model"), temporaryFile, sourceFile);
+
+    env->output->outputDebug("  Compiling nonlinear expressions: {}", command);
+
+    bool isCompiled = (std::system(command.c_str()) == 0);
+
+    std::error_code error;
+    fs::filesystem::remove(sourceFile, error);
+
+    if(!isCompiled)
+    {
+        env->output->outputWarning(fmt::format("  Could not compile generated code with: {}", command));
+        fs::filesystem::remove(temporaryFile, error);
+        return (false);
+    }
+
+    // Renaming is atomic, so concurrent solver processes sharing the cache never load a partially written library
+    fs::filesystem::rename(temporaryFile, libraryFile, error);
+
+    if(error)
+    {
+        fs::filesystem::remove(temporaryFile, error);
+        return (false);
+    }
+
+    return (true);
+}
+
+bool CompiledExpressions::compile(const NonlinearConstraints& constraints)
+{
+#ifdef _WIN32
+    env->output->outputWarning("  Code generation for nonlinear expressions is not supported on Windows.");
+    return (false);
+#else
+    auto source = generateSource(constraints);
+
+    fs::filesystem::path cachePath(env->settings->getSetting<std::string>("CodeGeneration.CachePath", "Model"));
+
+    if(cachePath.empty())
+        cachePath = fs::filesystem::temp_directory_path() / "SHOT_compiled";
+
+    std::error_code error;
+    fs::filesystem::create_directories(cachePath, error);
+
+    if(error)
+    {
+        env->output->outputWarning(
+            fmt::format("  Could not create cache directory {} for generated code.", cachePath.string()));
+        return (false);
+    }
+
+    // The compiler is included in the hash since another compiler may give a library that cannot be loaded
+    auto compiler = env->settings->getSetting<std::string>("CodeGeneration.Compiler", "Model");
+    auto hash = getStableHash(compiler + "\n" + source);
+    auto libraryFile = (cachePath / fmt::format("shot_{:016x}.so", hash)).string();
+
+    if(fs::filesystem::exists(libraryFile))
+        env->output->outputDebug("  Reusing compiled nonlinear expressions in {}", libraryFile);
+    else if(!compileSource(source, libraryFile))
+        return (false);
+
+    libraryHandle = dlopen(libraryFile.c_str(), RTLD_NOW | RTLD_LOCAL);
+
+    if(libraryHandle == nullptr)
+    {
+        env->output->outputWarning(fmt::format("  Could not load compiled nonlinear expressions: {}", dlerror()));
+        return (false);
+    }
+
+    std::vector<std::pair<CompiledFunctionValue, CompiledGradient>> functions(constraints.size(), { nullptr, nullptr });
+
+    for(size_t i = 0; i < constraints.size(); i++)
+    {
+        auto& C = constraints[i];
+
+        if(!C->properties.hasNonlinearExpression || C->variablesInNonlinearExpression.size() == 0)
+            continue;
+
+        functions[i].first = reinterpret_cast<CompiledFunctionValue>(
+            dlsym(libraryHandle, fmt::format("shot_value_{}", C->index).c_str()));
+        functions[i].second = reinterpret_cast<CompiledGradient>(
+            dlsym(libraryHandle, fmt::format("shot_gradient_{}", C->index).c_str()));
+
+        if(functions[i].first == nullptr || functions[i].second == nullptr)
+        {
+            env->output->outputWarning(
+                fmt::format("  Compiled code for constraint {} not found in {}.", C->name, libraryFile));
+
+            dlclose(libraryHandle);
+            libraryHandle = nullptr;
+            return (false);
+        }
+    }
+
+    for(size_t i = 0; i < constraints.size(); i++)
+    {
+        constraints[i]->compiledFunctionValue = functions[i].first;
+        constraints[i]->compiledGradient = functions[i].second;
+    }
+
+    return (true);
+#endif
+}
+
+} // namespace SHOT
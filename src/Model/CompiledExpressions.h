@@ -0,0 +1,45 @@
+/**
+   The Supporting Hyperplane Optimization Toolkit (SHOT).
+
+   @author Andreas Lundell, Åbo Akademi University
+
+   @section LICENSE
+   This software is licensed under the Eclipse Public License 2.0.
+   Please see the README and LICENSE files for more information.
+*/
+
+#pragma once
+
+#include "../Environment.h"
+#include "../Structs.h"
+
+#include "Constraints.h"
+
+#include <string>
+
+namespace SHOT
+{
+
+// Translates the nonlinear expressions in the constraints to straight-line C code for the function value and the
+// gradient (reverse mode), compiles it with the system C compiler and loads the resulting shared library. The
+// libraries are cached on disk and keyed by a hash of the generated source, so a model that is solved again reuses
+// the already compiled code.
+class CompiledExpressions
+{
+public:
+    CompiledExpressions(EnvironmentPtr envPtr) : env(envPtr) {};
+    ~CompiledExpressions();
+
+    // Sets the compiled function pointers in the constraints, returns false if the code could not be generated,
+    // compiled or loaded, in which case the constraints are left unchanged
+    bool compile(const NonlinearConstraints& constraints);
+
+private:
+    EnvironmentPtr env;
+    void* libraryHandle = nullptr;
+
+    std::string generateSource(const NonlinearConstraints& constraints);
+    bool compileSource(const std::string& source, const std::string& libraryFile);
+};
+
+} // namespace SHOT
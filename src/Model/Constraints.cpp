@@ -239,7 +239,7 @@ SparseVariableVector LinearConstraint::calculateGradient(const VectorDouble& poi
     SparseVariableVector gradient = linearTerms.calculateGradient(point);
 
     if(eraseZeroes)
-        Utilities::erase_if<VariablePtr, double>(gradient, 0.0);
+        gradient.compress(true);
 
     return gradient;
 }
@@ -353,10 +353,11 @@ void QuadraticConstraint::takeOwnership(ProblemPtr owner)
 
 SparseVariableVector QuadraticConstraint::calculateGradient(const VectorDouble& point, bool eraseZeroes = true)
 {
-    SparseVariableVector linearGradient = LinearConstraint::calculateGradient(point, eraseZeroes);
-    SparseVariableVector quadraticGradient = quadraticTerms.calculateGradient(point);
+    SparseVariableVector gradient = LinearConstraint::calculateGradient(point, eraseZeroes);
+    gradient.add(quadraticTerms.calculateGradient(point));
+    gradient.compress(eraseZeroes);
 
-    return (Utilities::combineSparseVariableVectors(linearGradient, quadraticGradient));
+    return (gradient);
 }
 
 void QuadraticConstraint::initializeGradientSparsityPattern()
@@ -567,7 +568,11 @@ void NonlinearConstraint::add(NonlinearExpressionPtr expression)
 
 void NonlinearConstraint::updateFactorableFunction()
 {
-    factorableFunction = std::make_shared<FactorableFunction>(nonlinearExpression->getFactorableFunction());
+    factorableFunction = std::make_shared<FactorableFunction>(
+        recordFactorableFunctionTape(nonlinearExpression, variablesInNonlinearExpression, ADFunction));
+
+    nonlinearGradientSparsityMapGenerated = false;
+    nonlinearHessianSparsityMapGenerated = false;
 }
 
 double NonlinearConstraint::calculateFunctionValue(const VectorDouble& point)
@@ -580,7 +585,9 @@ double NonlinearConstraint::calculateFunctionValue(const VectorDouble& point)
     if(this->properties.hasSignomialTerms)
         value += signomialTerms.calculate(point);
 
-    if(this->properties.hasNonlinearExpression)
+    if(this->properties.hasNonlinearExpression && compiledFunctionValue != nullptr)
+        value += compiledFunctionValue(point.data());
+    else if(this->properties.hasNonlinearExpression)
         value += nonlinearExpression->calculate(point);
 
     return value;
@@ -629,68 +636,60 @@ SparseVariableVector NonlinearConstraint::calculateGradient(const VectorDouble&
 {
     SparseVariableVector gradient = QuadraticConstraint::calculateGradient(point, eraseZeroes);
 
-    SparseVariableVector monomialGradient;
-
     if(this->properties.hasMonomialTerms)
-    {
-        monomialGradient = monomialTerms.calculateGradient(point);
-    }
-
-    SparseVariableVector signomialGradient;
+        gradient.add(monomialTerms.calculateGradient(point));
 
     if(this->properties.hasSignomialTerms)
-    {
-        signomialGradient = signomialTerms.calculateGradient(point);
-    }
+        gradient.add(signomialTerms.calculateGradient(point));
 
-    if(this->properties.hasNonlinearExpression)
+    if(this->properties.hasNonlinearExpression && compiledGradient != nullptr)
     {
-        if(!nonlinearGradientSparsityMapGenerated)
-            initializeGradientSparsityPattern();
+        VectorDouble nonlinearGradient(variablesInNonlinearExpression.size());
+        compiledGradient(point.data(), nonlinearGradient.data());
 
-        if(auto sharedOwnerProblem = ownerProblem.lock())
+        for(size_t i = 0; i < variablesInNonlinearExpression.size(); i++)
         {
-            int numberOfNonlinearVariables = sharedOwnerProblem->properties.numberOfVariablesInNonlinearExpressions;
-
-            std::vector<double> pointNonlinearSubset(numberOfNonlinearVariables, 0.0);
+            if(nonlinearGradient[i] == 0.0)
+                continue;
 
-            for(auto& VAR : sharedOwnerProblem->nonlinearExpressionVariables)
-                pointNonlinearSubset[VAR->properties.nonlinearVariableIndex] = point[VAR->index];
+            gradient.add(variablesInNonlinearExpression[i], nonlinearGradient[i]);
+        }
+    }
+    else if(this->properties.hasNonlinearExpression)
+    {
+        if(!nonlinearGradientSparsityMapGenerated)
+            initializeGradientSparsityPattern();
 
-            CppAD::sparse_rcv<std::vector<size_t>, std::vector<double>> subset(nonlinearGradientSparsityPattern);
-            sharedOwnerProblem->ADFunctions.subgraph_jac_rev(pointNonlinearSubset, subset);
+        std::vector<double> pointNonlinearSubset(variablesInNonlinearExpression.size());
 
-            const std::vector<size_t>& col(subset.col());
-            const std::vector<double>& value(subset.val());
+        for(size_t i = 0; i < variablesInNonlinearExpression.size(); i++)
+            pointNonlinearSubset[i] = point[variablesInNonlinearExpression[i]->index];
 
-            std::vector<size_t> rowMajor = subset.row_major();
+        CppAD::sparse_rcv<std::vector<size_t>, std::vector<double>> subset(nonlinearGradientSparsityPattern);
+        {
+            std::lock_guard<std::mutex> lock(ADFunctionMutex);
+            ADFunction.subgraph_jac_rev(pointNonlinearSubset, subset);
+        }
 
-            for(auto k : rowMajor)
-            {
-                double coefficient = value[k];
+        const std::vector<size_t>& col(subset.col());
+        const std::vector<double>& value(subset.val());
 
-                if(coefficient == 0.0)
-                    continue;
+        std::vector<size_t> rowMajor = subset.row_major();
 
-                auto VAR = sharedOwnerProblem->nonlinearExpressionVariables[col[k]];
+        for(auto k : rowMajor)
+        {
+            double coefficient = value[k];
 
-                auto element = gradient.emplace(VAR, coefficient);
+            if(coefficient == 0.0)
+                continue;
 
-                if(!element.second)
-                {
-                    // Element already exists for the variable
-                    element.first->second += coefficient;
-                }
-            }
+            gradient.add(variablesInNonlinearExpression[col[k]], coefficient);
         }
     }
 
-    auto result = Utilities::combineSparseVariableVectors(gradient, monomialGradient, signomialGradient);
-
-    if(eraseZeroes)
-        Utilities::erase_if<VariablePtr, double>(result, 0.0);
+    gradient.compress(eraseZeroes);
 
-    return result;
+    return gradient;
 }
 
 void NonlinearConstraint::initializeGradientSparsityPattern()
@@ -731,46 +730,29 @@ void NonlinearConstraint::initializeGradientSparsityPattern()
 
     if(this->properties.hasNonlinearExpression)
     {
-        if(auto sharedOwnerProblem = ownerProblem.lock())
-        {
-            assert(sharedOwnerProblem->properties.numberOfVariablesInNonlinearExpressions > 0);
-            assert(sharedOwnerProblem->properties.numberOfNonlinearExpressions > 0);
-            assert(this->nonlinearExpressionIndex >= 0);
-
-            // For some reason we need to have all nonlinear variables activated, otherwise not all nonzero elements
-            // of the gradient may be detected
-            auto nonlinearVariablesInExpressionMap
-                = std::vector<bool>(sharedOwnerProblem->properties.numberOfVariablesInNonlinearExpressions, true);
+        assert(variablesInNonlinearExpression.size() > 0);
 
-            auto nonlinearFunctionMap
-                = std::vector<bool>(sharedOwnerProblem->properties.numberOfNonlinearExpressions, false);
+        // For some reason we need to have all nonlinear variables activated, otherwise not all nonzero elements
+        // of the gradient may be detected
+        auto nonlinearVariablesInExpressionMap = std::vector<bool>(variablesInNonlinearExpression.size(), true);
+        auto nonlinearFunctionMap = std::vector<bool>(1, true);
 
-            nonlinearFunctionMap[this->nonlinearExpressionIndex] = true;
+        CppAD::sparse_rc<std::vector<size_t>> pattern;
 
-            CppAD::sparse_rc<std::vector<size_t>> pattern;
+        ADFunction.subgraph_sparsity(nonlinearVariablesInExpressionMap, nonlinearFunctionMap, false, pattern);
 
-            sharedOwnerProblem->ADFunctions.subgraph_sparsity(
-                nonlinearVariablesInExpressionMap, nonlinearFunctionMap, false, pattern);
+        // Save for later use when calculating gradients
+        nonlinearGradientSparsityPattern = pattern;
 
-            // Save for later use when calculating gradients
-            nonlinearGradientSparsityPattern = pattern;
+        const std::vector<size_t>& variableIndices(nonlinearGradientSparsityPattern.col());
 
-            const std::vector<size_t>& variableIndices(nonlinearGradientSparsityPattern.col());
-
-            for(size_t i = 0; i < nonlinearGradientSparsityPattern.nnz(); i++)
-            {
-                for(auto& VAR : variablesInNonlinearExpression)
-                {
-                    if((size_t)VAR->properties.nonlinearVariableIndex == variableIndices[i])
-                    {
-                        if(std::find(gradientSparsityPattern->begin(), gradientSparsityPattern->end(), VAR)
-                            == gradientSparsityPattern->end())
-                            gradientSparsityPattern->push_back(VAR);
+        for(size_t i = 0; i < nonlinearGradientSparsityPattern.nnz(); i++)
+        {
+            auto VAR = variablesInNonlinearExpression[variableIndices[i]];
 
-                        continue;
-                    }
-                }
-            }
+            if(std::find(gradientSparsityPattern->begin(), gradientSparsityPattern->end(), VAR)
+                == gradientSparsityPattern->end())
+                gradientSparsityPattern->push_back(VAR);
         }
     }
 
@@ -783,12 +765,12 @@ SparseVariableMatrix NonlinearConstraint::calculateHessian(const VectorDouble& p
 
     if(properties.hasMonomialTerms)
     {
-        hessian = Utilities::combineSparseVariableMatrices(monomialTerms.calculateHessian(point), hessian);
+        monomialTerms.calculateHessian(point, hessian);
     }
 
     if(properties.hasSignomialTerms)
     {
-        hessian = Utilities::combineSparseVariableMatrices(signomialTerms.calculateHessian(point), hessian);
+        signomialTerms.calculateHessian(point, hessian);
     }
 
     if(this->properties.hasNonlinearExpression)
@@ -796,43 +778,45 @@ SparseVariableMatrix NonlinearConstraint::calculateHessian(const VectorDouble& p
         if(!nonlinearHessianSparsityMapGenerated)
             initializeHessianSparsityPattern();
 
-        if(auto sharedOwnerProblem = ownerProblem.lock())
-        {
-            int numberOfNonlinearVariables = sharedOwnerProblem->properties.numberOfVariablesInNonlinearExpressions;
+        size_t numberOfNonlinearVariables = variablesInNonlinearExpression.size();
+
+        std::vector<double> pointNonlinearSubset(numberOfNonlinearVariables);
 
-            std::vector<double> pointNonlinearSubset(numberOfNonlinearVariables, 0.0);
+        for(size_t i = 0; i < numberOfNonlinearVariables; i++)
+            pointNonlinearSubset[i] = point[variablesInNonlinearExpression[i]->index];
 
-            std::vector<double> weights(sharedOwnerProblem->properties.numberOfNonlinearExpressions, 0.0);
-            weights[this->nonlinearExpressionIndex] = 1.0;
+        std::vector<double> weights(1, 1.0);
 
-            for(auto& VAR : sharedOwnerProblem->nonlinearExpressionVariables)
-                pointNonlinearSubset[VAR->properties.nonlinearVariableIndex] = point[VAR->index];
+        // TODO: utilize sparsity pattern
+        std::vector<double> calculatedHessian;
 
-            // TODO: utilize sparsity pattern
-            auto calculatedHessian = sharedOwnerProblem->ADFunctions.SparseHessian(pointNonlinearSubset, weights);
+        {
+            std::lock_guard<std::mutex> lock(ADFunctionMutex);
+            calculatedHessian = ADFunction.SparseHessian(pointNonlinearSubset, weights);
+        }
+
+        for(size_t i = 0; i < numberOfNonlinearVariables; i++)
+        {
+            auto& V1 = variablesInNonlinearExpression[i];
 
-            for(auto& V1 : variablesInNonlinearExpression)
+            for(size_t j = 0; j < numberOfNonlinearVariables; j++)
             {
-                for(auto& V2 : variablesInNonlinearExpression)
-                {
-                    size_t hessianIndex = V1->properties.nonlinearVariableIndex * numberOfNonlinearVariables
-                        + V2->properties.nonlinearVariableIndex;
+                auto& V2 = variablesInNonlinearExpression[j];
 
-                    double hessianValue = calculatedHessian[hessianIndex];
+                double hessianValue = calculatedHessian[i * numberOfNonlinearVariables + j];
 
-                    if(hessianValue == 0.0)
-                        continue;
+                if(hessianValue == 0.0)
+                    continue;
 
-                    // Only save elements above the diagonal since the Hessian is symmetric
-                    if(V1->index <= V2->index)
-                    {
-                        auto element = hessian.emplace(std::make_pair(V1, V2), hessianValue);
+                // Only save elements above the diagonal since the Hessian is symmetric
+                if(V1->index <= V2->index)
+                {
+                    auto element = hessian.emplace(std::make_pair(V1, V2), hessianValue);
 
-                        if(!element.second)
-                        {
-                            // Element already exists for the variable
-                            element.first->second += hessianValue;
-                        }
+                    if(!element.second)
+                    {
+                        // Element already exists for the variable
+                        element.first->second += hessianValue;
                     }
                 }
             }
@@ -901,53 +885,35 @@ void NonlinearConstraint::initializeHessianSparsityPattern()
 
     if(this->properties.hasNonlinearExpression)
     {
-        if(auto sharedOwnerProblem = ownerProblem.lock())
-        {
-            // For some reason we need to have all nonlinear variables activated, otherwise not all nonzero elements of
-            // the hessian may be detected
-            auto nonlinearVariablesInExpressionMap
-                = std::vector<bool>(sharedOwnerProblem->properties.numberOfVariablesInNonlinearExpressions, true);
+        // For some reason we need to have all nonlinear variables activated, otherwise not all nonzero elements of
+        // the hessian may be detected
+        auto nonlinearVariablesInExpressionMap = std::vector<bool>(variablesInNonlinearExpression.size(), true);
+        auto nonlinearFunctionMap = std::vector<bool>(1, true);
 
-            auto nonlinearFunctionMap
-                = std::vector<bool>(sharedOwnerProblem->properties.numberOfNonlinearExpressions, false);
+        CppAD::sparse_rc<std::vector<size_t>> pattern;
 
-            nonlinearFunctionMap[this->nonlinearExpressionIndex] = true;
+        ADFunction.for_hes_sparsity(nonlinearVariablesInExpressionMap, nonlinearFunctionMap, false, pattern);
 
-            CppAD::sparse_rc<std::vector<size_t>> pattern;
+        nonlinearHessianSparsityPattern = pattern;
 
-            sharedOwnerProblem->ADFunctions.for_hes_sparsity(
-                nonlinearVariablesInExpressionMap, nonlinearFunctionMap, false, pattern);
+        const std::vector<size_t>& rowIndices(nonlinearHessianSparsityPattern.row());
+        const std::vector<size_t>& colIndices(nonlinearHessianSparsityPattern.col());
 
-            nonlinearHessianSparsityPattern = pattern;
+        for(size_t i = 0; i < nonlinearHessianSparsityPattern.nnz(); i++)
+        {
+            auto& V1 = variablesInNonlinearExpression[rowIndices[i]];
+            auto& V2 = variablesInNonlinearExpression[colIndices[i]];
 
-            const std::vector<size_t>& rowIndices(nonlinearHessianSparsityPattern.row());
-            const std::vector<size_t>& colIndices(nonlinearHessianSparsityPattern.col());
+            std::pair<VariablePtr, VariablePtr> variablePair;
 
-            for(size_t i = 0; i < nonlinearHessianSparsityPattern.nnz(); i++)
-            {
-                for(auto& V1 : variablesInNonlinearExpression)
-                {
-                    for(auto& V2 : variablesInNonlinearExpression)
-                    {
-                        if((size_t)V1->properties.nonlinearVariableIndex == rowIndices[i]
-                            && (size_t)V2->properties.nonlinearVariableIndex == colIndices[i])
-                        {
-                            std::pair<VariablePtr, VariablePtr> variablePair;
-
-                            if(V1->index < V2->index)
-                                variablePair = std::make_pair(V1, V2);
-                            else
-                                variablePair = std::make_pair(V2, V1);
-
-                            if(std::find(hessianSparsityPattern->begin(), hessianSparsityPattern->end(), variablePair)
-                                == hessianSparsityPattern->end())
-                                hessianSparsityPattern->push_back(variablePair);
-
-                            continue;
-                        }
-                    }
-                }
-            }
+            if(V1->index < V2->index)
+                variablePair = std::make_pair(V1, V2);
+            else
+                variablePair = std::make_pair(V2, V1);
+
+            if(std::find(hessianSparsityPattern->begin(), hessianSparsityPattern->end(), variablePair)
+                == hessianSparsityPattern->end())
+                hessianSparsityPattern->push_back(variablePair);
         }
     }
 
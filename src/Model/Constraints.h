@@ -12,6 +12,7 @@
 
 #include <string>
 #include <memory>
+#include <mutex>
 
 #include "../Enums.h"
 #include "../Structs.h"
@@ -292,6 +293,11 @@ using QuadraticConstraints = std::vector<QuadraticConstraintPtr>;
 
 std::ostream& operator<<(std::ostream& stream, QuadraticConstraintPtr constraint);
 
+// Signatures of the nonlinear expressions compiled to native code by CompiledExpressions. The point is in the space of
+// all variables and the gradient is written in the order of variablesInNonlinearExpression
+using CompiledFunctionValue = double (*)(const double*);
+using CompiledGradient = void (*)(const double*, double*);
+
 class NonlinearConstraint : public QuadraticConstraint
 {
 public:
@@ -301,6 +307,11 @@ public:
     NonlinearExpressionPtr nonlinearExpression;
     FactorableFunctionPtr factorableFunction;
 
+    // Tape for the nonlinear expression only, it keeps its sweep state internally so concurrent derivative
+    // evaluations must be serialized
+    CppAD::ADFun<double> ADFunction;
+    std::mutex ADFunctionMutex;
+
     CppAD::sparse_rc<std::vector<size_t>> nonlinearGradientSparsityPattern;
     CppAD::sparse_rc<std::vector<size_t>> nonlinearHessianSparsityPattern;
 
@@ -313,6 +324,10 @@ public:
 
     int nonlinearExpressionIndex = -1;
 
+    // Used instead of the expression tree and the tape if the nonlinear expression has been compiled
+    CompiledFunctionValue compiledFunctionValue = nullptr;
+    CompiledGradient compiledGradient = nullptr;
+
     NonlinearConstraint() = default;
 
     NonlinearConstraint(int constraintIndex, std::string constraintName, double LHS, double RHS)
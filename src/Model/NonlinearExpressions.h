@@ -20,6 +20,11 @@
 #include "ffunc.hpp"
 #include "cppad/cppad.hpp"
 
+#include <atomic>
+#include <cstring>
+#include <functional>
+#include <mutex>
+
 namespace SHOT
 {
 
@@ -119,8 +124,62 @@ inline E_Monotonicity getMonotonicityTimesWithConstantFunction(
     return E_Monotonicity::Unknown;
 }
 
+// Returns for each interval the sum (or product) of all the other intervals. Prefix and suffix sums are used, so this
+// is linear in the number of intervals and does not depend on the order in which the results are used.
+inline std::vector<Interval> combineOtherIntervals(const std::vector<Interval>& intervals, bool multiply)
+{
+    auto size = intervals.size();
+    Interval neutral(multiply ? 1.0 : 0.0);
+
+    std::vector<Interval> suffixes(size + 1, neutral);
+
+    for(size_t i = size; i-- > 0;)
+        suffixes[i] = multiply ? intervals[i] * suffixes[i + 1] : intervals[i] + suffixes[i + 1];
+
+    std::vector<Interval> others(size, neutral);
+    Interval prefix = neutral;
+
+    for(size_t i = 0; i < size; i++)
+    {
+        others[i] = multiply ? prefix * suffixes[i + 1] : prefix + suffixes[i + 1];
+        prefix = multiply ? prefix * intervals[i] : prefix + intervals[i];
+    }
+
+    return (others);
+}
+
+// Projects the nonnegative root of an even power on the base, which can be on either side of zero
+inline Interval getEvenRootProjection(const Interval& root, const Interval& baseBounds)
+{
+    if(baseBounds.l() >= 0.0)
+        return (root);
+
+    if(baseBounds.u() <= 0.0)
+        return (-root);
+
+    return (Interval(-root.u(), root.u()));
+}
+
 class NonlinearExpression
 {
+private:
+    // The bounds are cached together with a key formed from the children and their bound versions
+    mutable Interval cachedBounds;
+    mutable size_t cachedBoundsKey = 0;
+    mutable unsigned long long cachedBoundsPass = 0;
+    mutable unsigned long long boundsVersion = 0;
+
+protected:
+    // Validates the cached bounds of the children and returns a key identifying them and their bound versions
+    virtual size_t getBoundsKey() const = 0;
+
+    static inline size_t combineBoundsKey(size_t seed, const void* pointer, unsigned long long version)
+    {
+        seed ^= std::hash<const void*>()(pointer) + 0x9e3779b9 + (seed << 6) + (seed >> 2);
+        seed ^= std::hash<unsigned long long>()(version) + 0x9e3779b9 + (seed << 6) + (seed >> 2);
+        return (seed);
+    }
+
 public:
     virtual ~NonlinearExpression() = default;
 
@@ -130,7 +189,47 @@ public:
 
     virtual double calculate([[maybe_unused]] const VectorDouble& point) const = 0;
     virtual Interval calculate([[maybe_unused]] const IntervalVector& intervalVector) const = 0;
-    virtual Interval getBounds() const = 0;
+
+    // Calculates the bounds from the (cached) bounds of the children, use getBounds instead
+    virtual Interval calculateBounds() const = 0;
+
+    // Returns the cached bounds of the expression, which are only recalculated if the bounds of a variable in the
+    // expression has changed (see Variable::boundsVersion) or if a child expression has been replaced. Each node is
+    // validated at most once per outermost call. Not thread-safe, since the cache is shared by all callers.
+    inline Interval getBounds() const
+    {
+        static std::atomic<unsigned long long> passCounter { 0 };
+        thread_local unsigned long long currentPass = 0;
+        thread_local int depth = 0;
+
+        if(depth == 0)
+            currentPass = ++passCounter;
+
+        if(cachedBoundsPass == currentPass)
+            return (cachedBounds);
+
+        struct DepthGuard
+        {
+            int& depth;
+            DepthGuard(int& depth) : depth(depth) { depth++; }
+            ~DepthGuard() { depth--; }
+        } guard(depth);
+
+        auto key = getBoundsKey();
+
+        if(boundsVersion == 0 || key != cachedBoundsKey)
+        {
+            cachedBounds = calculateBounds();
+            cachedBoundsKey = key;
+            boundsVersion = Variable::getNewBoundsVersion();
+        }
+
+        cachedBoundsPass = currentPass;
+        return (cachedBounds);
+    }
+
+    // Changes whenever the cached bounds are recalculated
+    inline unsigned long long getBoundsVersion() const { return (boundsVersion); }
 
     virtual bool tightenBounds(Interval bound) = 0;
 
@@ -205,7 +304,14 @@ public:
         return (Interval(constant));
     };
 
-    inline Interval getBounds() const override { return Interval(constant); };
+    inline Interval calculateBounds() const override { return Interval(constant); };
+
+    inline size_t getBoundsKey() const override
+    {
+        unsigned long long bits;
+        std::memcpy(&bits, &constant, sizeof(bits));
+        return (combineBoundsKey(0, this, bits));
+    };
 
     inline bool tightenBounds([[maybe_unused]] Interval bound) override { return false; };
 
@@ -253,7 +359,12 @@ public:
 
     inline FactorableFunction getFactorableFunction() override { return *(variable->factorableFunctionVariable); };
 
-    inline Interval getBounds() const override { return (variable->getBound()); };
+    inline Interval calculateBounds() const override { return (variable->getBound()); };
+
+    inline size_t getBoundsKey() const override
+    {
+        return (combineBoundsKey(0, variable.get(), variable->boundsVersion));
+    };
 
     inline bool tightenBounds(Interval bound) override { return (variable->tightenBounds(bound)); };
 
@@ -301,6 +412,12 @@ public:
 
     inline int getNumberOfChildren() const override { return 1; }
 
+    inline size_t getBoundsKey() const override
+    {
+        child->getBounds();
+        return (combineBoundsKey(0, child.get(), child->getBoundsVersion()));
+    }
+
     inline void appendNonlinearVariables(Variables& nonlinearVariables) override
     {
         child->appendNonlinearVariables(nonlinearVariables);
@@ -328,6 +445,15 @@ public:
 
     inline int getNumberOfChildren() const override { return 2; }
 
+    inline size_t getBoundsKey() const override
+    {
+        firstChild->getBounds();
+        secondChild->getBounds();
+
+        return (combineBoundsKey(combineBoundsKey(0, firstChild.get(), firstChild->getBoundsVersion()),
+            secondChild.get(), secondChild->getBoundsVersion()));
+    }
+
     inline void appendNonlinearVariables(Variables& nonlinearVariables) override
     {
         firstChild->appendNonlinearVariables(nonlinearVariables);
@@ -355,6 +481,19 @@ public:
 
     inline int getNumberOfChildren() const override { return children.size(); }
 
+    inline size_t getBoundsKey() const override
+    {
+        size_t key = children.size();
+
+        for(auto& C : children)
+        {
+            C->getBounds();
+            key = combineBoundsKey(key, C.get(), C->getBoundsVersion());
+        }
+
+        return (key);
+    }
+
     inline void appendNonlinearVariables(Variables& nonlinearVariables) override
     {
         for(auto& C : children)
@@ -378,7 +517,7 @@ public:
         return (-child->calculate(intervalVector));
     }
 
-    inline Interval getBounds() const override { return (-child->getBounds()); };
+    inline Interval calculateBounds() const override { return (-child->getBounds()); };
 
     inline bool tightenBounds(Interval bound) override { return (child->tightenBounds(-bound)); };
 
@@ -458,7 +597,7 @@ public:
         return (1.0 / child->calculate(intervalVector));
     }
 
-    inline Interval getBounds() const override
+    inline Interval calculateBounds() const override
     {
         auto denominatorBounds = child->getBounds();
 
@@ -555,7 +694,7 @@ public:
         return (sqrt(child->calculate(intervalVector)));
     }
 
-    inline Interval getBounds() const override
+    inline Interval calculateBounds() const override
     {
         auto childBounds = child->getBounds();
 
@@ -567,9 +706,13 @@ public:
 
     inline bool tightenBounds(Interval bound) override
     {
-        if(bound.l() < 0.0 && bound.u() < 0.0)
+        if(bound.u() < 0.0)
             return (false);
 
+        // The square root is nonnegative
+        if(bound.l() < 0.0)
+            bound.l(0.0);
+
         auto interval = pow(bound, 2);
 
         return (child->tightenBounds(interval));
@@ -659,7 +802,7 @@ public:
         return (log(childValue));
     }
 
-    inline Interval getBounds() const override
+    inline Interval calculateBounds() const override
     {
         auto childValue = child->getBounds();
 
@@ -721,13 +864,17 @@ public:
         return (exp(child->calculate(intervalVector)));
     }
 
-    inline Interval getBounds() const override { return (exp(child->getBounds())); }
+    inline Interval calculateBounds() const override { return (exp(child->getBounds())); }
 
     inline bool tightenBounds(Interval bound) override
     {
-        if(bound.l() <= 0)
+        if(bound.u() <= 0)
             return false;
 
+        // Only the upper bound gives information if the bound includes nonpositive values
+        if(bound.l() <= 0)
+            return (child->tightenBounds(Interval(SHOT_DBL_MIN, std::log(bound.u()))));
+
         return (child->tightenBounds(log(bound)));
     };
 
@@ -788,7 +935,7 @@ public:
         return (interval);
     }
 
-    inline Interval getBounds() const override
+    inline Interval calculateBounds() const override
     {
         auto value = child->getBounds();
 
@@ -799,10 +946,13 @@ public:
 
     inline bool tightenBounds(Interval bound) override
     {
-        if(bound.l() < 0)
+        if(bound.u() < 0)
             return false;
 
-        return (child->tightenBounds(sqrt(bound)));
+        if(bound.l() < 0)
+            bound.l(0.0);
+
+        return (child->tightenBounds(getEvenRootProjection(sqrt(bound), child->getBounds())));
     };
 
     inline FactorableFunction getFactorableFunction() override
@@ -878,7 +1028,7 @@ public:
         return (sin(child->calculate(intervalVector)));
     }
 
-    inline Interval getBounds() const override { return (sin(child->getBounds())); }
+    inline Interval calculateBounds() const override { return (sin(child->getBounds())); }
 
     inline bool tightenBounds([[maybe_unused]] Interval bound) override { return (false); };
 
@@ -978,7 +1128,7 @@ public:
         return (cos(child->calculate(intervalVector)));
     }
 
-    inline Interval getBounds() const override { return (cos(child->getBounds())); }
+    inline Interval calculateBounds() const override { return (cos(child->getBounds())); }
 
     inline bool tightenBounds([[maybe_unused]] Interval bound) override { return (false); };
 
@@ -1078,7 +1228,7 @@ public:
         return (tan(child->calculate(intervalVector)));
     }
 
-    inline Interval getBounds() const override { return (tan(child->getBounds())); }
+    inline Interval calculateBounds() const override { return (tan(child->getBounds())); }
 
     inline bool tightenBounds([[maybe_unused]] Interval bound) override { return (false); };
 
@@ -1145,7 +1295,7 @@ public:
         return (asin(child->calculate(intervalVector)));
     }
 
-    inline Interval getBounds() const override { return (asin(child->getBounds())); }
+    inline Interval calculateBounds() const override { return (asin(child->getBounds())); }
 
     inline bool tightenBounds([[maybe_unused]] Interval bound) override { return (false); };
 
@@ -1202,7 +1352,7 @@ public:
         return (acos(child->calculate(intervalVector)));
     }
 
-    inline Interval getBounds() const override { return (acos(child->getBounds())); }
+    inline Interval calculateBounds() const override { return (acos(child->getBounds())); }
 
     inline bool tightenBounds([[maybe_unused]] Interval bound) override { return (false); };
 
@@ -1260,7 +1410,7 @@ public:
         return (atan(child->calculate(intervalVector)));
     }
 
-    inline Interval getBounds() const override { return (atan(child->getBounds())); }
+    inline Interval calculateBounds() const override { return (atan(child->getBounds())); }
 
     inline bool tightenBounds([[maybe_unused]] Interval bound) override { return (false); };
 
@@ -1317,7 +1467,7 @@ public:
         return (fabs(child->calculate(intervalVector)));
     }
 
-    inline Interval getBounds() const override { return (fabs(child->getBounds())); }
+    inline Interval calculateBounds() const override { return (fabs(child->getBounds())); }
 
     inline bool tightenBounds([[maybe_unused]] Interval bound) override { return (false); };
 
@@ -1411,7 +1561,7 @@ public:
         return (firstChild->calculate(intervalVector) / secondChild->calculate(intervalVector));
     }
 
-    inline Interval getBounds() const override
+    inline Interval calculateBounds() const override
     {
         auto denominatorBounds = secondChild->getBounds();
 
@@ -1789,7 +1939,7 @@ public:
         return (pow(baseBounds, powerBounds));
     }
 
-    inline Interval getBounds() const override
+    inline Interval calculateBounds() const override
     {
         auto baseBounds = firstChild->getBounds();
         auto powerBounds = secondChild->getBounds();
@@ -1852,16 +2002,41 @@ public:
         int integerValue = (int)round(intpart);
         bool isEven = (integerValue % 2 == 0);
 
-        if(isInteger && isEven && power > 0 && bound.l() <= 0.0)
-            bound.l(0.0);
-        else if(bound.l() <= 0.0)
+        if(power == 0.0)
+            return (false);
+
+        if(isInteger && power > 0 && !isEven)
+        {
+            // Odd powers are increasing also for negative bases
+            auto root = [power](double value)
+            { return (value < 0.0 ? -std::pow(-value, 1.0 / power) : std::pow(value, 1.0 / power)); };
+
+            return (firstChild->tightenBounds(Interval(root(bound.l()), root(bound.u()))));
+        }
+
+        if(isInteger && power > 0)
+        {
+            if(bound.u() < 0.0)
+                return (false);
+
+            if(bound.l() < 0.0)
+                bound.l(0.0);
+
+            auto interval = (power == 2.0) ? sqrt(bound) : pow(bound, 1.0 / power);
+
+            return (firstChild->tightenBounds(getEvenRootProjection(interval, firstChild->getBounds())));
+        }
+
+        // For negative integer powers the projection below is only valid for positive bases
+        if(isInteger && firstChild->getBounds().l() <= 0.0)
+            return (false);
+
+        if(bound.l() <= 0.0)
             bound.l(SHOT_DBL_EPS);
 
         Interval interval;
 
-        if(power == 2.0)
-            interval = sqrt(bound);
-        else if(power == -1.0)
+        if(power == -1.0)
         {
             interval = 1 / bound;
 
@@ -2221,7 +2396,7 @@ public:
         return (tmpInterval);
     }
 
-    inline Interval getBounds() const override
+    inline Interval calculateBounds() const override
     {
         Interval tmpInterval(0.);
 
@@ -2235,24 +2410,23 @@ public:
 
     inline bool tightenBounds(Interval bound) override
     {
-        bool tightened = false;
+        // The bound is first intersected with the bounds from the forward pass
+        if(!mc::inter(bound, bound, getBounds()))
+            return (false);
 
-        for(auto& T : children)
-        {
-            Interval newBound = Interval(0.0);
+        std::vector<Interval> childrenBounds;
+        childrenBounds.reserve(children.size());
 
-            for(auto& T2 : children)
-            {
-                if(T2 == T)
-                    continue;
+        for(auto& C : children)
+            childrenBounds.push_back(C->getBounds());
 
-                newBound += T2->getBounds();
-            }
+        // All candidates are calculated before any child is tightened
+        auto othersBounds = combineOtherIntervals(childrenBounds, false);
 
-            Interval candidate = bound - newBound;
+        bool tightened = false;
 
-            tightened = T->tightenBounds(candidate) || tightened;
-        }
+        for(size_t i = 0; i < children.size(); i++)
+            tightened = children[i]->tightenBounds(bound - othersBounds[i]) || tightened;
 
         return (tightened);
     };
@@ -2425,7 +2599,7 @@ public:
         return (tmpInterval);
     }
 
-    inline Interval getBounds() const override
+    inline Interval calculateBounds() const override
     {
         Interval tmpInterval(1.);
 
@@ -2448,27 +2622,28 @@ public:
         if(numberOfChildren == 1)
             return (children.at(0)->tightenBounds(bound));
 
-        bool tightened = false;
+        // The bound is first intersected with the bounds from the forward pass
+        if(!mc::inter(bound, bound, getBounds()))
+            return (false);
 
-        for(auto& C1 : children)
-        {
-            Interval othersBound(1.0);
+        std::vector<Interval> childrenBounds;
+        childrenBounds.reserve(children.size());
 
-            for(auto& C2 : children)
-            {
-                if(C1 == C2)
-                    continue;
+        for(auto& C : children)
+            childrenBounds.push_back(C->getBounds());
 
-                othersBound *= C2->getBounds();
-            }
+        // All candidates are calculated before any child is tightened
+        auto othersBounds = combineOtherIntervals(childrenBounds, true);
 
+        bool tightened = false;
+
+        for(size_t i = 0; i < children.size(); i++)
+        {
             // To avoid division by zero
-            if(othersBound.l() <= 0 && othersBound.u() >= 0)
+            if(othersBounds[i].l() <= 0 && othersBounds[i].u() >= 0)
                 continue;
 
-            auto childBound = bound / othersBound;
-
-            tightened = C1->tightenBounds(childBound);
+            tightened = children[i]->tightenBounds(bound / othersBounds[i]) || tightened;
         }
 
         return (tightened);
@@ -2799,4 +2974,36 @@ public:
 };
 
 // End general operations
+
+// Records the expression on the tape with only the given variables, which should be the variables in the expression,
+// as independent variables. The cost of evaluating derivatives on the tape thus depends on the size of the expression
+// and not on the whole problem. Returns the function value of the expression on the tape. The tapes are recorded one at
+// a time since the factorable function variables of the shared variables are replaced during the recording.
+inline FactorableFunction recordFactorableFunctionTape(
+    const NonlinearExpressionPtr& expression, const Variables& variables, CppAD::ADFun<double>& tape)
+{
+    static std::mutex recordingMutex;
+    std::lock_guard<std::mutex> lock(recordingMutex);
+
+    std::vector<CppAD::AD<double>> localVariables(variables.size(), 3.0);
+    std::vector<FactorableFunction*> problemVariables(variables.size());
+
+    for(size_t i = 0; i < variables.size(); i++)
+    {
+        problemVariables[i] = variables[i]->factorableFunctionVariable;
+        variables[i]->factorableFunctionVariable = &localVariables[i];
+    }
+
+    CppAD::Independent(localVariables);
+
+    std::vector<CppAD::AD<double>> dependentFunctions(1, expression->getFactorableFunction());
+
+    tape.Dependent(localVariables, dependentFunctions);
+    tape.optimize();
+
+    for(size_t i = 0; i < variables.size(); i++)
+        variables[i]->factorableFunctionVariable = problemVariables[i];
+
+    return (dependentFunctions[0]);
+}
 } // namespace SHOT
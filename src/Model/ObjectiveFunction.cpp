@@ -258,19 +258,12 @@ SparseVariableVector LinearObjectiveFunction::calculateGradient(
     [[maybe_unused]] const VectorDouble& point, [[maybe_unused]] bool eraseZeroes = true)
 {
     SparseVariableVector gradient;
+    gradient.reserve(linearTerms.size());
 
     for(auto& T : linearTerms)
-    {
-        auto element = gradient.emplace(T->variable, T->coefficient);
-        if(!element.second)
-        {
-            // Element already exists for the variable
-            element.first->second += T->coefficient;
-        }
-    }
+        gradient.add(T->variable, T->coefficient);
 
-    if(eraseZeroes)
-        Utilities::erase_if<VariablePtr, double>(gradient, 0.0);
+    gradient.compress(eraseZeroes);
 
     return gradient;
 }
@@ -434,39 +427,16 @@ SparseVariableVector QuadraticObjectiveFunction::calculateGradient(const VectorD
     {
         if(T->firstVariable == T->secondVariable) // variable squared
         {
-            auto value = 2 * T->coefficient * point[T->firstVariable->index];
-            auto element = gradient.emplace(T->firstVariable, value);
-
-            if(!element.second)
-            {
-                // Element already exists for the variable
-                element.first->second += value;
-            }
+            gradient.add(T->firstVariable, 2 * T->coefficient * point[T->firstVariable->index]);
         }
         else
         {
-            auto value = T->coefficient * point[T->secondVariable->index];
-            auto element = gradient.emplace(T->firstVariable, value);
-
-            if(!element.second)
-            {
-                // Element already exists for the variable
-                element.first->second += value;
-            }
-
-            value = T->coefficient * point[T->firstVariable->index];
-            element = gradient.emplace(T->secondVariable, value);
-
-            if(!element.second)
-            {
-                // Element already exists for the variable
-                element.first->second += value;
-            }
+            gradient.add(T->firstVariable, T->coefficient * point[T->secondVariable->index]);
+            gradient.add(T->secondVariable, T->coefficient * point[T->firstVariable->index]);
         }
     }
 
-    if(eraseZeroes)
-        Utilities::erase_if<VariablePtr, double>(gradient, 0.0);
+    gradient.compress(eraseZeroes);
 
     return gradient;
 }
@@ -554,7 +524,7 @@ void QuadraticObjectiveFunction::initializeHessianSparsityPattern()
         auto firstVariable
             = (T->firstVariable->index < T->secondVariable->index) ? T->firstVariable : T->secondVariable;
         auto secondVariable
-            = (T->firstVariable->index > T->secondVariable->index) ? T->secondVariable : T->firstVariable;
+            = (T->firstVariable->index < T->secondVariable->index) ? T->secondVariable : T->firstVariable;
 
         auto key = std::make_pair(firstVariable, secondVariable);
 
@@ -643,7 +613,11 @@ void NonlinearObjectiveFunction::add(NonlinearExpressionPtr expression)
 
 void NonlinearObjectiveFunction::updateFactorableFunction()
 {
-    factorableFunction = std::make_shared<FactorableFunction>(nonlinearExpression->getFactorableFunction());
+    factorableFunction = std::make_shared<FactorableFunction>(
+        recordFactorableFunctionTape(nonlinearExpression, variablesInNonlinearExpression, ADFunction));
+
+    nonlinearGradientSparsityMapGenerated = false;
+    nonlinearHessianSparsityMapGenerated = false;
 }
 
 void NonlinearObjectiveFunction::updateProperties()
@@ -772,63 +746,42 @@ SparseVariableVector NonlinearObjectiveFunction::calculateGradient(const VectorD
         if(!nonlinearGradientSparsityMapGenerated)
             initializeGradientSparsityPattern();
 
-        if(auto sharedOwnerProblem = ownerProblem.lock())
-        {
-            int numberOfNonlinearVariables = sharedOwnerProblem->properties.numberOfVariablesInNonlinearExpressions;
-
-            std::vector<double> pointNonlinearSubset(numberOfNonlinearVariables, 0.0);
-
-            for(auto& VAR : sharedOwnerProblem->nonlinearExpressionVariables)
-                pointNonlinearSubset[VAR->properties.nonlinearVariableIndex] = point[VAR->index];
+        std::vector<double> pointNonlinearSubset(variablesInNonlinearExpression.size());
 
-            CppAD::sparse_rcv<std::vector<size_t>, std::vector<double>> subset(nonlinearGradientSparsityPattern);
-            sharedOwnerProblem->ADFunctions.subgraph_jac_rev(pointNonlinearSubset, subset);
+        for(size_t i = 0; i < variablesInNonlinearExpression.size(); i++)
+            pointNonlinearSubset[i] = point[variablesInNonlinearExpression[i]->index];
 
-            const std::vector<size_t>& col(subset.col());
-            const std::vector<double>& value(subset.val());
-
-            std::vector<size_t> rowMajor = subset.row_major();
+        CppAD::sparse_rcv<std::vector<size_t>, std::vector<double>> subset(nonlinearGradientSparsityPattern);
+        {
+            std::lock_guard<std::mutex> lock(ADFunctionMutex);
+            ADFunction.subgraph_jac_rev(pointNonlinearSubset, subset);
+        }
 
-            for(auto k : rowMajor)
-            {
-                double coefficient = value[k];
+        const std::vector<size_t>& col(subset.col());
+        const std::vector<double>& value(subset.val());
 
-                if(coefficient == 0.0)
-                    continue;
+        std::vector<size_t> rowMajor = subset.row_major();
 
-                auto VAR = sharedOwnerProblem->nonlinearExpressionVariables[col[k]];
+        for(auto k : rowMajor)
+        {
+            double coefficient = value[k];
 
-                auto element = gradient.emplace(VAR, coefficient);
+            if(coefficient == 0.0)
+                continue;
 
-                if(!element.second)
-                {
-                    // Element already exists for the variable
-                    element.first->second += coefficient;
-                }
-            }
+            gradient.add(variablesInNonlinearExpression[col[k]], coefficient);
         }
     }
 
-    SparseVariableVector monomialGradient;
-
     if(this->properties.hasMonomialTerms)
-    {
-        monomialGradient = monomialTerms.calculateGradient(point);
-    }
-
-    SparseVariableVector signomialGradient;
+        gradient.add(monomialTerms.calculateGradient(point));
 
     if(this->properties.hasSignomialTerms)
-    {
-        signomialGradient = signomialTerms.calculateGradient(point);
-    }
-
-    auto result = Utilities::combineSparseVariableVectors(gradient, monomialGradient, signomialGradient);
+        gradient.add(signomialTerms.calculateGradient(point));
 
-    if(eraseZeroes)
-        Utilities::erase_if<VariablePtr, double>(gradient, 0.0);
+    gradient.compress(eraseZeroes);
 
-    return result;
+    return gradient;
 }
 
 void NonlinearObjectiveFunction::initializeGradientSparsityPattern()
@@ -896,50 +849,33 @@ void NonlinearObjectiveFunction::initializeGradientSparsityPattern()
 
     if(this->properties.hasNonlinearExpression)
     {
-        if(auto sharedOwnerProblem = ownerProblem.lock())
-        {
-            assert(sharedOwnerProblem->properties.numberOfVariablesInNonlinearExpressions > 0);
-            assert(sharedOwnerProblem->properties.numberOfNonlinearExpressions > 0);
-            assert(this->nonlinearExpressionIndex >= 0);
+        assert(variablesInNonlinearExpression.size() > 0);
 
-            // For some reason we need to have all nonlinear variables activated, otherwise not all nonzero elements
-            // of the gradient may be detected
-            auto nonlinearVariablesInExpressionMap
-                = std::vector<bool>(sharedOwnerProblem->properties.numberOfVariablesInNonlinearExpressions, true);
+        // For some reason we need to have all nonlinear variables activated, otherwise not all nonzero elements
+        // of the gradient may be detected
+        auto nonlinearVariablesInExpressionMap = std::vector<bool>(variablesInNonlinearExpression.size(), true);
+        auto nonlinearFunctionMap = std::vector<bool>(1, true);
 
-            auto nonlinearFunctionMap
-                = std::vector<bool>(sharedOwnerProblem->properties.numberOfNonlinearExpressions, false);
+        CppAD::sparse_rc<std::vector<size_t>> pattern;
 
-            nonlinearFunctionMap[this->nonlinearExpressionIndex] = true;
+        ADFunction.subgraph_sparsity(nonlinearVariablesInExpressionMap, nonlinearFunctionMap, false, pattern);
 
-            CppAD::sparse_rc<std::vector<size_t>> pattern;
+        // Save for later use when calculating gradients
+        nonlinearGradientSparsityPattern = pattern;
 
-            sharedOwnerProblem->ADFunctions.subgraph_sparsity(
-                nonlinearVariablesInExpressionMap, nonlinearFunctionMap, false, pattern);
+        const std::vector<size_t>& variableIndices(nonlinearGradientSparsityPattern.col());
 
-            // Save for later use when calculating gradients
-            nonlinearGradientSparsityPattern = pattern;
-
-            const std::vector<size_t>& variableIndices(nonlinearGradientSparsityPattern.col());
+        for(size_t i = 0; i < nonlinearGradientSparsityPattern.nnz(); i++)
+        {
+            auto VAR = variablesInNonlinearExpression[variableIndices[i]];
 
-            for(size_t i = 0; i < nonlinearGradientSparsityPattern.nnz(); i++)
+            if(std::find(gradientSparsityPattern->begin(), gradientSparsityPattern->end(), VAR)
+                == gradientSparsityPattern->end())
             {
-                for(auto& VAR : variablesInNonlinearExpression)
-                {
-                    if((size_t)VAR->properties.nonlinearVariableIndex == variableIndices[i])
-                    {
-                        if(std::find(gradientSparsityPattern->begin(), gradientSparsityPattern->end(), VAR)
-                            == gradientSparsityPattern->end())
-                        {
-                            gradientSparsityPattern->push_back(VAR);
-
-                            if(debug)
-                                stream << "(nonlinear expr) " << VAR->name << '\n';
-                        }
+                gradientSparsityPattern->push_back(VAR);
 
-                        continue;
-                    }
-                }
+                if(debug)
+                    stream << "(nonlinear expr) " << VAR->name << '\n';
             }
         }
     }
@@ -965,12 +901,12 @@ SparseVariableMatrix NonlinearObjectiveFunction::calculateHessian(const VectorDo
 
     if(properties.hasMonomialTerms)
     {
-        hessian = Utilities::combineSparseVariableMatrices(monomialTerms.calculateHessian(point), hessian);
+        monomialTerms.calculateHessian(point, hessian);
     }
 
     if(properties.hasSignomialTerms)
     {
-        hessian = Utilities::combineSparseVariableMatrices(signomialTerms.calculateHessian(point), hessian);
+        signomialTerms.calculateHessian(point, hessian);
     }
 
     if(this->properties.hasNonlinearExpression)
@@ -978,44 +914,45 @@ SparseVariableMatrix NonlinearObjectiveFunction::calculateHessian(const VectorDo
         if(!nonlinearHessianSparsityMapGenerated)
             initializeHessianSparsityPattern();
 
-        if(auto sharedOwnerProblem = ownerProblem.lock())
-        {
-            int numberOfNonlinearVariables = sharedOwnerProblem->properties.numberOfVariablesInNonlinearExpressions;
+        size_t numberOfNonlinearVariables = variablesInNonlinearExpression.size();
 
-            std::vector<double> pointNonlinearSubset(numberOfNonlinearVariables, 0.0);
+        std::vector<double> pointNonlinearSubset(numberOfNonlinearVariables);
 
-            std::vector<double> weights(sharedOwnerProblem->properties.numberOfNonlinearExpressions, 0.0);
-            weights[this->nonlinearExpressionIndex] = 1.0;
+        for(size_t i = 0; i < numberOfNonlinearVariables; i++)
+            pointNonlinearSubset[i] = point[variablesInNonlinearExpression[i]->index];
 
-            for(auto& VAR : sharedOwnerProblem->nonlinearExpressionVariables)
-                pointNonlinearSubset[VAR->properties.nonlinearVariableIndex] = point[VAR->index];
+        std::vector<double> weights(1, 1.0);
 
-            CppAD::sparse_rcv<std::vector<size_t>, std::vector<double>> subset(nonlinearHessianSparsityPattern);
+        // TODO: utilize sparsity pattern
+        std::vector<double> calculatedHessian;
 
-            auto calculatedHessian = sharedOwnerProblem->ADFunctions.SparseHessian(pointNonlinearSubset, weights);
+        {
+            std::lock_guard<std::mutex> lock(ADFunctionMutex);
+            calculatedHessian = ADFunction.SparseHessian(pointNonlinearSubset, weights);
+        }
+
+        for(size_t i = 0; i < numberOfNonlinearVariables; i++)
+        {
+            auto& V1 = variablesInNonlinearExpression[i];
 
-            for(auto& V1 : variablesInNonlinearExpression)
+            for(size_t j = 0; j < numberOfNonlinearVariables; j++)
             {
-                for(auto& V2 : variablesInNonlinearExpression)
-                {
-                    size_t hessianIndex = V1->properties.nonlinearVariableIndex * numberOfNonlinearVariables
-                        + V2->properties.nonlinearVariableIndex;
+                auto& V2 = variablesInNonlinearExpression[j];
 
-                    double hessianValue = calculatedHessian[hessianIndex];
+                double hessianValue = calculatedHessian[i * numberOfNonlinearVariables + j];
 
-                    if(hessianValue == 0.0)
-                        continue;
+                if(hessianValue == 0.0)
+                    continue;
 
-                    // Only save elements above the diagonal since the Hessian is symmetric
-                    if(V1->index <= V2->index)
-                    {
-                        auto element = hessian.emplace(std::make_pair(V1, V2), hessianValue);
+                // Only save elements above the diagonal since the Hessian is symmetric
+                if(V1->index <= V2->index)
+                {
+                    auto element = hessian.emplace(std::make_pair(V1, V2), hessianValue);
 
-                        if(!element.second)
-                        {
-                            // Element already exists for the variable
-                            element.first->second += hessianValue;
-                        }
+                    if(!element.second)
+                    {
+                        // Element already exists for the variable
+                        element.first->second += hessianValue;
                     }
                 }
             }
@@ -1081,53 +1018,35 @@ void NonlinearObjectiveFunction::initializeHessianSparsityPattern()
 
     if(this->properties.hasNonlinearExpression)
     {
-        if(auto sharedOwnerProblem = ownerProblem.lock())
-        {
-            // For some reason we need to have all nonlinear variables activated, otherwise not all nonzero elements of
-            // the hessian may be detected
-            auto nonlinearVariablesInExpressionMap
-                = std::vector<bool>(sharedOwnerProblem->properties.numberOfVariablesInNonlinearExpressions, true);
+        // For some reason we need to have all nonlinear variables activated, otherwise not all nonzero elements of
+        // the hessian may be detected
+        auto nonlinearVariablesInExpressionMap = std::vector<bool>(variablesInNonlinearExpression.size(), true);
+        auto nonlinearFunctionMap = std::vector<bool>(1, true);
 
-            auto nonlinearFunctionMap
-                = std::vector<bool>(sharedOwnerProblem->properties.numberOfNonlinearExpressions, true);
+        CppAD::sparse_rc<std::vector<size_t>> pattern;
 
-            nonlinearFunctionMap[this->nonlinearExpressionIndex] = true;
+        ADFunction.for_hes_sparsity(nonlinearVariablesInExpressionMap, nonlinearFunctionMap, false, pattern);
 
-            CppAD::sparse_rc<std::vector<size_t>> pattern;
+        nonlinearHessianSparsityPattern = pattern;
 
-            sharedOwnerProblem->ADFunctions.for_hes_sparsity(
-                nonlinearVariablesInExpressionMap, nonlinearFunctionMap, false, pattern);
+        const std::vector<size_t>& rowIndices(nonlinearHessianSparsityPattern.row());
+        const std::vector<size_t>& colIndices(nonlinearHessianSparsityPattern.col());
 
-            nonlinearHessianSparsityPattern = pattern;
+        for(size_t i = 0; i < nonlinearHessianSparsityPattern.nnz(); i++)
+        {
+            auto& V1 = variablesInNonlinearExpression[rowIndices[i]];
+            auto& V2 = variablesInNonlinearExpression[colIndices[i]];
 
-            const std::vector<size_t>& rowIndices(nonlinearHessianSparsityPattern.row());
-            const std::vector<size_t>& colIndices(nonlinearHessianSparsityPattern.col());
+            std::pair<VariablePtr, VariablePtr> variablePair;
 
-            for(size_t i = 0; i < nonlinearHessianSparsityPattern.nnz(); i++)
-            {
-                for(auto& V1 : variablesInNonlinearExpression)
-                {
-                    for(auto& V2 : variablesInNonlinearExpression)
-                    {
-                        if((size_t)V1->properties.nonlinearVariableIndex == rowIndices[i]
-                            && (size_t)V2->properties.nonlinearVariableIndex == colIndices[i])
-                        {
-                            std::pair<VariablePtr, VariablePtr> variablePair;
-
-                            if(V1->index < V2->index)
-                                variablePair = std::make_pair(V1, V2);
-                            else
-                                variablePair = std::make_pair(V2, V1);
-
-                            if(std::find(hessianSparsityPattern->begin(), hessianSparsityPattern->end(), variablePair)
-                                == hessianSparsityPattern->end())
-                                hessianSparsityPattern->push_back(variablePair);
-
-                            continue;
-                        }
-                    }
-                }
-            }
+            if(V1->index < V2->index)
+                variablePair = std::make_pair(V1, V2);
+            else
+                variablePair = std::make_pair(V2, V1);
+
+            if(std::find(hessianSparsityPattern->begin(), hessianSparsityPattern->end(), variablePair)
+                == hessianSparsityPattern->end())
+                hessianSparsityPattern->push_back(variablePair);
         }
     }
 
@@ -15,6 +15,7 @@
 #include "Terms.h"
 #include "NonlinearExpressions.h"
 
+#include <mutex>
 #include <vector>
 
 #include "cppad/cppad.hpp"
@@ -344,6 +345,11 @@ public:
     NonlinearExpressionPtr nonlinearExpression;
     FactorableFunctionPtr factorableFunction;
 
+    // Tape for the nonlinear expression only, it keeps its sweep state internally so concurrent derivative
+    // evaluations must be serialized
+    CppAD::ADFun<double> ADFunction;
+    std::mutex ADFunctionMutex;
+
     CppAD::sparse_rc<std::vector<size_t>> nonlinearGradientSparsityPattern;
     CppAD::sparse_rc<std::vector<size_t>> nonlinearHessianSparsityPattern;
 
@@ -0,0 +1,840 @@
+/**
+   The Supporting Hyperplane Optimization Toolkit (SHOT).
+
+   @author Andreas Lundell, Åbo Akademi University
+
+   @section LICENSE
+   This software is licensed under the Eclipse Public License 2.0.
+   Please see the README and LICENSE files for more information.
+*/
+
+#include "Presolve.h"
+
+#include "../Output.h"
+#include "../Settings.h"
+
+#include "AuxiliaryVariables.h"
+#include "ObjectiveFunction.h"
+
+#include <algorithm>
+#include <map>
+#include <unordered_set>
+
+namespace SHOT
+{
+
+// Constraint coefficients smaller than this are removed, e.g., after cancellation in substitutions
+static const double coefficientTolerance = 1e-12;
+
+// The largest ratio between the coefficients of the variable kept and the one substituted in doubleton equations
+static const double maxAggregationRatio = 1e3;
+
+Presolve::Presolve(EnvironmentPtr envPtr, ProblemPtr problem) : env(envPtr), problem(problem)
+{
+    minimumLowerBound = env->settings->getSetting<double>("Variables.Continuous.MinimumLowerBound", "Model");
+    maximumUpperBound = env->settings->getSetting<double>("Variables.Continuous.MaximumUpperBound", "Model");
+}
+
+void Presolve::run()
+{
+    constraints = problem->linearConstraints;
+    isConstraintRemoved.assign(constraints.size(), false);
+
+    for(auto& C : constraints)
+        normalizeConstraint(C);
+
+    updateLockedVariables();
+
+    int maxRounds = env->settings->getSetting<int>("Presolve.MaxRounds", "Model");
+    bool useAggregation = env->settings->getSetting<bool>("Presolve.Aggregation.Use", "Model");
+
+    for(int round = 0; round < maxRounds; round++)
+    {
+        bool isChanged = removeFixedVariables();
+        isChanged = removeEmptyAndSingletonConstraints() || isChanged;
+        isChanged = removeRedundantConstraints() || isChanged;
+        isChanged = mergeParallelConstraints() || isChanged;
+        isChanged = removeFreeColumnSingletons() || isChanged;
+
+        if(useAggregation)
+            isChanged = aggregateDoubletonEquations() || isChanged;
+
+        isChanged = fixDominatedVariables() || isChanged;
+
+        if(!isChanged)
+            break;
+    }
+
+    updateOccurrences();
+
+    // Removes the constraints from the problem
+    std::unordered_set<NumericConstraint*> remainingConstraints;
+
+    for(auto& C : constraints)
+        remainingConstraints.insert(C.get());
+
+    std::unordered_set<NumericConstraint*> removedConstraints;
+
+    for(auto& C : problem->linearConstraints)
+    {
+        if(remainingConstraints.count(C.get()) == 0)
+            removedConstraints.insert(C.get());
+    }
+
+    problem->linearConstraints = constraints;
+
+    problem->numericConstraints.erase(std::remove_if(problem->numericConstraints.begin(),
+                                          problem->numericConstraints.end(),
+                                          [&](const NumericConstraintPtr& constraint)
+                                          { return (removedConstraints.count(constraint.get()) > 0); }),
+        problem->numericConstraints.end());
+
+    for(size_t i = 0; i < problem->numericConstraints.size(); i++)
+        problem->numericConstraints[i]->index = i;
+
+    for(auto& C : constraints)
+    {
+        C->gradientSparsityPattern.reset();
+        C->hessianSparsityPattern.reset();
+        C->updateProperties();
+    }
+
+    env->output->outputDebug("  Presolve removed {} constraints and {} variables, fixed {} variables and tightened {} "
+                             "bounds.",
+        numberOfRemovedConstraints, numberOfRemovedVariables, numberOfFixedVariables, numberOfTightenedBounds);
+}
+
+void Presolve::postsolve(VectorDouble& point) const
+{
+    for(auto S = postsolveSteps.rbegin(); S != postsolveSteps.rend(); S++)
+    {
+        if(S->variableIndex >= (int)point.size())
+            continue;
+
+        double activity = S->constant;
+
+        for(auto& [index, coefficient] : S->otherTerms)
+        {
+            if(index < (int)point.size())
+                activity += coefficient * point[index];
+        }
+
+        // Keeps the value of the removed variable if the constraint is already fulfilled
+        double target = S->coefficient * point[S->variableIndex] + activity;
+        target = std::max(target, S->valueLHS);
+        target = std::min(target, S->valueRHS);
+
+        point[S->variableIndex] = (target - activity) / S->coefficient;
+    }
+}
+
+VectorInteger Presolve::getRemovedVariableIndexes() const
+{
+    VectorInteger indexes;
+
+    for(auto& S : postsolveSteps)
+        indexes.push_back(S.variableIndex);
+
+    return (indexes);
+}
+
+void Presolve::updateLockedVariables()
+{
+    isLocked.assign(problem->allVariables.size(), false);
+
+    auto lockVariable = [&](const VariablePtr& variable) { isLocked[variable->index] = true; };
+
+    auto lockLinearTerms = [&](const LinearTerms& terms)
+    {
+        for(auto& T : terms)
+            lockVariable(T->variable);
+    };
+
+    auto lockNonlinearTerms = [&](const QuadraticTerms& quadraticTerms, const MonomialTerms& monomialTerms,
+                                  const SignomialTerms& signomialTerms, const NonlinearExpressionPtr& expression)
+    {
+        for(auto& T : quadraticTerms)
+        {
+            lockVariable(T->firstVariable);
+            lockVariable(T->secondVariable);
+        }
+
+        for(auto& T : monomialTerms)
+        {
+            for(auto& V : T->variables)
+                lockVariable(V);
+        }
+
+        for(auto& T : signomialTerms)
+        {
+            for(auto& E : T->elements)
+                lockVariable(E->variable);
+        }
+
+        if(expression)
+        {
+            Variables variables;
+            expression->appendNonlinearVariables(variables);
+
+            for(auto& V : variables)
+                lockVariable(V);
+        }
+    };
+
+    for(auto& V : problem->allVariables)
+    {
+        if(V->properties.isAuxiliary || V->properties.type == E_VariableType::Semicontinuous)
+            lockVariable(V);
+    }
+
+    for(auto& C : problem->quadraticConstraints)
+    {
+        lockLinearTerms(C->linearTerms);
+        lockNonlinearTerms(C->quadraticTerms, MonomialTerms(), SignomialTerms(), nullptr);
+    }
+
+    for(auto& C : problem->nonlinearConstraints)
+    {
+        lockLinearTerms(C->linearTerms);
+        lockNonlinearTerms(C->quadraticTerms, C->monomialTerms, C->signomialTerms, C->nonlinearExpression);
+    }
+
+    if(auto objective = std::dynamic_pointer_cast<NonlinearObjectiveFunction>(problem->objectiveFunction))
+    {
+        lockNonlinearTerms(objective->quadraticTerms, objective->monomialTerms, objective->signomialTerms,
+            objective->nonlinearExpression);
+    }
+    else if(auto objective = std::dynamic_pointer_cast<QuadraticObjectiveFunction>(problem->objectiveFunction))
+    {
+        lockNonlinearTerms(objective->quadraticTerms, MonomialTerms(), SignomialTerms(), nullptr);
+    }
+
+    // The values of the auxiliary variables are calculated from their definitions, so the variables in these cannot be
+    // removed or changed
+    auto auxiliaryVariables = problem->auxiliaryVariables;
+
+    if(problem->auxiliaryObjectiveVariable)
+        auxiliaryVariables.push_back(problem->auxiliaryObjectiveVariable);
+
+    for(auto& V : auxiliaryVariables)
+    {
+        lockLinearTerms(V->linearTerms);
+        lockNonlinearTerms(V->quadraticTerms, V->monomialTerms, V->signomialTerms, V->nonlinearExpression);
+    }
+}
+
+void Presolve::updateOccurrences()
+{
+    LinearConstraints remainingConstraints;
+
+    for(size_t i = 0; i < constraints.size(); i++)
+    {
+        if(!isConstraintRemoved[i])
+            remainingConstraints.push_back(constraints[i]);
+    }
+
+    constraints = remainingConstraints;
+    isConstraintRemoved.assign(constraints.size(), false);
+
+    variableConstraints.assign(problem->allVariables.size(), std::vector<int>());
+    objectiveCoefficients.assign(problem->allVariables.size(), 0.0);
+
+    for(size_t i = 0; i < constraints.size(); i++)
+    {
+        for(auto& T : constraints[i]->linearTerms)
+            variableConstraints[T->variable->index].push_back(i);
+    }
+
+    if(auto objective = std::dynamic_pointer_cast<LinearObjectiveFunction>(problem->objectiveFunction))
+    {
+        for(auto& T : objective->linearTerms)
+            objectiveCoefficients[T->variable->index] += T->coefficient;
+    }
+}
+
+void Presolve::normalizeConstraint(LinearConstraintPtr& constraint)
+{
+    std::map<int, std::pair<VariablePtr, double>> coefficients;
+
+    for(auto& T : constraint->linearTerms)
+    {
+        auto& coefficient = coefficients.emplace(T->variable->index, std::make_pair(T->variable, 0.0)).first->second;
+        coefficient.second += T->coefficient;
+    }
+
+    // The terms can be shared with other problems, so new ones are created
+    LinearTerms terms;
+
+    for(auto& [index, coefficient] : coefficients)
+    {
+        if(std::abs(coefficient.second) > coefficientTolerance)
+            terms.add(std::make_shared<LinearTerm>(coefficient.second, coefficient.first));
+    }
+
+    constraint->linearTerms = terms;
+    constraint->properties.hasLinearTerms = terms.size() > 0;
+}
+
+std::pair<double, double> Presolve::getActivityBounds(const LinearConstraintPtr& constraint) const
+{
+    double minimum = 0.0;
+    double maximum = 0.0;
+    bool isMinimumInfinite = false;
+    bool isMaximumInfinite = false;
+
+    for(auto& T : constraint->linearTerms)
+    {
+        double lowerBound = T->variable->lowerBound;
+        double upperBound = T->variable->upperBound;
+
+        if(T->variable->properties.type == E_VariableType::Semicontinuous)
+        {
+            lowerBound = std::min(0.0, lowerBound);
+            upperBound = std::max(0.0, upperBound);
+        }
+
+        if(T->coefficient < 0)
+            std::swap(lowerBound, upperBound);
+
+        if(isFinite(lowerBound))
+            minimum += T->coefficient * lowerBound;
+        else
+            isMinimumInfinite = true;
+
+        if(isFinite(upperBound))
+            maximum += T->coefficient * upperBound;
+        else
+            isMaximumInfinite = true;
+    }
+
+    return (std::make_pair(isMinimumInfinite ? SHOT_DBL_MIN : minimum, isMaximumInfinite ? SHOT_DBL_MAX : maximum));
+}
+
+bool Presolve::setVariableBounds(VariablePtr variable, double lowerBound, double upperBound)
+{
+    if(variable->properties.type == E_VariableType::Binary || variable->properties.type == E_VariableType::Integer)
+    {
+        if(isFinite(lowerBound))
+            lowerBound = std::ceil(lowerBound - tolerance);
+
+        if(isFinite(upperBound))
+            upperBound = std::floor(upperBound + tolerance);
+    }
+
+    double newLowerBound = std::max(lowerBound, variable->lowerBound);
+    double newUpperBound = std::min(upperBound, variable->upperBound);
+
+    if(newLowerBound > newUpperBound + tolerance * std::max(1.0, std::abs(newUpperBound)))
+        return (false);
+
+    if(newLowerBound > newUpperBound)
+        newLowerBound = newUpperBound;
+
+    if(newLowerBound > variable->lowerBound + tolerance * std::max(1.0, std::abs(variable->lowerBound)))
+    {
+        variable->setLowerBound(newLowerBound);
+        variable->properties.hasLowerBoundBeenTightened = true;
+        numberOfTightenedBounds++;
+    }
+
+    if(newUpperBound < variable->upperBound - tolerance * std::max(1.0, std::abs(variable->upperBound)))
+    {
+        variable->setUpperBound(newUpperBound);
+        variable->properties.hasUpperBoundBeenTightened = true;
+        numberOfTightenedBounds++;
+    }
+
+    return (true);
+}
+
+void Presolve::removeConstraint(int position)
+{
+    isConstraintRemoved[position] = true;
+    numberOfRemovedConstraints++;
+}
+
+bool Presolve::removeFixedVariables()
+{
+    bool isChanged = false;
+
+    auto isFixed = [](const VariablePtr& variable) {
+        return (variable->properties.type != E_VariableType::Semicontinuous
+            && variable->lowerBound == variable->upperBound);
+    };
+
+    for(auto& C : constraints)
+    {
+        if(std::none_of(C->linearTerms.begin(), C->linearTerms.end(),
+               [&](const LinearTermPtr& term) { return (isFixed(term->variable)); }))
+            continue;
+
+        LinearTerms terms;
+
+        for(auto& T : C->linearTerms)
+        {
+            if(isFixed(T->variable))
+                C->constant += T->coefficient * T->variable->lowerBound;
+            else
+                terms.add(T);
+        }
+
+        C->linearTerms = terms;
+        C->properties.hasLinearTerms = terms.size() > 0;
+        isChanged = true;
+    }
+
+    if(auto objective = std::dynamic_pointer_cast<LinearObjectiveFunction>(problem->objectiveFunction))
+    {
+        LinearTerms terms;
+
+        for(auto& T : objective->linearTerms)
+        {
+            if(isFixed(T->variable))
+                objective->constant += T->coefficient * T->variable->lowerBound;
+            else
+                terms.add(T);
+        }
+
+        if(terms.size() < objective->linearTerms.size())
+        {
+            objective->linearTerms = terms;
+            objective->properties.hasLinearTerms = terms.size() > 0;
+        }
+    }
+
+    return (isChanged);
+}
+
+bool Presolve::removeEmptyAndSingletonConstraints()
+{
+    bool isChanged = false;
+
+    for(size_t i = 0; i < constraints.size(); i++)
+    {
+        auto& C = constraints[i];
+
+        if(isConstraintRemoved[i])
+            continue;
+
+        if(C->linearTerms.size() == 0)
+        {
+            // An infeasible constraint is kept, so that the infeasibility is detected by the subsolvers
+            if((!isFinite(C->valueLHS) || C->constant >= C->valueLHS - tolerance)
+                && (!isFinite(C->valueRHS) || C->constant <= C->valueRHS + tolerance))
+            {
+                removeConstraint(i);
+                isChanged = true;
+            }
+
+            continue;
+        }
+
+        if(C->linearTerms.size() != 1)
+            continue;
+
+        auto& term = C->linearTerms[0];
+
+        if(term->variable->properties.type == E_VariableType::Semicontinuous)
+            continue;
+
+        double lowerBound = SHOT_DBL_MIN;
+        double upperBound = SHOT_DBL_MAX;
+
+        if(isFinite(C->valueLHS))
+        {
+            if(term->coefficient > 0)
+                lowerBound = (C->valueLHS - C->constant) / term->coefficient;
+            else
+                upperBound = (C->valueLHS - C->constant) / term->coefficient;
+        }
+
+        if(isFinite(C->valueRHS))
+        {
+            if(term->coefficient > 0)
+                upperBound = (C->valueRHS - C->constant) / term->coefficient;
+            else
+                lowerBound = (C->valueRHS - C->constant) / term->coefficient;
+        }
+
+        if(setVariableBounds(term->variable, lowerBound, upperBound))
+        {
+            removeConstraint(i);
+            isChanged = true;
+        }
+    }
+
+    return (isChanged);
+}
+
+bool Presolve::removeRedundantConstraints()
+{
+    bool isChanged = false;
+
+    for(size_t i = 0; i < constraints.size(); i++)
+    {
+        auto& C = constraints[i];
+
+        if(isConstraintRemoved[i] || C->linearTerms.size() == 0)
+            continue;
+
+        auto [minimum, maximum] = getActivityBounds(C);
+
+        bool isLHSRedundant = !isFinite(C->valueLHS)
+            || (isFinite(minimum)
+                && minimum + C->constant >= C->valueLHS - tolerance * std::max(1.0, std::abs(C->valueLHS)));
+
+        bool isRHSRedundant = !isFinite(C->valueRHS)
+            || (isFinite(maximum)
+                && maximum + C->constant <= C->valueRHS + tolerance * std::max(1.0, std::abs(C->valueRHS)));
+
+        if(isLHSRedundant && isRHSRedundant)
+        {
+            removeConstraint(i);
+            isChanged = true;
+        }
+        else if(isLHSRedundant && isFinite(C->valueLHS))
+        {
+            C->valueLHS = SHOT_DBL_MIN;
+            isChanged = true;
+        }
+        else if(isRHSRedundant && isFinite(C->valueRHS))
+        {
+            C->valueRHS = SHOT_DBL_MAX;
+            isChanged = true;
+        }
+    }
+
+    return (isChanged);
+}
+
+bool Presolve::mergeParallelConstraints()
+{
+    bool isChanged = false;
+
+    // The terms are sorted by the variable indexes in normalizeConstraint, so parallel constraints have equal indexes
+    std::map<VectorInteger, std::vector<int>> constraintsWithVariables;
+
+    for(size_t i = 0; i < constraints.size(); i++)
+    {
+        if(isConstraintRemoved[i] || constraints[i]->linearTerms.size() < 2)
+            continue;
+
+        VectorInteger variableIndexes;
+
+        for(auto& T : constraints[i]->linearTerms)
+            variableIndexes.push_back(T->variable->index);
+
+        constraintsWithVariables[variableIndexes].push_back(i);
+    }
+
+    for(auto& [variableIndexes, positions] : constraintsWithVariables)
+    {
+        for(size_t i = 0; i < positions.size(); i++)
+        {
+            if(isConstraintRemoved[positions[i]])
+                continue;
+
+            auto& first = constraints[positions[i]];
+
+            for(size_t j = i + 1; j < positions.size(); j++)
+            {
+                if(isConstraintRemoved[positions[j]])
+                    continue;
+
+                auto& second = constraints[positions[j]];
+
+                // The second constraint is ratio times the first one
+                double ratio = second->linearTerms[0]->coefficient / first->linearTerms[0]->coefficient;
+                bool isParallel = true;
+
+                for(size_t k = 1; k < first->linearTerms.size(); k++)
+                {
+                    double coefficient = second->linearTerms[k]->coefficient;
+
+                    if(std::abs(coefficient - ratio * first->linearTerms[k]->coefficient)
+                        > tolerance * std::max(1.0, std::abs(coefficient)))
+                    {
+                        isParallel = false;
+                        break;
+                    }
+                }
+
+                if(!isParallel)
+                    continue;
+
+                // The bounds on the terms of the first constraint given by both constraints
+                double lowerBound = isFinite(first->valueLHS) ? first->valueLHS - first->constant : SHOT_DBL_MIN;
+                double upperBound = isFinite(first->valueRHS) ? first->valueRHS - first->constant : SHOT_DBL_MAX;
+
+                if(isFinite(second->valueLHS))
+                {
+                    double value = (second->valueLHS - second->constant) / ratio;
+
+                    if(ratio > 0)
+                        lowerBound = std::max(lowerBound, value);
+                    else
+                        upperBound = std::min(upperBound, value);
+                }
+
+                if(isFinite(second->valueRHS))
+                {
+                    double value = (second->valueRHS - second->constant) / ratio;
+
+                    if(ratio > 0)
+                        upperBound = std::min(upperBound, value);
+                    else
+                        lowerBound = std::max(lowerBound, value);
+                }
+
+                if(lowerBound > upperBound + tolerance * std::max(1.0, std::abs(upperBound)))
+                    continue;
+
+                if(lowerBound > upperBound)
+                    lowerBound = upperBound;
+
+                first->valueLHS = isFinite(lowerBound) ? lowerBound + first->constant : SHOT_DBL_MIN;
+                first->valueRHS = isFinite(upperBound) ? upperBound + first->constant : SHOT_DBL_MAX;
+
+                removeConstraint(positions[j]);
+                isChanged = true;
+            }
+        }
+    }
+
+    return (isChanged);
+}
+
+bool Presolve::removeFreeColumnSingletons()
+{
+    bool isChanged = false;
+
+    updateOccurrences();
+
+    for(auto& V : problem->allVariables)
+    {
+        int index = V->index;
+
+        if(isLocked[index] || V->properties.type != E_VariableType::Real || isFinite(V->lowerBound)
+            || isFinite(V->upperBound) || variableConstraints[index].size() != 1 || objectiveCoefficients[index] != 0.0)
+            continue;
+
+        int position = variableConstraints[index][0];
+
+        if(isConstraintRemoved[position])
+            continue;
+
+        auto& C = constraints[position];
+
+        // The values of auxiliary variables are calculated from their definitions in postsolve, which is done after
+        if(std::any_of(C->linearTerms.begin(), C->linearTerms.end(),
+               [](const LinearTermPtr& term) { return (term->variable->properties.isAuxiliary); }))
+            continue;
+
+        PostsolveStep step;
+        step.variableIndex = index;
+        step.constant = C->constant;
+        step.valueLHS = C->valueLHS;
+        step.valueRHS = C->valueRHS;
+
+        for(auto& T : C->linearTerms)
+        {
+            if(T->variable == V)
+                step.coefficient = T->coefficient;
+            else
+                step.otherTerms.emplace_back(T->variable->index, T->coefficient);
+        }
+
+        postsolveSteps.push_back(step);
+
+        removeConstraint(position);
+        isLocked[index] = true;
+        numberOfRemovedVariables++;
+        isChanged = true;
+    }
+
+    return (isChanged);
+}
+
+bool Presolve::aggregateDoubletonEquations()
+{
+    bool isChanged = false;
+
+    updateOccurrences();
+
+    auto objective = std::dynamic_pointer_cast<LinearObjectiveFunction>(problem->objectiveFunction);
+
+    for(size_t i = 0; i < constraints.size(); i++)
+    {
+        auto& C = constraints[i];
+
+        if(isConstraintRemoved[i] || C->linearTerms.size() != 2 || C->valueLHS != C->valueRHS || !isFinite(C->valueLHS))
+            continue;
+
+        for(int k = 1; k >= 0; k--)
+        {
+            // The variable y is substituted with (rhs - a * x) / b in all other constraints and the objective
+            auto variableY = C->linearTerms[k]->variable;
+            auto variableX = C->linearTerms[1 - k]->variable;
+            double coefficientY = C->linearTerms[k]->coefficient;
+            double coefficientX = C->linearTerms[1 - k]->coefficient;
+            double rhs = C->valueLHS - C->constant;
+
+            if(isLocked[variableY->index] || variableY->properties.type != E_VariableType::Real
+                || variableX->properties.isAuxiliary || variableX->properties.type == E_VariableType::Semicontinuous)
+                continue;
+
+            if(std::abs(coefficientX / coefficientY) > maxAggregationRatio)
+                continue;
+
+            // The bounds of y are moved to x
+            double factor = -coefficientY / coefficientX;
+            double offset = rhs / coefficientX;
+            double lowerBoundY = factor > 0 ? variableY->lowerBound : variableY->upperBound;
+            double upperBoundY = factor > 0 ? variableY->upperBound : variableY->lowerBound;
+            double lowerBoundX = isFinite(lowerBoundY) ? offset + factor * lowerBoundY : SHOT_DBL_MIN;
+            double upperBoundX = isFinite(upperBoundY) ? offset + factor * upperBoundY : SHOT_DBL_MAX;
+
+            if(!setVariableBounds(variableX, lowerBoundX, upperBoundX))
+                continue;
+
+            for(auto P : variableConstraints[variableY->index])
+            {
+                if(P == (int)i || isConstraintRemoved[P])
+                    continue;
+
+                auto& otherConstraint = constraints[P];
+                double coefficient = 0.0;
+                LinearTerms terms;
+
+                for(auto& T : otherConstraint->linearTerms)
+                {
+                    if(T->variable == variableY)
+                        coefficient += T->coefficient;
+                    else
+                        terms.add(T);
+                }
+
+                if(coefficient == 0.0)
+                    continue;
+
+                terms.add(std::make_shared<LinearTerm>(-coefficient * coefficientX / coefficientY, variableX));
+                otherConstraint->linearTerms = terms;
+                otherConstraint->constant += coefficient * rhs / coefficientY;
+                normalizeConstraint(otherConstraint);
+
+                // The occurrences are updated here, since x can be substituted later in the same round
+                auto& constraintsX = variableConstraints[variableX->index];
+
+                if(std::find(constraintsX.begin(), constraintsX.end(), P) == constraintsX.end())
+                    constraintsX.push_back(P);
+            }
+
+            variableConstraints[variableY->index].clear();
+
+            if(objective && objectiveCoefficients[variableY->index] != 0.0)
+            {
+                double coefficient = objectiveCoefficients[variableY->index];
+                LinearTerms terms;
+
+                for(auto& T : objective->linearTerms)
+                {
+                    if(T->variable != variableY)
+                        terms.add(T);
+                }
+
+                terms.add(std::make_shared<LinearTerm>(-coefficient * coefficientX / coefficientY, variableX));
+                objective->linearTerms = terms;
+                objective->constant += coefficient * rhs / coefficientY;
+
+                objectiveCoefficients[variableX->index] -= coefficient * coefficientX / coefficientY;
+                objectiveCoefficients[variableY->index] = 0.0;
+            }
+
+            PostsolveStep step;
+            step.variableIndex = variableY->index;
+            step.coefficient = coefficientY;
+            step.otherTerms.emplace_back(variableX->index, coefficientX);
+            step.constant = C->constant;
+            step.valueLHS = C->valueLHS;
+            step.valueRHS = C->valueRHS;
+            postsolveSteps.push_back(step);
+
+            removeConstraint(i);
+            isLocked[variableY->index] = true;
+            numberOfRemovedVariables++;
+            isChanged = true;
+            break;
+        }
+    }
+
+    return (isChanged);
+}
+
+bool Presolve::fixDominatedVariables()
+{
+    bool isChanged = false;
+
+    updateOccurrences();
+
+    double sign = (problem->objectiveFunction->direction == E_ObjectiveFunctionDirection::Minimize) ? 1.0 : -1.0;
+
+    for(auto& V : problem->allVariables)
+    {
+        int index = V->index;
+
+        if(isLocked[index] || V->lowerBound == V->upperBound)
+            continue;
+
+        // The number of constraints that would prevent decreasing or increasing the variable
+        int downLocks = 0;
+        int upLocks = 0;
+
+        for(auto P : variableConstraints[index])
+        {
+            auto& C = constraints[P];
+
+            for(auto& T : C->linearTerms)
+            {
+                if(T->variable != V)
+                    continue;
+
+                bool hasLHS = isFinite(C->valueLHS);
+                bool hasRHS = isFinite(C->valueRHS);
+
+                if(T->coefficient > 0)
+                {
+                    downLocks += hasLHS;
+                    upLocks += hasRHS;
+                }
+                else
+                {
+                    downLocks += hasRHS;
+                    upLocks += hasLHS;
+                }
+            }
+        }
+
+        double coefficient = sign * objectiveCoefficients[index];
+
+        // The bounds are changed through setVariableBounds so that they are marked and counted as tightened
+        if(coefficient >= 0.0 && downLocks == 0 && isFinite(V->lowerBound))
+        {
+            setVariableBounds(V, V->lowerBound, V->lowerBound);
+        }
+        else if(coefficient <= 0.0 && upLocks == 0 && isFinite(V->upperBound))
+        {
+            setVariableBounds(V, V->upperBound, V->upperBound);
+        }
+        else
+        {
+            continue;
+        }
+
+        numberOfFixedVariables++;
+        isChanged = true;
+    }
+
+    return (isChanged);
+}
+
+} // namespace SHOT
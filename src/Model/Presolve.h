@@ -0,0 +1,116 @@
+/**
+   The Supporting Hyperplane Optimization Toolkit (SHOT).
+
+   @author Andreas Lundell, Åbo Akademi University
+
+   @section LICENSE
+   This software is licensed under the Eclipse Public License 2.0.
+   Please see the README and LICENSE files for more information.
+*/
+
+#pragma once
+
+#include "../Environment.h"
+#include "../Structs.h"
+
+#include "Constraints.h"
+#include "Problem.h"
+
+#include <vector>
+
+namespace SHOT
+{
+
+// Reductions on the linear constraints of a problem, used on the reformulated problem before the dual problem is
+// created from it. The variables are never removed from the problem, so that the variable indexes stay the same in all
+// problems, but they can be fixed or removed from all constraints:
+//  - empty and redundant constraints are removed, constraints with one variable are replaced by variable bounds
+//  - parallel constraints, e.g., duplicates, are merged into one
+//  - fixed variables are removed from the linear constraints and the objective
+//  - a free continuous variable in only one constraint is removed together with the constraint
+//  - a continuous variable in an equality constraint with two variables is substituted in the other constraints
+//  - a variable whose objective coefficient and constraint coefficients all favour one of its bounds is fixed to it
+// The last three only consider variables that are not in nonlinear or quadratic terms or in the definitions of the
+// auxiliary variables. The values of the variables removed together with a constraint are calculated in postsolve.
+class Presolve
+{
+public:
+    Presolve(EnvironmentPtr envPtr, ProblemPtr problem);
+
+    // Must be called before the problem is finalized, reductions that would make the problem infeasible are skipped
+    void run();
+
+    // Calculates the values of the variables removed together with a constraint from the values of the other ones, so
+    // that the removed constraints are fulfilled. The point can contain only the original variables.
+    void postsolve(VectorDouble& point) const;
+
+    // The indexes of the variables removed together with a constraint, i.e., the ones calculated in postsolve
+    VectorInteger getRemovedVariableIndexes() const;
+
+    int numberOfRemovedConstraints = 0;
+    int numberOfRemovedVariables = 0;
+    int numberOfFixedVariables = 0;
+    int numberOfTightenedBounds = 0;
+
+private:
+    EnvironmentPtr env;
+    ProblemPtr problem;
+
+    // A variable removed from the problem together with the constraint valueLHS <= coefficient * variable +
+    // sum(otherTerms) + constant <= valueRHS
+    struct PostsolveStep
+    {
+        int variableIndex;
+        double coefficient;
+        std::vector<std::pair<int, double>> otherTerms;
+        double constant;
+        double valueLHS;
+        double valueRHS;
+    };
+
+    std::vector<PostsolveStep> postsolveSteps;
+
+    // The linear constraints that have not been removed, the removed ones are only marked until updateOccurrences
+    LinearConstraints constraints;
+    std::vector<bool> isConstraintRemoved;
+
+    // The positions in constraints of the constraints with each variable, updated by updateOccurrences
+    std::vector<std::vector<int>> variableConstraints;
+    VectorDouble objectiveCoefficients;
+
+    // Variables in nonlinear or quadratic terms, auxiliary variables and the ones already removed
+    std::vector<bool> isLocked;
+
+    double minimumLowerBound;
+    double maximumUpperBound;
+
+    const double tolerance = 1e-9;
+
+    bool isFinite(double value) const { return (value > minimumLowerBound && value < maximumUpperBound); }
+
+    void updateLockedVariables();
+    void updateOccurrences();
+
+    // Combines the terms with the same variable and removes the ones with zero coefficients
+    void normalizeConstraint(LinearConstraintPtr& constraint);
+
+    // The bounds of the terms in the constraint, not including the constant, SHOT_DBL_MIN or SHOT_DBL_MAX if infinite
+    std::pair<double, double> getActivityBounds(const LinearConstraintPtr& constraint) const;
+
+    // Tightens the bounds, returns false without changing them if the new bounds are infeasible
+    bool setVariableBounds(VariablePtr variable, double lowerBound, double upperBound);
+
+    void removeConstraint(int position);
+
+    bool removeFixedVariables();
+    bool removeEmptyAndSingletonConstraints();
+    bool removeRedundantConstraints();
+    bool mergeParallelConstraints();
+    bool removeFreeColumnSingletons();
+    bool aggregateDoubletonEquations();
+    bool fixDominatedVariables();
+};
+
+using PresolvePtr = std::shared_ptr<Presolve>;
+
+} // namespace SHOT
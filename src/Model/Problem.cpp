@@ -9,6 +9,8 @@
 */
 
 #include "Problem.h"
+#include "CompiledExpressions.h"
+#include "Presolve.h"
 #include "../Enums.h"
 #include "../Output.h"
 #include "../Settings.h"
@@ -17,6 +19,9 @@
 #include "../Model/Simplifications.h"
 #include "../Tasks/TaskReformulateProblem.h"
 
+#include <cstring>
+#include <numeric>
+
 namespace SHOT
 {
 
@@ -368,8 +373,8 @@ void Problem::updateVariableBounds()
             && allVariables[i]->upperBound < 2 && allVariables[i]->lowerBound != allVariables[i]->upperBound)
         {
             allVariables[i]->properties.type = E_VariableType::Binary;
-            allVariables[i]->lowerBound = 0.0;
-            allVariables[i]->upperBound = 1.0;
+            allVariables[i]->setLowerBound(0.0);
+            allVariables[i]->setUpperBound(1.0);
         }
 
         variableLowerBounds[i] = allVariables[i]->lowerBound;
@@ -757,15 +762,14 @@ void Problem::updateFactorableFunctions()
         nonlinearVariableCounter++;
     }
 
-    CppAD::Independent(factorableFunctionVariables);
-
     int nonlinearExpressionCounter = 0;
 
+    // Each nonlinear expression is recorded on its own tape
     for(auto& C : nonlinearConstraints)
     {
         if(C->properties.hasNonlinearExpression && C->variablesInNonlinearExpression.size() > 0)
         {
-            factorableFunctions.push_back(C->nonlinearExpression->getFactorableFunction());
+            C->updateFactorableFunction();
             constraintsWithNonlinearExpressions.push_back(C);
             C->nonlinearExpressionIndex = nonlinearExpressionCounter;
             nonlinearExpressionCounter++;
@@ -780,18 +784,8 @@ void Problem::updateFactorableFunctions()
         auto objective = std::dynamic_pointer_cast<NonlinearObjectiveFunction>(objectiveFunction);
 
         objective->updateFactorableFunction();
-        factorableFunctions.push_back(objective->nonlinearExpression->getFactorableFunction());
-
         objective->nonlinearExpressionIndex = nonlinearExpressionCounter;
     }
-
-    if(factorableFunctions.size() > 0)
-    {
-        ADFunctions.Dependent(factorableFunctionVariables, factorableFunctions);
-        // ADFunctions.optimize();
-    }
-
-    CppAD::AD<double>::abort_recording();
 }
 
 Problem::Problem(EnvironmentPtr env) : env(env) {}
@@ -817,7 +811,6 @@ Problem::~Problem()
     nonlinearConstraints.clear();
 
     factorableFunctionVariables.clear();
-    factorableFunctions.clear();
 }
 
 void Problem::finalize()
@@ -826,6 +819,24 @@ void Problem::finalize()
     updateFactorableFunctions();
     assert(verifyOwnership());
 
+    if(auxiliaryVariables.size() > 0 || auxiliaryObjectiveVariable)
+    {
+        auxiliaryVariableProgram
+            = std::make_shared<AuxiliaryVariableProgram>(auxiliaryVariables, auxiliaryObjectiveVariable);
+    }
+    else
+    {
+        auxiliaryVariableProgram.reset();
+    }
+
+    if(env->settings->getSetting<bool>("CodeGeneration.Use", "Model") && nonlinearConstraints.size() > 0
+        && properties.numberOfVariablesInNonlinearExpressions > 0)
+    {
+        // The previously loaded library, if any, is kept until the constraints point to the new one
+        if(auto compiled = std::make_shared<CompiledExpressions>(env); compiled->compile(nonlinearConstraints))
+            compiledExpressions = compiled;
+    }
+
     if(env->settings->getSetting<bool>("BoundTightening.FeasibilityBased.Use", "Model"))
     {
         bool performBoundTightening = true;
@@ -883,7 +894,7 @@ void Problem::add(VariablePtr variable)
     variable->takeOwnership(shared_from_this());
     variablesUpdated = false;
 
-    env->output->outputTrace("Added variable to problem: " + variable->name);
+    env->output->outputTrace("Added variable to problem: {}", variable->name);
 }
 
 void Problem::add(AuxiliaryVariables variables)
@@ -922,7 +933,7 @@ void Problem::add(AuxiliaryVariablePtr variable)
     variable->takeOwnership(shared_from_this());
     variablesUpdated = false;
 
-    env->output->outputTrace("Added variable to problem: " + variable->name);
+    env->output->outputTrace("Added variable to problem: {}", variable->name);
 }
 
 void Problem::add(NumericConstraintPtr constraint)
@@ -951,7 +962,7 @@ void Problem::add(NumericConstraintPtr constraint)
 
     constraint->takeOwnership(shared_from_this());
 
-    env->output->outputTrace("Added numeric constraint to problem: " + constraint->name);
+    env->output->outputTrace("Added numeric constraint to problem: {}", constraint->name);
 }
 
 void Problem::add(LinearConstraintPtr constraint)
@@ -962,7 +973,7 @@ void Problem::add(LinearConstraintPtr constraint)
 
     constraint->takeOwnership(shared_from_this());
 
-    env->output->outputTrace("Added linear constraint to problem: " + constraint->name);
+    env->output->outputTrace("Added linear constraint to problem: {}", constraint->name);
 }
 
 void Problem::add(QuadraticConstraintPtr constraint)
@@ -973,7 +984,7 @@ void Problem::add(QuadraticConstraintPtr constraint)
 
     constraint->takeOwnership(shared_from_this());
 
-    env->output->outputTrace("Added quadratic constraint to problem: " + constraint->name);
+    env->output->outputTrace("Added quadratic constraint to problem: {}", constraint->name);
 }
 
 void Problem::add(NonlinearConstraintPtr constraint)
@@ -984,7 +995,7 @@ void Problem::add(NonlinearConstraintPtr constraint)
 
     constraint->takeOwnership(shared_from_this());
 
-    env->output->outputTrace("Added nonlinear constraint to problem: " + constraint->name);
+    env->output->outputTrace("Added nonlinear constraint to problem: {}", constraint->name);
 }
 
 void Problem::add(ObjectiveFunctionPtr objective)
@@ -1093,6 +1104,24 @@ IntervalVector Problem::getVariableBounds()
     return variableBounds;
 }
 
+void Problem::liftToReformulatedSpace(VectorDouble& point)
+{
+    if(auxiliaryVariableProgram)
+        auxiliaryVariableProgram->lift(point);
+}
+
+void Problem::liftToReformulatedSpace(IntervalVector& intervalVector)
+{
+    if(auxiliaryVariableProgram)
+        auxiliaryVariableProgram->lift(intervalVector);
+}
+
+void Problem::postsolve(VectorDouble& point)
+{
+    if(presolve)
+        presolve->postsolve(point);
+}
+
 AuxiliaryVariables Problem::getAuxiliaryVariablesOfType(E_AuxiliaryVariableType type)
 {
     AuxiliaryVariables variables;
@@ -1108,20 +1137,20 @@ AuxiliaryVariables Problem::getAuxiliaryVariablesOfType(E_AuxiliaryVariableType
 
 void Problem::setVariableLowerBound(int variableIndex, double bound)
 {
-    allVariables.at(variableIndex)->lowerBound = bound;
+    allVariables.at(variableIndex)->setLowerBound(bound);
     variablesUpdated = true;
 }
 
 void Problem::setVariableUpperBound(int variableIndex, double bound)
 {
-    allVariables.at(variableIndex)->upperBound = bound;
+    allVariables.at(variableIndex)->setUpperBound(bound);
     variablesUpdated = true;
 }
 
 void Problem::setVariableBounds(int variableIndex, double lowerBound, double upperBound)
 {
-    allVariables.at(variableIndex)->lowerBound = lowerBound;
-    allVariables.at(variableIndex)->upperBound = upperBound;
+    allVariables.at(variableIndex)->setLowerBound(lowerBound);
+    allVariables.at(variableIndex)->setUpperBound(upperBound);
     variablesUpdated = true;
 }
 
@@ -1205,6 +1234,193 @@ std::shared_ptr<std::vector<std::pair<VariablePtr, VariablePtr>>> Problem::getCo
     return (constraintsHessianSparsityPattern);
 }
 
+std::vector<ProblemBlock> Problem::getIndependentBlocks(
+    const VectorDouble& lowerBounds, const VectorDouble& upperBounds)
+{
+    int numberOfVariables = properties.numberOfVariables;
+
+    auto isFixed = [&](int variableIndex) { return (lowerBounds[variableIndex] == upperBounds[variableIndex]); };
+
+    // A union-find structure where each component is represented by its variable with the smallest index
+    VectorInteger representatives(numberOfVariables);
+    std::iota(representatives.begin(), representatives.end(), 0);
+
+    auto findRepresentative = [&](int variableIndex)
+    {
+        while(representatives[variableIndex] != variableIndex)
+        {
+            representatives[variableIndex] = representatives[representatives[variableIndex]];
+            variableIndex = representatives[variableIndex];
+        }
+
+        return (variableIndex);
+    };
+
+    auto join = [&](int firstIndex, int secondIndex)
+    {
+        firstIndex = findRepresentative(firstIndex);
+        secondIndex = findRepresentative(secondIndex);
+
+        if(firstIndex < secondIndex)
+            representatives[secondIndex] = firstIndex;
+        else if(secondIndex < firstIndex)
+            representatives[firstIndex] = secondIndex;
+    };
+
+    for(auto& C : numericConstraints)
+    {
+        int firstIndex = -1;
+
+        for(auto& V : *C->getGradientSparsityPattern())
+        {
+            if(isFixed(V->index))
+                continue;
+
+            if(firstIndex < 0)
+                firstIndex = V->index;
+            else
+                join(firstIndex, V->index);
+        }
+    }
+
+    // The objective function is separable in the variables that are not in the same nonlinear term
+    for(auto& [firstVariable, secondVariable] : *objectiveFunction->getHessianSparsityPattern())
+    {
+        if(!isFixed(firstVariable->index) && !isFixed(secondVariable->index))
+            join(firstVariable->index, secondVariable->index);
+    }
+
+    std::vector<ProblemBlock> blocks;
+    VectorInteger blockPlacement(numberOfVariables, -1);
+
+    for(int i = 0; i < numberOfVariables; i++)
+    {
+        if(isFixed(i))
+            continue;
+
+        int representative = findRepresentative(i);
+
+        if(blockPlacement[representative] < 0)
+        {
+            blockPlacement[representative] = blocks.size();
+            blocks.emplace_back();
+        }
+
+        blocks[blockPlacement[representative]].variableIndexes.push_back(i);
+    }
+
+    for(auto& C : numericConstraints)
+    {
+        auto gradientSparsityPattern = C->getGradientSparsityPattern();
+
+        auto variable = std::find_if(gradientSparsityPattern->begin(), gradientSparsityPattern->end(),
+            [&](auto const& V) { return (!isFixed(V->index)); });
+
+        if(variable != gradientSparsityPattern->end())
+            blocks[blockPlacement[findRepresentative((*variable)->index)]].constraintIndexes.push_back(C->index);
+    }
+
+    return (blocks);
+}
+
+ObjectiveFunctionPtr Problem::createBlockObjectiveFunction(const ProblemBlock& block)
+{
+    std::vector<bool> isInBlock(properties.numberOfVariables, false);
+
+    for(auto I : block.variableIndexes)
+        isInBlock[I] = true;
+
+    auto isBlockVariable = [&](const VariablePtr& variable) { return (isInBlock[variable->index]); };
+
+    std::shared_ptr<LinearObjectiveFunction> blockObjective;
+
+    if(auto objective = std::dynamic_pointer_cast<NonlinearObjectiveFunction>(objectiveFunction))
+    {
+        auto nonlinearObjective = std::make_shared<NonlinearObjectiveFunction>(objectiveFunction->direction);
+
+        for(auto& T : objective->monomialTerms)
+        {
+            if(std::any_of(T->variables.begin(), T->variables.end(), isBlockVariable))
+                nonlinearObjective->add(T);
+        }
+
+        for(auto& T : objective->signomialTerms)
+        {
+            if(std::any_of(T->elements.begin(), T->elements.end(),
+                   [&](auto const& E) { return (isBlockVariable(E->variable)); }))
+                nonlinearObjective->add(T);
+        }
+
+        if(objective->nonlinearExpression)
+        {
+            // The terms in a sum are included separately, a term with variables in several blocks is in each of them
+            NonlinearExpressions terms;
+
+            if(objective->nonlinearExpression->getType() == E_NonlinearExpressionTypes::Sum)
+                terms = std::dynamic_pointer_cast<ExpressionSum>(objective->nonlinearExpression)->children;
+            else
+                terms.push_back(objective->nonlinearExpression);
+
+            NonlinearExpressions blockTerms;
+
+            for(auto& T : terms)
+            {
+                Variables variables;
+                T->appendNonlinearVariables(variables);
+
+                if(std::any_of(variables.begin(), variables.end(), isBlockVariable))
+                    blockTerms.push_back(T);
+            }
+
+            if(blockTerms.size() == 1)
+                nonlinearObjective->add(blockTerms[0]);
+            else if(blockTerms.size() > 1)
+                nonlinearObjective->add(std::make_shared<ExpressionSum>(std::move(blockTerms)));
+        }
+
+        blockObjective = nonlinearObjective;
+    }
+    else if(std::dynamic_pointer_cast<QuadraticObjectiveFunction>(objectiveFunction))
+    {
+        blockObjective = std::make_shared<QuadraticObjectiveFunction>(objectiveFunction->direction);
+    }
+    else
+    {
+        blockObjective = std::make_shared<LinearObjectiveFunction>(objectiveFunction->direction);
+    }
+
+    if(auto objective = std::dynamic_pointer_cast<LinearObjectiveFunction>(objectiveFunction))
+    {
+        for(auto& T : objective->linearTerms)
+        {
+            if(isBlockVariable(T->variable))
+                blockObjective->add(T);
+        }
+    }
+
+    if(auto objective = std::dynamic_pointer_cast<QuadraticObjectiveFunction>(objectiveFunction))
+    {
+        auto blockQuadraticObjective = std::dynamic_pointer_cast<QuadraticObjectiveFunction>(blockObjective);
+
+        for(auto& T : objective->quadraticTerms)
+        {
+            if(isBlockVariable(T->firstVariable) || isBlockVariable(T->secondVariable))
+                blockQuadraticObjective->add(T);
+        }
+    }
+
+    blockObjective->ownerProblem = weak_from_this();
+    blockObjective->updateProperties();
+
+    auto blockNonlinearObjective = std::dynamic_pointer_cast<NonlinearObjectiveFunction>(blockObjective);
+
+    if(blockNonlinearObjective && blockNonlinearObjective->properties.hasNonlinearExpression
+        && blockNonlinearObjective->variablesInNonlinearExpression.size() > 0)
+        blockNonlinearObjective->updateFactorableFunction();
+
+    return (blockObjective);
+}
+
 std::shared_ptr<std::vector<std::pair<VariablePtr, VariablePtr>>> Problem::getLagrangianHessianSparsityPattern()
 {
     if(lagrangianHessianSparsityPattern)
@@ -1275,6 +1491,45 @@ std::shared_ptr<std::vector<std::pair<VariablePtr, VariablePtr>>> Problem::getLa
     return (lagrangianHessianSparsityPattern);
 }
 
+PointKey Problem::getPointKey(const VectorDouble& point, double bucketWidth, bool onlyDiscreteVariables)
+{
+    PointKey key;
+    key.reserve(onlyDiscreteVariables ? properties.numberOfDiscreteVariables : allVariables.size());
+
+    for(auto& V : allVariables)
+    {
+        if(V->index >= (int)point.size())
+            break;
+
+        double value = point[V->index];
+
+        if(V->properties.type == E_VariableType::Binary || V->properties.type == E_VariableType::Integer)
+        {
+            key.push_back(std::llround(value));
+            continue;
+        }
+
+        if(onlyDiscreteVariables)
+            continue;
+
+        double bucket = std::round(value / bucketWidth);
+
+        if(std::abs(bucket) < 1e18)
+        {
+            key.push_back((long long)bucket);
+        }
+        else
+        {
+            // Too large to be bucketed, use the bit pattern of the value instead
+            long long bits;
+            std::memcpy(&bits, &value, sizeof(double));
+            key.push_back(bits);
+        }
+    }
+
+    return (key);
+}
+
 std::optional<NumericConstraintValue> Problem::getMostDeviatingNumericConstraint(const VectorDouble& point)
 {
     return (this->getMostDeviatingNumericConstraint(point, numericConstraints));
@@ -1432,84 +1687,58 @@ NumericConstraintValue getMaxNumericConstraintValue(const VectorDouble& point,
     return value;
 }
 
-NumericConstraintValue Problem::getMaxNumericConstraintValue(
-    const VectorDouble& point, const LinearConstraints constraintSelection)
+// Finds the constraint with the largest normalized value in one pass, only the most deviating constraint gets a full
+// NumericConstraintValue (with its shared pointer) created
+template <typename T>
+static NumericConstraintValue getMaxNumericConstraintValueInSelection(
+    const VectorDouble& point, const std::vector<std::shared_ptr<T>>& constraintSelection, double correction = 0.0)
 {
     assert(constraintSelection.size() > 0);
 
-    auto value = constraintSelection[0]->calculateNumericValue(point);
+    size_t maxIndex = 0;
+
+    double value = constraintSelection[0]->calculateFunctionValue(point);
+    double maxNormalizedValue
+        = std::max(value - constraintSelection[0]->valueRHS, constraintSelection[0]->valueLHS - value);
 
     for(size_t i = 1; i < constraintSelection.size(); i++)
     {
-        auto tmpValue = constraintSelection[i]->calculateNumericValue(point);
+        value = constraintSelection[i]->calculateFunctionValue(point);
+        double normalizedValue
+            = std::max(value - constraintSelection[i]->valueRHS, constraintSelection[i]->valueLHS - value);
 
-        if(tmpValue.normalizedValue > value.normalizedValue)
+        if(normalizedValue > maxNormalizedValue)
         {
-            value = tmpValue;
+            maxNormalizedValue = normalizedValue;
+            maxIndex = i;
         }
     }
 
-    return value;
+    return (constraintSelection[maxIndex]->calculateNumericValue(point, correction));
 }
 
 NumericConstraintValue Problem::getMaxNumericConstraintValue(
-    const VectorDouble& point, const QuadraticConstraints constraintSelection)
+    const VectorDouble& point, const LinearConstraints& constraintSelection)
 {
-    assert(constraintSelection.size() > 0);
-
-    auto value = constraintSelection[0]->calculateNumericValue(point);
-
-    for(size_t i = 1; i < constraintSelection.size(); i++)
-    {
-        auto tmpValue = constraintSelection[i]->calculateNumericValue(point);
-
-        if(tmpValue.normalizedValue > value.normalizedValue)
-        {
-            value = tmpValue;
-        }
-    }
-
-    return value;
+    return (getMaxNumericConstraintValueInSelection(point, constraintSelection));
 }
 
 NumericConstraintValue Problem::getMaxNumericConstraintValue(
-    const VectorDouble& point, const NonlinearConstraints constraintSelection, double correction)
+    const VectorDouble& point, const QuadraticConstraints& constraintSelection)
 {
-    assert(constraintSelection.size() > 0);
-
-    auto value = constraintSelection[0]->calculateNumericValue(point, correction);
-
-    for(size_t i = 1; i < constraintSelection.size(); i++)
-    {
-        auto tmpValue = constraintSelection[i]->calculateNumericValue(point, correction);
-
-        if(tmpValue.normalizedValue > value.normalizedValue)
-        {
-            value = tmpValue;
-        }
-    }
-
-    return value;
+    return (getMaxNumericConstraintValueInSelection(point, constraintSelection));
 }
 
 NumericConstraintValue Problem::getMaxNumericConstraintValue(
-    const VectorDouble& point, const NumericConstraints constraintSelection)
+    const VectorDouble& point, const NonlinearConstraints& constraintSelection, double correction)
 {
-    assert(constraintSelection.size() > 0);
-
-    auto value = constraintSelection[0]->calculateNumericValue(point);
-
-    for(size_t i = 1; i < constraintSelection.size(); i++)
-    {
-        auto tmpValue = constraintSelection[i]->calculateNumericValue(point);
-
-        if(tmpValue.normalizedValue > value.normalizedValue)
-        {
-            value = tmpValue;
-        }
-    }
+    return (getMaxNumericConstraintValueInSelection(point, constraintSelection, correction));
+}
 
-    return value;
+NumericConstraintValue Problem::getMaxNumericConstraintValue(
+    const VectorDouble& point, const NumericConstraints& constraintSelection)
+{
+    return (getMaxNumericConstraintValueInSelection(point, constraintSelection));
 }
 
 NumericConstraintValue Problem::getMaxNumericConstraintValue(const VectorDouble& point,
@@ -1688,7 +1917,7 @@ void Problem::doFBBT()
     {
         bool boundsUpdated = false;
 
-        env->output->outputDebug(fmt::format("  Bound tightening pass {} of {}.", i + 1, numberOfIterations));
+        env->output->outputDebug("  Bound tightening pass {} of {}.", i + 1, numberOfIterations);
 
         for(auto& C : linearConstraints)
         {
@@ -1759,326 +1988,249 @@ bool Problem::doFBBTOnConstraint(NumericConstraintPtr constraint, double timeLim
 {
     bool boundsUpdated = false;
 
+    int maxIterations
+        = env->settings->getSetting<int>("BoundTightening.FeasibilityBased.MaxConstraintIterations", "Model");
+
     try
     {
-        if(constraint->properties.hasLinearTerms)
+        // Repeats the forward-backward propagation until no bound is tightened or the work limit is reached
+        for(int i = 0; i < maxIterations; i++)
         {
-            Interval otherTermsBound(constraint->constant);
-
-            if(constraint->properties.hasQuadraticTerms)
-                otherTermsBound
-                    += std::dynamic_pointer_cast<QuadraticConstraint>(constraint)->quadraticTerms.getBounds();
-
-            if(constraint->properties.hasMonomialTerms)
-                otherTermsBound
-                    += std::dynamic_pointer_cast<NonlinearConstraint>(constraint)->monomialTerms.getBounds();
-
-            if(constraint->properties.hasSignomialTerms)
-                otherTermsBound
-                    += std::dynamic_pointer_cast<NonlinearConstraint>(constraint)->signomialTerms.getBounds();
-
-            if(constraint->properties.hasNonlinearExpression)
-                otherTermsBound
-                    += std::dynamic_pointer_cast<NonlinearConstraint>(constraint)->nonlinearExpression->getBounds();
-
-            auto terms = std::dynamic_pointer_cast<LinearConstraint>(constraint)->linearTerms;
-
-            for(auto& T : terms)
-            {
-                if(env->timing->getElapsedTime("BoundTightening") > timeLimit)
-                    break;
-
-                if(T->coefficient == 0.0)
-                    continue;
-
-                Interval newBound = otherTermsBound;
-
-                for(auto& T2 : terms)
-                {
-                    if(T2 == T)
-                        continue;
-
-                    newBound += T2->getBounds();
-                }
+            if(env->timing->getElapsedTime("BoundTightening") > timeLimit)
+                break;
 
-                Interval termBound = Interval(constraint->valueLHS, constraint->valueRHS) - newBound;
-                termBound = termBound / T->coefficient;
+            if(!doHC4ReviseOnConstraint(constraint))
+                break;
 
-                if(T->variable->tightenBounds(termBound))
-                {
-                    boundsUpdated = true;
-                    env->output->outputDebug(
-                        fmt::format("  bound tightened using linear term in constraint {} .", constraint->name));
-                }
-            }
+            boundsUpdated = true;
         }
+    }
+    catch(mc::Interval::Exceptions& e)
+    {
+        env->output->outputError(
+            fmt::format("  error when tightening bound in constraint {}: {}", constraint->name, e.what()));
+    }
 
-        if(constraint->properties.hasQuadraticTerms && env->timing->getElapsedTime("BoundTightening") < timeLimit)
+    // Update variable bounds for original variables also in original problem if tightened in reformulated one
+    if(boundsUpdated && this->properties.isReformulated)
+    {
+        for(size_t i = 0; i < env->problem->allVariables.size(); i++)
         {
-            Interval otherTermsBound(constraint->constant);
-
-            if(constraint->properties.hasLinearTerms)
-                otherTermsBound += std::dynamic_pointer_cast<LinearConstraint>(constraint)->linearTerms.getBounds();
-
-            if(constraint->properties.hasMonomialTerms)
-                otherTermsBound
-                    += std::dynamic_pointer_cast<NonlinearConstraint>(constraint)->monomialTerms.getBounds();
+            if(allVariables[i]->lowerBound > env->problem->allVariables[i]->lowerBound)
+                env->problem->allVariables[i]->setLowerBound(allVariables[i]->lowerBound);
 
-            if(constraint->properties.hasSignomialTerms)
-                otherTermsBound
-                    += std::dynamic_pointer_cast<NonlinearConstraint>(constraint)->signomialTerms.getBounds();
+            if(allVariables[i]->upperBound < env->problem->allVariables[i]->upperBound)
+                env->problem->allVariables[i]->setUpperBound(allVariables[i]->upperBound);
+        }
+    }
 
-            if(constraint->properties.hasNonlinearExpression)
-                otherTermsBound
-                    += std::dynamic_pointer_cast<NonlinearConstraint>(constraint)->nonlinearExpression->getBounds();
+    return (boundsUpdated);
+}
 
-            auto terms = std::dynamic_pointer_cast<QuadraticConstraint>(constraint)->quadraticTerms;
+bool Problem::doHC4ReviseOnConstraint(NumericConstraintPtr constraint)
+{
+    bool boundsUpdated = false;
 
-            for(auto& T : terms)
-            {
-                if(env->timing->getElapsedTime("BoundTightening") > timeLimit)
-                    break;
+    LinearTerms emptyLinearTerms;
+    QuadraticTerms emptyQuadraticTerms;
+    MonomialTerms emptyMonomialTerms;
+    SignomialTerms emptySignomialTerms;
 
-                if(T->coefficient == 0.0)
-                    continue;
+    auto& linearTerms = constraint->properties.hasLinearTerms
+        ? std::dynamic_pointer_cast<LinearConstraint>(constraint)->linearTerms
+        : emptyLinearTerms;
+    auto& quadraticTerms = constraint->properties.hasQuadraticTerms
+        ? std::dynamic_pointer_cast<QuadraticConstraint>(constraint)->quadraticTerms
+        : emptyQuadraticTerms;
+    auto& monomialTerms = constraint->properties.hasMonomialTerms
+        ? std::dynamic_pointer_cast<NonlinearConstraint>(constraint)->monomialTerms
+        : emptyMonomialTerms;
+    auto& signomialTerms = constraint->properties.hasSignomialTerms
+        ? std::dynamic_pointer_cast<NonlinearConstraint>(constraint)->signomialTerms
+        : emptySignomialTerms;
 
-                Interval newBound = otherTermsBound;
+    NonlinearExpressionPtr nonlinearExpression;
 
-                for(auto& T2 : terms)
-                {
-                    if(T2 == T)
-                        continue;
+    if(constraint->properties.hasNonlinearExpression)
+        nonlinearExpression = std::dynamic_pointer_cast<NonlinearConstraint>(constraint)->nonlinearExpression;
 
-                    newBound += T2->getBounds();
-                }
+    // Forward pass: the bounds of all terms calculated from the current variable bounds, in the order linear,
+    // quadratic, monomial and signomial terms and finally the nonlinear expression
 
-                Interval termBound = Interval(constraint->valueLHS, constraint->valueRHS) - newBound;
-                termBound = termBound / T->coefficient;
+    std::vector<Interval> termBounds;
+    termBounds.reserve(linearTerms.size() + quadraticTerms.size() + monomialTerms.size() + signomialTerms.size() + 1);
 
-                if(T->firstVariable == T->secondVariable)
-                {
-                    if(termBound.l() < 0)
-                        continue;
+    for(auto& T : linearTerms)
+        termBounds.push_back(T->coefficient * T->variable->getBound());
 
-                    if(T->firstVariable->tightenBounds(sqrt(termBound)))
-                    {
-                        boundsUpdated = true;
-                        env->output->outputDebug(
-                            fmt::format("  bound tightened using quadratic term in constraint {}.", constraint->name));
-                    }
-                }
-                else
-                {
-                    Interval firstVariableBound = T->firstVariable->getBound();
-                    Interval secondVariableBound = T->secondVariable->getBound();
+    for(auto& T : quadraticTerms)
+    {
+        if(T->firstVariable == T->secondVariable)
+            termBounds.push_back(T->coefficient * sqr(T->firstVariable->getBound()));
+        else
+            termBounds.push_back(T->coefficient * T->firstVariable->getBound() * T->secondVariable->getBound());
+    }
 
-                    if((firstVariableBound.l() > 0 || firstVariableBound.u() < 0)
-                        && T->secondVariable->tightenBounds(termBound / firstVariableBound))
-                    {
-                        boundsUpdated = true;
-                        env->output->outputDebug(
-                            fmt::format("  bound tightened using quadratic term in constraint {}.", constraint->name));
-                    }
+    for(auto& T : monomialTerms)
+    {
+        Interval bound(T->coefficient);
 
-                    if((secondVariableBound.l() > 0 || secondVariableBound.u() < 0)
-                        && T->firstVariable->tightenBounds(termBound / secondVariableBound))
-                    {
-                        boundsUpdated = true;
-                        env->output->outputDebug(
-                            fmt::format("  bound tightened using quadratic term in constraint {}.", constraint->name));
-                    }
-                }
-            }
-        }
+        for(auto& V : T->variables)
+            bound *= V->getBound();
 
-        if(constraint->properties.hasMonomialTerms && env->timing->getElapsedTime("BoundTightening") < timeLimit)
-        {
-            Interval otherTermsBound(constraint->constant);
+        termBounds.push_back(bound);
+    }
 
-            if(constraint->properties.hasLinearTerms)
-                otherTermsBound += std::dynamic_pointer_cast<LinearConstraint>(constraint)->linearTerms.getBounds();
+    for(auto& T : signomialTerms)
+    {
+        Interval bound(T->coefficient);
 
-            if(constraint->properties.hasQuadraticTerms)
-                otherTermsBound
-                    += std::dynamic_pointer_cast<QuadraticConstraint>(constraint)->quadraticTerms.getBounds();
+        for(auto& E : T->elements)
+            bound *= E->getBounds();
 
-            if(constraint->properties.hasSignomialTerms)
-                otherTermsBound
-                    += std::dynamic_pointer_cast<NonlinearConstraint>(constraint)->signomialTerms.getBounds();
+        termBounds.push_back(bound);
+    }
 
-            if(constraint->properties.hasNonlinearExpression)
-                otherTermsBound
-                    += std::dynamic_pointer_cast<NonlinearConstraint>(constraint)->nonlinearExpression->getBounds();
+    if(nonlinearExpression)
+        termBounds.push_back(nonlinearExpression->getBounds());
 
-            auto terms = std::dynamic_pointer_cast<NonlinearConstraint>(constraint)->monomialTerms;
+    // Backward pass: each term is projected on the constraint bounds minus the bounds of all the other terms, which are
+    // all calculated from the forward pass
 
-            for(auto& T : terms)
-            {
-                if(env->timing->getElapsedTime("BoundTightening") > timeLimit)
-                    break;
+    auto otherTermsBounds = combineOtherIntervals(termBounds, false);
+    Interval constraintBound = Interval(constraint->valueLHS, constraint->valueRHS) - constraint->constant;
 
-                if(T->coefficient == 0.0)
-                    continue;
+    size_t termIndex = 0;
 
-                Interval newBound = otherTermsBound;
+    for(auto& T : linearTerms)
+    {
+        auto termBound = constraintBound - otherTermsBounds[termIndex++];
 
-                for(auto& T2 : terms)
-                {
-                    if(T2 == T)
-                        continue;
+        if(T->coefficient == 0.0)
+            continue;
 
-                    newBound += T2->getBounds();
-                }
+        if(T->variable->tightenBounds(termBound / T->coefficient))
+        {
+            boundsUpdated = true;
+            env->output->outputDebug("  bound tightened using linear term in constraint {} .", constraint->name);
+        }
+    }
 
-                Interval termBound = Interval(constraint->valueLHS, constraint->valueRHS) - newBound;
-                termBound = termBound / T->coefficient;
+    for(auto& T : quadraticTerms)
+    {
+        auto termBound = constraintBound - otherTermsBounds[termIndex++];
 
-                for(auto& V1 : T->variables)
-                {
-                    Interval othersBound(1.0);
+        if(T->coefficient == 0.0)
+            continue;
 
-                    for(auto& V2 : T->variables)
-                    {
-                        if(V1 == V2)
-                            continue;
+        termBound = termBound / T->coefficient;
+        bool tightened = false;
 
-                        othersBound *= V2->getBound();
-                    }
+        if(T->firstVariable == T->secondVariable)
+        {
+            if(termBound.u() < 0)
+                continue;
 
-                    // To avoid division by zero
-                    if(othersBound.l() <= 0 && othersBound.u() >= 0)
-                        continue;
+            if(termBound.l() < 0)
+                termBound.l(0.0);
 
-                    auto childBound = termBound / othersBound;
+            // The variable can be on either side of zero, so its current bounds are used to select the branch
+            auto squareRoot = sqrt(termBound);
+            auto variableBound = T->firstVariable->getBound();
 
-                    if(V1->tightenBounds(childBound))
-                    {
-                        boundsUpdated = true;
-                        env->output->outputDebug(
-                            fmt::format("  bound tightened using monomial term in constraint {}.", constraint->name));
-                    }
-                }
-            }
+            if(variableBound.l() >= 0)
+                tightened = T->firstVariable->tightenBounds(squareRoot);
+            else if(variableBound.u() <= 0)
+                tightened = T->firstVariable->tightenBounds(-squareRoot);
+            else
+                tightened = T->firstVariable->tightenBounds(Interval(-squareRoot.u(), squareRoot.u()));
         }
-
-        if(constraint->properties.hasSignomialTerms && env->timing->getElapsedTime("BoundTightening") < timeLimit)
+        else
         {
-            Interval otherTermsBound(constraint->constant);
-
-            if(constraint->properties.hasLinearTerms)
-                otherTermsBound += std::dynamic_pointer_cast<LinearConstraint>(constraint)->linearTerms.getBounds();
-
-            if(constraint->properties.hasQuadraticTerms)
-                otherTermsBound
-                    += std::dynamic_pointer_cast<QuadraticConstraint>(constraint)->quadraticTerms.getBounds();
-
-            if(constraint->properties.hasMonomialTerms)
-                otherTermsBound
-                    += std::dynamic_pointer_cast<NonlinearConstraint>(constraint)->monomialTerms.getBounds();
-
-            if(constraint->properties.hasNonlinearExpression)
-                otherTermsBound
-                    += std::dynamic_pointer_cast<NonlinearConstraint>(constraint)->nonlinearExpression->getBounds();
-
-            auto terms = std::dynamic_pointer_cast<NonlinearConstraint>(constraint)->signomialTerms;
+            Interval firstVariableBound = T->firstVariable->getBound();
+            Interval secondVariableBound = T->secondVariable->getBound();
 
-            for(auto& T : terms)
-            {
-                if(env->timing->getElapsedTime("BoundTightening") > timeLimit)
-                    break;
+            if(firstVariableBound.l() > 0 || firstVariableBound.u() < 0)
+                tightened = T->secondVariable->tightenBounds(termBound / firstVariableBound);
 
-                if(T->coefficient == 0.0)
-                    continue;
-
-                Interval newBound = otherTermsBound;
-
-                for(auto& T2 : terms)
-                {
-                    if(T2 == T)
-                        continue;
+            if(secondVariableBound.l() > 0 || secondVariableBound.u() < 0)
+                tightened = T->firstVariable->tightenBounds(termBound / secondVariableBound) || tightened;
+        }
 
-                    newBound += T2->getBounds();
-                }
+        if(tightened)
+        {
+            boundsUpdated = true;
+            env->output->outputDebug("  bound tightened using quadratic term in constraint {}.", constraint->name);
+        }
+    }
 
-                Interval termBound = Interval(constraint->valueLHS, constraint->valueRHS) - newBound;
+    for(auto& T : monomialTerms)
+    {
+        auto termBound = constraintBound - otherTermsBounds[termIndex++];
 
-                termBound = termBound / T->coefficient;
+        if(T->coefficient == 0.0)
+            continue;
 
-                for(auto& E1 : T->elements)
-                {
-                    Interval othersBound(1.0);
+        termBound = termBound / T->coefficient;
 
-                    for(auto& E2 : T->elements)
-                    {
-                        if(E1 == E2)
-                            continue;
+        std::vector<Interval> variableBounds;
+        variableBounds.reserve(T->variables.size());
 
-                        othersBound *= E2->getBounds();
-                    }
+        for(auto& V : T->variables)
+            variableBounds.push_back(V->getBound());
 
-                    // To avoid division by zero
-                    if(othersBound.l() <= 0 && othersBound.u() >= 0)
-                        continue;
+        auto otherVariablesBounds = combineOtherIntervals(variableBounds, true);
 
-                    auto childBound = termBound / othersBound;
+        for(size_t i = 0; i < T->variables.size(); i++)
+        {
+            // To avoid division by zero
+            if(otherVariablesBounds[i].l() <= 0 && otherVariablesBounds[i].u() >= 0)
+                continue;
 
-                    if(E1->tightenBounds(childBound))
-                    {
-                        boundsUpdated = true;
-                        env->output->outputDebug(
-                            fmt::format("  bound tightened using signomial term in constraint {}.", constraint->name));
-                    }
-                }
+            if(T->variables[i]->tightenBounds(termBound / otherVariablesBounds[i]))
+            {
+                boundsUpdated = true;
+                env->output->outputDebug("  bound tightened using monomial term in constraint {}.", constraint->name);
             }
         }
+    }
 
-        if(constraint->properties.hasNonlinearExpression && env->timing->getElapsedTime("BoundTightening") < timeLimit)
-        {
-            Interval otherTermsBound(constraint->constant);
+    for(auto& T : signomialTerms)
+    {
+        auto termBound = constraintBound - otherTermsBounds[termIndex++];
+
+        if(T->coefficient == 0.0)
+            continue;
 
-            if(constraint->properties.hasLinearTerms)
-                otherTermsBound += std::dynamic_pointer_cast<LinearConstraint>(constraint)->linearTerms.getBounds();
+        termBound = termBound / T->coefficient;
 
-            if(constraint->properties.hasQuadraticTerms)
-                otherTermsBound
-                    += std::dynamic_pointer_cast<QuadraticConstraint>(constraint)->quadraticTerms.getBounds();
+        std::vector<Interval> elementBounds;
+        elementBounds.reserve(T->elements.size());
 
-            if(constraint->properties.hasMonomialTerms)
-                otherTermsBound
-                    += std::dynamic_pointer_cast<NonlinearConstraint>(constraint)->monomialTerms.getBounds();
+        for(auto& E : T->elements)
+            elementBounds.push_back(E->getBounds());
 
-            if(constraint->properties.hasSignomialTerms)
-                otherTermsBound
-                    += std::dynamic_pointer_cast<NonlinearConstraint>(constraint)->signomialTerms.getBounds();
+        auto otherElementsBounds = combineOtherIntervals(elementBounds, true);
 
-            Interval candidate = Interval(constraint->valueLHS, constraint->valueRHS) - otherTermsBound;
+        for(size_t i = 0; i < T->elements.size(); i++)
+        {
+            // To avoid division by zero
+            if(otherElementsBounds[i].l() <= 0 && otherElementsBounds[i].u() >= 0)
+                continue;
 
-            if(std::dynamic_pointer_cast<NonlinearConstraint>(constraint)
-                    ->nonlinearExpression->tightenBounds(candidate))
+            if(T->elements[i]->tightenBounds(termBound / otherElementsBounds[i]))
             {
-                env->output->outputDebug(
-                    fmt::format("  bound tightened using nonlinear expression in constraint {}.", constraint->name));
                 boundsUpdated = true;
+                env->output->outputDebug("  bound tightened using signomial term in constraint {}.", constraint->name);
             }
         }
     }
-    catch(mc::Interval::Exceptions& e)
-    {
-        env->output->outputError(
-            fmt::format("  error when tightening bound in constraint {}: {}", constraint->name, e.what()));
-    }
 
-    // Update variable bounds for original variables also in original problem if tightened in reformulated one
-    if(boundsUpdated && this->properties.isReformulated)
+    if(nonlinearExpression
+        && nonlinearExpression->tightenBounds(constraintBound - otherTermsBounds[termIndex]))
     {
-        for(size_t i = 0; i < env->problem->allVariables.size(); i++)
-        {
-            if(allVariables[i]->lowerBound > env->problem->allVariables[i]->lowerBound)
-                env->problem->allVariables[i]->lowerBound = allVariables[i]->lowerBound;
-
-            if(allVariables[i]->upperBound < env->problem->allVariables[i]->upperBound)
-                env->problem->allVariables[i]->upperBound = allVariables[i]->upperBound;
-        }
+        env->output->outputDebug("  bound tightened using nonlinear expression in constraint {}.", constraint->name);
+        boundsUpdated = true;
     }
 
     return (boundsUpdated);
@@ -72,6 +72,16 @@ struct ProblemProperties
     bool isReformulated = false; // True if this is the reformulated problem
 };
 
+// A set of variables and the constraints that only contain these (and fixed) variables
+struct ProblemBlock
+{
+    VectorInteger variableIndexes;
+    VectorInteger constraintIndexes;
+};
+
+class CompiledExpressions;
+class Presolve;
+
 class DllExport Problem : public std::enable_shared_from_this<Problem>
 {
 private:
@@ -114,6 +124,9 @@ public:
     AuxiliaryVariables auxiliaryVariables;
     AuxiliaryVariablePtr auxiliaryObjectiveVariable; // This is not the same as one created in the dual problem
 
+    // The definitions of the auxiliary variables compiled when the problem is finalized
+    AuxiliaryVariableProgramPtr auxiliaryVariableProgram;
+
     VectorDouble variableLowerBounds;
     VectorDouble variableUpperBounds;
     IntervalVector variableBounds;
@@ -126,8 +139,12 @@ public:
     NonlinearConstraints nonlinearConstraints;
 
     std::vector<CppAD::AD<double>> factorableFunctionVariables;
-    std::vector<CppAD::AD<double>> factorableFunctions;
-    CppAD::ADFun<double> ADFunctions;
+
+    // Owns the loaded library if the nonlinear expressions have been compiled to native code
+    std::shared_ptr<CompiledExpressions> compiledExpressions;
+
+    // The reductions done on the linear constraints, if the problem has been presolved
+    std::shared_ptr<Presolve> presolve;
 
     void updateProperties();
 
@@ -163,6 +180,14 @@ public:
 
     IntervalVector getVariableBounds();
 
+    // Calculates the values of the auxiliary variables from the original ones, the point or interval vector is extended
+    // to contain all variables
+    void liftToReformulatedSpace(VectorDouble& point);
+    void liftToReformulatedSpace(IntervalVector& intervalVector);
+
+    // Calculates the values of the variables removed in presolve from the other ones, if the problem has been presolved
+    void postsolve(VectorDouble& point);
+
     AuxiliaryVariables getAuxiliaryVariablesOfType(E_AuxiliaryVariableType type);
 
     void setVariableLowerBound(int variableIndex, double bound);
@@ -174,6 +199,19 @@ public:
     std::shared_ptr<std::vector<std::pair<VariablePtr, VariablePtr>>> getConstraintsHessianSparsityPattern();
     std::shared_ptr<std::vector<std::pair<VariablePtr, VariablePtr>>> getLagrangianHessianSparsityPattern();
 
+    // Splits the variables that are not fixed by the given bounds into the connected components of the graph where two
+    // variables are adjacent if they are in the same constraint or in the same nonlinear objective term. With the other
+    // blocks fixed, each block is an independent problem. Constraints with only fixed variables are not in any block.
+    std::vector<ProblemBlock> getIndependentBlocks(const VectorDouble& lowerBounds, const VectorDouble& upperBounds);
+
+    // Returns an objective function with only the terms that have variables in the block, so that the objective of the
+    // block can be evaluated without the terms that are constant when the other blocks are fixed
+    ObjectiveFunctionPtr createBlockObjectiveFunction(const ProblemBlock& block);
+
+    // Discrete variables are rounded and continuous variables mapped to buckets of the given width, so points with the
+    // same key are equal up to the bucket width and the key can be used in hashed containers
+    PointKey getPointKey(const VectorDouble& point, double bucketWidth, bool onlyDiscreteVariables = false);
+
     std::optional<NumericConstraintValue> getMostDeviatingNumericConstraint(const VectorDouble& point);
     std::optional<NumericConstraintValue> getMostDeviatingNonlinearOrQuadraticConstraint(const VectorDouble& point);
     std::optional<NumericConstraintValue> getMostDeviatingNonlinearConstraint(const VectorDouble& point);
@@ -191,13 +229,13 @@ public:
         std::vector<std::shared_ptr<T>> constraintSelection, std::vector<std::shared_ptr<T>>& activeConstraints);
 
     NumericConstraintValue getMaxNumericConstraintValue(
-        const VectorDouble& point, const LinearConstraints constraintSelection);
+        const VectorDouble& point, const LinearConstraints& constraintSelection);
     NumericConstraintValue getMaxNumericConstraintValue(
-        const VectorDouble& point, const QuadraticConstraints constraintSelection);
+        const VectorDouble& point, const QuadraticConstraints& constraintSelection);
     NumericConstraintValue getMaxNumericConstraintValue(
-        const VectorDouble& point, const NonlinearConstraints constraintSelection, double correction = 0.0);
+        const VectorDouble& point, const NonlinearConstraints& constraintSelection, double correction = 0.0);
     NumericConstraintValue getMaxNumericConstraintValue(
-        const VectorDouble& point, const NumericConstraints constraintSelection);
+        const VectorDouble& point, const NumericConstraints& constraintSelection);
 
     template <typename T>
     NumericConstraintValue getMaxNumericConstraintValue(
@@ -237,6 +275,10 @@ public:
     void doFBBT();
     bool doFBBTOnConstraint(NumericConstraintPtr constraint, double timeLimit);
 
+    // One forward-backward interval propagation (HC4-revise) over the terms and the nonlinear expression in the
+    // constraint, returns true if any variable bound was tightened
+    bool doHC4ReviseOnConstraint(NumericConstraintPtr constraint);
+
     friend std::ostream& operator<<(std::ostream& stream, const Problem& problem);
 };
 
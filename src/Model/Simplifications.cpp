@@ -19,6 +19,9 @@ namespace SHOT
 void simplifyNonlinearExpressions(
     ProblemPtr problem, bool extractMonomials, bool extractSignomials, bool extractQuadratics)
 {
+    // Nodes shared between the objective and constraints are only simplified once
+    SimplificationCache simplificationCache;
+
     if(problem->objectiveFunction->properties.hasNonlinearExpression)
     {
         auto nonlinearObjective = std::dynamic_pointer_cast<NonlinearObjectiveFunction>(problem->objectiveFunction);
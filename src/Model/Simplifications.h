@@ -23,6 +23,7 @@
 #include "../Model/Problem.h"
 
 #include <optional>
+#include <unordered_map>
 
 namespace SHOT
 {
@@ -32,6 +33,129 @@ NonlinearExpressionPtr copyNonlinearExpression(NonlinearExpression* expression,
 
 inline NonlinearExpressionPtr simplify(NonlinearExpressionPtr expression);
 
+// While an instance exists on a thread, each expression node is simplified only once and all expressions referencing
+// the node get the same simplified node. This is needed when nodes are shared between several expressions, e.g. for
+// AMPL defined variables, since the simplifications replace the children of the nodes in place.
+class SimplificationCache
+{
+public:
+    SimplificationCache() : previous(current()) { current() = this; }
+    ~SimplificationCache() { current() = previous; }
+
+    SimplificationCache(const SimplificationCache&) = delete;
+    SimplificationCache& operator=(const SimplificationCache&) = delete;
+
+    static SimplificationCache*& current()
+    {
+        thread_local SimplificationCache* cache = nullptr;
+        return (cache);
+    }
+
+    // The original nodes are kept alive so that their addresses are not reused for new nodes
+    std::unordered_map<const NonlinearExpression*, std::pair<NonlinearExpressionPtr, NonlinearExpressionPtr>> results;
+
+private:
+    SimplificationCache* previous;
+};
+
+// The structural hash and equality identify expressions with the same tree, also when the nodes are not shared, e.g.,
+// for copies of an AMPL defined variable
+inline size_t getStructuralHash(const NonlinearExpression* expression)
+{
+    auto combine = [](size_t seed, size_t value) { return (seed ^ (value + 0x9e3779b9 + (seed << 6) + (seed >> 2))); };
+
+    auto type = expression->getType();
+    size_t hash = std::hash<int>()(static_cast<int>(type));
+
+    switch(type)
+    {
+    case E_NonlinearExpressionTypes::Constant:
+        return (combine(hash, std::hash<double>()(static_cast<const ExpressionConstant*>(expression)->constant)));
+    case E_NonlinearExpressionTypes::Variable:
+        return (combine(hash, std::hash<int>()(static_cast<const ExpressionVariable*>(expression)->variable->index)));
+    case E_NonlinearExpressionTypes::Divide:
+    case E_NonlinearExpressionTypes::Power:
+    {
+        auto binary = static_cast<const ExpressionBinary*>(expression);
+        hash = combine(hash, getStructuralHash(binary->firstChild.get()));
+        return (combine(hash, getStructuralHash(binary->secondChild.get())));
+    }
+    case E_NonlinearExpressionTypes::Sum:
+    case E_NonlinearExpressionTypes::Product:
+    {
+        for(auto& C : static_cast<const ExpressionGeneral*>(expression)->children)
+            hash = combine(hash, getStructuralHash(C.get()));
+
+        return (hash);
+    }
+    default:
+        return (combine(hash, getStructuralHash(static_cast<const ExpressionUnary*>(expression)->child.get())));
+    }
+}
+
+inline bool isStructurallyEqual(const NonlinearExpression* first, const NonlinearExpression* second)
+{
+    if(first == second)
+        return (true);
+
+    auto type = first->getType();
+
+    if(type != second->getType())
+        return (false);
+
+    switch(type)
+    {
+    case E_NonlinearExpressionTypes::Constant:
+        return (static_cast<const ExpressionConstant*>(first)->constant
+            == static_cast<const ExpressionConstant*>(second)->constant);
+    case E_NonlinearExpressionTypes::Variable:
+        return (static_cast<const ExpressionVariable*>(first)->variable->index
+            == static_cast<const ExpressionVariable*>(second)->variable->index);
+    case E_NonlinearExpressionTypes::Divide:
+    case E_NonlinearExpressionTypes::Power:
+    {
+        auto firstBinary = static_cast<const ExpressionBinary*>(first);
+        auto secondBinary = static_cast<const ExpressionBinary*>(second);
+
+        return (isStructurallyEqual(firstBinary->firstChild.get(), secondBinary->firstChild.get())
+            && isStructurallyEqual(firstBinary->secondChild.get(), secondBinary->secondChild.get()));
+    }
+    case E_NonlinearExpressionTypes::Sum:
+    case E_NonlinearExpressionTypes::Product:
+    {
+        auto& firstChildren = static_cast<const ExpressionGeneral*>(first)->children;
+        auto& secondChildren = static_cast<const ExpressionGeneral*>(second)->children;
+
+        if(firstChildren.size() != secondChildren.size())
+            return (false);
+
+        for(size_t i = 0; i < firstChildren.size(); i++)
+        {
+            if(!isStructurallyEqual(firstChildren[i].get(), secondChildren[i].get()))
+                return (false);
+        }
+
+        return (true);
+    }
+    default:
+        return (isStructurallyEqual(static_cast<const ExpressionUnary*>(first)->child.get(),
+            static_cast<const ExpressionUnary*>(second)->child.get()));
+    }
+}
+
+struct NonlinearExpressionStructuralHasher
+{
+    size_t operator()(const NonlinearExpressionPtr& expression) const { return (getStructuralHash(expression.get())); }
+};
+
+struct NonlinearExpressionStructuralEquality
+{
+    bool operator()(const NonlinearExpressionPtr& first, const NonlinearExpressionPtr& second) const
+    {
+        return (isStructurallyEqual(first.get(), second.get()));
+    }
+};
+
 inline NonlinearExpressionPtr simplifyExpression(std::shared_ptr<ExpressionConstant> expression)
 {
     return (expression);
@@ -64,30 +188,34 @@ inline NonlinearExpressionPtr simplifyExpression(std::shared_ptr<ExpressionNegat
     {
         expression->child = simplify(child);
 
+        // The simplified child may be used elsewhere, e.g. if it is an AMPL defined variable, so new nodes are created
+        // for the negated terms instead of modifying the child
         if(expression->child->getType() == E_NonlinearExpressionTypes::Sum)
         {
-            auto sum = std::dynamic_pointer_cast<ExpressionSum>(expression->child);
+            auto sum = std::make_shared<ExpressionSum>();
 
-            for(auto& T : sum->children)
+            for(auto& T : std::dynamic_pointer_cast<ExpressionSum>(expression->child)->children)
             {
                 if(T->getType() == E_NonlinearExpressionTypes::Negate)
                 {
                     // Negations cancel out
-                    T = std::dynamic_pointer_cast<ExpressionNegate>(T)->child;
+                    sum->children.add(std::dynamic_pointer_cast<ExpressionNegate>(T)->child);
                 }
                 else if(T->getType() == E_NonlinearExpressionTypes::Constant)
                 {
-                    std::dynamic_pointer_cast<ExpressionConstant>(T)->constant *= -1;
+                    auto constant = std::dynamic_pointer_cast<ExpressionConstant>(T)->constant;
+                    sum->children.add(std::make_shared<ExpressionConstant>(-constant));
                 }
                 else if(T->getType() == E_NonlinearExpressionTypes::Product)
                 {
-                    std::dynamic_pointer_cast<ExpressionProduct>(T)->children.add(
-                        std::make_shared<ExpressionConstant>(-1.0));
-                    T = simplify(T);
+                    auto product = std::make_shared<ExpressionProduct>(
+                        std::dynamic_pointer_cast<ExpressionProduct>(T)->children);
+                    product->children.add(std::make_shared<ExpressionConstant>(-1.0));
+                    sum->children.add(simplify(product));
                 }
                 else
                 {
-                    T = std::make_shared<ExpressionNegate>(T);
+                    sum->children.add(std::make_shared<ExpressionNegate>(T));
                 }
             }
 
@@ -95,9 +223,8 @@ inline NonlinearExpressionPtr simplifyExpression(std::shared_ptr<ExpressionNegat
         }
         else if(expression->child->getType() == E_NonlinearExpressionTypes::Constant)
         {
-            std::dynamic_pointer_cast<ExpressionConstant>(expression->child)->constant *= -1;
-
-            return (expression->child);
+            return (std::make_shared<ExpressionConstant>(
+                -std::dynamic_pointer_cast<ExpressionConstant>(expression->child)->constant));
         }
         else if(expression->child->getType() == E_NonlinearExpressionTypes::Variable)
         {
@@ -112,11 +239,12 @@ inline NonlinearExpressionPtr simplifyExpression(std::shared_ptr<ExpressionNegat
         }
         else if(expression->child->getType() == E_NonlinearExpressionTypes::Product)
         {
-            auto product = std::dynamic_pointer_cast<ExpressionProduct>(expression->child);
+            auto product = std::make_shared<ExpressionProduct>(
+                std::dynamic_pointer_cast<ExpressionProduct>(expression->child)->children);
 
             product->children.add(std::make_shared<ExpressionConstant>(-1.0));
 
-            return (simplify(expression->child));
+            return (simplify(product));
         }
 
         return expression;
@@ -149,9 +277,9 @@ inline NonlinearExpressionPtr simplifyExpression(std::shared_ptr<ExpressionInver
             if(child->secondChild->getType() == E_NonlinearExpressionTypes::Constant)
             {
                 auto power = std::dynamic_pointer_cast<ExpressionConstant>(child->secondChild);
-                power->constant *= -1.0;
 
-                return child;
+                return (std::make_shared<ExpressionPower>(
+                    child->firstChild, std::make_shared<ExpressionConstant>(-power->constant)));
             }
         }
     }
@@ -184,9 +312,8 @@ inline NonlinearExpressionPtr simplifyExpression(std::shared_ptr<ExpressionSquar
     }
     else if(child->getType() == E_NonlinearExpressionTypes::Constant)
     {
-        std::dynamic_pointer_cast<ExpressionConstant>(child)->constant
-            *= std::dynamic_pointer_cast<ExpressionConstant>(child)->constant;
-        return (child);
+        double constant = std::dynamic_pointer_cast<ExpressionConstant>(child)->constant;
+        return (std::make_shared<ExpressionConstant>(constant * constant));
     }
 
     expression->child = child;
@@ -364,9 +491,10 @@ inline NonlinearExpressionPtr simplifyExpression(std::shared_ptr<ExpressionDivid
             && child->secondChild->getType() == E_NonlinearExpressionTypes::Constant)
         {
             auto power = std::dynamic_pointer_cast<ExpressionConstant>(child->secondChild);
-            power->constant *= -1.0;
 
-            return (std::make_shared<ExpressionProduct>(firstChild, secondChild));
+            return (std::make_shared<ExpressionProduct>(firstChild,
+                std::make_shared<ExpressionPower>(
+                    child->firstChild, std::make_shared<ExpressionConstant>(-power->constant))));
         }
     }
     else if(secondChild->getType() == E_NonlinearExpressionTypes::Square)
@@ -677,7 +805,7 @@ inline NonlinearExpressionPtr simplifyExpression(std::shared_ptr<ExpressionProdu
     return (product);
 }
 
-inline NonlinearExpressionPtr simplify(NonlinearExpressionPtr expression)
+inline NonlinearExpressionPtr simplifyNode(NonlinearExpressionPtr expression)
 {
     switch(expression->getType())
     {
@@ -724,6 +852,22 @@ inline NonlinearExpressionPtr simplify(NonlinearExpressionPtr expression)
     return (expression);
 }
 
+inline NonlinearExpressionPtr simplify(NonlinearExpressionPtr expression)
+{
+    auto cache = SimplificationCache::current();
+
+    if(cache == nullptr)
+        return (simplifyNode(expression));
+
+    if(auto result = cache->results.find(expression.get()); result != cache->results.end())
+        return (result->second.second);
+
+    auto simplifiedExpression = simplifyNode(expression);
+    cache->results.emplace(expression.get(), std::make_pair(expression, simplifiedExpression));
+
+    return (simplifiedExpression);
+}
+
 inline std::optional<double> convertProductToConstant(std::shared_ptr<ExpressionProduct> product)
 {
     std::optional<double> resultingConstant;
@@ -1396,14 +1540,15 @@ inline std::tuple<LinearTerms, QuadraticTerms, MonomialTerms, SignomialTerms, No
                 children.push_back(tmpNonlinearExpression);
         }
 
+        // The sum is not modified in place since it can be shared with other expressions, e.g., as an AMPL defined
+        // variable
         if(children.size() == 0)
             // The nonlinear expression has been fully extracted
             nonlinearExpression = std::make_shared<ExpressionConstant>(0.0);
+        else if(children.size() == 1)
+            nonlinearExpression = children[0];
         else
-        {
-            std::dynamic_pointer_cast<ExpressionSum>(expression)->children = children;
-            nonlinearExpression = expression;
-        }
+            nonlinearExpression = std::make_shared<ExpressionSum>(children);
     }
     else
     {
@@ -0,0 +1,552 @@
+/**
+   The Supporting Hyperplane Optimization Toolkit (SHOT).
+
+   @author Andreas Lundell, Åbo Akademi University
+
+   @section LICENSE
+   This software is licensed under the Eclipse Public License 2.0.
+   Please see the README and LICENSE files for more information.
+*/
+
+#include "Symmetry.h"
+
+#include "../Output.h"
+#include "../Settings.h"
+
+#include "NonlinearExpressions.h"
+#include "ObjectiveFunction.h"
+#include "Presolve.h"
+
+#include <algorithm>
+#include <numeric>
+
+namespace SHOT
+{
+
+// The maximum number of nodes individualized when searching for an automorphism between two variables
+static const int maxSearchDepth = 50;
+
+// The maximum number of variables in other orbits of the same cell tried as the preimage of a variable
+static const int maxPreimageCandidates = 3;
+
+Symmetry::Symmetry(EnvironmentPtr envPtr, ProblemPtr problem) : env(envPtr), problem(problem) { }
+
+bool Symmetry::detect()
+{
+    timeLimit = env->settings->getSetting<double>("Symmetry.TimeLimit", "Model");
+    timer.restart();
+
+    createGraph();
+
+    int maxGraphSize = env->settings->getSetting<int>("Symmetry.MaxGraphSize", "Model");
+
+    if((int)adjacency.size() > maxGraphSize)
+    {
+        env->output->outputDebug(
+            "  Symmetry detection skipped since the graph has {} nodes (limit {}).", adjacency.size(), maxGraphSize);
+        return (false);
+    }
+
+    VectorInteger colors = nodeColors;
+    int numberOfColors = refine(colors);
+
+    orbitRoots.resize(numberOfVariables);
+    std::iota(orbitRoots.begin(), orbitRoots.end(), 0);
+
+    std::vector<VectorInteger> cells(numberOfColors);
+
+    for(int i = 0; i < numberOfVariables; i++)
+        cells[colors[i]].push_back(i);
+
+    for(auto& cell : cells)
+    {
+        for(size_t k = 1; k < cell.size(); k++)
+        {
+            if(isTimeLimitReached())
+                break;
+
+            int to = cell[k];
+
+            // Already in the orbit of a previous variable
+            if(findOrbitRoot(to) != to)
+                continue;
+
+            int numberOfCandidates = 0;
+
+            // The equitable partition can put variables in different orbits in the same cell, so the preimage is tried
+            // from a few of the orbits of the previous variables
+            for(size_t j = 0; j < k && numberOfCandidates < maxPreimageCandidates; j++)
+            {
+                int from = cell[j];
+
+                if(findOrbitRoot(from) != from)
+                    continue;
+
+                numberOfCandidates++;
+
+                VectorInteger permutation;
+
+                if(!findAutomorphism(colors, numberOfColors, from, to, permutation))
+                    continue;
+
+                permutation.resize(numberOfVariables);
+
+                for(int i = 0; i < numberOfVariables; i++)
+                {
+                    int firstRoot = findOrbitRoot(i);
+                    int secondRoot = findOrbitRoot(permutation[i]);
+
+                    // The smallest variable index is kept as the root
+                    if(firstRoot < secondRoot)
+                        orbitRoots[secondRoot] = firstRoot;
+                    else if(secondRoot < firstRoot)
+                        orbitRoots[firstRoot] = secondRoot;
+                }
+
+                generators.push_back(permutation);
+                break;
+            }
+        }
+    }
+
+    if(isTimeLimitReached())
+        env->output->outputDebug("  Symmetry detection stopped at the time limit {} s.", timeLimit);
+
+    env->output->outputDebug("  Symmetry detection found {} generators in a graph with {} nodes.", generators.size(),
+        adjacency.size());
+
+    return (true);
+}
+
+std::vector<VectorInteger> Symmetry::getOrbits()
+{
+    std::map<int, VectorInteger> orbitsByRoot;
+
+    for(int i = 0; i < (int)orbitRoots.size(); i++)
+        orbitsByRoot[findOrbitRoot(i)].push_back(i);
+
+    std::vector<VectorInteger> orbits;
+
+    for(auto& [root, orbit] : orbitsByRoot)
+    {
+        if(orbit.size() > 1)
+            orbits.push_back(orbit);
+    }
+
+    return (orbits);
+}
+
+std::vector<std::pair<int, int>> Symmetry::getSymmetryBreakingPairs()
+{
+    // The generators moving the same variables are grouped together. The group is the direct product of the groups
+    // generated by each set, so one orbit from each set can be used.
+    VectorInteger componentRoots(numberOfVariables);
+    std::iota(componentRoots.begin(), componentRoots.end(), 0);
+
+    auto findComponentRoot = [&](int variable)
+    {
+        while(componentRoots[variable] != variable)
+            variable = componentRoots[variable] = componentRoots[componentRoots[variable]];
+
+        return (variable);
+    };
+
+    for(auto& G : generators)
+    {
+        int firstMoved = -1;
+
+        for(int i = 0; i < numberOfVariables; i++)
+        {
+            if(G[i] == i)
+                continue;
+
+            if(firstMoved == -1)
+                firstMoved = i;
+            else
+                componentRoots[findComponentRoot(i)] = findComponentRoot(firstMoved);
+        }
+    }
+
+    auto getScore = [&](const VectorInteger& orbit)
+    {
+        auto type = problem->allVariables[orbit[0]]->properties.type;
+        bool isDiscrete = (type == E_VariableType::Binary || type == E_VariableType::Integer);
+
+        return (std::make_pair(isDiscrete, orbit.size()));
+    };
+
+    std::map<int, VectorInteger> selectedOrbits;
+
+    for(auto& O : getOrbits())
+    {
+        // Auxiliary variables are not used, since they are not the same in the original problem
+        if(std::any_of(O.begin(), O.end(),
+               [&](int index) { return (problem->allVariables[index]->properties.isAuxiliary); }))
+            continue;
+
+        auto& selected = selectedOrbits[findComponentRoot(O[0])];
+
+        if(selected.empty() || getScore(O) > getScore(selected))
+            selected = O;
+    }
+
+    std::vector<std::pair<int, int>> pairs;
+
+    for(auto& [root, orbit] : selectedOrbits)
+    {
+        for(size_t i = 1; i < orbit.size(); i++)
+            pairs.emplace_back(orbit[0], orbit[i]);
+    }
+
+    return (pairs);
+}
+
+int Symmetry::addNode(E_NodeType type, int subtype, double firstValue, double secondValue)
+{
+    auto key = std::make_tuple((int)type, subtype, firstValue, secondValue);
+    auto color = nodeColorKeys.emplace(key, (int)nodeColorKeys.size()).first->second;
+
+    nodeColors.push_back(color);
+    adjacency.emplace_back();
+
+    return (nodeColors.size() - 1);
+}
+
+void Symmetry::addEdge(int firstNode, int secondNode, int edgeType, double edgeValue)
+{
+    auto key = std::make_pair(edgeType, edgeValue);
+    auto color = edgeColorKeys.emplace(key, (int)edgeColorKeys.size()).first->second;
+
+    adjacency[firstNode].emplace_back(secondNode, color);
+    adjacency[secondNode].emplace_back(firstNode, color);
+}
+
+void Symmetry::addTerms(int node, const LinearTerms& linearTerms, const QuadraticTerms& quadraticTerms,
+    const MonomialTerms& monomialTerms, const SignomialTerms& signomialTerms, const NonlinearExpressionPtr& expression)
+{
+    for(auto& T : linearTerms)
+        addEdge(node, T->variable->index, 0, T->coefficient);
+
+    for(auto& T : quadraticTerms)
+    {
+        int termNode = addNode(E_NodeType::QuadraticTerm, 0, T->coefficient);
+        addEdge(node, termNode);
+        addEdge(termNode, T->firstVariable->index);
+        addEdge(termNode, T->secondVariable->index);
+    }
+
+    for(auto& T : monomialTerms)
+    {
+        int termNode = addNode(E_NodeType::MonomialTerm, 0, T->coefficient);
+        addEdge(node, termNode);
+
+        for(auto& V : T->variables)
+            addEdge(termNode, V->index);
+    }
+
+    for(auto& T : signomialTerms)
+    {
+        int termNode = addNode(E_NodeType::SignomialTerm, 0, T->coefficient);
+        addEdge(node, termNode);
+
+        for(auto& E : T->elements)
+            addEdge(termNode, E->variable->index, 1, E->power);
+    }
+
+    if(expression)
+        addEdge(node, addExpression(expression), 2);
+}
+
+int Symmetry::addExpression(const NonlinearExpressionPtr& expression)
+{
+    auto type = expression->getType();
+
+    if(type == E_NonlinearExpressionTypes::Variable)
+        return (std::static_pointer_cast<ExpressionVariable>(expression)->variable->index);
+
+    if(type == E_NonlinearExpressionTypes::Constant)
+    {
+        return (addNode(
+            E_NodeType::Expression, (int)type, std::static_pointer_cast<ExpressionConstant>(expression)->constant));
+    }
+
+    int node = addNode(E_NodeType::Expression, (int)type);
+
+    // The order of the children only matters for the binary operations
+    if(auto binary = std::dynamic_pointer_cast<ExpressionBinary>(expression))
+    {
+        addEdge(node, addExpression(binary->firstChild), 2, 1.0);
+        addEdge(node, addExpression(binary->secondChild), 2, 2.0);
+    }
+    else if(auto unary = std::dynamic_pointer_cast<ExpressionUnary>(expression))
+    {
+        addEdge(node, addExpression(unary->child), 2);
+    }
+    else if(auto general = std::dynamic_pointer_cast<ExpressionGeneral>(expression))
+    {
+        for(auto& C : general->children)
+            addEdge(node, addExpression(C), 2);
+    }
+
+    return (node);
+}
+
+void Symmetry::createGraph()
+{
+    numberOfVariables = problem->allVariables.size();
+
+    // The variables removed in presolve are calculated from the other variables in postsolve, and are not in any
+    // constraint. Each gets a colour of its own so that it is not moved by any permutation.
+    std::vector<bool> isRemoved(numberOfVariables, false);
+
+    if(problem->presolve)
+    {
+        for(auto I : problem->presolve->getRemovedVariableIndexes())
+            isRemoved[I] = true;
+    }
+
+    // The variable nodes are the first ones, so that the node index is the same as the variable index
+    for(auto& V : problem->allVariables)
+    {
+        if(isRemoved[V->index])
+        {
+            addNode(E_NodeType::RemovedVariable, V->index);
+            continue;
+        }
+
+        addNode(E_NodeType::Variable, 2 * (int)V->properties.type + (V->properties.isAuxiliary ? 1 : 0),
+            V->lowerBound, V->upperBound);
+    }
+
+    auto objective = problem->objectiveFunction;
+    int objectiveNode = addNode(E_NodeType::Objective, (int)objective->direction, objective->constant);
+
+    if(auto nonlinearObjective = std::dynamic_pointer_cast<NonlinearObjectiveFunction>(objective))
+    {
+        addTerms(objectiveNode, nonlinearObjective->linearTerms, nonlinearObjective->quadraticTerms,
+            nonlinearObjective->monomialTerms, nonlinearObjective->signomialTerms,
+            nonlinearObjective->nonlinearExpression);
+    }
+    else if(auto quadraticObjective = std::dynamic_pointer_cast<QuadraticObjectiveFunction>(objective))
+    {
+        addTerms(objectiveNode, quadraticObjective->linearTerms, quadraticObjective->quadraticTerms, MonomialTerms(),
+            SignomialTerms(), nullptr);
+    }
+    else if(auto linearObjective = std::dynamic_pointer_cast<LinearObjectiveFunction>(objective))
+    {
+        addTerms(objectiveNode, linearObjective->linearTerms, QuadraticTerms(), MonomialTerms(), SignomialTerms(),
+            nullptr);
+    }
+
+    for(auto& C : problem->numericConstraints)
+    {
+        int constraintNode
+            = addNode(E_NodeType::Constraint, 0, C->valueLHS - C->constant, C->valueRHS - C->constant);
+
+        if(auto nonlinearConstraint = std::dynamic_pointer_cast<NonlinearConstraint>(C))
+        {
+            addTerms(constraintNode, nonlinearConstraint->linearTerms, nonlinearConstraint->quadraticTerms,
+                nonlinearConstraint->monomialTerms, nonlinearConstraint->signomialTerms,
+                nonlinearConstraint->nonlinearExpression);
+        }
+        else if(auto quadraticConstraint = std::dynamic_pointer_cast<QuadraticConstraint>(C))
+        {
+            addTerms(constraintNode, quadraticConstraint->linearTerms, quadraticConstraint->quadraticTerms,
+                MonomialTerms(), SignomialTerms(), nullptr);
+        }
+        else if(auto linearConstraint = std::dynamic_pointer_cast<LinearConstraint>(C))
+        {
+            addTerms(constraintNode, linearConstraint->linearTerms, QuadraticTerms(), MonomialTerms(),
+                SignomialTerms(), nullptr);
+        }
+    }
+
+    for(auto& A : adjacency)
+        std::sort(A.begin(), A.end());
+}
+
+int Symmetry::refine(VectorInteger& colors)
+{
+    int numberOfNodes = colors.size();
+    int numberOfColors = *std::max_element(colors.begin(), colors.end()) + 1;
+
+    std::vector<std::vector<std::pair<int, int>>> signatures(numberOfNodes);
+    VectorInteger order(numberOfNodes);
+    VectorInteger newColors(numberOfNodes);
+    VectorInteger cellSizes;
+
+    while(true)
+    {
+        cellSizes.assign(numberOfColors, 0);
+
+        for(auto C : colors)
+            cellSizes[C]++;
+
+        // The signature of a node is the multiset of the edge colours and the colours of its neighbours. The cells with
+        // one node cannot be split, so their signatures are not needed.
+        for(int i = 0; i < numberOfNodes; i++)
+        {
+            signatures[i].clear();
+
+            if(cellSizes[colors[i]] == 1)
+                continue;
+
+            for(auto& [node, edgeColor] : adjacency[i])
+                signatures[i].emplace_back(edgeColor, colors[node]);
+
+            std::sort(signatures[i].begin(), signatures[i].end());
+        }
+
+        std::iota(order.begin(), order.end(), 0);
+
+        std::sort(order.begin(), order.end(),
+            [&](int first, int second)
+            {
+                if(colors[first] != colors[second])
+                    return (colors[first] < colors[second]);
+
+                return (signatures[first] < signatures[second]);
+            });
+
+        int color = 0;
+
+        for(int i = 0; i < numberOfNodes; i++)
+        {
+            if(i > 0
+                && (colors[order[i]] != colors[order[i - 1]] || signatures[order[i]] != signatures[order[i - 1]]))
+                color++;
+
+            newColors[order[i]] = color;
+        }
+
+        colors.swap(newColors);
+
+        bool isEquitable = (color + 1 == numberOfColors);
+        numberOfColors = color + 1;
+
+        if(isEquitable || isTimeLimitReached())
+            break;
+    }
+
+    return (numberOfColors);
+}
+
+bool Symmetry::findAutomorphism(
+    const VectorInteger& colors, int numberOfColors, int from, int to, VectorInteger& permutation)
+{
+    int numberOfNodes = colors.size();
+
+    VectorInteger firstColors = colors;
+    VectorInteger secondColors = colors;
+    int firstIndividualized = from;
+    int secondIndividualized = to;
+
+    for(int depth = 0; depth < maxSearchDepth; depth++)
+    {
+        firstColors[firstIndividualized] = numberOfColors;
+        secondColors[secondIndividualized] = numberOfColors;
+
+        numberOfColors = refine(firstColors);
+
+        if(refine(secondColors) != numberOfColors || isTimeLimitReached())
+            return (false);
+
+        std::vector<VectorInteger> firstCells(numberOfColors);
+        std::vector<VectorInteger> secondCells(numberOfColors);
+
+        for(int i = 0; i < numberOfNodes; i++)
+        {
+            firstCells[firstColors[i]].push_back(i);
+            secondCells[secondColors[i]].push_back(i);
+        }
+
+        // The nodes in the same cell in both partitions are mapped to themselves and the others in order
+        permutation.assign(numberOfNodes, -1);
+        firstIndividualized = -1;
+        int fixedNode = -1;
+
+        for(int c = 0; c < numberOfColors; c++)
+        {
+            auto& firstCell = firstCells[c];
+            auto& secondCell = secondCells[c];
+
+            if(firstCell.size() != secondCell.size())
+                return (false);
+
+            VectorInteger common;
+            VectorInteger onlyFirst;
+            VectorInteger onlySecond;
+
+            std::set_intersection(firstCell.begin(), firstCell.end(), secondCell.begin(), secondCell.end(),
+                std::back_inserter(common));
+            std::set_difference(firstCell.begin(), firstCell.end(), secondCell.begin(), secondCell.end(),
+                std::back_inserter(onlyFirst));
+            std::set_difference(secondCell.begin(), secondCell.end(), firstCell.begin(), firstCell.end(),
+                std::back_inserter(onlySecond));
+
+            for(auto N : common)
+                permutation[N] = N;
+
+            for(size_t i = 0; i < onlyFirst.size(); i++)
+                permutation[onlyFirst[i]] = onlySecond[i];
+
+            if(firstCell.size() > 1 && firstIndividualized == -1 && onlyFirst.size() > 0)
+            {
+                firstIndividualized = onlyFirst[0];
+                secondIndividualized = onlySecond[0];
+            }
+            else if(firstCell.size() > 1 && fixedNode == -1)
+            {
+                fixedNode = firstCell[0];
+            }
+        }
+
+        if(isAutomorphism(permutation))
+            return (true);
+
+        // Continues with a cell where the partitions differ, or fixes a node if they only differ in singletons
+        if(firstIndividualized == -1)
+        {
+            if(fixedNode == -1)
+                return (false);
+
+            firstIndividualized = fixedNode;
+            secondIndividualized = fixedNode;
+        }
+    }
+
+    return (false);
+}
+
+bool Symmetry::isAutomorphism(const VectorInteger& permutation) const
+{
+    std::vector<std::pair<int, int>> mappedEdges;
+
+    for(size_t i = 0; i < permutation.size(); i++)
+    {
+        if(nodeColors[permutation[i]] != nodeColors[i])
+            return (false);
+
+        mappedEdges.clear();
+
+        for(auto& [node, edgeColor] : adjacency[i])
+            mappedEdges.emplace_back(permutation[node], edgeColor);
+
+        std::sort(mappedEdges.begin(), mappedEdges.end());
+
+        if(mappedEdges != adjacency[permutation[i]])
+            return (false);
+    }
+
+    return (true);
+}
+
+int Symmetry::findOrbitRoot(int variable)
+{
+    while(orbitRoots[variable] != variable)
+        variable = orbitRoots[variable] = orbitRoots[orbitRoots[variable]];
+
+    return (variable);
+}
+
+} // namespace SHOT
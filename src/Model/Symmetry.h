@@ -0,0 +1,113 @@
+/**
+   The Supporting Hyperplane Optimization Toolkit (SHOT).
+
+   @author Andreas Lundell, Åbo Akademi University
+
+   @section LICENSE
+   This software is licensed under the Eclipse Public License 2.0.
+   Please see the README and LICENSE files for more information.
+*/
+
+#pragma once
+
+#include "../Environment.h"
+#include "../Structs.h"
+#include "../Timer.h"
+
+#include "Problem.h"
+
+#include <map>
+#include <tuple>
+#include <vector>
+
+namespace SHOT
+{
+
+// Finds permutations of the variables that map the problem onto itself, i.e., that keep the objective function and the
+// set of constraints the same. These are found as automorphisms of a coloured graph with nodes for the variables, the
+// constraints, the objective, the terms and the nodes in the expression trees. The coloured graph is refined to an
+// equitable partition, and for each pair of variables in the same cell, the two variables are individualized in two
+// copies of the partition which are then refined in parallel until the nodes with the same colour in both give an
+// automorphism. Only verified automorphisms are used as generators, so the search can miss symmetries but never finds
+// wrong ones.
+class Symmetry
+{
+public:
+    Symmetry(EnvironmentPtr envPtr, ProblemPtr problem);
+
+    // Returns false if the graph is larger than allowed in the settings. If the time limit is reached, the generators
+    // found so far are kept.
+    bool detect();
+
+    // Each generator maps the variable with index i to the one with index generator[i]
+    std::vector<VectorInteger> generators;
+
+    // The orbits of the group given by the generators with more than one variable, sorted by the variable indexes
+    std::vector<VectorInteger> getOrbits();
+
+    // Pairs of variable indexes (i, j) such that there is an optimal solution with x_i >= x_j. One orbit is selected
+    // for each set of generators that move the same variables, and i is the first variable in the orbit. Orbits of
+    // discrete variables are preferred.
+    std::vector<std::pair<int, int>> getSymmetryBreakingPairs();
+
+private:
+    EnvironmentPtr env;
+    ProblemPtr problem;
+
+    enum class E_NodeType
+    {
+        Variable,
+        RemovedVariable,
+        Objective,
+        Constraint,
+        QuadraticTerm,
+        MonomialTerm,
+        SignomialTerm,
+        Expression
+    };
+
+    int numberOfVariables = 0;
+
+    Timer timer = Timer("Symmetry");
+    double timeLimit = SHOT_DBL_MAX;
+
+    bool isTimeLimitReached() { return (timer.elapsed() > timeLimit); }
+
+    // The initial colours are given by the type and values of the nodes
+    VectorInteger nodeColors;
+    std::map<std::tuple<int, int, double, double>, int> nodeColorKeys;
+
+    // The edges are stored in both directions as pairs of the other node and the edge colour, sorted
+    std::vector<std::vector<std::pair<int, int>>> adjacency;
+    std::map<std::pair<int, double>, int> edgeColorKeys;
+
+    int addNode(E_NodeType type, int subtype = 0, double firstValue = 0.0, double secondValue = 0.0);
+    void addEdge(int firstNode, int secondNode, int edgeType = 0, double edgeValue = 0.0);
+
+    void addTerms(int node, const LinearTerms& linearTerms, const QuadraticTerms& quadraticTerms,
+        const MonomialTerms& monomialTerms, const SignomialTerms& signomialTerms,
+        const NonlinearExpressionPtr& expression);
+
+    int addExpression(const NonlinearExpressionPtr& expression);
+
+    void createGraph();
+
+    // Refines the colours until the partition is equitable, the colours are numbered by their signatures so that
+    // isomorphic partitions get the same colours. Returns the number of colours. The partition may not be equitable if
+    // the time limit is reached.
+    int refine(VectorInteger& colors);
+
+    // Finds an automorphism mapping the variable node from to the variable node to
+    bool findAutomorphism(
+        const VectorInteger& colors, int numberOfColors, int from, int to, VectorInteger& permutation);
+
+    bool isAutomorphism(const VectorInteger& permutation) const;
+
+    // Union-find on the variables
+    VectorInteger orbitRoots;
+    int findOrbitRoot(int variable);
+};
+
+using SymmetryPtr = std::shared_ptr<Symmetry>;
+
+} // namespace SHOT
@@ -12,12 +12,33 @@
 #include "Problem.h"
 #include "../Settings.h"
 
+#include <numeric>
+
 #include <Eigen/Sparse>
+#include <Eigen/SparseCholesky>
 #include <Eigen/Eigenvalues>
 #include "Eigen/src/SparseCore/SparseUtil.h"
 
+
 namespace SHOT
 {
+// Adds the value to the upper triangular element of the Hessian corresponding to the two variables
+inline void addToHessian(SparseVariableMatrix& hessian, const VariablePtr& firstVariable,
+    const VariablePtr& secondVariable, double value)
+{
+    auto variablePair = (firstVariable->index <= secondVariable->index)
+        ? std::make_pair(firstVariable, secondVariable)
+        : std::make_pair(secondVariable, firstVariable);
+
+    auto element = hessian.emplace(variablePair, value);
+
+    if(!element.second)
+    {
+        // Element already exists for the variable pair
+        element.first->second += value;
+    }
+}
+
 Interval Term::getBounds()
 {
     IntervalVector variableBounds;
@@ -32,6 +53,105 @@ Interval Term::getBounds()
     return (interval);
 }
 
+// Determines the convexity of a block of the quadratic form by first checking whether the block (shifted by the
+// tolerance) is positive or negative definite with a sparse LDL^T factorization, which gives the inertia of the matrix.
+// If the factorization is inconclusive, e.g., due to zero pivots in a semidefinite block, the eigenvalues are
+// calculated instead if the block is small enough.
+E_Convexity getQuadraticBlockConvexity(int blockSize, const std::vector<Eigen::Triplet<double>>& elements,
+    double eigenvalueTolerance, int maxBlockSizeEigenvalues)
+{
+    if(blockSize == 1)
+    {
+        double value = 0.0;
+
+        for(auto& E : elements)
+            value += E.value();
+
+        if(value > eigenvalueTolerance)
+            return (E_Convexity::Convex);
+        else if(value < -eigenvalueTolerance)
+            return (E_Convexity::Concave);
+
+        return (E_Convexity::Linear);
+    }
+
+    // Returns 1 if sign * matrix + tolerance * I is positive definite, -1 if it is indefinite and 0 if the
+    // factorization is inconclusive
+    auto checkDefiniteness = [&](double sign) {
+        std::vector<Eigen::Triplet<double>> shiftedElements;
+        shiftedElements.reserve(elements.size() + blockSize);
+
+        for(auto& E : elements)
+            shiftedElements.emplace_back(E.row(), E.col(), sign * E.value());
+
+        for(int i = 0; i < blockSize; i++)
+            shiftedElements.emplace_back(i, i, eigenvalueTolerance);
+
+        Eigen::SparseMatrix<double> matrix(blockSize, blockSize);
+        matrix.setFromTriplets(shiftedElements.begin(), shiftedElements.end());
+
+        Eigen::SimplicialLDLT<Eigen::SparseMatrix<double>, Eigen::Lower> factorization(matrix);
+
+        if(factorization.info() != Eigen::Success)
+            return (0);
+
+        auto pivots = factorization.vectorD();
+
+        if((pivots.array() > 0.0).all())
+            return (1);
+
+        if((pivots.array() != 0.0).all())
+            return (-1);
+
+        return (0);
+    };
+
+    int convexStatus = checkDefiniteness(1.0);
+
+    if(convexStatus == 1)
+        return (E_Convexity::Convex);
+
+    int concaveStatus = checkDefiniteness(-1.0);
+
+    if(concaveStatus == 1)
+        return (E_Convexity::Concave);
+
+    if(convexStatus == -1 && concaveStatus == -1)
+        return (E_Convexity::Nonconvex);
+
+    if(blockSize > maxBlockSizeEigenvalues)
+        return (E_Convexity::Unknown);
+
+    Eigen::SparseMatrix<double> matrix(blockSize, blockSize);
+    matrix.setFromTriplets(elements.begin(), elements.end());
+
+    Eigen::SelfAdjointEigenSolver<Eigen::MatrixXd> eigenSolver(
+        Eigen::MatrixXd(matrix), Eigen::DecompositionOptions::EigenvaluesOnly);
+
+    if(eigenSolver.info() != Eigen::Success)
+        return (E_Convexity::Unknown);
+
+    bool areAllPositiveOrZero = true;
+    bool areAllNegativeOrZero = true;
+
+    for(int i = 0; i < blockSize; i++)
+    {
+        double eigenvalue = eigenSolver.eigenvalues()[i];
+
+        areAllNegativeOrZero = areAllNegativeOrZero && eigenvalue <= eigenvalueTolerance;
+        areAllPositiveOrZero = areAllPositiveOrZero && eigenvalue >= -eigenvalueTolerance;
+    }
+
+    if(areAllPositiveOrZero && areAllNegativeOrZero)
+        return (E_Convexity::Linear);
+    else if(areAllPositiveOrZero)
+        return (E_Convexity::Convex);
+    else if(areAllNegativeOrZero)
+        return (E_Convexity::Concave);
+
+    return (E_Convexity::Nonconvex);
+}
+
 void QuadraticTerms::updateConvexity()
 {
     if(size() == 0)
@@ -40,83 +160,49 @@ void QuadraticTerms::updateConvexity()
         return;
     }
 
-    std::vector<Eigen::Triplet<double>> elements;
-    elements.reserve(2 * size());
-
     std::map<VariablePtr, int> variableMap;
+    std::vector<VariablePtr> variables;
+
+    auto getVariableIndex = [&](const VariablePtr& variable) {
+        auto element = variableMap.emplace(variable, (int)variables.size());
+
+        if(element.second)
+            variables.push_back(variable);
+
+        return (element.first->second);
+    };
+
+    // The elements of the matrix, with variables indexed in the order they are found
+    std::vector<Eigen::Triplet<double>> elements;
+    elements.reserve(size());
 
     bool allSquares = true;
     bool allPositive = true;
     bool allNegative = true;
     bool allBilinear = true;
 
-    int variableCounter = 0;
-
     for(auto& T : (*this))
     {
         if(T->firstVariable == T->secondVariable)
         {
-            int currentVariableIndex;
-            auto element = variableMap.emplace(T->firstVariable, variableCounter);
-
-            if(element.second)
-            {
-                // Variable not already indexed found
-                currentVariableIndex = variableCounter;
-                variableCounter++;
-            }
-            else
-            {
-                currentVariableIndex = element.first->second;
-            }
+            int variableIndex = getVariableIndex(T->firstVariable);
 
             allPositive = allPositive && T->coefficient >= 0;
             allNegative = allNegative && T->coefficient <= 0;
             allBilinear = false;
 
-            elements.emplace_back(currentVariableIndex, currentVariableIndex, T->coefficient);
+            elements.emplace_back(variableIndex, variableIndex, T->coefficient);
         }
         else
         {
-            int currentFirstVariableIndex;
-            auto element = variableMap.emplace(T->firstVariable, variableCounter);
-
-            if(element.second)
-            {
-                // Variable not already indexed found, but inserted into map
-                currentFirstVariableIndex = variableCounter;
-                variableCounter++;
-            }
-            else
-            {
-                currentFirstVariableIndex = element.first->second;
-            }
-
-            int currentSecondVariableIndex;
-            element = variableMap.emplace(T->secondVariable, variableCounter);
-
-            if(element.second)
-            {
-                // Variable not already indexed found, but inserted into map
-                currentSecondVariableIndex = variableCounter;
-                variableCounter++;
-            }
-            else
-            {
-                currentSecondVariableIndex = element.first->second;
-            }
+            int firstVariableIndex = getVariableIndex(T->firstVariable);
+            int secondVariableIndex = getVariableIndex(T->secondVariable);
 
             allSquares = false;
 
             // Matrix is self adjoint, so only need lower triangular elements
-            if(T->firstVariable->index > T->secondVariable->index)
-            {
-                elements.emplace_back(currentFirstVariableIndex, currentSecondVariableIndex, 0.5 * T->coefficient);
-            }
-            else
-            {
-                elements.emplace_back(currentSecondVariableIndex, currentFirstVariableIndex, 0.5 * T->coefficient);
-            }
+            elements.emplace_back(std::max(firstVariableIndex, secondVariableIndex),
+                std::min(firstVariableIndex, secondVariableIndex), 0.5 * T->coefficient);
         }
     }
 
@@ -138,24 +224,68 @@ void QuadraticTerms::updateConvexity()
         return;
     }
 
-    int numberOfVariables = variableMap.size();
+    int numberOfVariables = variables.size();
 
-    Eigen::SparseMatrix<double> matrix(numberOfVariables, numberOfVariables);
-    matrix.setFromTriplets(elements.begin(), elements.end());
+    // Splits the matrix into its block-diagonal structure, i.e., the connected components of the graph where the
+    // variables are nodes and the bilinear terms edges
+    std::vector<int> parents(numberOfVariables);
+    std::iota(parents.begin(), parents.end(), 0);
 
-    Eigen::SelfAdjointEigenSolver<Eigen::SparseMatrix<double>> eigenSolver(
-        matrix, Eigen::DecompositionOptions::EigenvaluesOnly);
+    auto findRoot = [&](int variableIndex) {
+        while(parents[variableIndex] != variableIndex)
+        {
+            parents[variableIndex] = parents[parents[variableIndex]];
+            variableIndex = parents[variableIndex];
+        }
 
-    if(eigenSolver.info() != Eigen::Success)
+        return (variableIndex);
+    };
+
+    for(auto& E : elements)
     {
-        convexity = E_Convexity::Unknown;
-        return;
+        if(E.row() != E.col())
+            parents[findRoot(E.row())] = findRoot(E.col());
     }
 
-    bool areAllPositiveOrZero = true;
-    bool areAllNegativeOrZero = true;
+    std::vector<int> rootBlockIndices(numberOfVariables, -1);
+    std::vector<int> blockIndices(numberOfVariables);
+    std::vector<int> indicesInBlock(numberOfVariables);
+    std::vector<int> blockSizes;
 
-    double eigenvalueTolerance = 0.0;
+    // The blocks are identified by the variables and coefficients in them, since the blocks not affected by added terms
+    // need not be checked again
+    std::vector<BlockConvexityKey> blockKeys;
+
+    for(int i = 0; i < numberOfVariables; i++)
+    {
+        int root = findRoot(i);
+
+        if(rootBlockIndices[root] == -1)
+        {
+            rootBlockIndices[root] = blockSizes.size();
+            blockSizes.push_back(0);
+            blockKeys.emplace_back();
+        }
+
+        blockIndices[i] = rootBlockIndices[root];
+        indicesInBlock[i] = blockSizes[blockIndices[i]]++;
+        std::get<1>(blockKeys[blockIndices[i]]).push_back(variables[i]->index);
+    }
+
+    std::vector<std::vector<Eigen::Triplet<double>>> blockElements(blockSizes.size());
+
+    for(auto& E : elements)
+    {
+        int row = indicesInBlock[E.row()];
+        int column = indicesInBlock[E.col()];
+        int block = blockIndices[E.row()];
+
+        blockElements[block].emplace_back(std::max(row, column), std::min(row, column), E.value());
+        std::get<2>(blockKeys[block]).emplace_back(std::max(row, column), std::min(row, column), E.value());
+    }
+
+    double eigenvalueTolerance = 1e-5;
+    int maxBlockSizeEigenvalues = 1000;
 
     if(auto sharedOwnerProblem = ownerProblem.lock())
     {
@@ -163,24 +293,72 @@ void QuadraticTerms::updateConvexity()
         {
             eigenvalueTolerance = sharedOwnerProblem->env->settings->getSetting<double>(
                 "Convexity.Quadratics.EigenValueTolerance", "Model");
+
+            maxBlockSizeEigenvalues = sharedOwnerProblem->env->settings->getSetting<int>(
+                "Convexity.Quadratics.MaxBlockSizeEigenValues", "Model");
+        }
+    }
+    else
+    {
+        eigenvalueTolerance = 0.0;
+    }
+
+    bool areAllBlocksConvex = true;
+    bool areAllBlocksConcave = true;
+    bool isAnyBlockUnknown = false;
+
+    // Only the blocks of the current terms are kept in the cache, so its size is bounded by the number of blocks
+    std::map<BlockConvexityKey, E_Convexity> updatedBlockConvexityCache;
+
+    for(size_t i = 0; i < blockSizes.size(); i++)
+    {
+        auto& blockKey = blockKeys[i];
+        std::get<0>(blockKey) = eigenvalueTolerance;
+
+        E_Convexity blockConvexity;
+
+        if(auto cachedConvexity = blockConvexityCache.find(blockKey); cachedConvexity != blockConvexityCache.end())
+        {
+            blockConvexity = cachedConvexity->second;
         }
         else
         {
-            eigenvalueTolerance = 1e-5;
+            blockConvexity = getQuadraticBlockConvexity(
+                blockSizes[i], blockElements[i], eigenvalueTolerance, maxBlockSizeEigenvalues);
         }
-    }
 
-    for(int i = 0; i < numberOfVariables; i++)
-    {
-        double eigenvalue = eigenSolver.eigenvalues().col(0)[i];
+        updatedBlockConvexityCache.emplace(std::move(blockKey), blockConvexity);
 
-        areAllNegativeOrZero = areAllNegativeOrZero && eigenvalue <= eigenvalueTolerance;
-        areAllPositiveOrZero = areAllPositiveOrZero && eigenvalue >= -eigenvalueTolerance;
+        switch(blockConvexity)
+        {
+        case E_Convexity::Convex:
+            areAllBlocksConcave = false;
+            break;
+        case E_Convexity::Concave:
+            areAllBlocksConvex = false;
+            break;
+        case E_Convexity::Linear:
+            break;
+        case E_Convexity::Unknown:
+            isAnyBlockUnknown = true;
+            break;
+        default:
+            areAllBlocksConvex = false;
+            areAllBlocksConcave = false;
+            break;
+        }
+
+        if(isAnyBlockUnknown || (!areAllBlocksConvex && !areAllBlocksConcave))
+            break;
     }
 
-    if(areAllPositiveOrZero)
+    blockConvexityCache = std::move(updatedBlockConvexityCache);
+
+    if(isAnyBlockUnknown)
+        convexity = E_Convexity::Unknown;
+    else if(areAllBlocksConvex)
         convexity = E_Convexity::Convex;
-    else if(areAllNegativeOrZero)
+    else if(areAllBlocksConcave)
         convexity = E_Convexity::Concave;
     else
         convexity = E_Convexity::Nonconvex;
@@ -209,4 +387,313 @@ SignomialTerm::SignomialTerm(const SignomialTerm* term, ProblemPtr destinationPr
             std::make_shared<SignomialElement>(destinationProblem->getVariable(E->variable->index), E->power));
     }
 }
+
+void MonomialTerm::calculatePartialDerivatives(const VectorDouble& point, VectorDouble& partials) const
+{
+    size_t numberOfVariables = variables.size();
+    partials.resize(numberOfVariables);
+
+    if(numberOfVariables == 0)
+        return;
+
+    // The suffix products x_{i+1}*...*x_{k-1} are stored first
+    partials[numberOfVariables - 1] = 1.0;
+
+    for(size_t i = numberOfVariables - 1; i > 0; i--)
+        partials[i - 1] = partials[i] * variables[i]->calculate(point);
+
+    // Then they are multiplied with the prefix products c*x_0*...*x_{i-1}
+    double prefixProduct = coefficient;
+
+    for(size_t i = 0; i < numberOfVariables; i++)
+    {
+        partials[i] *= prefixProduct;
+        prefixProduct *= variables[i]->calculate(point);
+    }
+}
+
+void MonomialTerm::calculateHessian(
+    const VectorDouble& point, SparseVariableMatrix& hessian, VectorDouble& suffixProducts) const
+{
+    size_t numberOfVariables = variables.size();
+
+    if(numberOfVariables < 2)
+        return;
+
+    suffixProducts.resize(numberOfVariables);
+    suffixProducts[numberOfVariables - 1] = 1.0;
+
+    for(size_t i = numberOfVariables - 1; i > 0; i--)
+        suffixProducts[i - 1] = suffixProducts[i] * variables[i]->calculate(point);
+
+    double prefixProduct = coefficient;
+
+    for(size_t i = 0; i < numberOfVariables; i++)
+    {
+        // The product of all variables except the ones in positions i and j is prefix * between * suffix
+        double partialProduct = prefixProduct;
+
+        for(size_t j = i + 1; j < numberOfVariables; j++)
+        {
+            double value = partialProduct * suffixProducts[j];
+
+            // The same variable in two positions contributes twice to the diagonal element
+            if(variables[i] == variables[j])
+                value *= 2.0;
+
+            addToHessian(hessian, variables[i], variables[j], value);
+
+            partialProduct *= variables[j]->calculate(point);
+        }
+
+        prefixProduct *= variables[i]->calculate(point);
+    }
+}
+
+void MonomialTerms::calculateGradient(const VectorDouble& point, VectorDouble& gradient) const
+{
+    VectorDouble partials;
+
+    for(auto& T : (*this))
+    {
+        if(T->coefficient == 0.0)
+            continue;
+
+        T->calculatePartialDerivatives(point, partials);
+
+        for(size_t i = 0; i < partials.size(); i++)
+            gradient[T->variables[i]->index] += partials[i];
+    }
+}
+
+SparseVariableVector MonomialTerms::calculateGradient(const VectorDouble& point) const
+{
+    SparseVariableVector gradient;
+    VectorDouble partials;
+
+    for(auto& T : (*this))
+    {
+        if(T->coefficient == 0.0)
+            continue;
+
+        T->calculatePartialDerivatives(point, partials);
+
+        for(size_t i = 0; i < partials.size(); i++)
+            gradient.add(T->variables[i], partials[i]);
+    }
+
+    gradient.compress();
+    return gradient;
+}
+
+void MonomialTerms::calculateHessian(const VectorDouble& point, SparseVariableMatrix& hessian) const
+{
+    VectorDouble suffixProducts;
+
+    for(auto& T : (*this))
+    {
+        if(T->coefficient == 0.0)
+            continue;
+
+        T->calculateHessian(point, hessian, suffixProducts);
+    }
+}
+
+SparseVariableMatrix MonomialTerms::calculateHessian(const VectorDouble& point) const
+{
+    SparseVariableMatrix hessian;
+    calculateHessian(point, hessian);
+    return hessian;
+}
+
+void SignomialTerm::calculatePartialDerivatives(const VectorDouble& point, VectorDouble& partials) const
+{
+    size_t numberOfElements = elements.size();
+    partials.resize(numberOfElements);
+
+    if(numberOfElements == 0)
+        return;
+
+    bool allVariablesPositive = true;
+    double value = coefficient;
+
+    for(auto& E : elements)
+    {
+        if(E->variable->calculate(point) <= 0.0)
+        {
+            allVariablesPositive = false;
+            break;
+        }
+
+        value *= E->calculate(point);
+    }
+
+    if(allVariablesPositive)
+    {
+        // In log-space the partial derivative is value * power / x
+        for(size_t i = 0; i < numberOfElements; i++)
+            partials[i] = value * elements[i]->power / elements[i]->variable->calculate(point);
+
+        return;
+    }
+
+    // The suffix products of the element values are stored first
+    partials[numberOfElements - 1] = 1.0;
+
+    for(size_t i = numberOfElements - 1; i > 0; i--)
+        partials[i - 1] = partials[i] * elements[i]->calculate(point);
+
+    double prefixProduct = coefficient;
+
+    for(size_t i = 0; i < numberOfElements; i++)
+    {
+        partials[i] *= prefixProduct * elements[i]->calculateDerivative(point);
+        prefixProduct *= elements[i]->calculate(point);
+    }
+}
+
+void SignomialTerm::calculateHessian(
+    const VectorDouble& point, SparseVariableMatrix& hessian, VectorDouble& scratch) const
+{
+    size_t numberOfElements = elements.size();
+
+    if(numberOfElements == 0)
+        return;
+
+    bool allVariablesPositive = true;
+    double value = coefficient;
+
+    for(auto& E : elements)
+    {
+        if(E->variable->calculate(point) <= 0.0)
+        {
+            allVariablesPositive = false;
+            break;
+        }
+
+        value *= E->calculate(point);
+    }
+
+    if(allVariablesPositive)
+    {
+        for(size_t i = 0; i < numberOfElements; i++)
+        {
+            double firstValue = elements[i]->variable->calculate(point);
+            double firstPower = elements[i]->power;
+
+            addToHessian(hessian, elements[i]->variable, elements[i]->variable,
+                value * firstPower * (firstPower - 1.0) / (firstValue * firstValue));
+
+            for(size_t j = i + 1; j < numberOfElements; j++)
+            {
+                double secondValue = elements[j]->variable->calculate(point);
+                double crossValue = value * firstPower * elements[j]->power / (firstValue * secondValue);
+
+                if(elements[i]->variable == elements[j]->variable)
+                    crossValue *= 2.0;
+
+                addToHessian(hessian, elements[i]->variable, elements[j]->variable, crossValue);
+            }
+        }
+
+        return;
+    }
+
+    // The scratch storage contains the element values, their first derivatives and the suffix products
+    scratch.resize(3 * numberOfElements);
+    double* elementValues = scratch.data();
+    double* derivatives = elementValues + numberOfElements;
+    double* suffixProducts = derivatives + numberOfElements;
+
+    for(size_t i = 0; i < numberOfElements; i++)
+    {
+        elementValues[i] = elements[i]->calculate(point);
+        derivatives[i] = elements[i]->calculateDerivative(point);
+    }
+
+    suffixProducts[numberOfElements - 1] = 1.0;
+
+    for(size_t i = numberOfElements - 1; i > 0; i--)
+        suffixProducts[i - 1] = suffixProducts[i] * elementValues[i];
+
+    double prefixProduct = coefficient;
+
+    for(size_t i = 0; i < numberOfElements; i++)
+    {
+        addToHessian(hessian, elements[i]->variable, elements[i]->variable,
+            prefixProduct * elements[i]->calculateSecondDerivative(point) * suffixProducts[i]);
+
+        double partialProduct = prefixProduct * derivatives[i];
+
+        for(size_t j = i + 1; j < numberOfElements; j++)
+        {
+            double crossValue = partialProduct * derivatives[j] * suffixProducts[j];
+
+            if(elements[i]->variable == elements[j]->variable)
+                crossValue *= 2.0;
+
+            addToHessian(hessian, elements[i]->variable, elements[j]->variable, crossValue);
+
+            partialProduct *= elementValues[j];
+        }
+
+        prefixProduct *= elementValues[i];
+    }
+}
+
+void SignomialTerms::calculateGradient(const VectorDouble& point, VectorDouble& gradient) const
+{
+    VectorDouble partials;
+
+    for(auto& T : (*this))
+    {
+        if(T->coefficient == 0.0)
+            continue;
+
+        T->calculatePartialDerivatives(point, partials);
+
+        for(size_t i = 0; i < partials.size(); i++)
+            gradient[T->elements[i]->variable->index] += partials[i];
+    }
+}
+
+SparseVariableVector SignomialTerms::calculateGradient(const VectorDouble& point) const
+{
+    SparseVariableVector gradient;
+    VectorDouble partials;
+
+    for(auto& T : (*this))
+    {
+        if(T->coefficient == 0.0)
+            continue;
+
+        T->calculatePartialDerivatives(point, partials);
+
+        for(size_t i = 0; i < partials.size(); i++)
+            gradient.add(T->elements[i]->variable, partials[i]);
+    }
+
+    gradient.compress();
+    return gradient;
+}
+
+void SignomialTerms::calculateHessian(const VectorDouble& point, SparseVariableMatrix& hessian) const
+{
+    VectorDouble scratch;
+
+    for(auto& T : (*this))
+    {
+        if(T->coefficient == 0.0)
+            continue;
+
+        T->calculateHessian(point, hessian, scratch);
+    }
+}
+
+SparseVariableMatrix SignomialTerms::calculateHessian(const VectorDouble& point) const
+{
+    SparseVariableMatrix hessian;
+    calculateHessian(point, hessian);
+    return hessian;
+}
 } // namespace SHOT
\ No newline at end of file
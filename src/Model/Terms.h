@@ -18,6 +18,8 @@
 
 #include "ffunc.hpp"
 
+#include <map>
+#include <tuple>
 #include <vector>
 
 namespace SHOT
@@ -274,14 +276,10 @@ public:
             if(T->coefficient == 0.0)
                 continue;
 
-            auto element = gradient.emplace(T->variable, T->coefficient);
-            if(!element.second)
-            {
-                // Element already exists for the variable
-                element.first->second += T->coefficient;
-            }
+            gradient.add(T->variable, T->coefficient);
         }
 
+        gradient.compress();
         return gradient;
     };
 };
@@ -405,6 +403,11 @@ inline std::ostream& operator<<(std::ostream& stream, QuadraticTermPtr term)
 class QuadraticTerms : public Terms<QuadraticTermPtr>
 {
 private:
+    // The convexity of the individual blocks of the quadratic form, indexed by the eigenvalue tolerance, the variable
+    // indexes and the elements of the block. Only the blocks from the latest update are kept.
+    using BlockConvexityKey = std::tuple<double, VectorInteger, std::vector<std::tuple<int, int, double>>>;
+    std::map<BlockConvexityKey, E_Convexity> blockConvexityCache;
+
     void updateConvexity() override;
 
 public:
@@ -446,6 +449,7 @@ public:
     SparseVariableVector calculateGradient(const VectorDouble& point) const
     {
         SparseVariableVector gradient;
+        gradient.reserve(2 * this->size());
 
         for(auto& T : (*this))
         {
@@ -454,38 +458,16 @@ public:
 
             if(T->firstVariable == T->secondVariable) // variable squared
             {
-                auto value = 2 * T->coefficient * point[T->firstVariable->index];
-                auto element = gradient.emplace(T->firstVariable, value);
-
-                if(!element.second)
-                {
-                    // Element already exists for the variable
-                    element.first->second += value;
-                }
+                gradient.add(T->firstVariable, 2 * T->coefficient * point[T->firstVariable->index]);
             }
             else
             {
-                auto value = T->coefficient * point[T->secondVariable->index];
-                auto element = gradient.emplace(T->firstVariable, value);
-
-                if(!element.second)
-                {
-                    // Element already exists for the variable
-                    element.first->second += value;
-                }
-
-                value = T->coefficient * point[T->firstVariable->index];
-
-                element = gradient.emplace(T->secondVariable, value);
-
-                if(!element.second)
-                {
-                    // Element already exists for the variable
-                    element.first->second += value;
-                }
+                gradient.add(T->firstVariable, T->coefficient * point[T->secondVariable->index]);
+                gradient.add(T->secondVariable, T->coefficient * point[T->firstVariable->index]);
             }
         }
 
+        gradient.compress();
         return gradient;
     };
 };
@@ -555,6 +537,13 @@ public:
     inline E_Convexity getConvexity() const override { return E_Convexity::Nonconvex; };
 
     inline E_Monotonicity getMonotonicity() const override { return E_Monotonicity::Unknown; };
+
+    // Calculates the partial derivatives w.r.t. each variable (in the order of variables) in linear time using prefix
+    // and suffix products
+    void calculatePartialDerivatives(const VectorDouble& point, VectorDouble& partials) const;
+
+    // Adds the upper triangular part of the Hessian to hessian, suffixProducts is used as scratch storage
+    void calculateHessian(const VectorDouble& point, SparseVariableMatrix& hessian, VectorDouble& suffixProducts) const;
 };
 
 using MonomialTermPtr = std::shared_ptr<MonomialTerm>;
@@ -639,75 +628,15 @@ public:
         }
     }
 
-    SparseVariableVector calculateGradient(const VectorDouble& point) const
-    {
-        SparseVariableVector gradient;
-
-        for(auto& T : (*this))
-        {
-            if(T->coefficient == 0.0)
-                continue;
-
-            for(auto& V1 : T->variables)
-            {
-                double value = 1.0;
-
-                for(auto& V2 : T->variables)
-                {
-                    if(V1 == V2)
-                        continue;
+    // Adds the gradient to the dense vector gradient, which is indexed by the variable indices
+    void calculateGradient(const VectorDouble& point, VectorDouble& gradient) const;
 
-                    value *= V2->calculate(point);
-                }
+    SparseVariableVector calculateGradient(const VectorDouble& point) const;
 
-                gradient.emplace(V1, value);
-            }
-        };
-
-        return gradient;
-    };
-
-    SparseVariableMatrix calculateHessian(const VectorDouble& point) const
-    {
-        SparseVariableMatrix hessian;
-
-        for(auto& T : (*this))
-        {
-            if(T->coefficient == 0)
-                continue;
-
-            for(auto& V1 : T->variables)
-            {
-                for(auto& V2 : T->variables)
-                {
-                    if(V1->index >= V2->index)
-                        continue;
-
-                    double value = T->coefficient;
-
-                    for(auto& V3 : T->variables)
-                    {
-                        if(V3 == V1 || V3 == V2)
-                            continue;
-
-                        value *= V3->calculate(point);
-                    }
-
-                    std::pair<VariablePtr, VariablePtr> variablePair = std::make_pair(V1, V2);
-
-                    auto element = hessian.emplace(variablePair, value);
-
-                    if(!element.second)
-                    {
-                        // Element already exists for the variable
-                        element.first->second += value;
-                    }
-                }
-            }
-        }
+    // Adds the upper triangular part of the Hessian to hessian
+    void calculateHessian(const VectorDouble& point, SparseVariableMatrix& hessian) const;
 
-        return hessian;
-    };
+    SparseVariableMatrix calculateHessian(const VectorDouble& point) const;
 };
 
 class SignomialElement
@@ -721,6 +650,28 @@ public:
 
     inline double calculate(const VectorDouble& point) const { return pow(variable->calculate(point), power); }
 
+    inline double calculateDerivative(const VectorDouble& point) const
+    {
+        if(power == 1.0)
+            return (1.0);
+
+        if(power == 2.0)
+            return (2.0 * variable->calculate(point));
+
+        return (power * pow(variable->calculate(point), power - 1.0));
+    }
+
+    inline double calculateSecondDerivative(const VectorDouble& point) const
+    {
+        if(power == 1.0)
+            return (0.0);
+
+        if(power == 2.0)
+            return (2.0);
+
+        return (power * (power - 1.0) * pow(variable->calculate(point), power - 2.0));
+    }
+
     inline Interval calculate(const IntervalVector& intervalVector) const
     {
         auto variableBound = variable->calculate(intervalVector);
@@ -970,6 +921,13 @@ public:
 
         return E_Monotonicity::Unknown;
     };
+
+    // Calculates the partial derivatives w.r.t. each element (in the order of elements) in linear time, in log-space
+    // if all variables are positive and otherwise using prefix and suffix products
+    void calculatePartialDerivatives(const VectorDouble& point, VectorDouble& partials) const;
+
+    // Adds the upper triangular part of the Hessian to hessian, scratch is used as temporary storage
+    void calculateHessian(const VectorDouble& point, SparseVariableMatrix& hessian, VectorDouble& scratch) const;
 };
 
 using SignomialTermPtr = std::shared_ptr<SignomialTerm>;
@@ -1054,91 +1012,15 @@ public:
         }
     }
 
-    inline SparseVariableVector calculateGradient(const VectorDouble& point) const
-    {
-        SparseVariableVector gradient;
+    // Adds the gradient to the dense vector gradient, which is indexed by the variable indices
+    void calculateGradient(const VectorDouble& point, VectorDouble& gradient) const;
 
-        for(auto& T : (*this))
-        {
-            if(T->coefficient == 0.0)
-                continue;
-
-            for(auto& E1 : T->elements)
-            {
-                double value = 1.0;
-
-                for(auto& E2 : T->elements)
-                {
-                    if(E1 == E2)
-                    {
-                        if(E2->power != 1.0)
-                            value *= E2->power * pow(E2->variable->calculate(point), E2->power - 1.0);
-                    }
-                    else
-                    {
-                        value *= E2->calculate(point);
-                    }
-                }
-
-                auto element = gradient.emplace(E1->variable, T->coefficient * value);
-
-                if(!element.second)
-                {
-                    // Element already exists for the variable
-                    element.first->second += value;
-                }
-            }
-        };
+    SparseVariableVector calculateGradient(const VectorDouble& point) const;
 
-        return gradient;
-    };
+    // Adds the upper triangular part of the Hessian to hessian
+    void calculateHessian(const VectorDouble& point, SparseVariableMatrix& hessian) const;
 
-    SparseVariableMatrix calculateHessian(const VectorDouble& point) const
-    {
-        SparseVariableMatrix hessian;
-
-        for(auto& T : (*this))
-        {
-            if(T->coefficient == 0)
-                continue;
-
-            auto value = T->calculate(point);
-
-            for(auto& E1 : T->elements)
-            {
-                for(auto& E2 : T->elements)
-                {
-                    if(E1->variable->index > E2->variable->index)
-                        continue;
-
-                    double corrFactor;
-
-                    if(E1->variable->index == E2->variable->index)
-                    {
-                        corrFactor = E1->power * (E1->power - 1.0)
-                            / (E1->variable->calculate(point) * E1->variable->calculate(point));
-                    }
-                    else
-                    {
-                        corrFactor
-                            = E1->power * E2->power / (E1->variable->calculate(point) * E2->variable->calculate(point));
-                    }
-
-                    auto variablePair = std::make_pair(E1->variable, E2->variable);
-
-                    auto element = hessian.emplace(variablePair, corrFactor * value);
-
-                    if(!element.second)
-                    {
-                        // Element already exists for the variable
-                        element.first->second += corrFactor * value;
-                    }
-                }
-            }
-        }
-
-        return hessian;
-    };
+    SparseVariableMatrix calculateHessian(const VectorDouble& point) const;
 };
 
 inline std::ostream& operator<<(std::ostream& stream, LinearTerms terms)
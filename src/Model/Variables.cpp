@@ -13,6 +13,8 @@
 
 #include "ffunc.hpp"
 
+#include <atomic>
+
 #include "spdlog/fmt/fmt.h"
 
 #include "../Environment.h"
@@ -26,6 +28,24 @@ double Variable::calculate(const VectorDouble& point) const { return point[index
 Interval Variable::calculate(const IntervalVector& intervalVector) const { return intervalVector[index]; }
 Interval Variable::getBound() { return Interval(lowerBound, upperBound); }
 
+void Variable::setLowerBound(double bound)
+{
+    lowerBound = bound;
+    boundsVersion = getNewBoundsVersion();
+}
+
+void Variable::setUpperBound(double bound)
+{
+    upperBound = bound;
+    boundsVersion = getNewBoundsVersion();
+}
+
+unsigned long long Variable::getNewBoundsVersion()
+{
+    static std::atomic<unsigned long long> boundsVersionCounter { 0 };
+    return (++boundsVersionCounter);
+}
+
 bool Variable::tightenBounds(const Interval bound)
 {
     bool tightened = false;
@@ -76,13 +96,14 @@ bool Variable::tightenBounds(const Interval bound)
 
     if(tightened)
     {
+        boundsVersion = getNewBoundsVersion();
+
         if(auto sharedOwnerProblem = ownerProblem.lock())
         {
             if(sharedOwnerProblem->env->output)
             {
-                sharedOwnerProblem->env->output->outputDebug(
-                    fmt::format(" Bounds tightened for variable {}:\t[{},{}] -> [{},{}].", this->name,
-                        originalLowerBound, originalUpperBound, this->lowerBound, this->upperBound));
+                sharedOwnerProblem->env->output->outputDebug(" Bounds tightened for variable {}:\t[{},{}] -> [{},{}].",
+                    this->name, originalLowerBound, originalUpperBound, this->lowerBound, this->upperBound);
             }
         }
     }
@@ -13,6 +13,7 @@
 #include "../Enums.h"
 #include "../Structs.h"
 
+#include <algorithm>
 #include <map>
 #include <memory>
 #include <ostream>
@@ -66,9 +67,13 @@ public:
 
     std::weak_ptr<Problem> ownerProblem;
 
+    // Use setLowerBound and setUpperBound to modify the bounds, so that cached bounds in expressions are updated
     double upperBound;
     double lowerBound;
 
+    // Changes whenever the bounds are modified
+    unsigned long long boundsVersion = getNewBoundsVersion();
+
     FactorableFunction* factorableFunctionVariable;
 
     Variable()
@@ -100,6 +105,12 @@ public:
     Interval calculate(const IntervalVector& intervalVector) const;
     Interval getBound();
 
+    void setLowerBound(double bound);
+    void setUpperBound(double bound);
+
+    // Returns a new unique bound version, used both for variables and the cached bounds in nonlinear expressions
+    static unsigned long long getNewBoundsVersion();
+
     bool tightenBounds(const Interval bound);
 
     bool isDualUnbounded();
@@ -108,7 +119,84 @@ public:
 };
 
 using VariablePtr = std::shared_ptr<Variable>;
-using SparseVariableVector = std::map<VariablePtr, double>;
+
+// A sparse vector over the variables, stored contiguously as (variable, value) pairs. Values are appended with add()
+// and the same variable may occur several times until compress() is called, which merges the duplicates by scattering
+// them into a dense array indexed on the variable indexes and sorts the entries on the variable index.
+class SparseVariableVector : private std::vector<std::pair<VariablePtr, double>>
+{
+public:
+    using std::vector<std::pair<VariablePtr, double>>::begin;
+    using std::vector<std::pair<VariablePtr, double>>::end;
+    using std::vector<std::pair<VariablePtr, double>>::size;
+    using std::vector<std::pair<VariablePtr, double>>::empty;
+    using std::vector<std::pair<VariablePtr, double>>::reserve;
+    using std::vector<std::pair<VariablePtr, double>>::clear;
+
+    inline void add(const VariablePtr& variable, double value) { this->emplace_back(variable, value); }
+
+    inline void add(const SparseVariableVector& other) { this->insert(this->end(), other.begin(), other.end()); }
+
+    void compress(bool eraseZeroes = false)
+    {
+        auto& elements = static_cast<std::vector<std::pair<VariablePtr, double>>&>(*this);
+
+        // The positions of the variables in the compressed vector, -1 if not yet seen; is reset after each use
+        thread_local VectorInteger positions;
+        size_t numberOfUnique = 0;
+
+        for(size_t i = 0; i < elements.size(); i++)
+        {
+            size_t variableIndex = elements[i].first->index;
+
+            if(variableIndex >= positions.size())
+                positions.resize(variableIndex + 1, -1);
+
+            if(positions[variableIndex] < 0)
+            {
+                positions[variableIndex] = numberOfUnique;
+
+                if(numberOfUnique != i)
+                    elements[numberOfUnique] = std::move(elements[i]);
+
+                numberOfUnique++;
+            }
+            else
+            {
+                elements[positions[variableIndex]].second += elements[i].second;
+            }
+        }
+
+        elements.erase(elements.begin() + numberOfUnique, elements.end());
+
+        for(auto& E : elements)
+            positions[E.first->index] = -1;
+
+        if(eraseZeroes)
+        {
+            elements.erase(std::remove_if(elements.begin(), elements.end(), [](auto& E) { return (E.second == 0.0); }),
+                elements.end());
+        }
+
+        std::sort(elements.begin(), elements.end(),
+            [](auto& first, auto& second) { return (first.first->index < second.first->index); });
+    }
+
+    // Returns the sum of the values for the variable, or zero if it is not in the vector
+    double operator[](const VariablePtr& variable) const
+    {
+        double value = 0.0;
+
+        for(auto& E : *this)
+        {
+            if(E.first == variable)
+                value += E.second;
+        }
+
+        return (value);
+    }
+};
+
 using SparseVariableMatrix = std::map<std::pair<VariablePtr, VariablePtr>, double>;
 
 class Variables : private std::vector<VariablePtr>
@@ -56,6 +56,11 @@ private:
 
     NonlinearExpressions nonlinearExpressions;
 
+    // The AMPL defined variables (common expressions). Each is created once, and the same node is then used in all
+    // expressions referencing it instead of a copy
+    NonlinearExpressions commonExpressions;
+    std::shared_ptr<ExpressionSum> commonExpressionLinearPart;
+
     double minLBCont;
     double maxUBCont;
     double minLBInt;
@@ -74,6 +79,8 @@ public:
 
     void OnHeader(const mp::NLHeader& h)
     {
+        commonExpressions.resize(h.num_common_exprs());
+
         destination->allVariables.reserve(h.num_vars);
         destination->integerVariables.reserve(h.num_integer_vars());
         destination->realVariables.reserve(h.num_continuous_vars());
@@ -293,6 +300,70 @@ public:
         return nullptr;
     }
 
+    NonlinearExpressionPtr OnCommonExprRef(int expressionIndex)
+    {
+        auto& expression = commonExpressions.at(expressionIndex);
+
+        if(!expression)
+            throw OperationNotImplementedException(
+                fmt::format("Error: AMPL defined variable {} used before its definition", expressionIndex));
+
+        return (expression);
+    }
+
+    // Used for creating the linear part of a defined variable
+    class LinearExprHandler
+    {
+    private:
+        ProblemPtr destination;
+        std::shared_ptr<ExpressionSum> terms;
+
+    public:
+        LinearExprHandler(ProblemPtr problem, std::shared_ptr<ExpressionSum> terms)
+            : destination(problem), terms(terms)
+        {
+        }
+
+        void AddTerm(int variableIndex, double coefficient)
+        {
+            if(coefficient == 0.0)
+                return;
+
+            auto variable = std::make_shared<ExpressionVariable>(destination->getVariable(variableIndex));
+
+            if(coefficient == 1.0)
+                terms->children.add(variable);
+            else
+                terms->children.add(
+                    std::make_shared<ExpressionProduct>(std::make_shared<ExpressionConstant>(coefficient), variable));
+        }
+    };
+
+    LinearExprHandler BeginCommonExpr([[maybe_unused]] int expressionIndex, [[maybe_unused]] int numLinearTerms)
+    {
+        commonExpressionLinearPart = std::make_shared<ExpressionSum>();
+        return (LinearExprHandler(destination, commonExpressionLinearPart));
+    }
+
+    void EndCommonExpr(int expressionIndex, NonlinearExpressionPtr nonlinearExpression, [[maybe_unused]] int position)
+    {
+        auto& linearPart = commonExpressionLinearPart->children;
+
+        if(linearPart.size() == 0)
+            commonExpressions.at(expressionIndex) = nonlinearExpression;
+        else if(nonlinearExpression->getType() == E_NonlinearExpressionTypes::Constant
+            && std::dynamic_pointer_cast<ExpressionConstant>(nonlinearExpression)->constant == 0.0)
+            commonExpressions.at(expressionIndex)
+                = (linearPart.size() == 1) ? linearPart[0] : commonExpressionLinearPart;
+        else
+        {
+            linearPart.add(nonlinearExpression);
+            commonExpressions.at(expressionIndex) = commonExpressionLinearPart;
+        }
+
+        commonExpressionLinearPart.reset();
+    }
+
     // Used for creating a list of terms in a sum
     struct NumericArgHandler
     {
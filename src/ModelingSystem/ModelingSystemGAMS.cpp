@@ -104,15 +104,15 @@ void ModelingSystemGAMS::updateSettings(SettingsPtr settings)
         // Sets time limit
         env->settings->updateSetting("TimeLimit", "Termination", gevGetDblOpt(modelingEnvironment, gevResLim));
         env->output->outputDebug(
-            fmt::format("Time limit set to {} by GAMS", env->settings->getSetting<double>("TimeLimit", "Termination")));
+            "Time limit set to {} by GAMS", env->settings->getSetting<double>("TimeLimit", "Termination"));
 
         // Sets iteration limit
         if(gevGetIntOpt(modelingEnvironment, gevIterLim) != ITERLIM_INFINITY)
         {
             env->settings->updateSetting(
                 "IterationLimit", "Termination", gevGetIntOpt(modelingEnvironment, gevIterLim));
-            env->output->outputDebug(fmt::format(
-                "Iteration limit set to {} by GAMS", env->settings->getSetting<int>("IterationLimit", "Termination")));
+            env->output->outputDebug(
+                "Iteration limit set to {} by GAMS", env->settings->getSetting<int>("IterationLimit", "Termination"));
         }
         else
         {
@@ -122,14 +122,14 @@ void ModelingSystemGAMS::updateSettings(SettingsPtr settings)
         // Sets absolute objective gap tolerance
         env->settings->updateSetting(
             "ObjectiveGap.Absolute", "Termination", gevGetDblOpt(modelingEnvironment, gevOptCA));
-        env->output->outputDebug(fmt::format("Absolute termination tolerance set to {} by GAMS",
-            env->settings->getSetting<double>("ObjectiveGap.Absolute", "Termination")));
+        env->output->outputDebug("Absolute termination tolerance set to {} by GAMS",
+            env->settings->getSetting<double>("ObjectiveGap.Absolute", "Termination"));
 
         // Sets relative objective gap tolerance
         env->settings->updateSetting(
             "ObjectiveGap.Relative", "Termination", gevGetDblOpt(modelingEnvironment, gevOptCR));
-        env->output->outputDebug(fmt::format("Relative termination tolerance set to {} by GAMS",
-            env->settings->getSetting<double>("ObjectiveGap.Relative", "Termination")));
+        env->output->outputDebug("Relative termination tolerance set to {} by GAMS",
+            env->settings->getSetting<double>("ObjectiveGap.Relative", "Termination"));
 
         // Sets cutoff value for dual solver
         if(gevGetIntOpt(modelingEnvironment, gevUseCutOff) == 1)
@@ -148,8 +148,8 @@ void ModelingSystemGAMS::updateSettings(SettingsPtr settings)
 
         // Sets the number of threads
         env->settings->updateSetting("MIP.NumberOfThreads", "Dual", gevThreads(modelingEnvironment));
-        env->output->outputDebug(fmt::format(
-            "MIP number of threads set to {} by GAMS", env->settings->getSetting<int>("MIP.NumberOfThreads", "Dual")));
+        env->output->outputDebug(
+            "MIP number of threads set to {} by GAMS", env->settings->getSetting<int>("MIP.NumberOfThreads", "Dual"));
 
         // Uses NLP solver in GAMS by default, Ipopt can be used directly if value set by user in options file (read
         // below)
@@ -47,6 +47,10 @@ public:
 
     virtual std::string getSolverDescription() = 0;
 
+    // Adds the statistics of the solves since the last call to the solution statistics in the environment. The solver
+    // instances can be used from several threads, so this is called afterwards from the thread that owns them.
+    virtual void updateSolutionStatistics() {};
+
 protected:
     virtual E_NLPSolutionStatus solveProblemInstance() = 0;
 };
@@ -26,37 +26,75 @@
 namespace SHOT
 {
 
+// The maximal constraint deviation along the line segment between two points, only the constraints that can attain the
+// maximum somewhere on the segment are evaluated
 class MinimizationFunction
 {
 private:
-    VectorDouble firstPt;
-    VectorDouble secondPt;
-    ProblemPtr NLPProblem;
+    const VectorDouble& firstPt;
+    const VectorDouble& secondPt;
+    const std::vector<NumericConstraint*>& constraints;
+    VectorDouble ptNew;
 
 public:
-    MinimizationFunction(VectorDouble ptA, VectorDouble ptB, ProblemPtr prob)
+    MinimizationFunction(
+        const VectorDouble& ptA, const VectorDouble& ptB, const std::vector<NumericConstraint*>& activeConstraints)
+        : firstPt(ptA), secondPt(ptB), constraints(activeConstraints), ptNew(ptA.size())
     {
-        firstPt = ptA;
-        secondPt = ptB;
-        NLPProblem = prob;
     }
 
     double operator()(const double x)
     {
-        int length = firstPt.size();
-        VectorDouble ptNew(length);
+        for(size_t i = 0; i < ptNew.size(); i++)
+            ptNew[i] = x * firstPt[i] + (1 - x) * secondPt[i];
 
-        for(int i = 0; i < length; i++)
+        double maxValue = SHOT_DBL_MIN;
+
+        for(auto& C : constraints)
         {
-            ptNew.at(i) = x * firstPt.at(i) + (1 - x) * secondPt.at(i);
+            double value = C->calculateFunctionValue(ptNew);
+            maxValue = std::max(maxValue, std::max(value - C->valueRHS, C->valueLHS - value));
         }
 
-        auto maxDev = NLPProblem->getMaxNumericConstraintValue(ptNew, NLPProblem->nonlinearConstraints);
-
-        return (maxDev.normalizedValue);
+        return (maxValue);
     }
 };
 
+// Selects the constraints to use in the line search between two points. A convex constraint is bounded by its values
+// in the end points along the segment, while the maximal deviation is bounded from below by the LP objective value if
+// the problem is convex. Thus, a convex constraint whose values in the end points are below this bound can never be
+// the maximal term.
+static std::vector<NumericConstraint*> getLineSearchConstraints(const ProblemPtr& problem, const VectorDouble& ptA,
+    const VectorDouble& ptB, double lowerBound, bool useLowerBound)
+{
+    std::vector<NumericConstraint*> activeConstraints;
+    activeConstraints.reserve(problem->nonlinearConstraints.size());
+
+    for(auto& C : problem->nonlinearConstraints)
+    {
+        if(!useLowerBound || C->properties.convexity != E_Convexity::Convex)
+        {
+            activeConstraints.push_back(C.get());
+            continue;
+        }
+
+        double valueA = C->calculateFunctionValue(ptA);
+        double valueB = C->calculateFunctionValue(ptB);
+
+        double maxValue = std::max(std::max(valueA - C->valueRHS, C->valueLHS - valueA),
+            std::max(valueB - C->valueRHS, C->valueLHS - valueB));
+
+        if(maxValue >= lowerBound)
+            activeConstraints.push_back(C.get());
+    }
+
+    // At least one constraint is needed to get a value of the line search objective
+    if(activeConstraints.empty() && !problem->nonlinearConstraints.empty())
+        activeConstraints.push_back(problem->nonlinearConstraints[0].get());
+
+    return (activeConstraints);
+}
+
 NLPSolverCuttingPlaneMinimax::NLPSolverCuttingPlaneMinimax(EnvironmentPtr envPtr, ProblemPtr problem)
     : INLPSolver(envPtr), sourceProblem(problem)
 {
@@ -81,7 +119,12 @@ NLPSolverCuttingPlaneMinimax::NLPSolverCuttingPlaneMinimax(EnvironmentPtr envPtr
 #ifdef HAS_CBC
     if(solver == ES_MIPSolver::Cbc)
     {
-        LPSolver = std::make_unique<MIPSolverCbc>(env);
+        auto CbcSolver = std::make_unique<MIPSolverCbc>(env);
+
+        // The minimax LP problems only change by the added cuts, so they are reoptimized from the previous basis
+        CbcSolver->useLPWarmStart = true;
+
+        LPSolver = std::move(CbcSolver);
         env->output->outputDebug(" Cbc selected as MIP solver for minimax solver.");
     }
 #endif
@@ -119,6 +162,9 @@ E_NLPSolutionStatus NLPSolverCuttingPlaneMinimax::solveProblemInstance()
     boost::uintmax_t maxIterSubsolver
         = env->settings->getSetting<int>("ESH.InteriorPoint.CuttingPlane.IterationLimitSubsolver", "Dual");
     int bitPrecision = env->settings->getSetting<int>("ESH.InteriorPoint.CuttingPlane.BitPrecision", "Dual");
+    double objLowerBound = env->settings->getSetting<double>("ESH.InteriorPoint.MinimaxObjectiveLowerBound", "Dual");
+
+    bool isConvex = (sourceProblem->properties.convexity == E_ProblemConvexity::Convex);
 
     // currSol is the current LP solution, and prevSol the previous one
     VectorDouble currSol, prevSol;
@@ -216,7 +262,13 @@ E_NLPSolutionStatus NLPSolverCuttingPlaneMinimax::solveProblemInstance()
         }
         else
         {
-            MinimizationFunction funct(LPVarSol, prevSol, sourceProblem);
+            // The LP objective is not a valid bound if the objective variable is at its lower bound
+            bool useLowerBound = isConvex && LPObjVar > objLowerBound;
+
+            auto lineSearchConstraints
+                = getLineSearchConstraints(sourceProblem, LPVarSol, prevSol, LPObjVar, useLowerBound);
+
+            MinimizationFunction funct(LPVarSol, prevSol, lineSearchConstraints);
 
             // Solves the minization problem wrt lambda in [0, 1]
             auto minimizationResult
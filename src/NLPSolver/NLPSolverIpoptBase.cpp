@@ -10,9 +10,13 @@
 
 #include "NLPSolverIpoptBase.h"
 
+#include <algorithm>
 #include <cstdio>
+#include <numeric>
+#include <thread>
 
 #include "../Output.h"
+#include "../Results.h"
 #include "../Settings.h"
 #include "../Utilities.h"
 
@@ -21,6 +25,16 @@ namespace SHOT
 
 using namespace Ipopt;
 
+// The budgets for the fixed-integer NLP problems are only used when there are this many previous solves
+const size_t minimumSolvesForBudget = 5;
+const int minimumIterationBudget = 50;
+const double minimumTimeBudget = 0.1;
+
+// The number of feasible iterations used to estimate the decrease of the objective
+const size_t objectiveTrendIterations = 5;
+
+const double relativeCutoffTolerance = 1e-6;
+
 void IpoptJournal::PrintImpl(Ipopt::EJournalCategory category, Ipopt::EJournalLevel level, const char* str)
 {
     auto lines = Utilities::splitStringByCharacter(str, '\n');
@@ -38,20 +52,20 @@ void IpoptJournal::PrintImpl(Ipopt::EJournalCategory category, Ipopt::EJournalLe
     case J_DETAILED:
 
         for(auto const line : lines)
-            env->output->outputInfo(fmt::format("      | {} ", line));
+            env->output->outputInfo("      | {} ", line);
 
         break;
 
     case J_MOREDETAILED:
 
         for(auto const line : lines)
-            env->output->outputDebug(fmt::format("      | {} ", line));
+            env->output->outputDebug("      | {} ", line);
 
         break;
 
     default:
         for(auto const line : lines)
-            env->output->outputTrace(fmt::format("      | {} ", line));
+            env->output->outputTrace("      | {} ", line);
 
         break;
     }
@@ -91,21 +105,215 @@ void IpoptJournal::FlushBufferImpl()
     env->output->flush();
 }
 
-IpoptProblem::IpoptProblem(EnvironmentPtr envPtr, ProblemPtr problem) : env(envPtr), sourceProblem(problem) {}
+IpoptProblem::IpoptProblem(EnvironmentPtr envPtr, ProblemPtr problem)
+    : objectiveFunction(problem->objectiveFunction), env(envPtr), sourceProblem(problem)
+{
+}
+
+bool IpoptProblem::updateReducedSpace(double constraintTolerance)
+{
+    int numberOfVariables = sourceProblem->properties.numberOfVariables;
+
+    reducedVariableIndexes.clear();
+    variablePlacement.assign(numberOfVariables, -1);
+    fullSpacePoint.assign(numberOfVariables, 0.0);
+
+    std::vector<bool> isInBlock;
+    std::vector<bool> isConstraintInBlock;
+
+    if(block)
+    {
+        isInBlock.assign(numberOfVariables, false);
+        isConstraintInBlock.assign(sourceProblem->properties.numberOfNumericConstraints, false);
+
+        for(auto& I : block->variableIndexes)
+            isInBlock[I] = true;
+
+        for(auto& I : block->constraintIndexes)
+            isConstraintInBlock[I] = true;
+
+        for(size_t k = 0; k < startingPointVariableIndexes.size(); k++)
+            fullSpacePoint[startingPointVariableIndexes[k]] = startingPointVariableValues[k];
+    }
+
+    for(int i = 0; i < numberOfVariables; i++)
+    {
+        if(useReducedSpace && lowerBounds[i] == upperBounds[i])
+        {
+            fullSpacePoint[i] = lowerBounds[i];
+            continue;
+        }
+
+        // The variables in the other blocks do not affect the constraints in this block and only add a constant term to
+        // the objective
+        if(block && !isInBlock[i])
+        {
+            fullSpacePoint[i] = std::clamp(fullSpacePoint[i], lowerBounds[i], upperBounds[i]);
+            continue;
+        }
+
+        variablePlacement[i] = reducedVariableIndexes.size();
+        reducedVariableIndexes.push_back(i);
+    }
+
+    numberOfReducedNonlinearVariables = 0;
+
+    for(auto& V : sourceProblem->nonlinearVariables)
+    {
+        if(variablePlacement[V->index] >= 0)
+            numberOfReducedNonlinearVariables++;
+    }
+
+    reducedConstraintIndexes.clear();
+    bool isFeasible = true;
+
+    for(auto& C : sourceProblem->numericConstraints)
+    {
+        // The constraints with only fixed variables have been checked when the blocks were created
+        if(block && !isConstraintInBlock[C->index])
+            continue;
+
+        auto gradientSparsityPattern = C->getGradientSparsityPattern();
+
+        if(std::any_of(gradientSparsityPattern->begin(), gradientSparsityPattern->end(),
+               [&](auto const& V) { return (variablePlacement[V->index] >= 0); }))
+        {
+            reducedConstraintIndexes.push_back(C->index);
+            continue;
+        }
+
+        // The value of the constraint is determined by the fixed variables
+        double value = C->calculateFunctionValue(fullSpacePoint);
+
+        if(value < C->valueLHS - constraintTolerance || value > C->valueRHS + constraintTolerance)
+        {
+            env->output->outputTrace("         Constraint {} with only fixed variables is violated: {} <= {} <= {}",
+                C->name, C->valueLHS, value, C->valueRHS);
+            isFeasible = false;
+        }
+    }
+
+    if(!block && reducedVariableIndexes.size() < (size_t)numberOfVariables)
+    {
+        env->output->outputDebug("        Removed {} fixed variables and {} constraints from the Ipopt problem.",
+            numberOfVariables - reducedVariableIndexes.size(),
+            sourceProblem->numericConstraints.size() - reducedConstraintIndexes.size());
+    }
+
+    return (isFeasible);
+}
+
+void IpoptProblem::estimateHessianCost(int& numberOfNonzeros, double& density, double& costRatio)
+{
+    auto isInReducedSpace = [&](const VariablePtr& V) { return (variablePlacement[V->index] >= 0); };
+
+    numberOfNonzeros = 0;
+
+    for(auto& E : *sourceProblem->getLagrangianHessianSparsityPattern())
+    {
+        if(isInReducedSpace(E.first) && isInReducedSpace(E.second))
+            numberOfNonzeros++;
+    }
+
+    double upperTriangleSize = 0.5 * numberOfReducedNonlinearVariables * (numberOfReducedNonlinearVariables + 1.0);
+    density = (upperTriangleSize > 0.0) ? numberOfNonzeros / upperTriangleSize : 0.0;
+
+    // The cost of the terms is proportional to the number of derivatives in the reduced space. The Hessian of a
+    // nonlinear expression is calculated with one sweep of its tape for each variable in it, the gradient with one.
+    double gradientCost = 0.0;
+    double hessianCost = 0.0;
+
+    auto addTermCost = [&](auto const& function)
+    {
+        for(auto& V : *function->getGradientSparsityPattern())
+            gradientCost += isInReducedSpace(V) ? 1.0 : 0.0;
+
+        for(auto& E : *function->getHessianSparsityPattern())
+            hessianCost += (isInReducedSpace(E.first) && isInReducedSpace(E.second)) ? 1.0 : 0.0;
+    };
+
+    auto addTapeCost = [&](const CppAD::ADFun<double>& tape, const Variables& tapeVariables)
+    {
+        if(std::none_of(tapeVariables.begin(), tapeVariables.end(), isInReducedSpace))
+            return;
+
+        gradientCost += tape.size_op();
+        hessianCost += (double)tape.size_op() * tapeVariables.size();
+    };
+
+    addTermCost(objectiveFunction);
+
+    if(objectiveFunction->properties.hasNonlinearExpression)
+    {
+        if(auto objective = std::dynamic_pointer_cast<NonlinearObjectiveFunction>(objectiveFunction))
+            addTapeCost(objective->ADFunction, objective->variablesInNonlinearExpression);
+    }
+
+    for(auto& K : reducedConstraintIndexes)
+    {
+        auto& C = sourceProblem->numericConstraints[K];
+
+        addTermCost(C);
+
+        if(!C->properties.hasNonlinearExpression)
+            continue;
+
+        if(auto constraint = std::dynamic_pointer_cast<NonlinearConstraint>(C))
+            addTapeCost(constraint->ADFunction, constraint->variablesInNonlinearExpression);
+    }
+
+    costRatio = hessianCost / std::max(gradientCost, 1.0);
+}
+
+void IpoptProblem::resetIterationData()
+{
+    earlyTerminationStatus.reset();
+    numberOfIterations = 0;
+    feasibleObjectiveValues.clear();
+    solveTimer.restart();
+}
+
+void IpoptProblem::updateFullSpacePoint(const Number* x)
+{
+    for(size_t i = 0; i < reducedVariableIndexes.size(); i++)
+        fullSpacePoint[reducedVariableIndexes[i]] = x[i];
+}
+
+VectorDouble IpoptProblem::getFullSpacePoint(const Number* x)
+{
+    updateFullSpacePoint(x);
+    return (fullSpacePoint);
+}
 
 bool IpoptProblem::get_nlp_info(Index& n, Index& m, Index& nnz_jac_g, Index& nnz_h_lag, IndexStyleEnum& index_style)
 {
-    n = sourceProblem->properties.numberOfVariables;
-    m = sourceProblem->properties.numberOfNumericConstraints;
+    n = reducedVariableIndexes.size();
+    m = reducedConstraintIndexes.size();
 
     nnz_jac_g = 0;
 
-    for(auto& E : *sourceProblem->getConstraintsJacobianSparsityPattern())
+    for(auto& K : reducedConstraintIndexes)
     {
-        nnz_jac_g += E.second.size();
+        for(auto& V : *sourceProblem->numericConstraints[K]->getGradientSparsityPattern())
+        {
+            if(variablePlacement[V->index] >= 0)
+                nnz_jac_g++;
+        }
     }
 
-    nnz_h_lag = sourceProblem->getLagrangianHessianSparsityPattern()->size();
+    nnz_h_lag = 0;
+
+    if(useLimitedMemoryHessian)
+    {
+        index_style = TNLP::C_STYLE;
+        return (true);
+    }
+
+    for(auto& E : *sourceProblem->getLagrangianHessianSparsityPattern())
+    {
+        if(variablePlacement[E.first->index] >= 0 && variablePlacement[E.second->index] >= 0)
+            nnz_h_lag++;
+    }
 
     // use the C style indexing (0-based)
     index_style = TNLP::C_STYLE;
@@ -117,8 +325,8 @@ bool IpoptProblem::get_bounds_info(Index n, Number* x_l, Number* x_u, Index m, N
 {
     for(int i = 0; i < n; i++)
     {
-        x_l[i] = lowerBounds[i];
-        x_u[i] = upperBounds[i];
+        x_l[i] = lowerBounds[reducedVariableIndexes[i]];
+        x_u[i] = upperBounds[reducedVariableIndexes[i]];
     }
 
     // Ipopt interprets any number greater than nlp_upper_bound_inf as
@@ -128,7 +336,7 @@ bool IpoptProblem::get_bounds_info(Index n, Number* x_l, Number* x_u, Index m, N
 
     for(int i = 0; i < m; i++)
     {
-        auto constraint = std::dynamic_pointer_cast<NumericConstraint>(sourceProblem->getConstraint(i));
+        auto constraint = sourceProblem->numericConstraints[reducedConstraintIndexes[i]];
 
         g_l[i] = constraint->valueLHS;
         g_u[i] = constraint->valueRHS;
@@ -140,11 +348,11 @@ bool IpoptProblem::get_bounds_info(Index n, Number* x_l, Number* x_u, Index m, N
 // gets the linearity of the variables
 bool IpoptProblem::get_variables_linearity(Ipopt::Index n, LinearityType* var_types)
 {
-    assert(n == sourceProblem->properties.numberOfVariables);
+    assert(n == (Ipopt::Index)reducedVariableIndexes.size());
 
     for(int i = 0; i < n; ++i)
     {
-        if(sourceProblem->allVariables[i]->properties.isNonlinear)
+        if(sourceProblem->allVariables[reducedVariableIndexes[i]]->properties.isNonlinear)
             var_types[i] = NON_LINEAR;
         else
             var_types[i] = LINEAR;
@@ -156,11 +364,12 @@ bool IpoptProblem::get_variables_linearity(Ipopt::Index n, LinearityType* var_ty
 // gets the linearity of the constraints
 bool IpoptProblem::get_constraints_linearity(Ipopt::Index m, LinearityType* const_types)
 {
-    assert(m == sourceProblem->properties.numberOfNumericConstraints);
+    assert(m == (Ipopt::Index)reducedConstraintIndexes.size());
 
     for(int i = 0; i < m; ++i)
     {
-        if(sourceProblem->numericConstraints[i]->properties.classification > E_ConstraintClassification::Linear)
+        if(sourceProblem->numericConstraints[reducedConstraintIndexes[i]]->properties.classification
+            > E_ConstraintClassification::Linear)
             const_types[i] = NON_LINEAR;
         else
             const_types[i] = LINEAR;
@@ -171,18 +380,20 @@ bool IpoptProblem::get_constraints_linearity(Ipopt::Index m, LinearityType* cons
 
 Ipopt::Index IpoptProblem::get_number_of_nonlinear_variables()
 {
-    return (sourceProblem->properties.numberOfNonlinearVariables);
+    return (numberOfReducedNonlinearVariables);
 }
 
 bool IpoptProblem::get_list_of_nonlinear_variables(
     [[maybe_unused]] Ipopt::Index num_nonlin_vars, Ipopt::Index* pos_nonlin_vars)
 {
-    VectorInteger nonlinearVariables;
     int count = 0;
 
-    for(int i = 0; i < sourceProblem->properties.numberOfNonlinearVariables; i++)
+    for(auto& V : sourceProblem->nonlinearVariables)
     {
-        pos_nonlin_vars[i] = sourceProblem->nonlinearVariables[i]->index;
+        if(variablePlacement[V->index] < 0)
+            continue;
+
+        pos_nonlin_vars[count] = variablePlacement[V->index];
         count++;
     }
 
@@ -192,13 +403,26 @@ bool IpoptProblem::get_list_of_nonlinear_variables(
 }
 
 // returns the initial point for the problem
-bool IpoptProblem::get_starting_point(Index n, [[maybe_unused]] bool init_x, [[maybe_unused]] Number* x,
-    [[maybe_unused]] bool init_z, [[maybe_unused]] Number* z_L, [[maybe_unused]] Number* z_U, [[maybe_unused]] Index m,
-    [[maybe_unused]] bool init_lambda, [[maybe_unused]] Number* lambda)
+bool IpoptProblem::get_starting_point(Index n, [[maybe_unused]] bool init_x, Number* x, bool init_z, Number* z_L,
+    Number* z_U, Index m, bool init_lambda, Number* lambda)
 {
     assert(init_x == true);
-    assert(init_z == false);
-    assert(init_lambda == false);
+
+    // The dual values are only requested when warm starting
+    if(init_z)
+    {
+        for(int i = 0; i < n; i++)
+        {
+            z_L[i] = warmStart ? warmStart->lowerBoundMultipliers[reducedVariableIndexes[i]] : 0.0;
+            z_U[i] = warmStart ? warmStart->upperBoundMultipliers[reducedVariableIndexes[i]] : 0.0;
+        }
+    }
+
+    if(init_lambda)
+    {
+        for(int i = 0; i < m; i++)
+            lambda[i] = warmStart ? warmStart->constraintMultipliers[reducedConstraintIndexes[i]] : 0.0;
+    }
 
     std::vector<bool> isInitialized(n, false);
 
@@ -206,6 +430,10 @@ bool IpoptProblem::get_starting_point(Index n, [[maybe_unused]] bool init_x, [[m
     {
         int variableIndex = startingPointVariableIndexes[k];
 
+        // Fixed variables are not in the reduced space
+        if(variablePlacement[variableIndex] < 0)
+            continue;
+
         double variableValue = startingPointVariableValues[k];
 
         double variableLB = sourceProblem->getVariableLowerBound(variableIndex);
@@ -215,9 +443,9 @@ bool IpoptProblem::get_starting_point(Index n, [[maybe_unused]] bool init_x, [[m
         {
             if(variableValue < variableLB)
             {
-                env->output->outputDebug("         Initial value " + std::to_string(variableValue)
-                    + " for variable with index " + std::to_string(variableIndex) + " is less than the lower bound "
-                    + std::to_string(variableLB));
+                env->output->outputDebug(
+                    "         Initial value {} for variable with index {} is less than the lower bound {}",
+                    variableValue, variableIndex, variableLB);
                 continue;
             }
         }
@@ -225,9 +453,9 @@ bool IpoptProblem::get_starting_point(Index n, [[maybe_unused]] bool init_x, [[m
         {
             if(variableValue > variableUB)
             {
-                env->output->outputDebug("         Initial value " + std::to_string(variableValue)
-                    + " for variable with index " + std::to_string(variableIndex) + " is larger than the upper bound "
-                    + std::to_string(variableUB));
+                env->output->outputDebug(
+                    "         Initial value {} for variable with index {} is larger than the upper bound {}",
+                    variableValue, variableIndex, variableUB);
                 continue;
             }
         }
@@ -235,9 +463,9 @@ bool IpoptProblem::get_starting_point(Index n, [[maybe_unused]] bool init_x, [[m
         {
             if(variableValue < variableLB || variableValue > variableUB)
             {
-                env->output->outputDebug("         Initial value " + std::to_string(variableValue)
-                    + " for variable with index " + std::to_string(variableIndex) + " is not within variable bounds ["
-                    + std::to_string(variableLB) + "," + std::to_string(variableUB));
+                env->output->outputDebug(
+                    "         Initial value {} for variable with index {} is not within variable bounds [{},{}]",
+                    variableValue, variableIndex, variableLB, variableUB);
                 continue;
             }
         }
@@ -245,23 +473,38 @@ bool IpoptProblem::get_starting_point(Index n, [[maybe_unused]] bool init_x, [[m
         if(variableValue < -divergingIterativesTolerance)
         {
             variableValue = -0.99 * divergingIterativesTolerance;
-            env->output->outputTrace(
-                fmt::format("         Starting point value for variable with index {} is below diverging "
-                            "iterates tolerance {}. Setting value to {}.",
-                    variableIndex, divergingIterativesTolerance, variableValue));
+            env->output->outputTrace("         Starting point value for variable with index {} is below diverging "
+                                     "iterates tolerance {}. Setting value to {}.",
+                variableIndex, divergingIterativesTolerance, variableValue);
         }
         else if(variableValue > divergingIterativesTolerance)
         {
             variableValue = 0.99 * divergingIterativesTolerance;
 
-            env->output->outputTrace(
-                fmt::format("         Starting point value for variable with index {} is above diverging "
-                            "iterates tolerance {}. Setting value to {}.",
-                    variableIndex, divergingIterativesTolerance, variableValue));
+            env->output->outputTrace("         Starting point value for variable with index {} is above diverging "
+                                     "iterates tolerance {}. Setting value to {}.",
+                variableIndex, divergingIterativesTolerance, variableValue);
         }
 
-        x[variableIndex] = variableValue;
-        isInitialized[variableIndex] = true;
+        x[variablePlacement[variableIndex]] = variableValue;
+        isInitialized[variablePlacement[variableIndex]] = true;
+    }
+
+    // The values in the warm start are for a problem with the same variables but some other fixed values, so they are
+    // only used for the variables without a given starting point
+    if(warmStart)
+    {
+        for(int k = 0; k < n; k++)
+        {
+            if(isInitialized[k])
+                continue;
+
+            int variableIndex = reducedVariableIndexes[k];
+
+            x[k] = std::clamp(
+                warmStart->variableValues[variableIndex], lowerBounds[variableIndex], upperBounds[variableIndex]);
+            isInitialized[k] = true;
+        }
     }
 
     double defaultInitValue = 1.7171; // TODO: why?
@@ -271,8 +514,8 @@ bool IpoptProblem::get_starting_point(Index n, [[maybe_unused]] bool init_x, [[m
         if(isInitialized[k])
             continue;
 
-        double variableLB = sourceProblem->getVariableLowerBound(k);
-        double variableUB = sourceProblem->getVariableUpperBound(k);
+        double variableLB = sourceProblem->getVariableLowerBound(reducedVariableIndexes[k]);
+        double variableUB = sourceProblem->getVariableUpperBound(reducedVariableIndexes[k]);
 
         if(variableUB == SHOT_DBL_MAX)
         {
@@ -300,14 +543,11 @@ bool IpoptProblem::get_starting_point(Index n, [[maybe_unused]] bool init_x, [[m
 }
 
 // Returns the value of the objective function
-bool IpoptProblem::eval_f(Index n, const Number* x, [[maybe_unused]] bool new_x, Number& obj_value)
+bool IpoptProblem::eval_f([[maybe_unused]] Index n, const Number* x, [[maybe_unused]] bool new_x, Number& obj_value)
 {
-    VectorDouble vectorPoint(n);
+    updateFullSpacePoint(x);
 
-    for(int i = 0; i < n; i++)
-        vectorPoint[i] = x[i];
-
-    obj_value = sourceProblem->objectiveFunction->calculateValue(vectorPoint);
+    obj_value = objectiveFunction->calculateValue(fullSpacePoint);
 
     return (true);
 }
@@ -315,39 +555,33 @@ bool IpoptProblem::eval_f(Index n, const Number* x, [[maybe_unused]] bool new_x,
 // Returns the gradient of the objective function
 bool IpoptProblem::eval_grad_f(Index n, const Number* x, [[maybe_unused]] bool new_x, Number* grad_f)
 {
-    VectorDouble vectorPoint(n);
-
-    for(int i = 0; i < n; i++)
-        vectorPoint[i] = x[i];
+    updateFullSpacePoint(x);
 
     for(int i = 0; i < n; i++)
         grad_f[i] = 0.0;
 
-    for(auto& G : sourceProblem->objectiveFunction->calculateGradient(vectorPoint, false))
-        grad_f[G.first->index] = G.second;
+    for(auto& G : objectiveFunction->calculateGradient(fullSpacePoint, false))
+    {
+        if(int location = variablePlacement[G.first->index]; location >= 0)
+            grad_f[location] = G.second;
+    }
 
     return (true);
 }
 
 // Return the value of the constraints
-bool IpoptProblem::eval_g(Index n, const Number* x, [[maybe_unused]] bool new_x, Index m, Number* g)
+bool IpoptProblem::eval_g([[maybe_unused]] Index n, const Number* x, [[maybe_unused]] bool new_x, Index m, Number* g)
 {
-    VectorDouble vectorPoint(n);
-
-    for(int i = 0; i < n; i++)
-        vectorPoint[i] = x[i];
-
-    for(int i = 0; i < m; i++)
-        g[i] = 0.0;
+    updateFullSpacePoint(x);
 
     for(int i = 0; i < m; i++)
-        g[i] = sourceProblem->numericConstraints[i]->calculateFunctionValue(vectorPoint);
+        g[i] = sourceProblem->numericConstraints[reducedConstraintIndexes[i]]->calculateFunctionValue(fullSpacePoint);
 
     return (true);
 }
 
 // Return the structure or values of the jacobian
-bool IpoptProblem::eval_jac_g(Index n, const Number* x, [[maybe_unused]] bool new_x, [[maybe_unused]] Index m,
+bool IpoptProblem::eval_jac_g([[maybe_unused]] Index n, const Number* x, [[maybe_unused]] bool new_x, Index m,
     Index nele_jac, Index* iRow, Index* jCol, Number* values)
 {
     // The structure
@@ -355,58 +589,77 @@ bool IpoptProblem::eval_jac_g(Index n, const Number* x, [[maybe_unused]] bool ne
     {
         int counter = 0;
 
-        jacobianCounterPlacement.clear();
+        jacobianConstraintOffsets.clear();
+        jacobianColumns.clear();
 
-        for(auto& C : sourceProblem->numericConstraints)
+        for(int k = 0; k < m; k++)
         {
-            auto jacobian = C->getGradientSparsityPattern();
+            jacobianConstraintOffsets.push_back(counter);
+
+            auto& constraint = sourceProblem->numericConstraints[reducedConstraintIndexes[k]];
+            auto jacobian = constraint->getGradientSparsityPattern();
 
             for(auto& G : *jacobian)
             {
-                iRow[counter] = C->index;
-                jCol[counter] = G->index;
+                if(variablePlacement[G->index] < 0)
+                    continue;
+
+                iRow[counter] = k;
+                jCol[counter] = variablePlacement[G->index];
 
-                jacobianCounterPlacement.emplace(std::make_pair(C->index, G->index), counter);
+                jacobianColumns.push_back(G->index);
                 counter++;
             }
 
             assert(counter <= nele_jac);
         }
 
+        jacobianConstraintOffsets.push_back(counter);
+        jacobianVariablePlacement.assign(sourceProblem->properties.numberOfVariables, -1);
+
         return (true);
     }
 
     // The values
 
-    VectorDouble vectorPoint(n);
-
-    for(int i = 0; i < n; i++)
-        vectorPoint[i] = x[i];
+    updateFullSpacePoint(x);
 
     for(int i = 0; i < nele_jac; i++)
         values[i] = 0.0;
 
-    for(auto& C : sourceProblem->numericConstraints)
+    for(int k = 0; k < m; k++)
     {
-        auto jacobian = C->calculateGradient(vectorPoint, false);
+        int first = jacobianConstraintOffsets[k];
+        int last = jacobianConstraintOffsets[k + 1];
+
+        // Scatter the positions of the constraint's nonzeroes so that the gradient can be gathered in one pass
+        for(int i = first; i < last; i++)
+            jacobianVariablePlacement[jacobianColumns[i]] = i;
 
-        for(auto& G : jacobian)
+        for(auto& G :
+            sourceProblem->numericConstraints[reducedConstraintIndexes[k]]->calculateGradient(fullSpacePoint, false))
         {
-            int location = jacobianCounterPlacement[std::make_pair(C->index, G.first->index)];
+            if(variablePlacement[G.first->index] < 0)
+                continue;
 
-            values[location] += G.second;
+            int location = jacobianVariablePlacement[G.first->index];
 
             assert(location < nele_jac);
             assert(location >= 0);
+
+            values[location] += G.second;
         }
+
+        for(int i = first; i < last; i++)
+            jacobianVariablePlacement[jacobianColumns[i]] = -1;
     }
 
     return (true);
 }
 
 // Return the structure or values of the Hessian of the Langragian
-bool IpoptProblem::eval_h(Index n, const Number* x, [[maybe_unused]] bool new_x, Number obj_factor,
-    [[maybe_unused]] Index m, const Number* lambda, [[maybe_unused]] bool new_lambda, Index nele_hess, Index* iRow,
+bool IpoptProblem::eval_h([[maybe_unused]] Index n, const Number* x, [[maybe_unused]] bool new_x, Number obj_factor,
+    Index m, const Number* lambda, [[maybe_unused]] bool new_lambda, Index nele_hess, Index* iRow,
     Index* jCol, Number* values)
 {
     // The structure
@@ -419,8 +672,12 @@ bool IpoptProblem::eval_h(Index n, const Number* x, [[maybe_unused]] bool new_x,
         {
             assert(E.first->index <= E.second->index);
 
-            iRow[counter] = E.first->index;
-            jCol[counter] = E.second->index;
+            if(variablePlacement[E.first->index] < 0 || variablePlacement[E.second->index] < 0)
+                continue;
+
+            // The order of the variables is kept in the reduced space, so the entries stay in the upper triangle
+            iRow[counter] = variablePlacement[E.first->index];
+            jCol[counter] = variablePlacement[E.second->index];
 
             lagrangianHessianCounterPlacement.emplace(std::make_pair(E.first->index, E.second->index), counter);
 
@@ -432,20 +689,23 @@ bool IpoptProblem::eval_h(Index n, const Number* x, [[maybe_unused]] bool new_x,
 
     // The values
 
-    VectorDouble vectorPoint(n);
-
-    for(int i = 0; i < n; i++)
-        vectorPoint[i] = x[i];
+    updateFullSpacePoint(x);
 
     for(int i = 0; i < nele_hess; i++)
         values[i] = 0.0;
 
+    // Entries with fixed variables are not in the reduced space
     if(obj_factor != 0.0)
     {
-        for(auto& E : sourceProblem->objectiveFunction->calculateHessian(vectorPoint, false))
+        for(auto& E : objectiveFunction->calculateHessian(fullSpacePoint, false))
         {
-            int location
-                = lagrangianHessianCounterPlacement[std::make_pair(E.first.first->index, E.first.second->index)];
+            auto placement = lagrangianHessianCounterPlacement.find(
+                std::make_pair(E.first.first->index, E.first.second->index));
+
+            if(placement == lagrangianHessianCounterPlacement.end())
+                continue;
+
+            int location = placement->second;
 
             assert(location < nele_hess);
             assert(location >= 0);
@@ -454,23 +714,30 @@ bool IpoptProblem::eval_h(Index n, const Number* x, [[maybe_unused]] bool new_x,
         }
     }
 
-    for(auto& C : sourceProblem->numericConstraints)
+    for(int k = 0; k < m; k++)
     {
+        auto& C = sourceProblem->numericConstraints[reducedConstraintIndexes[k]];
+
         if(C->properties.classification == E_ConstraintClassification::Linear)
             continue;
 
-        if(lambda[C->index] == 0.0)
+        if(lambda[k] == 0.0)
             continue;
 
-        for(auto& E : C->calculateHessian(vectorPoint, false))
+        for(auto& E : C->calculateHessian(fullSpacePoint, false))
         {
-            int location
-                = lagrangianHessianCounterPlacement[std::make_pair(E.first.first->index, E.first.second->index)];
+            auto placement = lagrangianHessianCounterPlacement.find(
+                std::make_pair(E.first.first->index, E.first.second->index));
+
+            if(placement == lagrangianHessianCounterPlacement.end())
+                continue;
+
+            int location = placement->second;
 
             assert(location < nele_hess);
             assert(location >= 0);
 
-            values[location] += lambda[C->index] * E.second;
+            values[location] += lambda[k] * E.second;
         }
     }
 
@@ -489,13 +756,87 @@ bool IpoptProblem::get_scaling_parameters(Number& obj_scaling, [[maybe_unused]]
     return (true);
 }
 
-void IpoptProblem::finalize_solution(SolverReturn status, [[maybe_unused]] Index n, const Number* x,
-    [[maybe_unused]] const Number* z_L, [[maybe_unused]] const Number* z_U, [[maybe_unused]] Index m,
-    [[maybe_unused]] const Number* g, [[maybe_unused]] const Number* lambda, Number obj_value,
-    [[maybe_unused]] const IpoptData* ip_data, [[maybe_unused]] IpoptCalculatedQuantities* ip_cq)
+bool IpoptProblem::intermediate_callback(AlgorithmMode mode, Index iter, Number obj_value, Number inf_pr,
+    [[maybe_unused]] Number inf_du, [[maybe_unused]] Number mu, [[maybe_unused]] Number d_norm,
+    [[maybe_unused]] Number regularization_size, [[maybe_unused]] Number alpha_du, [[maybe_unused]] Number alpha_pr,
+    [[maybe_unused]] Index ls_trials, [[maybe_unused]] const IpoptData* ip_data,
+    [[maybe_unused]] IpoptCalculatedQuantities* ip_cq)
 {
-    int numberOfVariables = sourceProblem->properties.numberOfVariables;
+    numberOfIterations = iter;
+
+    if(cancellationToken && cancellationToken->load())
+    {
+        env->output->outputDebug("        Terminating Ipopt since another block of the problem is infeasible.");
+        earlyTerminationStatus = E_NLPSolutionStatus::Infeasible;
+        return (false);
+    }
+
+    if(iter >= iterationBudget)
+    {
+        env->output->outputDebug(
+            "        Terminating Ipopt since the iteration budget {} is reached.", iterationBudget);
+        earlyTerminationStatus = E_NLPSolutionStatus::IterationLimit;
+        return (false);
+    }
+
+    if(solveTimer.elapsed() >= timeBudget)
+    {
+        env->output->outputDebug("        Terminating Ipopt since the time budget {} s is reached.", timeBudget);
+        earlyTerminationStatus = E_NLPSolutionStatus::TimeLimit;
+        return (false);
+    }
+
+    if(!useCutoff || mode != RegularMode)
+        return (true);
+
+    if(inf_pr > feasibilityTolerance)
+    {
+        feasibleObjectiveValues.clear();
+        return (true);
+    }
+
+    // The objective values are compared as for a minimization problem
+    bool isMinimize = sourceProblem->objectiveFunction->properties.isMinimize;
+    double objectiveValue = isMinimize ? obj_value : -obj_value;
+    double cutoff = isMinimize ? cutoffObjectiveValue : -cutoffObjectiveValue;
+    cutoff += relativeCutoffTolerance * std::max(1.0, std::abs(cutoff));
+
+    if(objectiveValue <= cutoff)
+    {
+        feasibleObjectiveValues.clear();
+        return (true);
+    }
+
+    // The solve is terminated if the objective value cannot reach the cutoff within the iteration budget when
+    // decreasing as in the last feasible iterations. This is a heuristic, so the result is not a proof that the problem
+    // has no better solution.
+    feasibleObjectiveValues.push_back(objectiveValue);
+
+    if(feasibleObjectiveValues.size() > objectiveTrendIterations)
+        feasibleObjectiveValues.pop_front();
 
+    if(feasibleObjectiveValues.size() == objectiveTrendIterations)
+    {
+        double decrease = (feasibleObjectiveValues.front() - objectiveValue) / (objectiveTrendIterations - 1);
+
+        if(decrease <= 0.0 || objectiveValue - decrease * (double)(iterationBudget - iter) > cutoff)
+        {
+            env->output->outputDebug("        Terminating Ipopt since the objective value {} is not decreasing fast "
+                                     "enough to improve on {}.",
+                objectiveValue, cutoff);
+            earlyTerminationStatus = E_NLPSolutionStatus::Cutoff;
+            return (false);
+        }
+    }
+
+    return (true);
+}
+
+void IpoptProblem::finalize_solution(SolverReturn status, Index n, const Number* x, const Number* z_L,
+    const Number* z_U, Index m,
+    [[maybe_unused]] const Number* g, const Number* lambda, Number obj_value,
+    [[maybe_unused]] const IpoptData* ip_data, [[maybe_unused]] IpoptCalculatedQuantities* ip_cq)
+{
     switch(status)
     {
     case SUCCESS:
@@ -503,10 +844,7 @@ void IpoptProblem::finalize_solution(SolverReturn status, [[maybe_unused]] Index
             = "Algorithm terminated normally at a locally optimal point satisfying the convergence tolerances.";
 
         solutionStatus = E_NLPSolutionStatus::Optimal;
-        variableSolution = VectorDouble(numberOfVariables);
-
-        for(int i = 0; i < numberOfVariables; i++)
-            variableSolution[i] = x[i];
+        variableSolution = getFullSpacePoint(x);
 
         objectiveValue = obj_value;
         hasSolution = true;
@@ -521,10 +859,7 @@ void IpoptProblem::finalize_solution(SolverReturn status, [[maybe_unused]] Index
         if(x != nullptr)
         {
             hasSolution = true;
-            variableSolution = VectorDouble(numberOfVariables);
-
-            for(int i = 0; i < numberOfVariables; i++)
-                variableSolution[i] = x[i];
+            variableSolution = getFullSpacePoint(x);
 
             objectiveValue = obj_value;
         }
@@ -539,10 +874,7 @@ void IpoptProblem::finalize_solution(SolverReturn status, [[maybe_unused]] Index
         if(x != nullptr)
         {
             hasSolution = true;
-            variableSolution = VectorDouble(numberOfVariables);
-
-            for(int i = 0; i < numberOfVariables; i++)
-                variableSolution[i] = x[i];
+            variableSolution = getFullSpacePoint(x);
 
             objectiveValue = obj_value;
         }
@@ -558,10 +890,7 @@ void IpoptProblem::finalize_solution(SolverReturn status, [[maybe_unused]] Index
         if(x != nullptr)
         {
             hasSolution = true;
-            variableSolution = VectorDouble(numberOfVariables);
-
-            for(int i = 0; i < numberOfVariables; i++)
-                variableSolution[i] = x[i];
+            variableSolution = getFullSpacePoint(x);
 
             objectiveValue = obj_value;
         }
@@ -583,10 +912,7 @@ void IpoptProblem::finalize_solution(SolverReturn status, [[maybe_unused]] Index
         if(x != nullptr)
         {
             hasSolution = true;
-            variableSolution = VectorDouble(numberOfVariables);
-
-            for(int i = 0; i < numberOfVariables; i++)
-                variableSolution[i] = x[i];
+            variableSolution = getFullSpacePoint(x);
 
             objectiveValue = obj_value;
         }
@@ -601,10 +927,7 @@ void IpoptProblem::finalize_solution(SolverReturn status, [[maybe_unused]] Index
         if(x != nullptr)
         {
             hasSolution = true;
-            variableSolution = VectorDouble(numberOfVariables);
-
-            for(int i = 0; i < numberOfVariables; i++)
-                variableSolution[i] = x[i];
+            variableSolution = getFullSpacePoint(x);
 
             objectiveValue = obj_value;
         }
@@ -619,10 +942,7 @@ void IpoptProblem::finalize_solution(SolverReturn status, [[maybe_unused]] Index
         if(x != nullptr)
         {
             hasSolution = true;
-            variableSolution = VectorDouble(numberOfVariables);
-
-            for(int i = 0; i < numberOfVariables; i++)
-                variableSolution[i] = x[i];
+            variableSolution = getFullSpacePoint(x);
 
             objectiveValue = obj_value;
         }
@@ -637,10 +957,7 @@ void IpoptProblem::finalize_solution(SolverReturn status, [[maybe_unused]] Index
         if(x != nullptr)
         {
             hasSolution = true;
-            variableSolution = VectorDouble(numberOfVariables);
-
-            for(int i = 0; i < numberOfVariables; i++)
-                variableSolution[i] = x[i];
+            variableSolution = getFullSpacePoint(x);
 
             objectiveValue = obj_value;
         }
@@ -655,10 +972,7 @@ void IpoptProblem::finalize_solution(SolverReturn status, [[maybe_unused]] Index
         if(x != nullptr)
         {
             hasSolution = true;
-            variableSolution = VectorDouble(numberOfVariables);
-
-            for(int i = 0; i < numberOfVariables; i++)
-                variableSolution[i] = x[i];
+            variableSolution = getFullSpacePoint(x);
 
             objectiveValue = obj_value;
         }
@@ -673,10 +987,7 @@ void IpoptProblem::finalize_solution(SolverReturn status, [[maybe_unused]] Index
         if(x != nullptr)
         {
             hasSolution = true;
-            variableSolution = VectorDouble(numberOfVariables);
-
-            for(int i = 0; i < numberOfVariables; i++)
-                variableSolution[i] = x[i];
+            variableSolution = getFullSpacePoint(x);
 
             objectiveValue = obj_value;
         }
@@ -689,6 +1000,26 @@ void IpoptProblem::finalize_solution(SolverReturn status, [[maybe_unused]] Index
         solutionStatus = E_NLPSolutionStatus::Error;
     }
 
+    constraintMultipliers.assign(sourceProblem->properties.numberOfNumericConstraints, 0.0);
+
+    if(lambda != nullptr)
+    {
+        for(int i = 0; i < m; i++)
+            constraintMultipliers[reducedConstraintIndexes[i]] = lambda[i];
+    }
+
+    lowerBoundMultipliers.assign(sourceProblem->properties.numberOfVariables, 0.0);
+    upperBoundMultipliers.assign(sourceProblem->properties.numberOfVariables, 0.0);
+
+    if(z_L != nullptr && z_U != nullptr)
+    {
+        for(int i = 0; i < n; i++)
+        {
+            lowerBoundMultipliers[reducedVariableIndexes[i]] = z_L[i];
+            upperBoundMultipliers[reducedVariableIndexes[i]] = z_U[i];
+        }
+    }
+
     env->output->outputDebug("        Ipopt terminated with status: " + solutionDescription);
 }
 
@@ -698,19 +1029,78 @@ E_NLPSolutionStatus NLPSolverIpoptBase::solveProblemInstance()
 
     E_NLPSolutionStatus status;
 
-    try
+    updateEarlyTermination();
+    updateWarmStart();
+
+    ipoptProblem->useReducedSpace = env->settings->getSetting<bool>("Ipopt.ReducedSpace", "Subsolver");
+
+    if(!ipoptProblem->updateReducedSpace(
+           env->settings->getSetting<double>("Ipopt.ConstraintViolationTolerance", "Subsolver")))
     {
-        Ipopt::ApplicationReturnStatus ipoptStatus;
+        ipoptProblem->hasSolution = false;
+        ipoptProblem->solutionStatus = E_NLPSolutionStatus::Infeasible;
 
-        if(!hasBeenSolved)
-        {
-            ipoptStatus = ipoptApplication->OptimizeTNLP(ipoptProblem);
-        }
-        else
-        {
-            ipoptStatus = ipoptApplication->ReOptimizeTNLP(ipoptProblem);
-            hasBeenSolved = true;
-        }
+        env->output->outputDebug(
+            "        No solution found to problem with Ipopt: Constraint with only fixed variables is violated.");
+        return (E_NLPSolutionStatus::Infeasible);
+    }
+
+    if(ipoptProblem->getNumberOfReducedVariables() == 0)
+    {
+        // All variables are fixed and all constraints are fulfilled, so there is nothing for Ipopt to solve
+        ipoptProblem->variableSolution = ipoptProblem->lowerBounds;
+        ipoptProblem->objectiveValue
+            = sourceProblem->objectiveFunction->calculateValue(ipoptProblem->variableSolution);
+        ipoptProblem->constraintMultipliers.assign(sourceProblem->properties.numberOfNumericConstraints, 0.0);
+        ipoptProblem->lowerBoundMultipliers.assign(sourceProblem->properties.numberOfVariables, 0.0);
+        ipoptProblem->upperBoundMultipliers.assign(sourceProblem->properties.numberOfVariables, 0.0);
+        ipoptProblem->hasSolution = true;
+        ipoptProblem->solutionStatus = E_NLPSolutionStatus::Optimal;
+
+        env->output->outputDebug("        All variables are fixed, Ipopt is not called.");
+        return (E_NLPSolutionStatus::Optimal);
+    }
+
+    updateHessianApproximation();
+
+    std::vector<ProblemBlock> blocks;
+
+    if(ipoptProblem->useReducedSpace && env->settings->getSetting<bool>("Ipopt.Decomposition.Use", "Subsolver"))
+        blocks = sourceProblem->getIndependentBlocks(ipoptProblem->lowerBounds, ipoptProblem->upperBounds);
+
+    if(blocks.size() > 1)
+        status = solveBlocks(blocks);
+    else
+        status = optimize(ipoptApplication, ipoptProblem);
+
+    if(!ipoptProblem->earlyTerminationStatus
+        && (status == E_NLPSolutionStatus::Optimal || status == E_NLPSolutionStatus::Feasible))
+    {
+        previousIterations.push_back(ipoptProblem->numberOfIterations);
+        previousTimes.push_back(ipoptProblem->solveTimer.elapsed());
+    }
+
+    // The environment is not updated here since the solver instances can be used concurrently
+    auto& statistics = ipoptProblem->useLimitedMemoryHessian ? limitedMemoryHessianStatistics : exactHessianStatistics;
+    statistics.numberOfProblems++;
+    statistics.numberOfIterations += ipoptProblem->numberOfIterations;
+    statistics.time += ipoptProblem->solveTimer.elapsed();
+
+    addToWarmStartCache(status);
+
+    env->output->outputDebug("        Finished solution of Ipopt problem.");
+
+    return (status);
+}
+
+E_NLPSolutionStatus NLPSolverIpoptBase::optimize(
+    SmartPtr<IpoptApplication> application, SmartPtr<IpoptProblem> problem)
+{
+    E_NLPSolutionStatus status;
+
+    try
+    {
+        Ipopt::ApplicationReturnStatus ipoptStatus = application->OptimizeTNLP(problem);
 
         switch(ipoptStatus)
         {
@@ -745,6 +1135,19 @@ E_NLPSolutionStatus NLPSolverIpoptBase::solveProblemInstance()
             env->output->outputDebug("        No solution found to problem with Ipopt: Diverging iterates.");
             break;
 
+        case Ipopt::ApplicationReturnStatus::User_Requested_Stop:
+            if(problem->earlyTerminationStatus)
+            {
+                status = problem->earlyTerminationStatus.value();
+                env->output->outputDebug("        No solution found to problem with Ipopt: Terminated early.");
+            }
+            else
+            {
+                status = E_NLPSolutionStatus::Error;
+                env->output->outputError(" Error when solving NLP problem with Ipopt.");
+            }
+            break;
+
         default:
             status = E_NLPSolutionStatus::Error;
             env->output->outputError(" Error when solving NLP problem with Ipopt.");
@@ -763,11 +1166,216 @@ E_NLPSolutionStatus NLPSolverIpoptBase::solveProblemInstance()
         status = E_NLPSolutionStatus::Error;
     }
 
-    env->output->outputDebug("        Finished solution of Ipopt problem.");
+    return (status);
+}
+
+E_NLPSolutionStatus NLPSolverIpoptBase::solveBlocks(const std::vector<ProblemBlock>& blocks)
+{
+    env->output->outputDebug("        Solving Ipopt problem as {} independent blocks.", blocks.size());
+
+    auto isBlockInfeasible = std::make_shared<std::atomic<bool>>(false);
+
+    std::vector<SmartPtr<IpoptProblem>> blockProblems;
+    std::vector<E_NLPSolutionStatus> blockStatuses(blocks.size(), E_NLPSolutionStatus::Infeasible);
+
+    // The cache is cleared when it has more objectives than there are variables, so that it does not grow without
+    // bound when the fixed variables change
+    if(blockObjectiveFunctions.size() + blocks.size() > (size_t)sourceProblem->properties.numberOfVariables)
+        blockObjectiveFunctions.clear();
+
+    for(auto& B : blocks)
+    {
+        SmartPtr<IpoptProblem> blockProblem = new IpoptProblem(env, sourceProblem);
+
+        blockProblem->block = std::make_shared<ProblemBlock>(B);
+
+        auto& blockObjective = blockObjectiveFunctions[B.variableIndexes];
+
+        if(!blockObjective)
+            blockObjective = sourceProblem->createBlockObjectiveFunction(B);
+
+        blockProblem->objectiveFunction = blockObjective;
+        blockProblem->cancellationToken = isBlockInfeasible;
+
+        blockProblem->lowerBounds = ipoptProblem->lowerBounds;
+        blockProblem->upperBounds = ipoptProblem->upperBounds;
+        blockProblem->startingPointVariableIndexes = ipoptProblem->startingPointVariableIndexes;
+        blockProblem->startingPointVariableValues = ipoptProblem->startingPointVariableValues;
+        blockProblem->warmStart = ipoptProblem->warmStart;
+        blockProblem->divergingIterativesTolerance = ipoptProblem->divergingIterativesTolerance;
+        blockProblem->iterationBudget = ipoptProblem->iterationBudget;
+        blockProblem->timeBudget = ipoptProblem->timeBudget;
+        blockProblem->feasibilityTolerance = ipoptProblem->feasibilityTolerance;
+        blockProblem->useLimitedMemoryHessian = ipoptProblem->useLimitedMemoryHessian;
+        blockProblem->useReducedSpace = ipoptProblem->useReducedSpace;
+
+        // The objective value of a block only includes its own terms, so it cannot be compared to the primal bound
+        blockProblem->useCutoff = false;
+
+        blockProblem->resetIterationData();
+        blockProblem->updateReducedSpace(
+            env->settings->getSetting<double>("Ipopt.ConstraintViolationTolerance", "Subsolver"));
+
+        blockProblems.push_back(blockProblem);
+    }
+
+    auto solveBlock = [&](size_t k, SmartPtr<IpoptApplication> application)
+    {
+        if(isBlockInfeasible->load())
+            return;
+
+        blockStatuses[k] = optimize(application, blockProblems[k]);
+
+        if(blockStatuses[k] == E_NLPSolutionStatus::Infeasible)
+            isBlockInfeasible->store(true);
+    };
+
+    size_t numberOfWorkers = std::min(
+        (size_t)env->settings->getSetting<int>("Ipopt.Decomposition.NumberOfThreads", "Subsolver"), blocks.size());
+
+    if(numberOfWorkers <= 1)
+    {
+        for(size_t k = 0; k < blocks.size(); k++)
+            solveBlock(k, ipoptApplication);
+    }
+    else
+    {
+        // The other threads use their own applications, with the options of the one for the full problem since these
+        // may change between the solves
+        while(blockApplications.size() + 1 < numberOfWorkers)
+        {
+            SmartPtr<IpoptApplication> application = new IpoptApplication(false);
+            *application->Options() = *ipoptApplication->Options();
+            application->Initialize();
+
+            blockApplications.push_back(application);
+        }
+
+        for(size_t w = 1; w < numberOfWorkers; w++)
+            *blockApplications[w - 1]->Options() = *ipoptApplication->Options();
+
+        std::vector<std::thread> workers;
+        workers.reserve(numberOfWorkers);
+
+        for(size_t w = 0; w < numberOfWorkers; w++)
+        {
+            workers.emplace_back([&, w]() {
+                auto application = (w == 0) ? ipoptApplication : blockApplications[w - 1];
+
+                for(size_t k = w; k < blocks.size(); k += numberOfWorkers)
+                    solveBlock(k, application);
+            });
+        }
+
+        for(auto& W : workers)
+            W.join();
+    }
+
+    // The problem is infeasible if any block is. Otherwise the status is the first one that is neither optimal nor
+    // feasible, or feasible if not all blocks are optimal. The blocks that were not solved are left as infeasible.
+    E_NLPSolutionStatus status = E_NLPSolutionStatus::Optimal;
+
+    for(auto S : blockStatuses)
+    {
+        if(S == E_NLPSolutionStatus::Infeasible)
+        {
+            status = E_NLPSolutionStatus::Infeasible;
+            break;
+        }
+
+        if(status != E_NLPSolutionStatus::Optimal && status != E_NLPSolutionStatus::Feasible)
+            continue;
+
+        if(S != E_NLPSolutionStatus::Optimal)
+            status = S;
+    }
+
+    ipoptProblem->solutionStatus = status;
+    ipoptProblem->numberOfIterations = 0;
+    ipoptProblem->hasSolution = std::all_of(
+        blockProblems.begin(), blockProblems.end(), [](auto const& P) { return (P->hasSolution); });
+
+    ipoptProblem->variableSolution = ipoptProblem->lowerBounds;
+    ipoptProblem->constraintMultipliers.assign(sourceProblem->properties.numberOfNumericConstraints, 0.0);
+    ipoptProblem->lowerBoundMultipliers.assign(sourceProblem->properties.numberOfVariables, 0.0);
+    ipoptProblem->upperBoundMultipliers.assign(sourceProblem->properties.numberOfVariables, 0.0);
+
+    for(size_t k = 0; k < blocks.size(); k++)
+    {
+        auto& P = blockProblems[k];
+
+        // The iterations of the blocks solved in parallel overlap, so the largest number is used for the budgets
+        ipoptProblem->numberOfIterations = std::max(ipoptProblem->numberOfIterations, P->numberOfIterations);
+
+        if(!P->hasSolution)
+            continue;
+
+        for(auto& I : blocks[k].variableIndexes)
+        {
+            ipoptProblem->variableSolution[I] = P->variableSolution[I];
+            ipoptProblem->lowerBoundMultipliers[I] = P->lowerBoundMultipliers[I];
+            ipoptProblem->upperBoundMultipliers[I] = P->upperBoundMultipliers[I];
+        }
+
+        for(auto& I : blocks[k].constraintIndexes)
+            ipoptProblem->constraintMultipliers[I] = P->constraintMultipliers[I];
+    }
+
+    if(ipoptProblem->hasSolution)
+    {
+        ipoptProblem->objectiveValue
+            = sourceProblem->objectiveFunction->calculateValue(ipoptProblem->variableSolution);
+    }
+
+    env->output->outputDebug("        Finished solution of {} Ipopt blocks.", blocks.size());
 
     return (status);
 }
 
+void NLPSolverIpoptBase::updateHessianApproximation()
+{
+    auto mode = static_cast<ES_IpoptHessianApproximation>(
+        env->settings->getSetting<int>("Ipopt.HessianApproximation.Mode", "Subsolver"));
+
+    bool useLimitedMemory = (mode == ES_IpoptHessianApproximation::LimitedMemory);
+
+    if(mode == ES_IpoptHessianApproximation::Automatic)
+    {
+        if(firstUseLimitedMemoryHessian
+            && !env->settings->getSetting<bool>("Ipopt.HessianApproximation.PerProblem", "Subsolver"))
+        {
+            useLimitedMemory = firstUseLimitedMemoryHessian.value();
+        }
+        else
+        {
+            int numberOfNonzeros;
+            double density;
+            double costRatio;
+
+            ipoptProblem->estimateHessianCost(numberOfNonzeros, density, costRatio);
+
+            // BFGS usually needs more iterations, so it only pays off if the exact Hessian is large and either dense,
+            // which makes the factorization of the KKT system expensive, or expensive to evaluate
+            useLimitedMemory = numberOfNonzeros
+                    >= env->settings->getSetting<int>("Ipopt.HessianApproximation.MinimumNonzeros", "Subsolver")
+                && (density >= env->settings->getSetting<double>("Ipopt.HessianApproximation.DensityLimit", "Subsolver")
+                    || costRatio
+                        >= env->settings->getSetting<double>("Ipopt.HessianApproximation.CostRatioLimit", "Subsolver"));
+
+            env->output->outputDebug("        Hessian has {} nonzeroes with density {:.3f} and cost ratio {:.1f}, "
+                                     "using {} Hessian in Ipopt.",
+                numberOfNonzeros, density, costRatio, useLimitedMemory ? "limited-memory" : "exact");
+
+            if(!firstUseLimitedMemoryHessian)
+                firstUseLimitedMemoryHessian = useLimitedMemory;
+        }
+    }
+
+    ipoptProblem->useLimitedMemoryHessian = useLimitedMemory;
+    ipoptApplication->Options()->SetStringValue(
+        "hessian_approximation", useLimitedMemory ? "limited-memory" : "exact");
+}
+
 double NLPSolverIpoptBase::getSolution(int i) { return (ipoptProblem->variableSolution[i]); }
 
 double NLPSolverIpoptBase::getObjectiveValue() { return (ipoptProblem->objectiveValue); }
@@ -840,6 +1448,22 @@ void NLPSolverIpoptBase::clearStartingPoint()
     setSolverSpecificInitialSettings();
 }
 
+void NLPSolverIpoptBase::updateSolutionStatistics()
+{
+    auto& statistics = env->solutionStatistics;
+
+    statistics.numberOfProblemsNLPExactHessian += exactHessianStatistics.numberOfProblems;
+    statistics.numberOfIterationsNLPExactHessian += exactHessianStatistics.numberOfIterations;
+    statistics.timeNLPExactHessian += exactHessianStatistics.time;
+
+    statistics.numberOfProblemsNLPLimitedMemoryHessian += limitedMemoryHessianStatistics.numberOfProblems;
+    statistics.numberOfIterationsNLPLimitedMemoryHessian += limitedMemoryHessianStatistics.numberOfIterations;
+    statistics.timeNLPLimitedMemoryHessian += limitedMemoryHessianStatistics.time;
+
+    exactHessianStatistics = HessianStatistics();
+    limitedMemoryHessianStatistics = HessianStatistics();
+}
+
 VectorDouble NLPSolverIpoptBase::getVariableLowerBounds() { return (ipoptProblem->lowerBounds); }
 
 VectorDouble NLPSolverIpoptBase::getVariableUpperBounds() { return (ipoptProblem->upperBounds); }
@@ -883,7 +1507,6 @@ void NLPSolverIpoptBase::setInitialSettings()
     }
 
     // ipoptApplication->Options()->SetStringValue("fixed_variable_treatment", "make_parameter");
-    // ipoptApplication->Options()->SetStringValue("hessian_approximation", "limited-memory");
 
     if(!env->settings->getSetting<bool>("Console.PrimalSolver.Show", "Output"))
     {
@@ -900,7 +1523,9 @@ void NLPSolverIpoptBase::setInitialSettings()
     ipoptApplication->Options()->SetStringValue("ma86_order", "auto", true, true);
     ipoptApplication->Options()->SetStringValue("mu_oracle", "probing", true, true);
     ipoptApplication->Options()->SetStringValue("expect_infeasible_problem", "yes", true, true);
-    // ipoptApplication->Options()->SetStringValue("warm_start_init_point", "yes", true, true);
+    // Used when warm starting from a previous solution, see updateWarmStart
+    ipoptApplication->Options()->SetNumericValue("warm_start_bound_push", 1e-9, true, true);
+    ipoptApplication->Options()->SetNumericValue("warm_start_mult_bound_push", 1e-9, true, true);
     ipoptApplication->Options()->SetNumericValue("gamma_phi", 1e-8, true, true);
     ipoptApplication->Options()->SetNumericValue("gamma_theta", 1e-4, true, true);
     ipoptApplication->Options()->SetNumericValue("required_infeasibility_reduction", 0.1, true, true);
@@ -1038,6 +1663,99 @@ void NLPSolverIpoptBase::updateVariableUpperBound(int variableIndex, double boun
     ipoptProblem->upperBounds[variableIndex] = bound;
 }
 
+void NLPSolverIpoptBase::updateEarlyTermination()
+{
+    ipoptProblem->resetIterationData();
+
+    ipoptProblem->useCutoff = false;
+    ipoptProblem->iterationBudget = std::numeric_limits<int>::max();
+    ipoptProblem->timeBudget = SHOT_DBL_MAX;
+    ipoptProblem->feasibilityTolerance
+        = env->settings->getSetting<double>("Ipopt.ConstraintViolationTolerance", "Subsolver");
+
+    if(!env->settings->getSetting<bool>("Ipopt.EarlyTermination.Use", "Subsolver"))
+        return;
+
+    // A solution to the NLP problem is only of interest if it improves on the primal bound
+    if(double primalBound = env->results->getPrimalBound();
+        !std::isnan(primalBound) && std::abs(primalBound) < SHOT_DBL_MAX)
+    {
+        ipoptProblem->useCutoff = true;
+        ipoptProblem->cutoffObjectiveValue = primalBound;
+    }
+
+    double budgetFactor = env->settings->getSetting<double>("Ipopt.EarlyTermination.BudgetFactor", "Subsolver");
+
+    if(budgetFactor > 0.0 && previousIterations.size() >= minimumSolvesForBudget)
+    {
+        double averageIterations
+            = std::accumulate(previousIterations.begin(), previousIterations.end(), 0.0) / previousIterations.size();
+        double averageTime = std::accumulate(previousTimes.begin(), previousTimes.end(), 0.0) / previousTimes.size();
+
+        ipoptProblem->iterationBudget
+            = std::max(minimumIterationBudget, (int)std::ceil(budgetFactor * averageIterations));
+        ipoptProblem->timeBudget = std::max(minimumTimeBudget, budgetFactor * averageTime);
+    }
+}
+
+VectorInteger NLPSolverIpoptBase::getIntegerAssignment()
+{
+    VectorInteger assignment;
+    assignment.reserve(ipoptProblem->fixedVariableValues.size());
+
+    for(auto& V : ipoptProblem->fixedVariableValues)
+        assignment.push_back((int)std::round(V));
+
+    return (assignment);
+}
+
+void NLPSolverIpoptBase::updateWarmStart()
+{
+    ipoptProblem->warmStart = nullptr;
+
+    int cacheSize = env->settings->getSetting<int>("Ipopt.WarmStartCache.Size", "Subsolver");
+
+    if(cacheSize > 0 && !warmStartCache)
+        warmStartCache = std::make_unique<NLPWarmStartCache>(cacheSize);
+
+    if(cacheSize > 0 && ipoptProblem->fixedVariableIndexes.size() > 0)
+    {
+        // The solutions for assignments further away are usually worse starting points than a cold start
+        size_t maxDistance = env->settings->getSetting<int>("Ipopt.WarmStartCache.MaximumDistance", "Subsolver");
+        size_t distance;
+
+        if(auto nearest = warmStartCache->findNearest(getIntegerAssignment(), distance, maxDistance))
+        {
+            env->output->outputDebug(
+                "        Warm starting Ipopt from a previous solution with {} different discrete values.", distance);
+            ipoptProblem->warmStart = nearest;
+        }
+    }
+
+    ipoptApplication->Options()->SetStringValue("warm_start_init_point", ipoptProblem->warmStart ? "yes" : "no");
+}
+
+void NLPSolverIpoptBase::addToWarmStartCache(E_NLPSolutionStatus status)
+{
+    if(!warmStartCache || ipoptProblem->fixedVariableIndexes.size() == 0)
+        return;
+
+    if(status != E_NLPSolutionStatus::Optimal && status != E_NLPSolutionStatus::Feasible)
+        return;
+
+    if(!ipoptProblem->hasSolution || ipoptProblem->variableSolution.size() == 0)
+        return;
+
+    auto entry = std::make_shared<NLPWarmStartCache::Entry>();
+    entry->assignment = getIntegerAssignment();
+    entry->variableValues = ipoptProblem->variableSolution;
+    entry->constraintMultipliers = ipoptProblem->constraintMultipliers;
+    entry->lowerBoundMultipliers = ipoptProblem->lowerBoundMultipliers;
+    entry->upperBoundMultipliers = ipoptProblem->upperBoundMultipliers;
+
+    warmStartCache->add(entry);
+}
+
 void NLPSolverIpoptBase::updateSettings() {}
 
 void NLPSolverIpoptBase::saveOptionsToFile([[maybe_unused]] std::string fileName) {}
@@ -10,11 +10,19 @@
 
 #pragma once
 #include "NLPSolverBase.h"
+#include "NLPWarmStartCache.h"
 
 #include "IpTNLP.hpp"
 #include "IpIpoptApplication.hpp"
 #include "IpJournalist.hpp"
 
+#include <atomic>
+#include <deque>
+#include <map>
+#include <optional>
+
+#include "../Timer.h"
+
 #include "../Model/Problem.h"
 
 namespace SHOT
@@ -69,10 +77,72 @@ public:
 
     double divergingIterativesTolerance = 1e20;
 
+    // If true, the variables with equal bounds, e.g., the discrete variables in the fixed-integer NLP problems, are not
+    // passed to Ipopt; instead their values are substituted into the objective and constraints. Constraints that only
+    // contain such variables are removed as well. Set from Ipopt.ReducedSpace before each solve.
+    bool useReducedSpace = false;
+
+    // The constraint multipliers for all constraints and the bound multipliers for all variables in the source problem,
+    // zero for the removed constraints and fixed variables
+    VectorDouble constraintMultipliers;
+    VectorDouble lowerBoundMultipliers;
+    VectorDouble upperBoundMultipliers;
+
+    // A previous solution used as the primal and dual starting point instead of the one given if set
+    NLPWarmStartCache::EntryPtr warmStart;
+
+    // If true, the solve is terminated in intermediate_callback as soon as the objective value cannot be better than
+    // cutoffObjectiveValue, e.g., the current primal bound when solving fixed-integer NLP problems
+    bool useCutoff = false;
+    double cutoffObjectiveValue = SHOT_DBL_MAX;
+
+    // The solve is terminated in intermediate_callback when these are exceeded
+    int iterationBudget = std::numeric_limits<int>::max();
+    double timeBudget = SHOT_DBL_MAX;
+
+    // Iterates with a larger constraint violation are not compared to the cutoff
+    double feasibilityTolerance = 1e-8;
+
+    // The objective function evaluated in eval_f, eval_grad_f and eval_h, either the one in the source problem or the
+    // part of it with the terms in the block
+    ObjectiveFunctionPtr objectiveFunction;
+
+    // If set, only the variables in the block and its constraints are passed to Ipopt, the other variables that are not
+    // fixed are kept at their starting point values
+    std::shared_ptr<ProblemBlock> block;
+
+    // If set, e.g., when another block of the same problem is infeasible, the solve is terminated
+    std::shared_ptr<std::atomic<bool>> cancellationToken;
+
+    // If set, Ipopt approximates the Hessian of the Lagrangian with limited-memory BFGS and eval_h is not used
+    bool useLimitedMemoryHessian = false;
+
+    // Updated in intermediate_callback during the solve, earlyTerminationStatus is set if the solve is terminated
+    std::optional<E_NLPSolutionStatus> earlyTerminationStatus;
+    int numberOfIterations = 0;
+    Timer solveTimer = Timer("IpoptSolve");
+
     /** the IpoptProblemclass constructor */
     IpoptProblem(EnvironmentPtr envPtr, ProblemPtr problem);
     ~IpoptProblem() override = default;
 
+    // Determines the variables and constraints passed to Ipopt from the current bounds, must be called before each
+    // solve. Returns false if one of the removed constraints is violated by the fixed variable values.
+    bool updateReducedSpace(double constraintTolerance);
+
+    int getNumberOfReducedVariables() { return (reducedVariableIndexes.size()); }
+
+    // Estimates the cost of the exact Hessian of the Lagrangian in the reduced space, must be called after
+    // updateReducedSpace. The density is relative to the upper triangle in the nonlinear variables, and the cost ratio
+    // compares the work in evaluating the Hessian to that of the objective gradient and the Jacobian.
+    void estimateHessianCost(int& numberOfNonzeros, double& density, double& costRatio);
+
+    // Resets the values updated in intermediate_callback, must be called before each solve
+    void resetIterationData();
+
+    // Returns the point in the source problem given a point in the reduced space
+    VectorDouble getFullSpacePoint(const Ipopt::Number* x);
+
     /** IPOpt specific methods for defining the nlp problem */
     bool get_nlp_info(Ipopt::Index& n, Ipopt::Index& m, Ipopt::Index& nnz_jac_g, Ipopt::Index& nnz_h_lag,
         IndexStyleEnum& index_style) override;
@@ -126,6 +196,12 @@ public:
     bool get_scaling_parameters(Ipopt::Number& obj_scaling, bool& use_x_scaling, Ipopt::Index n,
         Ipopt::Number* x_scaling, bool& use_g_scaling, Ipopt::Index m, Ipopt::Number* g_scaling) override;
 
+    /** This method is called once per iteration and terminates the solve if false is returned */
+    bool intermediate_callback(Ipopt::AlgorithmMode mode, Ipopt::Index iter, Ipopt::Number obj_value,
+        Ipopt::Number inf_pr, Ipopt::Number inf_du, Ipopt::Number mu, Ipopt::Number d_norm,
+        Ipopt::Number regularization_size, Ipopt::Number alpha_du, Ipopt::Number alpha_pr, Ipopt::Index ls_trials,
+        const Ipopt::IpoptData* ip_data, Ipopt::IpoptCalculatedQuantities* ip_cq) override;
+
     /** This method is called when the algorithm is complete so the TNLP can store/write the solution */
     void finalize_solution(Ipopt::SolverReturn status, Ipopt::Index n, const Ipopt::Number* x, const Ipopt::Number* z_L,
         const Ipopt::Number* z_U, Ipopt::Index m, const Ipopt::Number* g, const Ipopt::Number* lambda,
@@ -137,15 +213,32 @@ private:
     ProblemPtr sourceProblem;
 
     std::map<std::pair<int, int>, int> lagrangianHessianCounterPlacement;
-    std::map<std::pair<int, int>, int> jacobianCounterPlacement;
+
+    // The variable and constraint indexes in the source problem of the variables and constraints passed to Ipopt, and
+    // the index in the reduced space of each variable in the source problem (-1 if it is fixed)
+    VectorInteger reducedVariableIndexes;
+    VectorInteger reducedConstraintIndexes;
+    VectorInteger variablePlacement;
+    int numberOfReducedNonlinearVariables = 0;
+
+    // The objective values of the last iterations that are feasible
+    std::deque<double> feasibleObjectiveValues;
+
+    // A point in the source problem with the values of the fixed variables, the other values are updated on evaluation
+    VectorDouble fullSpacePoint;
+
+    void updateFullSpacePoint(const Ipopt::Number* x);
+
+    // The Jacobian nonzeroes of constraint k are stored in positions jacobianConstraintOffsets[k] to
+    // jacobianConstraintOffsets[k + 1] - 1, and jacobianVariablePlacement is a scratch array indexed by variable
+    VectorInteger jacobianConstraintOffsets;
+    VectorInteger jacobianColumns;
+    VectorInteger jacobianVariablePlacement;
 };
 
 class NLPSolverIpoptBase : virtual public INLPSolver
 {
 
-private:
-    bool hasBeenSolved = false;
-
 protected:
     Ipopt::SmartPtr<IpoptProblem> ipoptProblem;
     ProblemPtr sourceProblem;
@@ -172,12 +265,60 @@ protected:
 
     std::vector<E_VariableType> originalVariableType;
 
+    // The number of iterations and the time used in the previous fixed-integer NLP solves that gave a solution, used to
+    // set the budgets for the next ones
+    VectorInteger previousIterations;
+    VectorDouble previousTimes;
+
+    void updateEarlyTermination();
+
+    // The Hessian mode chosen in the first solve, reused if it is not decided for each problem
+    std::optional<bool> firstUseLimitedMemoryHessian;
+
+    // Chooses between the exact and the limited-memory Hessian for the next solve
+    void updateHessianApproximation();
+
+    // The solves with exact and limited-memory Hessians since the last call to updateSolutionStatistics
+    struct HessianStatistics
+    {
+        int numberOfProblems = 0;
+        int numberOfIterations = 0;
+        double time = 0.0;
+    };
+
+    HessianStatistics exactHessianStatistics;
+    HessianStatistics limitedMemoryHessianStatistics;
+
+    // Solves the problem with the application and converts the Ipopt return status
+    E_NLPSolutionStatus optimize(
+        Ipopt::SmartPtr<Ipopt::IpoptApplication> application, Ipopt::SmartPtr<IpoptProblem> problem);
+
+    // Solves the independent blocks of the problem as separate Ipopt problems, and stores the combined solution in
+    // ipoptProblem. The remaining blocks are not solved if one of them is infeasible.
+    E_NLPSolutionStatus solveBlocks(const std::vector<ProblemBlock>& blocks);
+
+    // The applications used by the threads solving the blocks, created and initialized once. The first thread uses
+    // ipoptApplication.
+    std::vector<Ipopt::SmartPtr<Ipopt::IpoptApplication>> blockApplications;
+
+    // The objective functions of the blocks by their variable indexes, since the blocks are usually the same in
+    // consecutive solves
+    std::map<VectorInteger, ObjectiveFunctionPtr> blockObjectiveFunctions;
+
+    // The solutions of previous fixed-integer NLP problems by the values of the discrete variables
+    std::unique_ptr<NLPWarmStartCache> warmStartCache;
+    VectorInteger getIntegerAssignment();
+    void updateWarmStart();
+    void addToWarmStartCache(E_NLPSolutionStatus status);
+
 public:
     ~NLPSolverIpoptBase() = default;
 
     void setStartingPoint(VectorInteger variableIndexes, VectorDouble variableValues) override;
     void clearStartingPoint() override;
 
+    void updateSolutionStatistics() override;
+
     VectorDouble getSolution() override;
     double getSolution(int i) override;
     double getObjectiveValue() override;
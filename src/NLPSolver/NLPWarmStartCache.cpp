@@ -0,0 +1,148 @@
+/**
+   The Supporting Hyperplane Optimization Toolkit (SHOT).
+
+   @author Andreas Lundell, Åbo Akademi University
+
+   @section LICENSE
+   This software is licensed under the Eclipse Public License 2.0.
+   Please see the README and LICENSE files for more information.
+*/
+
+#include "NLPWarmStartCache.h"
+
+#include <algorithm>
+#include <functional>
+
+namespace SHOT
+{
+
+static size_t getHammingDistance(const VectorInteger& first, const VectorInteger& second)
+{
+    size_t distance = 0;
+
+    for(size_t i = 0; i < first.size(); i++)
+    {
+        if(first[i] != second[i])
+            distance++;
+    }
+
+    return (distance);
+}
+
+NLPWarmStartCache::NLPWarmStartCache(size_t maxSize, size_t numberOfBlocks)
+    : maxSize(maxSize), numberOfBlocks(std::max(numberOfBlocks, (size_t)1))
+{
+    blockIndexes.resize(this->numberOfBlocks);
+}
+
+std::vector<size_t> NLPWarmStartCache::getBlockKeys(const VectorInteger& assignment)
+{
+    std::vector<size_t> keys(numberOfBlocks, 0);
+
+    for(size_t i = 0; i < assignment.size(); i++)
+    {
+        auto& key = keys[i * numberOfBlocks / assignment.size()];
+        key ^= std::hash<int>()(assignment[i]) + 0x9e3779b9 + (key << 6) + (key >> 2);
+    }
+
+    return (keys);
+}
+
+void NLPWarmStartCache::addToIndex(size_t position)
+{
+    for(size_t b = 0; b < numberOfBlocks; b++)
+        blockIndexes[b][entryBlockKeys[position][b]].push_back(position);
+}
+
+void NLPWarmStartCache::removeFromIndex(size_t position)
+{
+    for(size_t b = 0; b < numberOfBlocks; b++)
+    {
+        auto positions = blockIndexes[b].find(entryBlockKeys[position][b]);
+        positions->second.erase(std::find(positions->second.begin(), positions->second.end(), position));
+
+        if(positions->second.empty())
+            blockIndexes[b].erase(positions);
+    }
+}
+
+void NLPWarmStartCache::add(EntryPtr entry)
+{
+    if(maxSize == 0)
+        return;
+
+    if(size_t distance; auto sameEntry = findNearest(entry->assignment, distance, 0))
+    {
+        *sameEntry = std::move(*entry);
+        return;
+    }
+
+    size_t position = entries.size();
+
+    if(entries.size() < maxSize)
+    {
+        entries.push_back(entry);
+        entryBlockKeys.push_back(getBlockKeys(entry->assignment));
+    }
+    else
+    {
+        position = nextPosition;
+        nextPosition = (nextPosition + 1) % maxSize;
+
+        removeFromIndex(position);
+        entries[position] = entry;
+        entryBlockKeys[position] = getBlockKeys(entry->assignment);
+    }
+
+    addToIndex(position);
+}
+
+NLPWarmStartCache::EntryPtr NLPWarmStartCache::findNearest(
+    const VectorInteger& assignment, size_t& distance, size_t maxDistance)
+{
+    EntryPtr nearest;
+    distance = assignment.size() + 1;
+
+    auto keys = getBlockKeys(assignment);
+
+    for(size_t b = 0; b < numberOfBlocks; b++)
+    {
+        auto positions = blockIndexes[b].find(keys[b]);
+
+        if(positions == blockIndexes[b].end())
+            continue;
+
+        for(auto P : positions->second)
+        {
+            if(entries[P]->assignment.size() != assignment.size())
+                continue;
+
+            if(size_t entryDistance = getHammingDistance(entries[P]->assignment, assignment); entryDistance < distance)
+            {
+                distance = entryDistance;
+                nearest = entries[P];
+            }
+        }
+    }
+
+    // The entries not sharing a block differ from the assignment in at least as many positions as there are blocks, so
+    // these only need to be compared if no closer entry has been found
+    if((nearest && distance < numberOfBlocks) || maxDistance < numberOfBlocks)
+        return ((distance <= maxDistance) ? nearest : nullptr);
+
+    for(auto& E : entries)
+    {
+        if(E->assignment.size() != assignment.size())
+            continue;
+
+        if(size_t entryDistance = getHammingDistance(E->assignment, assignment); entryDistance < distance)
+        {
+            distance = entryDistance;
+            nearest = E;
+        }
+    }
+
+    return ((distance <= maxDistance) ? nearest : nullptr);
+}
+
+} // namespace SHOT
@@ -0,0 +1,71 @@
+/**
+   The Supporting Hyperplane Optimization Toolkit (SHOT).
+
+   @author Andreas Lundell, Åbo Akademi University
+
+   @section LICENSE
+   This software is licensed under the Eclipse Public License 2.0.
+   Please see the README and LICENSE files for more information.
+*/
+
+#pragma once
+#include "../Structs.h"
+
+#include <cstdint>
+#include <memory>
+#include <unordered_map>
+
+namespace SHOT
+{
+
+// Stores the primal and dual solutions of fixed-integer NLP problems by the values of the fixed discrete variables, so
+// that a new NLP problem can be warm started from the solution with the closest integer assignment. The nearest
+// neighbour in Hamming distance is found by splitting the assignments into blocks: if two assignments differ in fewer
+// positions than there are blocks, at least one block is equal, so only the entries sharing a block with the new
+// assignment need to be compared. All entries are only compared if none does.
+class NLPWarmStartCache
+{
+public:
+    struct Entry
+    {
+        VectorInteger assignment;
+
+        // The values are given for all variables and constraints in the problem
+        VectorDouble variableValues;
+        VectorDouble constraintMultipliers;
+        VectorDouble lowerBoundMultipliers;
+        VectorDouble upperBoundMultipliers;
+    };
+
+    using EntryPtr = std::shared_ptr<Entry>;
+
+    NLPWarmStartCache(size_t maxSize, size_t numberOfBlocks = 4);
+
+    // Adds the entry, replacing the one with the same assignment or the oldest one if the cache is full
+    void add(EntryPtr entry);
+
+    // Returns the entry with the smallest Hamming distance to the assignment, nullptr if the cache has no entry within
+    // maxDistance
+    EntryPtr findNearest(const VectorInteger& assignment, size_t& distance, size_t maxDistance = SIZE_MAX);
+
+    size_t size() const { return (entries.size()); }
+
+private:
+    size_t maxSize;
+    size_t numberOfBlocks;
+
+    // Used as a ring buffer when full, nextPosition is the position of the oldest entry
+    std::vector<EntryPtr> entries;
+    std::vector<std::vector<size_t>> entryBlockKeys;
+    size_t nextPosition = 0;
+
+    // The positions of the entries for the key of each block
+    std::vector<std::unordered_map<size_t, std::vector<size_t>>> blockIndexes;
+
+    std::vector<size_t> getBlockKeys(const VectorInteger& assignment);
+
+    void addToIndex(size_t position);
+    void removeFromIndex(size_t position);
+};
+
+} // namespace SHOT
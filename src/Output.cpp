@@ -24,7 +24,7 @@ Output::Output()
     SetConsoleOutputCP(CP_UTF8); // For correct output of special characters on Windows
 #endif
 
-    consoleSink = std::make_shared<spdlog::sinks::stdout_sink_st>();
+    consoleSink = std::make_shared<spdlog::sinks::stdout_sink_mt>();
     std::vector<spdlog::sink_ptr> sinks { consoleSink };
     logger = std::make_shared<spdlog::logger>("multi_sink", sinks.begin(), sinks.end());
 
@@ -36,28 +36,44 @@ Output::Output()
 
 Output::~Output() = default;
 
-void Output::outputCritical(std::string message) { logger->critical(message); }
+void Output::logMessage(spdlog::level::level_enum level, const std::string& message)
+{
+    logger->log(level, message);
+
+    if(fileLogger)
+        fileLogger->log(level, message);
+}
 
-void Output::outputError(std::string message) { logger->error(message); }
+void Output::outputCritical(const std::string& message) { logMessage(spdlog::level::critical, message); }
 
-void Output::outputError(std::string message, std::string errormessage)
+void Output::outputError(const std::string& message) { logMessage(spdlog::level::err, message); }
+
+void Output::outputError(const std::string& message, const std::string& errormessage)
 {
-    logger->error("{}: \"{}\"", message, errormessage);
+    log(spdlog::level::err, "{}: \"{}\"", message, errormessage);
 }
 
-void Output::outputWarning(std::string message) { logger->warn(message); }
+void Output::outputWarning(const std::string& message) { logMessage(spdlog::level::warn, message); }
 
-void Output::outputInfo(std::string message) { logger->info(message); }
+void Output::outputInfo(const std::string& message) { logMessage(spdlog::level::info, message); }
 
-void Output::outputDebug(std::string message) { logger->debug(message); }
+void Output::outputDebug(const std::string& message) { logMessage(spdlog::level::debug, message); }
 
-void Output::outputTrace([[maybe_unused]] std::string message)
+void Output::outputTrace([[maybe_unused]] const std::string& message)
 {
 #ifndef NDEBUG
-    logger->trace(message);
+    logMessage(spdlog::level::trace, message);
 #endif
 }
 
+void Output::flush()
+{
+    logger->flush();
+
+    if(fileLogger)
+        fileSink->flushAndWait(*fileLogger);
+}
+
 void Output::setLogLevels(E_LogLevel consoleLogLevel, E_LogLevel fileLogLevel)
 {
     // Sets the correct log levels
@@ -132,15 +148,11 @@ void Output::setLogLevels(E_LogLevel consoleLogLevel, E_LogLevel fileLogLevel)
             break;
         }
 
-    // Also set the level for the main logger
-    if((int)consoleLogLevel <= (int)fileLogLevel)
-    {
-        logger->set_level((spdlog::level::level_enum)consoleLogLevel);
-    }
-    else
-    {
-        logger->set_level((spdlog::level::level_enum)fileLogLevel);
-    }
+    // Also set the levels for the loggers, which are checked before the messages are formatted
+    logger->set_level((spdlog::level::level_enum)consoleLogLevel);
+
+    if(fileLogger != NULL)
+        fileLogger->set_level((spdlog::level::level_enum)fileLogLevel);
 }
 
 void Output::setConsoleSink(std::shared_ptr<spdlog::sinks::sink> newSink)
@@ -157,14 +169,56 @@ void Output::setConsoleSink(std::shared_ptr<spdlog::sinks::sink> newSink)
 
 void Output::setFileSink(std::string filename)
 {
-    fileSink = std::make_shared<spdlog::sinks::basic_file_sink_st>(filename, true);
+    fileSink = std::make_shared<LogFileSink>(filename);
     fileSink->set_pattern("%v");
     fileSink->set_level(consoleSink->level());
 
-    std::vector<spdlog::sink_ptr> sinks { consoleSink, fileSink };
-    logger = std::make_shared<spdlog::logger>("multi_sink", sinks.begin(), sinks.end());
+    // The messages already queued for a previous log file are written before its thread is stopped
+    fileLogger.reset();
+    fileThreadPool.reset();
 
-    logger->set_pattern("%v");
+    // When the queue is full, the solver waits for the messages to be written instead of dropping them
+    fileThreadPool = std::make_shared<spdlog::details::thread_pool>(8192, 1);
+    fileLogger = std::make_shared<spdlog::async_logger>(
+        "file", fileSink, fileThreadPool, spdlog::async_overflow_policy::block);
+
+    fileLogger->set_pattern("%v");
+    fileLogger->set_level(logger->level());
+}
+
+void LogFileSink::flushAndWait(spdlog::async_logger& logger)
+{
+    size_t flushNumber;
+
+    {
+        std::lock_guard<std::mutex> lock(flushMutex);
+        flushNumber = ++numberOfRequestedFlushes;
+    }
+
+    // The flush is queued after the messages already logged
+    logger.flush();
+
+    std::unique_lock<std::mutex> lock(flushMutex);
+    flushed.wait(lock, [&] { return (numberOfFlushes >= flushNumber); });
+}
+
+void LogFileSink::sink_it_(const spdlog::details::log_msg& message)
+{
+    spdlog::memory_buf_t formatted;
+    formatter_->format(message, formatted);
+    file.write(formatted);
+}
+
+void LogFileSink::flush_()
+{
+    file.flush();
+
+    {
+        std::lock_guard<std::mutex> lock(flushMutex);
+        numberOfFlushes++;
+    }
+
+    flushed.notify_all();
 }
 
 int OutputStream::overflow(int c)
@@ -178,11 +232,11 @@ int OutputStream::overflow(int c)
         switch(logLevel)
         {
         case(E_LogLevel::Info):
-            env->output->outputInfo(fmt::format("      | {} ", ss.str()));
+            env->output->outputInfo("      | {} ", ss.str());
             break;
 
         case(E_LogLevel::Debug):
-            env->output->outputDebug(fmt::format("      | {} ", ss.str()));
+            env->output->outputDebug("      | {} ", ss.str());
             break;
 
         case(E_LogLevel::Error):
@@ -190,11 +244,11 @@ int OutputStream::overflow(int c)
             break;
 
         case(E_LogLevel::Warning):
-            env->output->outputWarning(fmt::format("      | {} ", ss.str()));
+            env->output->outputWarning("      | {} ", ss.str());
             break;
 
         case(E_LogLevel::Trace):
-            env->output->outputTrace(fmt::format("      | {} ", ss.str()));
+            env->output->outputTrace("      | {} ", ss.str());
             break;
 
         default:
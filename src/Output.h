@@ -11,28 +11,84 @@
 #pragma once
 #include "Enums.h"
 #include "Structs.h"
+
+#include <condition_variable>
 #include <memory>
+#include <mutex>
 
 #include "spdlog/spdlog.h"
+#include "spdlog/async.h"
+#include "spdlog/details/file_helper.h"
+#include "spdlog/sinks/base_sink.h"
 #include "spdlog/sinks/stdout_sinks.h"
-#include "spdlog/sinks/basic_file_sink.h"
 
 namespace SHOT
 {
 
+// A file sink that keeps track of when the messages have been written, since this is done by a background thread
+class LogFileSink : public spdlog::sinks::base_sink<std::mutex>
+{
+public:
+    LogFileSink(const std::string& filename) { file.open(filename, true); }
+
+    // Makes the logger write its queued messages and waits until they are in the file
+    void flushAndWait(spdlog::async_logger& logger);
+
+protected:
+    void sink_it_(const spdlog::details::log_msg& message) override;
+    void flush_() override;
+
+private:
+    spdlog::details::file_helper file;
+
+    std::mutex flushMutex;
+    std::condition_variable flushed;
+    size_t numberOfRequestedFlushes = 0;
+    size_t numberOfFlushes = 0;
+};
+
 class DllExport Output
 {
 public:
     Output();
     virtual ~Output();
 
-    void outputCritical(std::string message);
-    void outputError(std::string message);
-    void outputError(std::string message, std::string errormessage);
-    void outputWarning(std::string message);
-    void outputInfo(std::string message);
-    void outputDebug(std::string message);
-    void outputTrace(std::string message);
+    void outputCritical(const std::string& message);
+    void outputError(const std::string& message);
+    void outputError(const std::string& message, const std::string& errormessage);
+    void outputWarning(const std::string& message);
+    void outputInfo(const std::string& message);
+    void outputDebug(const std::string& message);
+    void outputTrace(const std::string& message);
+
+    // Lazy versions taking a fmt format string and its arguments, e.g. outputDebug("Added variable {}", name). The
+    // message is only formatted if a logger accepts the level, so these should be used in code that is called often
+    template <typename Arg, typename... Args>
+    void outputWarning(const char* format, const Arg& argument, const Args&... arguments)
+    {
+        log(spdlog::level::warn, format, argument, arguments...);
+    }
+
+    template <typename Arg, typename... Args>
+    void outputInfo(const char* format, const Arg& argument, const Args&... arguments)
+    {
+        log(spdlog::level::info, format, argument, arguments...);
+    }
+
+    template <typename Arg, typename... Args>
+    void outputDebug(const char* format, const Arg& argument, const Args&... arguments)
+    {
+        log(spdlog::level::debug, format, argument, arguments...);
+    }
+
+    template <typename Arg, typename... Args>
+    void outputTrace([[maybe_unused]] const char* format, [[maybe_unused]] const Arg& argument,
+        [[maybe_unused]] const Args&... arguments)
+    {
+#ifndef NDEBUG
+        log(spdlog::level::trace, format, argument, arguments...);
+#endif
+    }
 
     void setLogLevels(E_LogLevel consoleLogLevel, E_LogLevel fileLogLevel);
 
@@ -40,13 +96,28 @@ public:
 
     void setFileSink(std::string filename);
 
-    void flush() { logger->flush(); }
+    void flush();
 
 private:
     std::shared_ptr<spdlog::sinks::sink> consoleSink;
-    std::shared_ptr<spdlog::sinks::basic_file_sink_st> fileSink;
+    std::shared_ptr<LogFileSink> fileSink;
 
     std::shared_ptr<spdlog::logger> logger;
+
+    // The log file is written by a background thread through a bounded queue; the thread pool is declared before the
+    // file logger so that the queued messages are written before the pool is destroyed
+    std::shared_ptr<spdlog::details::thread_pool> fileThreadPool;
+    std::shared_ptr<spdlog::async_logger> fileLogger;
+
+    void logMessage(spdlog::level::level_enum level, const std::string& message);
+
+    template <typename... Args> void log(spdlog::level::level_enum level, const char* format, const Args&... arguments)
+    {
+        logger->log(level, format, arguments...);
+
+        if(fileLogger)
+            fileLogger->log(level, format, arguments...);
+    }
 };
 
 class Environment;
@@ -19,6 +19,8 @@
 #include "Model/ObjectiveFunction.h"
 #include "Model/Constraints.h"
 
+#include <thread>
+
 namespace SHOT
 {
 
@@ -26,6 +28,9 @@ void PrimalSolver::addPrimalSolutionCandidate(VectorDouble pt, E_PrimalSolutionS
 {
     PrimalSolution sol;
 
+    if(env->reformulatedProblem)
+        env->reformulatedProblem->postsolve(pt);
+
     sol.point = pt;
     sol.sourceType = source;
     sol.objValue = env->problem->objectiveFunction->calculateValue(pt);
@@ -61,6 +66,9 @@ void PrimalSolver::addPrimalSolutionCandidate(SolutionPoint pt, E_PrimalSolution
 {
     PrimalSolution sol;
 
+    if(env->reformulatedProblem)
+        env->reformulatedProblem->postsolve(pt.point);
+
     sol.point = pt.point;
     sol.sourceType = source;
     sol.objValue = pt.objectiveValue;
@@ -83,9 +91,47 @@ void PrimalSolver::checkPrimalSolutionCandidates()
 {
     env->timing->startTimer("PrimalStrategy");
 
-    for(auto& cand : env->primalSolver->primalSolutionCandidates)
+    auto& candidates = env->primalSolver->primalSolutionCandidates;
+    std::vector<PrimalSolutionCheck> checks(candidates.size());
+
+    for(size_t i = 0; i < candidates.size(); i++)
+        checks[i].solution = candidates[i];
+
+    auto parameters = getPrimalSolutionCheckParameters();
+
+    size_t numberOfWorkers = std::min(
+        (size_t)env->settings->getSetting<int>("CandidateCheck.NumberOfThreads", "Primal"), candidates.size());
+
+    if(numberOfWorkers <= 1)
     {
-        this->checkPrimalSolutionPoint(cand);
+        for(auto& C : checks)
+            verifyPrimalSolutionPoint(C, parameters);
+    }
+    else
+    {
+        std::vector<std::thread> workers;
+        workers.reserve(numberOfWorkers);
+
+        for(size_t w = 0; w < numberOfWorkers; w++)
+        {
+            workers.emplace_back([this, w, numberOfWorkers, &parameters, &checks]() {
+                for(size_t i = w; i < checks.size(); i += numberOfWorkers)
+                    verifyPrimalSolutionPoint(checks[i], parameters);
+            });
+        }
+
+        for(auto& W : workers)
+            W.join();
+    }
+
+    // The candidates are added in the order they were given, so the result does not depend on the number of threads
+    for(auto& C : checks)
+    {
+        for(auto& M : C.messages)
+            env->output->outputDebug(M);
+
+        if(C.isAccepted)
+            env->results->addPrimalSolution(C.solution);
     }
 
     env->primalSolver->primalSolutionCandidates.clear();
@@ -95,12 +141,55 @@ void PrimalSolver::checkPrimalSolutionCandidates()
 
 bool PrimalSolver::checkPrimalSolutionPoint(PrimalSolution primalSol)
 {
+    PrimalSolutionCheck check;
+    check.solution = std::move(primalSol);
+
+    verifyPrimalSolutionPoint(check, getPrimalSolutionCheckParameters());
+
+    for(auto& M : check.messages)
+        env->output->outputDebug(M);
+
+    if(check.isAccepted)
+        env->results->addPrimalSolution(check.solution);
+
+    return (check.isAccepted);
+}
+
+PrimalSolver::PrimalSolutionCheckParameters PrimalSolver::getPrimalSolutionCheckParameters()
+{
+    PrimalSolutionCheckParameters parameters;
+
+    // A candidate worse than the worst solution in a full solution pool will not be saved by Results, so the
+    // constraints need not be checked
+    int poolSize = env->results->primalSolutions.size();
+
+    if(poolSize > 0 && poolSize >= env->settings->getSetting<int>("SaveNumberOfSolutions", "Output"))
+        parameters.dominatedObjective = env->results->primalSolutions.back().objValue;
+
+    parameters.integerTolerance = env->settings->getSetting<double>("Tolerance.Integer", "Primal");
+    parameters.linearConstraintTolerance = env->settings->getSetting<double>("Tolerance.LinearConstraint", "Primal");
+    parameters.nonlinearConstraintTolerance
+        = env->settings->getSetting<double>("Tolerance.NonlinearConstraint", "Primal");
+    parameters.trustLinearConstraintValues
+        = env->settings->getSetting<bool>("Tolerance.TrustLinearConstraintValues", "Primal");
+
+    return (parameters);
+}
+
+void PrimalSolver::verifyPrimalSolutionPoint(
+    PrimalSolutionCheck& check, const PrimalSolutionCheckParameters& parameters)
+{
+    auto& primalSol = check.solution;
+    double dominatedObjective = parameters.dominatedObjective;
+
     std::string sourceDesc;
 
-    VectorDouble tmpPoint(
-        primalSol.point.begin(), primalSol.point.begin() + env->problem->properties.numberOfVariables);
+    auto& messages = check.messages;
+    auto& point = primalSol.point;
 
-    double tmpObjVal = primalSol.objValue;
+    // Make sure no extra (auxiliary) values are in the vector
+    if((int)point.size() > env->problem->properties.numberOfVariables)
+        point.resize(env->problem->properties.numberOfVariables);
 
     bool isVariableBoundsFulfilled = true;
 
@@ -129,37 +218,36 @@ bool PrimalSolver::checkPrimalSolutionPoint(PrimalSolution primalSol)
         break;
     }
 
-    env->output->outputDebug(fmt::format(
+    messages.push_back(fmt::format(
         "        Checking primal solution point with objective value {} from {}.", primalSol.objValue, sourceDesc));
 
     primalSol.sourceDescription = sourceDesc;
 
     // Recalculate if the objective to be sure it is correct
-    primalSol.objValue = env->problem->objectiveFunction->calculateValue(primalSol.point);
-    tmpObjVal = primalSol.objValue;
+    primalSol.objValue = env->problem->objectiveFunction->calculateValue(point);
 
     // Check that solution fulfills bounds, project back otherwise
     bool reCalculateObjective = false;
 
     for(auto& V : env->problem->realVariables)
     {
-        auto value = V->calculate(tmpPoint);
+        auto value = V->calculate(point);
 
         if(value > V->upperBound)
         {
             isVariableBoundsFulfilled = false;
-            tmpPoint.at(V->index) = V->upperBound;
+            point[V->index] = V->upperBound;
         }
         else if(value < V->lowerBound)
         {
             isVariableBoundsFulfilled = false;
-            tmpPoint.at(V->index) = V->lowerBound;
+            point[V->index] = V->lowerBound;
         }
     }
 
     for(auto& V : env->problem->semicontinuousVariables)
     {
-        auto value = V->calculate(tmpPoint);
+        auto value = V->calculate(point);
 
         if(value == 0.0)
         {
@@ -167,117 +255,101 @@ bool PrimalSolver::checkPrimalSolutionPoint(PrimalSolution primalSol)
         else if(value > V->upperBound)
         {
             isVariableBoundsFulfilled = false;
-            tmpPoint.at(V->index) = V->upperBound;
+            point[V->index] = V->upperBound;
         }
         else if(value < V->lowerBound)
         {
             isVariableBoundsFulfilled = false;
-            tmpPoint.at(V->index) = V->lowerBound;
+            point[V->index] = V->lowerBound;
         }
     }
 
     for(auto& V : env->problem->integerVariables)
     {
-        auto value = V->calculate(tmpPoint);
+        auto value = V->calculate(point);
 
         if(value > V->upperBound)
         {
             isVariableBoundsFulfilled = false;
-            tmpPoint.at(V->index) = round(V->upperBound - 0.5);
+            point[V->index] = round(V->upperBound - 0.5);
         }
         else if(value < V->lowerBound)
         {
             isVariableBoundsFulfilled = false;
-            tmpPoint.at(V->index) = round(V->lowerBound + 0.5);
+            point[V->index] = round(V->lowerBound + 0.5);
         }
     }
 
     for(auto& V : env->problem->binaryVariables)
     {
-        auto value = V->calculate(tmpPoint);
+        auto value = V->calculate(point);
 
         if(value > V->upperBound)
         {
             isVariableBoundsFulfilled = false;
-            tmpPoint.at(V->index) = 1.0;
+            point[V->index] = 1.0;
         }
         else if(value < V->lowerBound)
         {
             isVariableBoundsFulfilled = false;
-            tmpPoint.at(V->index) = 0.0;
+            point[V->index] = 0.0;
         }
     }
 
     if(!isVariableBoundsFulfilled)
     {
         reCalculateObjective = true;
-        env->output->outputDebug("         Variable bounds not fulfilled. Projection to bounds performed.");
+        messages.push_back("         Variable bounds not fulfilled. Projection to bounds performed.");
         primalSol.boundProjectionPerformed = true;
     }
     else
     {
-        env->output->outputDebug("         All variable bounds fulfilled.");
+        messages.push_back("         All variable bounds fulfilled.");
         primalSol.boundProjectionPerformed = false;
     }
 
-    // Check that it fulfills integer constraints, round otherwise
+    // Check that it fulfills integer constraints, round otherwise. The rounding is done in place since the
+    // projection above already has made sure the discrete variables are within their bounds.
     if(env->problem->properties.numberOfDiscreteVariables > 0)
     {
-        auto integerTol = env->settings->getSetting<double>("Tolerance.Integer", "Primal");
+        auto integerTol = parameters.integerTolerance;
 
         bool isRounded = false;
 
-        VectorDouble ptRounded(tmpPoint);
-
         double maxIntegerError = 0.0;
 
-        for(auto& V : env->problem->integerVariables)
-        {
-            auto value = V->calculate(tmpPoint);
-            int index = V->index;
-
-            double rounded = std::round(value);
-            double error = std::abs(rounded - value);
-
-            maxIntegerError = std::max(maxIntegerError, error);
-
-            if(error > integerTol)
+        auto roundVariables = [&](const Variables& variables) {
+            for(auto& V : variables)
             {
-                ptRounded.at(index) = rounded;
-                isRounded = true;
-            }
-        }
-
-        for(auto& V : env->problem->binaryVariables)
-        {
-            auto value = V->calculate(tmpPoint);
-            int index = V->index;
+                auto value = V->calculate(point);
 
-            double rounded = std::round(value);
-            double error = std::abs(rounded - value);
+                double rounded = std::round(value);
+                double error = std::abs(rounded - value);
 
-            maxIntegerError = std::max(maxIntegerError, error);
+                maxIntegerError = std::max(maxIntegerError, error);
 
-            if(error > integerTol)
-            {
-                ptRounded.at(index) = rounded;
-                isRounded = true;
+                if(error > integerTol)
+                {
+                    point[V->index] = rounded;
+                    isRounded = true;
+                }
             }
-        }
+        };
+
+        roundVariables(env->problem->integerVariables);
+        roundVariables(env->problem->binaryVariables);
 
         if(isRounded)
         {
             reCalculateObjective = true;
-            tmpPoint = ptRounded;
 
-            auto tmpLine = fmt::format(
-                "         Discrete variables were not fulfilled to tolerance {}. Rounding performed...", integerTol);
-            env->output->outputDebug(tmpLine);
+            messages.push_back(fmt::format(
+                "         Discrete variables were not fulfilled to tolerance {}. Rounding performed...", integerTol));
         }
         else
         {
-            auto tmpLine = fmt::format("         All discrete variables are fulfilled to tolerance {}.", integerTol);
-            env->output->outputDebug(tmpLine);
+            messages.push_back(
+                fmt::format("         All discrete variables are fulfilled to tolerance {}.", integerTol));
         }
 
         primalSol.integerRoundingPerformed = isRounded;
@@ -287,7 +359,18 @@ bool PrimalSolver::checkPrimalSolutionPoint(PrimalSolution primalSol)
     // Recalculate the objective if rounding or projection has been performed
     if(reCalculateObjective)
     {
-        tmpObjVal = env->problem->objectiveFunction->calculateValue(tmpPoint);
+        primalSol.objValue = env->problem->objectiveFunction->calculateValue(point);
+    }
+
+    if(!std::isnan(dominatedObjective) && !Utilities::isAlmostEqual(primalSol.objValue, dominatedObjective, 1e-10)
+        && (env->problem->objectiveFunction->properties.isMinimize ? primalSol.objValue > dominatedObjective
+                                                                   : primalSol.objValue < dominatedObjective))
+    {
+        messages.push_back(fmt::format(
+            "         Objective value {} is not better than the worst solution {} in the full solution pool.",
+            primalSol.objValue, dominatedObjective));
+
+        return;
     }
 
     // For example rootsearches may violate linear constraints
@@ -297,9 +380,9 @@ bool PrimalSolver::checkPrimalSolutionPoint(PrimalSolution primalSol)
         || primalSol.sourceType == E_PrimalSolutionSource::MIPCallback);
 
     if(!primalSol.integerRoundingPerformed && acceptableType
-        && env->settings->getSetting<bool>("Tolerance.TrustLinearConstraintValues", "Primal"))
+        && parameters.trustLinearConstraintValues)
     {
-        env->output->outputDebug(
+        messages.push_back(
             "         Assuming that linear constraints are fulfilled since solution is from a subsolver.");
     }
     else
@@ -309,26 +392,26 @@ bool PrimalSolver::checkPrimalSolutionPoint(PrimalSolution primalSol)
         if(env->problem->properties.numberOfLinearConstraints > 0)
         {
             auto maxLinearConstraintValue
-                = env->problem->getMaxNumericConstraintValue(tmpPoint, env->problem->linearConstraints);
+                = env->problem->getMaxNumericConstraintValue(point, env->problem->linearConstraints);
 
             mostDevLinearConstraints.index = maxLinearConstraintValue.constraint->index;
             mostDevLinearConstraints.value = maxLinearConstraintValue.normalizedValue;
 
-            auto linTol = env->settings->getSetting<double>("Tolerance.LinearConstraint", "Primal");
+            auto linTol = parameters.linearConstraintTolerance;
 
             if(maxLinearConstraintValue.error > linTol)
             {
-                auto tmpLine = fmt::format("         Linear constraints are not fulfilled. Most deviating {}: {} > {}.",
-                    maxLinearConstraintValue.constraint->name, maxLinearConstraintValue.error, linTol);
-                env->output->outputDebug(tmpLine);
+                messages.push_back(
+                    fmt::format("         Linear constraints are not fulfilled. Most deviating {}: {} > {}.",
+                        maxLinearConstraintValue.constraint->name, maxLinearConstraintValue.error, linTol));
 
-                return (false);
+                return;
             }
             else
             {
-                auto tmpLine = fmt::format("         Linear constraints are fulfilled. Most deviating {}: {} > {}.",
-                    maxLinearConstraintValue.constraint->name, maxLinearConstraintValue.error, linTol);
-                env->output->outputDebug(tmpLine);
+                messages.push_back(
+                    fmt::format("         Linear constraints are fulfilled. Most deviating {}: {} > {}.",
+                        maxLinearConstraintValue.constraint->name, maxLinearConstraintValue.error, linTol));
             }
         }
 
@@ -341,26 +424,25 @@ bool PrimalSolver::checkPrimalSolutionPoint(PrimalSolution primalSol)
         PairIndexValue mostDevQuadraticConstraints;
 
         auto maxQuadraticConstraintValue
-            = env->problem->getMaxNumericConstraintValue(tmpPoint, env->problem->quadraticConstraints);
+            = env->problem->getMaxNumericConstraintValue(point, env->problem->quadraticConstraints);
 
         mostDevQuadraticConstraints.index = maxQuadraticConstraintValue.constraint->index;
         mostDevQuadraticConstraints.value = maxQuadraticConstraintValue.normalizedValue;
 
-        auto nonlinTol = env->settings->getSetting<double>("Tolerance.NonlinearConstraint", "Primal");
+        auto nonlinTol = parameters.nonlinearConstraintTolerance;
 
         if(mostDevQuadraticConstraints.value > nonlinTol)
         {
-            auto tmpLine = fmt::format("         Quadratic constraints are not fulfilled. Most deviating {}: {} > {}.",
-                maxQuadraticConstraintValue.constraint->name, maxQuadraticConstraintValue.error, nonlinTol);
-            env->output->outputDebug(tmpLine);
+            messages.push_back(
+                fmt::format("         Quadratic constraints are not fulfilled. Most deviating {}: {} > {}.",
+                    maxQuadraticConstraintValue.constraint->name, maxQuadraticConstraintValue.error, nonlinTol));
 
-            return (false);
+            return;
         }
         else
         {
-            auto tmpLine = fmt::format("         Quadratic constraints are fulfilled. Most deviating {}: {} > {}.",
-                maxQuadraticConstraintValue.constraint->name, maxQuadraticConstraintValue.error, nonlinTol);
-            env->output->outputDebug(tmpLine);
+            messages.push_back(fmt::format("         Quadratic constraints are fulfilled. Most deviating {}: {} > {}.",
+                maxQuadraticConstraintValue.constraint->name, maxQuadraticConstraintValue.error, nonlinTol));
         }
 
         primalSol.maxDevatingConstraintQuadratic = mostDevQuadraticConstraints;
@@ -372,42 +454,31 @@ bool PrimalSolver::checkPrimalSolutionPoint(PrimalSolution primalSol)
         PairIndexValue mostDevNonlinearConstraints;
 
         auto maxNonlinearConstraintValue
-            = env->problem->getMaxNumericConstraintValue(tmpPoint, env->problem->nonlinearConstraints);
+            = env->problem->getMaxNumericConstraintValue(point, env->problem->nonlinearConstraints);
 
         mostDevNonlinearConstraints.index = maxNonlinearConstraintValue.constraint->index;
         mostDevNonlinearConstraints.value = maxNonlinearConstraintValue.normalizedValue;
 
-        auto nonlinTol = env->settings->getSetting<double>("Tolerance.NonlinearConstraint", "Primal");
+        auto nonlinTol = parameters.nonlinearConstraintTolerance;
 
         if(mostDevNonlinearConstraints.value > nonlinTol)
         {
-            auto tmpLine = fmt::format("         Nonlinear constraints are not fulfilled. Most deviating {}: {} > {}.",
-                maxNonlinearConstraintValue.constraint->name, mostDevNonlinearConstraints.value, nonlinTol);
-            env->output->outputDebug(tmpLine);
+            messages.push_back(
+                fmt::format("         Nonlinear constraints are not fulfilled. Most deviating {}: {} > {}.",
+                    maxNonlinearConstraintValue.constraint->name, mostDevNonlinearConstraints.value, nonlinTol));
 
-            return (false);
+            return;
         }
         else
         {
-            auto tmpLine = fmt::format("         Nonlinear constraints are fulfilled. Most deviating {}: {} > {}.",
-                maxNonlinearConstraintValue.constraint->name, mostDevNonlinearConstraints.value, nonlinTol);
-            env->output->outputDebug(tmpLine);
+            messages.push_back(fmt::format("         Nonlinear constraints are fulfilled. Most deviating {}: {} > {}.",
+                maxNonlinearConstraintValue.constraint->name, mostDevNonlinearConstraints.value, nonlinTol));
         }
 
         primalSol.maxDevatingConstraintNonlinear = mostDevNonlinearConstraints;
     }
 
-    primalSol.objValue = tmpObjVal;
-
-    // Make sure no extra (auxiliary) values are in the vector
-    if((int)tmpPoint.size() > env->problem->properties.numberOfVariables)
-        tmpPoint.resize(env->problem->properties.numberOfVariables);
-
-    primalSol.point = tmpPoint;
-
-    env->results->addPrimalSolution(primalSol);
-
-    return (true);
+    check.isAccepted = true;
 }
 
 void PrimalSolver::addFixedNLPCandidate(
@@ -415,62 +486,68 @@ void PrimalSolver::addFixedNLPCandidate(
 {
     VectorDouble candidate(pt);
 
+    env->reformulatedProblem->postsolve(candidate);
+
     if((int)candidate.size() < env->reformulatedProblem->properties.numberOfVariables)
     {
-        for(auto& V : env->reformulatedProblem->auxiliaryVariables)
-        {
-            candidate.push_back(V->calculate(pt));
-        }
-
-        if(env->reformulatedProblem->auxiliaryObjectiveVariable)
-        {
-            candidate.push_back(env->reformulatedProblem->auxiliaryObjectiveVariable->calculate(pt));
-        }
+        env->reformulatedProblem->liftToReformulatedSpace(candidate);
     }
 
     assert((int)candidate.size() == env->reformulatedProblem->properties.numberOfVariables);
 
-    VectorInteger discretVariableValues;
-    discretVariableValues.reserve(env->reformulatedProblem->properties.numberOfDiscreteVariables);
+    // The keys only select the candidates to compare with, see isSameFixedNLPCandidate
+    const double pointBucketWidth = 1e-6;
 
-    for(auto& VAR : env->reformulatedProblem->allVariables)
-    {
-        if(VAR->properties.type == E_VariableType::Binary || VAR->properties.type == E_VariableType::Integer)
-            discretVariableValues.push_back(candidate[VAR->index]);
-    }
-
-    double pointHash;
-
-    if(env->settings->getSetting<bool>("FixedInteger.OnlyUniqueIntegerCombinations", "Primal"))
-    {
-        pointHash = Utilities::calculateHash(discretVariableValues);
-    }
-    else
-    {
-        pointHash = Utilities::calculateHash(candidate);
-    }
+    auto pointKey = env->reformulatedProblem->getPointKey(candidate, pointBucketWidth,
+        env->settings->getSetting<bool>("FixedInteger.OnlyUniqueIntegerCombinations", "Primal"));
 
-    if(!hasFixedNLPCandidateBeenTested(pointHash))
+    if(!hasFixedNLPCandidateBeenTested(pointKey, candidate))
     {
         fixedPrimalNLPCandidates.push_back(
-            PrimalFixedNLPCandidate { candidate, source, objVal, iter, maxConstrDev, pointHash });
+            PrimalFixedNLPCandidate { candidate, source, objVal, iter, maxConstrDev, pointKey });
     }
     else
-        env->output->outputDebug(
-            fmt::format("        Candidate for fixed integer search with hash {} has been used already.", pointHash));
+        env->output->outputDebug("        Candidate for fixed integer search has been used already.");
 }
 
-bool PrimalSolver::hasFixedNLPCandidateBeenTested(double hash)
+bool PrimalSolver::hasFixedNLPCandidateBeenTested(const PointKey& key, const VectorDouble& point)
 {
-    for(auto& IC : usedPrimalNLPCandidates)
+    auto [first, last] = usedFixedNLPCandidates.equal_range(key);
+
+    for(auto it = first; it != last; ++it)
     {
-        if(Utilities::isAlmostEqual(IC.discreteVariablePointHash, hash, 1e-8))
-        {
+        if(isSameFixedNLPCandidate(key, point, it->first, it->second))
+            return (true);
+    }
+
+    // The candidates in the current batch are only registered as used after they have been solved
+    for(auto& C : fixedPrimalNLPCandidates)
+    {
+        if(isSameFixedNLPCandidate(key, point, C.pointKey, C.point))
             return (true);
-        }
     }
 
     return (false);
 }
 
+bool PrimalSolver::isSameFixedNLPCandidate(const PointKey& firstKey, const VectorDouble& firstPoint,
+    const PointKey& secondKey, const VectorDouble& secondPoint)
+{
+    if(firstKey != secondKey)
+        return (false);
+
+    if(env->settings->getSetting<bool>("FixedInteger.OnlyUniqueIntegerCombinations", "Primal"))
+        return (true);
+
+    return (firstPoint.size() == secondPoint.size() && !Utilities::isDifferent(firstPoint, secondPoint));
+}
+
+void PrimalSolver::addUsedFixedNLPCandidate(const PrimalFixedNLPCandidate& candidate)
+{
+    if(env->settings->getSetting<bool>("FixedInteger.OnlyUniqueIntegerCombinations", "Primal"))
+        usedFixedNLPCandidates.emplace(candidate.pointKey, VectorDouble());
+    else
+        usedFixedNLPCandidates.emplace(candidate.pointKey, candidate.point);
+}
+
 } // namespace SHOT
\ No newline at end of file
@@ -13,6 +13,8 @@
 #include "Enums.h"
 #include "Structs.h"
 
+#include <unordered_map>
+
 namespace SHOT
 {
 
@@ -40,13 +42,51 @@ public:
     void addFixedNLPCandidate(
         VectorDouble pt, E_PrimalNLPSource source, double objVal, int iter, PairIndexValue maxConstrDev);
 
-    bool hasFixedNLPCandidateBeenTested(double hash);
+    // Returns true if the candidate has been solved already or is already waiting to be solved
+    bool hasFixedNLPCandidateBeenTested(const PointKey& key, const VectorDouble& point);
+
+    void addUsedFixedNLPCandidate(const PrimalFixedNLPCandidate& candidate);
 
     std::vector<PrimalSolution> primalSolutionCandidates;
     std::vector<PrimalFixedNLPCandidate> fixedPrimalNLPCandidates;
-    std::vector<PrimalFixedNLPCandidate> usedPrimalNLPCandidates;
 
 private:
+    // The keys and points of the fixed NLP candidates already solved. Only the discrete part of the point is used in
+    // the key if FixedInteger.OnlyUniqueIntegerCombinations is true, and the key then identifies the candidate and no
+    // point is stored. Otherwise candidates with the same key are compared exactly.
+    std::unordered_multimap<PointKey, VectorDouble, PointKeyHasher> usedFixedNLPCandidates;
+
+    bool isSameFixedNLPCandidate(const PointKey& firstKey, const VectorDouble& firstPoint, const PointKey& secondKey,
+        const VectorDouble& secondPoint);
+
+    // The outcome of verifying a primal solution candidate, the solution is a copy of the candidate that is projected
+    // and rounded during the verification, and the messages are output when the candidate is handled
+    struct PrimalSolutionCheck
+    {
+        PrimalSolution solution;
+        bool isAccepted = false;
+        std::vector<std::string> messages;
+    };
+
+    // The settings and solution pool values used in the verification, these are read before the candidates are
+    // verified so that the workers only read the model
+    struct PrimalSolutionCheckParameters
+    {
+        // The objective value a candidate must improve on to enter the solution pool, or NAN if all are accepted
+        double dominatedObjective = NAN;
+
+        double integerTolerance;
+        double linearConstraintTolerance;
+        double nonlinearConstraintTolerance;
+        bool trustLinearConstraintValues;
+    };
+
+    PrimalSolutionCheckParameters getPrimalSolutionCheckParameters();
+
+    // Projects and rounds the solution in the check and checks the constraints, does not modify any shared state so
+    // several candidates can be verified concurrently
+    void verifyPrimalSolutionPoint(PrimalSolutionCheck& check, const PrimalSolutionCheckParameters& parameters);
+
     EnvironmentPtr env;
 };
 
@@ -165,8 +165,8 @@ void Report::outputIterationDetail(int iterationNumber, std::string iterationDes
         if(env->results->getCurrentIteration()->numberOfExploredNodes > 0
             || env->results->getCurrentIteration()->numberOfOpenNodes > 0)
         {
-            env->output->outputDebug(fmt::format("        Explored nodes: {}. Open nodes: {}.",
-                env->solutionStatistics.numberOfExploredNodes, env->results->getCurrentIteration()->numberOfOpenNodes));
+            env->output->outputDebug("        Explored nodes: {}. Open nodes: {}.",
+                env->solutionStatistics.numberOfExploredNodes, env->results->getCurrentIteration()->numberOfOpenNodes);
         }
     }
     catch(...)
@@ -1150,6 +1150,30 @@ void Report::outputSolutionReport()
         env->output->outputInfo("");
     }
 
+    if(env->solutionStatistics.numberOfProblemsNLPExactHessian > 0
+        || env->solutionStatistics.numberOfProblemsNLPLimitedMemoryHessian > 0)
+    {
+        auto& statistics = env->solutionStatistics;
+
+        // The average number of iterations and time show the effect of the choice of Hessian in Ipopt
+        auto outputHessianStatistics = [&](std::string description, int problems, int iterations, double time) {
+            if(problems == 0)
+                return;
+
+            env->output->outputInfo(fmt::format(" - {:<46}{} ({:.1f} iterations, {:.3g} s on average)",
+                description + ':', problems, iterations / (double)problems, time / problems));
+        };
+
+        env->output->outputInfo(" Ipopt problems solved by Hessian:");
+
+        outputHessianStatistics("exact", statistics.numberOfProblemsNLPExactHessian,
+            statistics.numberOfIterationsNLPExactHessian, statistics.timeNLPExactHessian);
+        outputHessianStatistics("limited-memory BFGS", statistics.numberOfProblemsNLPLimitedMemoryHessian,
+            statistics.numberOfIterationsNLPLimitedMemoryHessian, statistics.timeNLPLimitedMemoryHessian);
+
+        env->output->outputInfo("");
+    }
+
     if(env->results->hasPrimalSolution())
     {
         env->output->outputInfo(fmt::format(
@@ -44,45 +44,50 @@ void Results::addDualSolution(DualSolution solution)
 
 void Results::addPrimalSolution(PrimalSolution solution)
 {
-    bool isDifferent = true;
+    // The keys only select the solutions to compare with, the points themselves are compared exactly. A coarse width
+    // makes sure that equal points never end up with different keys due to rounding.
+    const double pointBucketWidth = 1e-6;
 
-    for(auto& S : this->primalSolutions)
-    {
-        if(Utilities::isDifferent(S.point, solution.point))
-            continue;
+    auto key = env->problem->getPointKey(solution.point, pointBucketWidth);
 
-        isDifferent = false;
-        break;
-    }
+    auto isSamePoint = [&solution](const PrimalSolution& S) {
+        return (S.point.size() == solution.point.size() && !Utilities::isDifferent(S.point, solution.point));
+    };
 
-    if(!isDifferent) // The same solution point is already saved
+    bool isKnown = primalSolutionKeys.count(key) > 0
+        && std::any_of(this->primalSolutions.begin(), this->primalSolutions.end(), isSamePoint);
+
+    if(isKnown) // The same solution point is already saved
     {
-        env->output->outputDebug(fmt::format(
-            "         Primal solution candidate with objective value {} already known.", solution.objValue));
+        env->output->outputDebug(
+            "         Primal solution candidate with objective value {} already known.", solution.objValue);
         return;
     }
 
+    bool isMinimize = env->problem->objectiveFunction->properties.isMinimize;
+
+    auto isBetterObjective = [isMinimize](double first, double second) {
+        return (isMinimize ? first < second : first > second);
+    };
+
+    size_t maxNumberOfSolutions = std::max(1, env->settings->getSetting<int>("SaveNumberOfSolutions", "Output"));
+
+    bool isNewBestSolution = false;
+
     if(this->primalSolutions.size() == 0)
     {
         // This is the first solution, save it
-        this->primalSolutions.push_back(solution);
-        this->primalSolution = solution.point;
-        this->setPrimalBound(solution.objValue);
+        isNewBestSolution = true;
 
-        env->output->outputDebug(fmt::format(
-            "        First primal solution {} from {} found.", solution.objValue, solution.sourceDescription));
+        env->output->outputDebug(
+            "        First primal solution {} from {} found.", solution.objValue, solution.sourceDescription);
     }
-    else if(auto primalsol = this->primalSolutions.back();
-            (env->problem->objectiveFunction->properties.isMinimize && solution.objValue < primalsol.objValue)
-            || (!env->problem->objectiveFunction->properties.isMinimize && solution.objValue > primalsol.objValue))
+    else if(auto& primalsol = this->primalSolutions.front(); isBetterObjective(solution.objValue, primalsol.objValue))
     {
-        // Have a solution which is better than the worst one in the solution pool
-        this->primalSolutions.back() = solution;
-        this->primalSolution = solution.point;
-        this->setPrimalBound(solution.objValue);
+        isNewBestSolution = true;
 
-        env->output->outputDebug(fmt::format("        New (currently best) primal solution {} from {} found.",
-            solution.objValue, solution.sourceDescription));
+        env->output->outputDebug("        New (currently best) primal solution {} from {} found.",
+            solution.objValue, solution.sourceDescription);
     }
     else if(Utilities::isAlmostEqual(solution.objValue, primalsol.objValue, 1e-10)
         && (std::max({ solution.maxDevatingConstraintLinear.value, solution.maxDevatingConstraintQuadratic.value,
@@ -91,45 +96,50 @@ void Results::addPrimalSolution(PrimalSolution solution)
                      primalsol.maxDevatingConstraintNonlinear.value })))
     {
         // Have a solution which is similar to the best known, but with smaller constraint error
-        this->primalSolutions.back() = solution;
-        this->primalSolution = solution.point;
-        this->setPrimalBound(solution.objValue);
+        isNewBestSolution = true;
 
-        env->output->outputDebug(fmt::format("        New (currently best) primal solution {} from {} found.",
-            solution.objValue, solution.sourceDescription));
+        env->output->outputDebug("        New (currently best) primal solution {} from {} found.",
+            solution.objValue, solution.sourceDescription);
     }
-    else if((int)this->primalSolutions.size() < env->settings->getSetting<int>("SaveNumberOfSolutions", "Output"))
+    else if(this->primalSolutions.size() < maxNumberOfSolutions
+        || isBetterObjective(solution.objValue, this->primalSolutions.back().objValue))
     {
-        // The solution pool is not yet full, save the solution
-        this->primalSolutions.push_back(solution);
-
-        env->output->outputDebug(fmt::format("        New primal solution {} from {} found and added to solution pool.",
-            solution.objValue, solution.sourceDescription));
+        env->output->outputDebug("        New primal solution {} from {} found and added to solution pool.",
+            solution.objValue, solution.sourceDescription);
     }
     else
     {
-        env->output->outputDebug(fmt::format(
+        env->output->outputDebug(
             "        Primal solution {} from {} is not an improvement of the current value {} or the solution "
             "pool is full, so it will not be saved.",
-            solution.objValue, solution.sourceDescription, primalsol.objValue));
+            solution.objValue, solution.sourceDescription, this->primalSolutions.front().objValue);
         // Will not save this solution
         return;
     }
 
-    // Sorts the solutions so that the best one is at the first position
-    if(env->problem->objectiveFunction->properties.isMinimize)
+    // The solutions are kept sorted so that the best one is at the first position and the worst one is removed if
+    // the solution pool is full
+    if(this->primalSolutions.size() >= maxNumberOfSolutions)
     {
-        std::sort(this->primalSolutions.begin(), this->primalSolutions.end(),
-            [](const PrimalSolution& firstSolution, const PrimalSolution& secondSolution) {
-                return (firstSolution.objValue < secondSolution.objValue);
-            });
+        primalSolutionKeys.erase(
+            primalSolutionKeys.find(env->problem->getPointKey(this->primalSolutions.back().point, pointBucketWidth)));
+        this->primalSolutions.pop_back();
     }
-    else
-    {
-        std::sort(this->primalSolutions.begin(), this->primalSolutions.end(),
-            [](const PrimalSolution& firstSolution, const PrimalSolution& secondSolution) {
-                return (firstSolution.objValue > secondSolution.objValue);
+
+    auto position = isNewBestSolution
+        ? this->primalSolutions.begin()
+        : std::upper_bound(this->primalSolutions.begin(), this->primalSolutions.end(), solution.objValue,
+            [&isBetterObjective](double objectiveValue, const PrimalSolution& otherSolution) {
+                return (isBetterObjective(objectiveValue, otherSolution.objValue));
             });
+
+    this->primalSolutions.insert(position, solution);
+    primalSolutionKeys.insert(key);
+
+    if(isNewBestSolution)
+    {
+        this->primalSolution = solution.point;
+        this->setPrimalBound(solution.objValue);
     }
 
     env->solutionStatistics.numberOfFoundPrimalSolutions++;
@@ -220,6 +230,7 @@ Results::~Results()
     iterations.clear();
     primalSolution.clear();
     primalSolutions.clear();
+    primalSolutionKeys.clear();
     dualSolutions.clear();
 }
 
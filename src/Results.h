@@ -14,6 +14,7 @@
 #include <memory>
 #include <vector>
 #include <optional>
+#include <unordered_set>
 
 #include "Environment.h"
 #include "Iteration.h"
@@ -98,6 +99,10 @@ public:
     int getAuxiliaryVariableCounter(E_AuxiliaryVariableType type);
 
 private:
+    // The keys of the points in primalSolutions, used to find the already known solutions that need to be compared to
+    // a new solution. Several different points can have the same key.
+    std::unordered_multiset<PointKey, PointKeyHasher> primalSolutionKeys;
+
     EnvironmentPtr env;
 };
 
@@ -18,11 +18,10 @@
 
 #include "boost/math/tools/roots.hpp"
 
+#include <functional>
+
 namespace SHOT
 {
-std::vector<NumericConstraint*> activeConstraints;
-double lastActiveConstraintUpdateValue;
-
 Test::Test(EnvironmentPtr envPtr) : env(envPtr) {}
 
 Test::~Test()
@@ -57,15 +56,15 @@ double Test::operator()(const double x)
 
     auto currentConstraints = getActiveConstraints();
 
-    std::vector<NumericConstraint*> activeConstraints;
+    std::vector<NumericConstraint*> newActiveConstraints;
 
-    auto constraintValue = problem->getMaxNumericConstraintValue(ptNew, currentConstraints, activeConstraints);
+    auto constraintValue = problem->getMaxNumericConstraintValue(ptNew, currentConstraints, newActiveConstraints);
     double calculatedValue = constraintValue.normalizedValue;
 
     if(!constraintValue.isFulfilled && calculatedValue <= lastActiveConstraintUpdateValue
-        && activeConstraints.size() < currentConstraints.size())
+        && newActiveConstraints.size() < currentConstraints.size())
     {
-        setActiveConstraints(activeConstraints);
+        setActiveConstraints(newActiveConstraints);
         lastActiveConstraintUpdateValue = calculatedValue;
     }
 
@@ -92,7 +91,7 @@ RootsearchMethodBoost::RootsearchMethodBoost(EnvironmentPtr envPtr) : env(envPtr
     testObjective = std::make_unique<TestObjective>(env);
 }
 
-RootsearchMethodBoost::~RootsearchMethodBoost() { activeConstraints.clear(); }
+RootsearchMethodBoost::~RootsearchMethodBoost() = default;
 
 std::pair<VectorDouble, VectorDouble> RootsearchMethodBoost::findZero(const VectorDouble& ptA, const VectorDouble& ptB,
     int Nmax, double lambdaTol, double constrTol, const NonlinearConstraints constraints,
@@ -172,23 +171,23 @@ std::pair<VectorDouble, VectorDouble> RootsearchMethodBoost::findZero(const Vect
     if(static_cast<ES_RootsearchMethod>(env->settings->getSetting<int>("Rootsearch.Method", "Subsolver"))
         == ES_RootsearchMethod::BoostTOMS748)
     {
-        r1 = boost::math::tools::toms748_solve(*test, 0.0, 1.0, TerminationCondition(lambdaTol), max_iter);
+        // Passed by reference since the active constraints are updated during the search
+        r1 = boost::math::tools::toms748_solve(std::ref(*test), 0.0, 1.0, TerminationCondition(lambdaTol), max_iter);
     }
     else
     {
-        r1 = boost::math::tools::bisect(*test, 0.0, 1.0, TerminationCondition(lambdaTol), max_iter);
+        r1 = boost::math::tools::bisect(std::ref(*test), 0.0, 1.0, TerminationCondition(lambdaTol), max_iter);
     }
 
     int resFVals = env->solutionStatistics.numberOfFunctionEvalutions - tempFEvals;
     if((int)max_iter == Nmax)
     {
-        env->output->outputDebug(
-            "        Warning, number of line search iterations " + std::to_string(max_iter) + " reached!");
+        env->output->outputDebug("        Warning, number of line search iterations {} reached!", max_iter);
     }
     else
     {
-        env->output->outputTrace("        Line search iterations: " + std::to_string(max_iter)
-            + ". Function evaluations: " + std::to_string(resFVals));
+        env->output->outputTrace(
+            "        Line search iterations: {}. Function evaluations: {}", max_iter, resFVals);
     }
 
     for(size_t i = 0; i < length; i++)
@@ -252,13 +251,12 @@ std::pair<double, double> RootsearchMethodBoost::findZero(const VectorDouble& pt
     int resFVals = env->solutionStatistics.numberOfFunctionEvalutions - tempFEvals;
     if((int)max_iter == Nmax)
     {
-        env->output->outputDebug(
-            "        Warning, number of line search iterations " + std::to_string(max_iter) + " reached!");
+        env->output->outputDebug("        Warning, number of line search iterations {} reached!", max_iter);
     }
     else
     {
-        env->output->outputTrace("        Line search iterations: " + std::to_string(max_iter)
-            + ". Function evaluations: " + std::to_string(resFVals));
+        env->output->outputTrace(
+            "        Line search iterations: {}. Function evaluations: {}", max_iter, resFVals);
     }
 
     double ptNew = r1.first * objectiveLB + (1 - r1.first) * objectiveUB;
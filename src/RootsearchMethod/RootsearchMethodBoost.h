@@ -19,6 +19,10 @@ class Test
 private:
     EnvironmentPtr env;
 
+    // Kept per instance so that several root searches can run concurrently
+    std::vector<NumericConstraint*> activeConstraints;
+    double lastActiveConstraintUpdateValue = 0.0;
+
 public:
     Problem* problem;
 
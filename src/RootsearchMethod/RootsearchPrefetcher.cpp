@@ -0,0 +1,198 @@
+/**
+   The Supporting Hyperplane Optimization Toolkit (SHOT).
+
+   @author Andreas Lundell, Åbo Akademi University
+
+   @section LICENSE
+   This software is licensed under the Eclipse Public License 2.0.
+   Please see the README and LICENSE files for more information.
+*/
+
+#include "RootsearchPrefetcher.h"
+#include "RootsearchMethodBoost.h"
+
+#include "../DualSolver.h"
+#include "../Output.h"
+#include "../Settings.h"
+
+#include "../Model/Problem.h"
+
+#include "spdlog/fmt/fmt.h"
+
+namespace SHOT
+{
+
+// The solution points are identified up to this tolerance, see Problem::getPointKey
+const double pointKeyBucketWidth = 1e-9;
+
+RootsearchPrefetcher::RootsearchPrefetcher(EnvironmentPtr envPtr, int numberOfThreads) : env(envPtr)
+{
+    for(int i = 0; i < numberOfThreads; i++)
+        workers.emplace_back(&RootsearchPrefetcher::work, this);
+}
+
+RootsearchPrefetcher::~RootsearchPrefetcher()
+{
+    {
+        std::lock_guard<std::mutex> lock(prefetchMutex);
+        isStopped = true;
+        pendingPoints.clear();
+    }
+
+    pointAdded.notify_all();
+
+    for(auto& W : workers)
+        W.join();
+}
+
+void RootsearchPrefetcher::addPoint(VectorDouble point)
+{
+    if(point.size() != (size_t)env->reformulatedProblem->properties.numberOfVariables)
+    {
+        env->output->outputDebug("        Ignoring MIP solution with {} instead of {} variables for root searches.",
+            point.size(), env->reformulatedProblem->properties.numberOfVariables);
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(prefetchMutex);
+        pendingPoints.push_back(std::move(point));
+    }
+
+    pointAdded.notify_one();
+}
+
+void RootsearchPrefetcher::finish()
+{
+    std::unique_lock<std::mutex> lock(prefetchMutex);
+
+    if(pendingPoints.size() > 0)
+        env->output->outputDebug(
+            "        Dropping {} MIP solutions not yet used for root searches.", pendingPoints.size());
+
+    pendingPoints.clear();
+    pointProcessed.wait(lock, [this] { return (numberOfBusyWorkers == 0); });
+}
+
+void RootsearchPrefetcher::clear()
+{
+    std::lock_guard<std::mutex> lock(prefetchMutex);
+    results.clear();
+}
+
+std::optional<std::pair<VectorDouble, VectorDouble>> RootsearchPrefetcher::getResult(
+    const VectorDouble& interiorPoint, const VectorDouble& solutionPoint, int constraintIndex)
+{
+    auto key = std::make_pair(
+        env->reformulatedProblem->getPointKey(solutionPoint, pointKeyBucketWidth, false), constraintIndex);
+
+    std::lock_guard<std::mutex> lock(prefetchMutex);
+
+    if(auto resultsForPoint = results.find(key); resultsForPoint != results.end())
+    {
+        for(auto& R : resultsForPoint->second)
+        {
+            // The interior point may have been updated after the root search was performed
+            if(R.interiorPoint == interiorPoint)
+                return (R.points);
+        }
+    }
+
+    return (std::nullopt);
+}
+
+void RootsearchPrefetcher::work()
+{
+    // Each worker has its own root search instance since these keep the active constraints during the search
+    RootsearchMethodBoost rootsearchMethod(env);
+
+    while(true)
+    {
+        VectorDouble point;
+
+        {
+            std::unique_lock<std::mutex> lock(prefetchMutex);
+            pointAdded.wait(lock, [this] { return (isStopped || pendingPoints.size() > 0); });
+
+            if(isStopped)
+                return;
+
+            point = std::move(pendingPoints.front());
+            pendingPoints.pop_front();
+            numberOfBusyWorkers++;
+        }
+
+        performRootsearches(rootsearchMethod, point);
+
+        {
+            std::lock_guard<std::mutex> lock(prefetchMutex);
+            numberOfBusyWorkers--;
+        }
+
+        pointProcessed.notify_all();
+    }
+}
+
+void RootsearchPrefetcher::performRootsearches(IRootsearchMethod& rootsearchMethod, const VectorDouble& point)
+{
+    // The constraints are selected as in TaskSelectHyperplanePointsESH, but only the convex ones are considered since
+    // cuts for nonconvex constraints are only generated if no convex constraint gives one
+    auto constraintSelectionFactor
+        = env->settings->getSetting<double>("HyperplaneCuts.ConstraintSelectionFactor", "Dual");
+    int rootMaxIter = env->settings->getSetting<int>("Rootsearch.MaxIterations", "Subsolver");
+    double rootTerminationTolerance = env->settings->getSetting<double>("Rootsearch.TerminationTolerance", "Subsolver");
+    double rootActiveConstraintTolerance
+        = env->settings->getSetting<double>("Rootsearch.ActiveConstraintTolerance", "Subsolver");
+    int maxHyperplanesPerIter = env->settings->getSetting<int>("HyperplaneCuts.MaxPerIteration", "Dual");
+    double rootsearchConstraintTolerance
+        = env->settings->getSetting<double>("ESH.Rootsearch.ConstraintTolerance", "Dual");
+    double constraintMaxSelectionFactor
+        = env->settings->getSetting<double>("HyperplaneCuts.MaxConstraintFactor", "Dual");
+
+    auto numericConstraintValues = env->reformulatedProblem->getFractionOfDeviatingNonlinearConstraints(
+        point, 0.0, constraintSelectionFactor);
+
+    auto pointKey = env->reformulatedProblem->getPointKey(point, pointKeyBucketWidth, false);
+    int performedRootsearches = 0;
+
+    for(auto& NCV : numericConstraintValues)
+    {
+        if(std::isnan(NCV.error) || std::isnan(NCV.normalizedValue) || NCV.error <= 0.0)
+            continue;
+
+        if(NCV.normalizedValue < rootsearchConstraintTolerance)
+            continue;
+
+        if(NCV.error < constraintMaxSelectionFactor * numericConstraintValues.at(0).error)
+            continue;
+
+        if(NCV.constraint->properties.convexity != E_Convexity::Convex)
+            continue;
+
+        for(auto& IP : env->dualSolver->interiorPts)
+        {
+            if(performedRootsearches >= maxHyperplanesPerIter)
+                return;
+
+            std::vector<NumericConstraint*> currentConstraint { NCV.constraint.get() };
+
+            try
+            {
+                // Primal candidates cannot be added from the worker threads, this is done when the result is used
+                auto points = rootsearchMethod.findZero(IP->point, point, rootMaxIter, rootTerminationTolerance,
+                    rootActiveConstraintTolerance, currentConstraint, false);
+
+                std::lock_guard<std::mutex> lock(prefetchMutex);
+                results[std::make_pair(pointKey, NCV.constraint->index)].push_back(Result { IP->point, points });
+            }
+            catch(std::exception&)
+            {
+                // The root search is performed again when the cuts are generated
+            }
+
+            performedRootsearches++;
+        }
+    }
+}
+
+} // namespace SHOT
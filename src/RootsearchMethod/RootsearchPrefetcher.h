@@ -0,0 +1,75 @@
+/**
+   The Supporting Hyperplane Optimization Toolkit (SHOT).
+
+   @author Andreas Lundell, Åbo Akademi University
+
+   @section LICENSE
+   This software is licensed under the Eclipse Public License 2.0.
+   Please see the README and LICENSE files for more information.
+*/
+
+#pragma once
+#include "../Environment.h"
+#include "../Structs.h"
+
+#include <condition_variable>
+#include <deque>
+#include <map>
+#include <mutex>
+#include <optional>
+#include <thread>
+
+namespace SHOT
+{
+
+class IRootsearchMethod;
+
+// Performs the ESH root searches for the MIP solutions reported by the MIP solver while it is still running, on a pool
+// of worker threads with one root search instance each. When the MIP solver has returned, the results are looked up in
+// TaskSelectHyperplanePointsESH instead of repeating the root searches.
+class RootsearchPrefetcher
+{
+public:
+    RootsearchPrefetcher(EnvironmentPtr envPtr, int numberOfThreads);
+    ~RootsearchPrefetcher();
+
+    // Queues the root searches for a MIP solution point, does not wait for them. Points with another size than the
+    // number of variables in the reformulated problem are ignored.
+    void addPoint(VectorDouble point);
+
+    // Drops the points not yet started on and waits for the root searches in progress to finish
+    void finish();
+
+    // Removes the stored results
+    void clear();
+
+    // Returns the internal and external points of the root search from the interior point towards the solution point
+    // for the constraint, if it has been performed
+    std::optional<std::pair<VectorDouble, VectorDouble>> getResult(
+        const VectorDouble& interiorPoint, const VectorDouble& solutionPoint, int constraintIndex);
+
+private:
+    struct Result
+    {
+        VectorDouble interiorPoint;
+        std::pair<VectorDouble, VectorDouble> points;
+    };
+
+    EnvironmentPtr env;
+
+    std::vector<std::thread> workers;
+    std::deque<VectorDouble> pendingPoints;
+    int numberOfBusyWorkers = 0;
+    bool isStopped = false;
+
+    std::mutex prefetchMutex;
+    std::condition_variable pointAdded;
+    std::condition_variable pointProcessed;
+
+    std::map<std::pair<PointKey, int>, std::vector<Result>> results;
+
+    void work();
+    void performRootsearches(IRootsearchMethod& rootsearchMethod, const VectorDouble& point);
+};
+
+} // namespace SHOT
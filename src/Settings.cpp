@@ -33,35 +33,29 @@ void Settings::createBaseSetting(
 
     PairString key = make_pair(category, name);
 
-    std::string tempValue;
-
     if constexpr(std::is_same_v<T, std::string>)
     {
         stringSettings[key] = value;
         settingTypes[key] = E_SettingType::String;
-        tempValue = Utilities::trim(value);
-        output->outputTrace(" String setting " + category + "." + name + " = " + tempValue + " created.");
+        output->outputTrace(" String setting {}.{} = {} created.", category, name, Utilities::trim(value));
     }
     else if constexpr(std::is_same_v<T, int>)
     {
         integerSettings[key] = value;
         settingTypes[key] = E_SettingType::Integer;
-        tempValue = std::to_string(value);
-        output->outputTrace(" Integer setting " + category + "." + name + " = " + tempValue + " created.");
+        output->outputTrace(" Integer setting {}.{} = {} created.", category, name, value);
     }
     else if constexpr(std::is_same_v<T, double>)
     {
         doubleSettings[key] = value;
         settingTypes[key] = E_SettingType::Double;
-        tempValue = std::to_string(value);
-        output->outputTrace(" Double setting " + category + "." + name + " = " + tempValue + " created.");
+        output->outputTrace(" Double setting {}.{} = {} created.", category, name, value);
     }
     else if constexpr(std::is_same_v<T, bool>)
     {
         booleanSettings[key] = value;
         settingTypes[key] = E_SettingType::Boolean;
-        tempValue = std::to_string(value);
-        output->outputTrace(" Boolean " + category + "." + name + " = " + tempValue + " created.");
+        output->outputTrace(" Boolean {}.{} = {} created.", category, name, value);
     }
 
     settingDescriptions[key] = description;
@@ -155,7 +149,7 @@ template <typename T> void Settings::updateSetting(std::string name, std::string
     {
         stringSettings[key] = Utilities::trim(value);
 
-        output->outputTrace(" Setting " + key.first + "." + key.second + " updated. New value = " + value + ".");
+        output->outputTrace(" Setting {}.{} updated. New value = {}.", key.first, key.second, value);
     }
     else if constexpr(std::is_same_v<T, int>)
     {
@@ -230,7 +224,7 @@ void Settings::createSetting(std::string name, std::string category, int value,
     for(int i = startValue; i < (int)(startValue + enumDesc.size()); i++)
     {
         enumDescriptions[make_tuple(category, name, i)] = enumDesc.at(counter);
-        output->outputTrace(" Enum value " + std::to_string(i) + ": " + enumDesc.at(counter));
+        output->outputTrace(" Enum value {}: {}", i, enumDesc.at(counter));
         counter++;
     }
 
@@ -33,6 +33,7 @@
 #include "../Tasks/TaskPrintIterationReport.h"
 
 #include "../Tasks/TaskSolveIteration.h"
+#include "../Tasks/TaskPerformBoundTighteningOBBT.h"
 #include "../Tasks/TaskPresolve.h"
 
 #include "../Tasks/TaskRepairInfeasibleDualProblem.h"
@@ -67,12 +68,15 @@
 
 #include "../Tasks/TaskAddIntegerCuts.h"
 
+#include "../DualSolver.h"
 #include "../Output.h"
 #include "../Model/Problem.h"
 #include "../Model/ObjectiveFunction.h"
 #include "../Settings.h"
 #include "../Timing.h"
 
+#include "../RootsearchMethod/RootsearchPrefetcher.h"
+
 namespace SHOT
 {
 
@@ -268,6 +272,17 @@ SolutionStrategyMultiTree::SolutionStrategyMultiTree(EnvironmentPtr envPtr)
 
             auto tSelectHPPts = std::make_shared<TaskSelectHyperplanePointsESH>(env);
             env->tasks->addTask(tSelectHPPts, "SelectHPPts");
+
+            int numberOfPrefetchThreads
+                = env->settings->getSetting<int>("ESH.Rootsearch.Prefetch.NumberOfThreads", "Dual");
+
+            if(numberOfPrefetchThreads > 0
+                && static_cast<ES_MIPSolver>(env->settings->getSetting<int>("MIP.Solver", "Dual"))
+                    == ES_MIPSolver::Cbc)
+            {
+                env->dualSolver->rootsearchPrefetcher
+                    = std::make_shared<RootsearchPrefetcher>(env, numberOfPrefetchThreads);
+            }
         }
         else
         {
@@ -291,6 +306,12 @@ SolutionStrategyMultiTree::SolutionStrategyMultiTree(EnvironmentPtr envPtr)
 
     env->tasks->addTask(tAddHPs, "AddHPs");
 
+    if(env->settings->getSetting<bool>("BoundTightening.OptimizationBased.Use", "Model"))
+    {
+        auto tPerformOBBT = std::make_shared<TaskPerformBoundTighteningOBBT>(env);
+        env->tasks->addTask(tPerformOBBT, "PerformOBBT");
+    }
+
     if(static_cast<ES_MIPPresolveStrategy>(env->settings->getSetting<int>("MIP.Presolve.Frequency", "Dual"))
         != ES_MIPPresolveStrategy::Never)
     {
@@ -324,13 +345,13 @@ bool SolutionStrategyMultiTree::solveProblem()
         while(env->tasks->getNextTask(nextTask))
         {
 #ifdef SIMPLE_OUTPUT_CHARS
-            env->output->outputTrace("---- Started task:  " + nextTask->getType());
+            env->output->outputTrace("---- Started task:  {}", nextTask->getType());
             nextTask->run();
-            env->output->outputTrace("---- Finished task: " + nextTask->getType());
+            env->output->outputTrace("---- Finished task: {}", nextTask->getType());
 #else
-            env->output->outputTrace("┌─── Started task:  " + nextTask->getType());
+            env->output->outputTrace("┌─── Started task:  {}", nextTask->getType());
             nextTask->run();
-            env->output->outputTrace("└─── Finished task: " + nextTask->getType());
+            env->output->outputTrace("└─── Finished task: {}", nextTask->getType());
 #endif
         }
     }
@@ -70,6 +70,7 @@ Solver::Solver()
     env->timing->createTimer("BoundTightening", " - bound tightening");
     env->timing->createTimer("BoundTighteningFBBTOriginal", "   - feasibility based (original problem)");
     env->timing->createTimer("BoundTighteningFBBTReformulated", "   - feasibility based (reformulated problem)");
+    env->timing->createTimer("BoundTighteningOBBT", "   - optimization based");
 
     env->settings = std::make_shared<Settings>(env->output);
     env->tasks = std::make_shared<TaskHandler>(env);
@@ -101,6 +102,7 @@ Solver::Solver(std::shared_ptr<spdlog::sinks::sink> consoleSink)
     env->timing->createTimer("BoundTighteningFBBT", "   - feasibility based");
     env->timing->createTimer("BoundTighteningFBBTOriginal", "   - feasibility based (original problem");
     env->timing->createTimer("BoundTighteningFBBTReformulated", "   - feasibility based (reformulated problem");
+    env->timing->createTimer("BoundTighteningOBBT", "   - optimization based");
 
     env->settings = std::make_shared<Settings>(env->output);
     env->tasks = std::make_shared<TaskHandler>(env);
@@ -114,7 +116,12 @@ Solver::Solver(std::shared_ptr<spdlog::sinks::sink> consoleSink)
 
 Solver::Solver(EnvironmentPtr envPtr) : env(envPtr) { initializeSettings(); }
 
-Solver::~Solver() = default;
+Solver::~Solver()
+{
+    // The log file is written in the background, so make sure everything is in it before returning
+    if(env->output)
+        env->output->flush();
+}
 
 EnvironmentPtr Solver::getEnvironment() { return env; }
 
@@ -700,6 +707,9 @@ void Solver::initializeSettings()
     env->settings->createSetting("ESH.Rootsearch.ConstraintTolerance", "Dual", 1e-8,
         "Constraint tolerance for when not to add individual hyperplanes", 0, SHOT_DBL_MAX);
 
+    env->settings->createSetting("ESH.Rootsearch.Prefetch.NumberOfThreads", "Dual", 0,
+        "Number of threads performing root searches on the solutions found while Cbc is running (0: disabled)", 0, 64);
+
     // Dual strategy settings: Fixed integer strategy
 
     env->settings->createSettingGroup("Dual", "FixedInteger", "Fixed integer dual strategy",
@@ -889,6 +899,10 @@ void Solver::initializeSettings()
         "SHOT performs bound tightening to strengthen the internal representation of the problem. These settings "
         "control how and when bound tightening is performed.");
 
+    env->settings->createSetting("BoundTightening.FeasibilityBased.MaxConstraintIterations", "Model", 5,
+        "Maximal number of forward-backward propagations per constraint in each bound tightening iteration", 1,
+        SHOT_INT_MAX);
+
     env->settings->createSetting(
         "BoundTightening.FeasibilityBased.MaxIterations", "Model", 5, "Maximal number of bound tightening iterations");
 
@@ -901,6 +915,30 @@ void Solver::initializeSettings()
     env->settings->createSetting("BoundTightening.FeasibilityBased.UseNonlinear", "Model", true,
         "Peform feasibility-based bound tightening on nonlinear expressions");
 
+    env->settings->createSetting("BoundTightening.OptimizationBased.OnlyNonlinear", "Model", true,
+        "Only tighten the bounds of variables in nonlinear terms with optimization-based bound tightening");
+
+    env->settings->createSetting("BoundTightening.OptimizationBased.TimeLimit", "Model", 5.0,
+        "Time limit for optimization-based bound tightening", 0.0, SHOT_DBL_MAX);
+
+    env->settings->createSetting("BoundTightening.OptimizationBased.Use", "Model", false,
+        "Perform optimization-based bound tightening on the outer approximation (requires Cbc)");
+
+    // Code generation
+
+    env->settings->createSettingGroup("Model", "CodeGeneration", "Code generation",
+        "These settings control the compilation of the nonlinear expressions in the constraints to native code, which "
+        "is then used for evaluating the function values and gradients.");
+
+    env->settings->createSetting("CodeGeneration.CachePath", "Model", empty,
+        "Directory where the compiled expressions are cached, the system temporary directory is used if empty");
+
+    env->settings->createSetting("CodeGeneration.Compiler", "Model", std::string("cc"),
+        "C compiler used for compiling the generated code");
+
+    env->settings->createSetting("CodeGeneration.Use", "Model", false,
+        "Compile the nonlinear expressions in the constraints to native code (not available on Windows)");
+
     env->settings->createSettingGroup(
         "Model", "Convexity", "Convexity", "These settings control the convexity detection functionality.");
 
@@ -909,6 +947,37 @@ void Solver::initializeSettings()
     env->settings->createSetting("Convexity.Quadratics.EigenValueTolerance", "Model", 1e-5,
         "Convexity tolerance for the eigenvalues of the Hessian matrix for quadratic terms", 0.0, SHOT_DBL_MAX);
 
+    env->settings->createSetting("Convexity.Quadratics.MaxBlockSizeEigenValues", "Model", 1000,
+        "Max size of the blocks in quadratic terms for which eigenvalues are calculated if the factorization is "
+        "inconclusive",
+        0, SHOT_INT_MAX);
+
+    env->settings->createSettingGroup("Model", "Presolve", "Presolve",
+        "These settings control the reductions on the linear constraints of the reformulated problem, which are done "
+        "before the dual problem is created.");
+
+    env->settings->createSetting("Presolve.Aggregation.Use", "Model", true,
+        "Substitute continuous variables in equality constraints with two variables");
+
+    env->settings->createSetting(
+        "Presolve.MaxRounds", "Model", 10, "Maximum number of presolve rounds", 0, SHOT_INT_MAX);
+
+    env->settings->createSetting("Presolve.Use", "Model", false, "Presolve the linear constraints");
+
+    env->settings->createSettingGroup("Model", "Symmetry", "Symmetry",
+        "These settings control the detection of permutations of the variables that map the reformulated problem onto "
+        "itself. Symmetry breaking constraints for the variables in one orbit of each independent set of permutations "
+        "are added to the dual problem.");
+
+    env->settings->createSetting("Symmetry.MaxGraphSize", "Model", 100000,
+        "Maximum number of nodes in the graph used for symmetry detection", 0, SHOT_INT_MAX);
+
+    env->settings->createSetting("Symmetry.TimeLimit", "Model", 5.0,
+        "Time limit in seconds for symmetry detection, the permutations found before it are used", 0.0, SHOT_DBL_MAX);
+
+    env->settings->createSetting(
+        "Symmetry.Use", "Model", false, "Add symmetry breaking constraints to the dual problem");
+
     env->settings->createSettingGroup("Model", "Variables", "Variables",
         "These settings control the maximum variable bounds allowed in SHOT. Projection will be performed onto these "
         "intervals. Note that the MIP solvers may have stricter requirements, in which case those may be used.");
@@ -1107,6 +1176,11 @@ void Solver::initializeSettings()
     env->settings->createSetting(
         "FixedInteger.IterationLimit", "Primal", 10000000, "Max number of iterations per call", 0, SHOT_INT_MAX);
 
+    env->settings->createSetting("FixedInteger.NumberOfThreads", "Primal", 1,
+        "Number of Ipopt instances solving fixed NLP problems concurrently. Ignored unless Ipopt.LinearSolver is an HSL "
+        "solver.",
+        1, 999);
+
     env->settings->createSetting("FixedInteger.OnlyUniqueIntegerCombinations", "Primal", true,
         "Whether to resolve with the same integer combination, e.g. for nonconvex problems with different continuous "
         "variable starting points");
@@ -1174,6 +1248,14 @@ void Solver::initializeSettings()
     env->settings->createSetting("Tolerance.NonlinearConstraint", "Primal", 1e-5,
         "Nonlinear constraint tolerance for accepting primal solutions");
 
+    // Primal settings: checking of primal solution candidates
+
+    env->settings->createSettingGroup("Primal", "CandidateCheck", "Primal candidate checks",
+        "These settings control how batches of primal solution candidates are verified.");
+
+    env->settings->createSetting("CandidateCheck.NumberOfThreads", "Primal", 1,
+        "Number of threads used to verify primal solution candidates", 1, 999);
+
     // Strategy settings
 
     env->settings->createSettingGroup("Strategy", "", "Strategy", "Overall strategy parameters used in SHOT.");
@@ -1405,6 +1487,12 @@ void Solver::initializeSettings()
     env->settings->createSetting("Ipopt.ConstraintViolationTolerance", "Subsolver", 1E-8,
         "Constraint violation tolerance in Ipopt", SHOT_DBL_MIN, SHOT_DBL_MAX);
 
+    env->settings->createSetting("Ipopt.Decomposition.NumberOfThreads", "Subsolver", 1,
+        "Number of independent blocks of a problem solved concurrently. Requires a thread-safe linear solver.", 1, 999);
+
+    env->settings->createSetting("Ipopt.Decomposition.Use", "Subsolver", false,
+        "Solve the independent blocks of problems, e.g., when the discrete variables are fixed, separately");
+
     VectorString enumIPOptSolver;
     enumIPOptSolver.push_back("Default");
     enumIPOptSolver.push_back("MA27");
@@ -1412,15 +1500,55 @@ void Solver::initializeSettings()
     enumIPOptSolver.push_back("MA86");
     enumIPOptSolver.push_back("MA97");
     enumIPOptSolver.push_back("MUMPS");
+    env->settings->createSetting("Ipopt.EarlyTermination.BudgetFactor", "Subsolver", 0.0,
+        "Iteration and time budget for an NLP problem as a multiple of the average of the previous ones (0: none)", 0.0,
+        SHOT_DBL_MAX);
+
+    env->settings->createSetting("Ipopt.EarlyTermination.Use", "Subsolver", false,
+        "Terminate NLP problems early if the objective value is not decreasing fast enough to improve on the primal "
+        "bound");
+
+    env->settings->createSetting("Ipopt.HessianApproximation.CostRatioLimit", "Subsolver", 50.0,
+        "Automatic mode: estimated cost of the exact Hessian relative to the gradients for using limited-memory BFGS",
+        1.0, SHOT_DBL_MAX);
+
+    env->settings->createSetting("Ipopt.HessianApproximation.DensityLimit", "Subsolver", 0.5,
+        "Automatic mode: density of the Hessian in the nonlinear variables for using limited-memory BFGS", 0.0, 1.0);
+
+    env->settings->createSetting("Ipopt.HessianApproximation.MinimumNonzeros", "Subsolver", 1000,
+        "Automatic mode: number of Hessian nonzeroes needed for using limited-memory BFGS", 0, SHOT_INT_MAX);
+
+    VectorString enumHessianApproximation;
+    enumHessianApproximation.push_back("Exact");
+    enumHessianApproximation.push_back("Limited-memory BFGS");
+    enumHessianApproximation.push_back("Automatic");
+    env->settings->createSetting("Ipopt.HessianApproximation.Mode", "Subsolver",
+        static_cast<int>(ES_IpoptHessianApproximation::Exact), "Hessian of the Lagrangian used in Ipopt",
+        enumHessianApproximation, 0);
+    enumHessianApproximation.clear();
+
+    env->settings->createSetting("Ipopt.HessianApproximation.PerProblem", "Subsolver", true,
+        "Automatic mode: decide for each NLP problem, e.g., with different fixed variables, instead of once");
+
     env->settings->createSetting("Ipopt.LinearSolver", "Subsolver", static_cast<int>(ES_IpoptSolver::IpoptDefault),
         "Ipopt linear subsolver", enumIPOptSolver, 0);
     enumIPOptSolver.clear();
 
     env->settings->createSetting("Ipopt.MaxIterations", "Subsolver", 1000, "Maximum number of iterations");
 
+    env->settings->createSetting(
+        "Ipopt.ReducedSpace", "Subsolver", false, "Remove fixed variables and the constraints they determine in Ipopt");
+
     env->settings->createSetting(
         "Ipopt.RelativeConvergenceTolerance", "Subsolver", 1E-8, "Relative convergence tolerance");
 
+    env->settings->createSetting("Ipopt.WarmStartCache.MaximumDistance", "Subsolver", 1,
+        "Maximum number of different discrete values in a fixed NLP solution used for warm starting Ipopt", 0,
+        SHOT_INT_MAX);
+
+    env->settings->createSetting("Ipopt.WarmStartCache.Size", "Subsolver", 0,
+        "Number of fixed NLP solutions stored for warm starting Ipopt (0: disabled)", 0, SHOT_INT_MAX);
+
 #endif
 
     // Subsolver settings: root searches
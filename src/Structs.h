@@ -12,6 +12,7 @@
 
 #include "Enums.h"
 
+#include <functional>
 #include <limits>
 #include <memory>
 #include <sstream>
@@ -105,6 +106,22 @@ using VectorInteger = std::vector<int>;
 using VectorString = std::vector<std::string>;
 using VectorPairString = std::vector<PairString>;
 
+// Identifies a point up to a tolerance, see Problem::getPointKey
+using PointKey = std::vector<long long>;
+
+struct PointKeyHasher
+{
+    size_t operator()(const PointKey& key) const
+    {
+        size_t seed = key.size();
+
+        for(auto K : key)
+            seed ^= std::hash<long long>()(K) + 0x9e3779b9 + (seed << 6) + (seed >> 2);
+
+        return (seed);
+    }
+};
+
 struct PairIndexValue
 {
     int index;
@@ -161,7 +178,7 @@ struct PrimalFixedNLPCandidate
     double objValue;
     int iterFound;
     PairIndexValue maxDevatingConstraint;
-    double discreteVariablePointHash;
+    PointKey pointKey;
 };
 
 struct DualSolution
@@ -195,6 +212,7 @@ struct GeneratedHyperplane
     bool isSourceConvex = false;
     int iterationGenerated = -1;
     double pointHash;
+    VectorDouble generatedPoint; // Only stored for convex constraints when used in bound tightening
 };
 
 struct IntegerCut
@@ -228,8 +246,17 @@ struct SolutionStatistics
     int numberOfProblemsNLPInteriorPointSearch = 0;
     int numberOfProblemsFixedNLP = 0;
 
+    // The Ipopt problems solved with exact and limited-memory Hessians, and their iterations and solution times
+    int numberOfProblemsNLPExactHessian = 0;
+    int numberOfProblemsNLPLimitedMemoryHessian = 0;
+    int numberOfIterationsNLPExactHessian = 0;
+    int numberOfIterationsNLPLimitedMemoryHessian = 0;
+    double timeNLPExactHessian = 0;
+    double timeNLPLimitedMemoryHessian = 0;
+
     int numberOfConstraintsRemovedInPresolve = 0;
     int numberOfVariableBoundsTightenedInPresolve = 0;
+    int numberOfVariableBoundsTightenedOBBT = 0;
 
     int numberOfIntegerCuts = 0;
 
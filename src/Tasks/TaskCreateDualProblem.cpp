@@ -16,6 +16,7 @@
 #include "../Timing.h"
 
 #include "../MIPSolver/IMIPSolver.h"
+#include "../Model/Symmetry.h"
 
 namespace SHOT
 {
@@ -26,6 +27,16 @@ TaskCreateDualProblem::TaskCreateDualProblem(EnvironmentPtr envPtr) : TaskBase(e
 
     env->output->outputDebug(" Creating dual problem");
 
+    if(env->settings->getSetting<bool>("Symmetry.Use", "Model"))
+    {
+        auto symmetry = std::make_shared<Symmetry>(env, env->reformulatedProblem);
+
+        if(symmetry->detect())
+            symmetryBreakingPairs = symmetry->getSymmetryBreakingPairs();
+
+        env->output->outputDebug("  Number of symmetry breaking constraints added: {}", symmetryBreakingPairs.size());
+    }
+
     createProblem(env->dualSolver->MIPSolver, env->reformulatedProblem);
 
     env->dualSolver->MIPSolver->finalizeProblem();
@@ -204,6 +215,19 @@ bool TaskCreateDualProblem::createProblem(MIPSolverPtr destination, ProblemPtr s
             = constraintsInitialized && destination->finalizeConstraint(C->name, C->valueLHS, C->valueRHS, C->constant);
     }
 
+    // There is an optimal solution where the first variable in an orbit has the largest value
+    for(size_t i = 0; i < symmetryBreakingPairs.size(); i++)
+    {
+        constraintsInitialized = constraintsInitialized && destination->initializeConstraint();
+
+        constraintsInitialized = constraintsInitialized
+            && destination->addLinearTermToConstraint(-1.0, symmetryBreakingPairs[i].first)
+            && destination->addLinearTermToConstraint(1.0, symmetryBreakingPairs[i].second);
+
+        constraintsInitialized = constraintsInitialized
+            && destination->finalizeConstraint("shot_symmetry_" + std::to_string(i), SHOT_DBL_MIN, 0.0);
+    }
+
     if(!constraintsInitialized)
         return false;
 
@@ -28,5 +28,8 @@ public:
 
 private:
     bool createProblem(MIPSolverPtr destinationProblem, ProblemPtr sourceProblem);
+
+    // Pairs of variable indexes (i, j) for the symmetry breaking constraints x_i >= x_j
+    std::vector<std::pair<int, int>> symmetryBreakingPairs;
 };
 } // namespace SHOT
\ No newline at end of file
@@ -0,0 +1,317 @@
+/**
+   The Supporting Hyperplane Optimization Toolkit (SHOT).
+
+   @author Andreas Lundell, Åbo Akademi University
+
+   @section LICENSE
+   This software is licensed under the Eclipse Public License 2.0.
+   Please see the README and LICENSE files for more information.
+*/
+
+#include "TaskPerformBoundTighteningOBBT.h"
+
+#include "../DualSolver.h"
+#include "../Iteration.h"
+#include "../Output.h"
+#include "../Results.h"
+#include "../Settings.h"
+#include "../Timing.h"
+#include "../Utilities.h"
+
+#include "../MIPSolver/IMIPSolver.h"
+
+#include "../Model/Problem.h"
+
+#include <cmath>
+#include <map>
+
+#ifdef HAS_CBC
+#include "CoinPackedVector.hpp"
+#include "OsiClpSolverInterface.hpp"
+#endif
+
+namespace SHOT
+{
+
+TaskPerformBoundTighteningOBBT::TaskPerformBoundTighteningOBBT(EnvironmentPtr envPtr) : TaskBase(envPtr) {}
+
+TaskPerformBoundTighteningOBBT::~TaskPerformBoundTighteningOBBT() = default;
+
+void TaskPerformBoundTighteningOBBT::run()
+{
+    if(hasBeenPerformed)
+        return;
+
+    // Waits until the first MIP iteration so that the hyperplanes from the LP steps are included
+    if(!env->results->getCurrentIteration()->isMIP())
+        return;
+
+    hasBeenPerformed = true;
+
+    env->timing->startTimer("BoundTightening");
+    env->timing->startTimer("BoundTighteningOBBT");
+
+    performBoundTightening();
+
+    env->timing->stopTimer("BoundTighteningOBBT");
+    env->timing->stopTimer("BoundTightening");
+}
+
+#ifdef HAS_CBC
+void TaskPerformBoundTighteningOBBT::performBoundTightening()
+{
+    auto problem = env->reformulatedProblem;
+
+    double timeLimit = env->settings->getSetting<double>("BoundTightening.OptimizationBased.TimeLimit", "Model");
+    bool onlyNonlinear = env->settings->getSetting<bool>("BoundTightening.OptimizationBased.OnlyNonlinear", "Model");
+
+    // A bound is only updated if the improvement is larger than this, and the new bound is relaxed by the safety
+    // margin to account for the tolerances in the LP solver
+    const double minimalImprovement = 1e-4;
+    const double safetyMargin = 1e-6;
+
+    double startTime = env->timing->getElapsedTime("BoundTighteningOBBT");
+
+    env->output->outputInfo(" Performing optimization-based bound tightening on reformulated problem.");
+
+    int numberOfVariables = problem->properties.numberOfVariables;
+
+    OsiClpSolverInterface LPSolver;
+    LPSolver.messageHandler()->setLogLevel(0);
+
+    for(auto& V : problem->allVariables)
+        LPSolver.addCol(0, nullptr, nullptr, V->lowerBound, V->upperBound, 0.0);
+
+    for(auto& C : problem->linearConstraints)
+    {
+        std::map<int, double> elements;
+
+        for(auto& T : C->linearTerms)
+            elements[T->variable->index] += T->coefficient;
+
+        CoinPackedVector row;
+
+        for(auto& E : elements)
+            row.insert(E.first, E.second);
+
+        LPSolver.addRow(row, C->valueLHS - C->constant, C->valueRHS - C->constant);
+    }
+
+    int numberOfHyperplanes = 0;
+
+    // Only hyperplanes for convex constraints are valid for the outer approximation
+    for(auto& GH : env->dualSolver->generatedHyperplanes)
+    {
+        if(!GH.isSourceConvex || GH.isRemoved || !GH.sourceConstraint || GH.generatedPoint.empty())
+            continue;
+
+        Hyperplane hyperplane;
+        hyperplane.sourceConstraint = GH.sourceConstraint;
+        hyperplane.sourceConstraintIndex = GH.sourceConstraintIndex;
+        hyperplane.generatedPoint = GH.generatedPoint;
+        hyperplane.source = GH.source;
+        hyperplane.isSourceConvex = true;
+
+        auto terms = env->dualSolver->MIPSolver->createHyperplaneTerms(hyperplane);
+
+        if(!terms)
+            continue;
+
+        CoinPackedVector row;
+        bool isValid = std::isfinite(terms->second);
+
+        for(auto& E : terms->first)
+        {
+            if(!std::isfinite(E.second) || E.first >= numberOfVariables)
+            {
+                isValid = false;
+                break;
+            }
+
+            row.insert(E.first, E.second);
+        }
+
+        if(!isValid)
+            continue;
+
+        LPSolver.addRow(row, -LPSolver.getInfinity(), -terms->second);
+        numberOfHyperplanes++;
+    }
+
+    // Points that are worse than the primal bound need not be considered
+    if(problem->objectiveFunction->properties.classification == E_ObjectiveFunctionClassification::Linear
+        && env->results->hasPrimalSolution())
+    {
+        std::map<int, double> elements;
+
+        for(auto& T : std::dynamic_pointer_cast<LinearObjectiveFunction>(problem->objectiveFunction)->linearTerms)
+            elements[T->variable->index] += T->coefficient;
+
+        CoinPackedVector row;
+
+        for(auto& E : elements)
+            row.insert(E.first, E.second);
+
+        double bound = env->results->getPrimalBound() - problem->objectiveFunction->constant;
+
+        if(problem->objectiveFunction->properties.isMinimize)
+            LPSolver.addRow(row, -LPSolver.getInfinity(), bound);
+        else
+            LPSolver.addRow(row, bound, LPSolver.getInfinity());
+    }
+
+    env->output->outputDebug("  Outer approximation with {} linear constraints and {} hyperplanes created.",
+        problem->linearConstraints.size(), numberOfHyperplanes);
+
+    std::vector<int> candidates;
+
+    for(auto& V : problem->allVariables)
+    {
+        if(V->properties.type == E_VariableType::Binary)
+            continue;
+
+        if(onlyNonlinear && !V->properties.isNonlinear)
+            continue;
+
+        if(V->upperBound - V->lowerBound < minimalImprovement)
+            continue;
+
+        candidates.push_back(V->index);
+    }
+
+    try
+    {
+        LPSolver.initialSolve();
+    }
+    catch(CoinError& e)
+    {
+        env->output->outputError("  Error when solving outer approximation in bound tightening", e.message());
+        return;
+    }
+
+    if(!LPSolver.isProvenOptimal())
+    {
+        env->output->outputDebug("  Outer approximation could not be solved, no bound tightening performed.");
+        return;
+    }
+
+    // Only the objective changes between the solves, so the primal simplex method is used from the previous basis
+    LPSolver.setHintParam(OsiDoDualInResolve, false, OsiHintDo);
+
+    // A bound is already known to be tight if a solution to the outer approximation attains it
+    std::vector<bool> isLowerBoundTight(numberOfVariables, false);
+    std::vector<bool> isUpperBoundTight(numberOfVariables, false);
+
+    auto filterCandidates = [&](const double* solution) {
+        for(auto I : candidates)
+        {
+            if(solution[I] <= LPSolver.getColLower()[I] + safetyMargin)
+                isLowerBoundTight[I] = true;
+
+            if(solution[I] >= LPSolver.getColUpper()[I] - safetyMargin)
+                isUpperBoundTight[I] = true;
+        }
+    };
+
+    filterCandidates(LPSolver.getColSolution());
+
+    int numberOfProblemsSolved = 0;
+    int numberOfTightenedBounds = 0;
+    bool timeLimitReached = false;
+
+    for(auto I : candidates)
+    {
+        for(bool isLower : { true, false })
+        {
+            if(env->timing->getElapsedTime("BoundTighteningOBBT") - startTime > timeLimit)
+            {
+                timeLimitReached = true;
+                break;
+            }
+
+            if((isLower && isLowerBoundTight[I]) || (!isLower && isUpperBoundTight[I]))
+                continue;
+
+            LPSolver.setObjCoeff(I, isLower ? 1.0 : -1.0);
+
+            try
+            {
+                LPSolver.resolve();
+            }
+            catch(CoinError& e)
+            {
+                env->output->outputError("  Error when solving bound tightening problem", e.message());
+            }
+
+            LPSolver.setObjCoeff(I, 0.0);
+            numberOfProblemsSolved++;
+
+            if(!LPSolver.isProvenOptimal())
+                continue;
+
+            filterCandidates(LPSolver.getColSolution());
+
+            auto variable = problem->getVariable(I);
+            double value = LPSolver.getColSolution()[I];
+
+            double lowerBound = variable->lowerBound;
+            double upperBound = variable->upperBound;
+
+            if(isLower)
+            {
+                lowerBound = value - safetyMargin * std::max(1.0, std::abs(value));
+
+                if(variable->properties.type == E_VariableType::Integer)
+                    lowerBound = std::ceil(lowerBound - safetyMargin);
+
+                if(lowerBound < variable->lowerBound + minimalImprovement || lowerBound > upperBound)
+                    continue;
+
+                variable->properties.hasLowerBoundBeenTightened = true;
+            }
+            else
+            {
+                upperBound = value + safetyMargin * std::max(1.0, std::abs(value));
+
+                if(variable->properties.type == E_VariableType::Integer)
+                    upperBound = std::floor(upperBound + safetyMargin);
+
+                if(upperBound > variable->upperBound - minimalImprovement || upperBound < lowerBound)
+                    continue;
+
+                variable->properties.hasUpperBoundBeenTightened = true;
+            }
+
+            env->output->outputDebug("   Bounds for variable {} tightened from [{}, {}] to [{}, {}].",
+                variable->name, variable->lowerBound, variable->upperBound, lowerBound, upperBound);
+
+            problem->setVariableBounds(I, lowerBound, upperBound);
+            env->dualSolver->MIPSolver->updateVariableBound(I, lowerBound, upperBound);
+            LPSolver.setColBounds(I, lowerBound, upperBound);
+
+            numberOfTightenedBounds++;
+        }
+
+        if(timeLimitReached)
+            break;
+    }
+
+    env->solutionStatistics.numberOfVariableBoundsTightenedOBBT += numberOfTightenedBounds;
+
+    env->output->outputInfo("  - {} bounds tightened in {:.2f} s by solving {} LP problems{}.", numberOfTightenedBounds,
+        env->timing->getElapsedTime("BoundTighteningOBBT") - startTime, numberOfProblemsSolved,
+        timeLimitReached ? " (time limit reached)" : "");
+}
+#else
+void TaskPerformBoundTighteningOBBT::performBoundTightening()
+{
+    env->output->outputDebug(" Optimization-based bound tightening requires Clp, which is not available.");
+}
+#endif
+
+std::string TaskPerformBoundTighteningOBBT::getType()
+{
+    std::string type = typeid(this).name();
+    return (type);
+}
+} // namespace SHOT
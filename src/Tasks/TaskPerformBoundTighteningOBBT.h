@@ -0,0 +1,32 @@
+/**
+   The Supporting Hyperplane Optimization Toolkit (SHOT).
+
+   @author Andreas Lundell, Åbo Akademi University
+
+   @section LICENSE
+   This software is licensed under the Eclipse Public License 2.0.
+   Please see the README and LICENSE files for more information.
+*/
+
+#pragma once
+#include "TaskBase.h"
+
+namespace SHOT
+{
+// Optimization-based bound tightening: minimizes and maximizes the variables over the current polyhedral outer
+// approximation, i.e., the linear constraints and the hyperplanes generated for convex constraints
+class TaskPerformBoundTighteningOBBT : public TaskBase
+{
+public:
+    TaskPerformBoundTighteningOBBT(EnvironmentPtr envPtr);
+    ~TaskPerformBoundTighteningOBBT() override;
+
+    void run() override;
+    std::string getType() override;
+
+private:
+    void performBoundTightening();
+
+    bool hasBeenPerformed = false;
+};
+} // namespace SHOT
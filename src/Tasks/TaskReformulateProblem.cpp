@@ -18,6 +18,7 @@
 #include "../Utilities.h"
 #include "../Timing.h"
 
+#include "../Model/Presolve.h"
 #include "../Model/Simplifications.h"
 
 namespace SHOT
@@ -158,6 +159,14 @@ TaskReformulateProblem::TaskReformulateProblem(EnvironmentPtr envPtr) : TaskBase
     // Creating expressions for the bilinear reformulations
     createBilinearReformulations();
 
+    // Presolving the linear constraints, this is done before the properties are updated in finalize
+    if(env->settings->getSetting<bool>("Presolve.Use", "Model"))
+    {
+        auto presolve = std::make_shared<Presolve>(env, reformulatedProblem);
+        presolve->run();
+        reformulatedProblem->presolve = presolve;
+    }
+
     reformulatedProblem->properties.isReformulated = true;
     reformulatedProblem->finalize();
 
@@ -1172,6 +1181,17 @@ LinearTerms TaskReformulateProblem::partitionNonlinearSum(
 
         if(!allNonlinearExpressionsReformulated)
         {
+            // A term occurring in several constraints or the objective, e.g. an AMPL defined variable, only needs one
+            // auxiliary variable
+            auto& auxVariables = nonlinearSumAuxVariables[reversedSigns ? 1 : 0];
+            auto auxVariableIterator = auxVariables.find(T);
+
+            if(auxVariableIterator != auxVariables.end())
+            {
+                resultLinearTerms.add(std::make_shared<LinearTerm>(1.0, auxVariableIterator->second));
+                continue;
+            }
+
             Interval bounds;
 
             double varLowerBound = env->settings->getSetting<double>("Variables.Continuous.MinimumLowerBound", "Model");
@@ -1193,6 +1213,7 @@ LinearTerms TaskReformulateProblem::partitionNonlinearSum(
             env->results->increaseAuxiliaryVariableCounter(E_AuxiliaryVariableType::NonlinearExpressionPartitioning);
 
             resultLinearTerms.add(std::make_shared<LinearTerm>(1.0, auxVariable));
+            auxVariables.emplace(T, auxVariable);
 
             bool extractQuadraticTerms
                 = (env->settings->getSetting<int>("Reformulation.Quadratics.ExtractStrategy", "Model")
@@ -1381,9 +1402,9 @@ LinearTerms TaskReformulateProblem::partitionSignomialTerms(const SignomialTerms
         }
 
         if(signomialTerm->coefficient < 0.0 && auxVariable->upperBound > 0.0)
-            auxVariable->upperBound = 0.0;
+            auxVariable->setUpperBound(0.0);
         else if(signomialTerm->coefficient > 0.0 && auxVariable->lowerBound < 0.0)
-            auxVariable->lowerBound = 0.0;
+            auxVariable->setLowerBound(0.0);
 
         auxConstraint->add(signomialTerm);
 
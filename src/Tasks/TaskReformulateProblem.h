@@ -11,13 +11,16 @@
 #pragma once
 #include "TaskBase.h"
 
+#include <array>
 #include <map>
 #include <tuple>
+#include <unordered_map>
 
 #include "../Model/AuxiliaryVariables.h"
 #include "../Model/Constraints.h"
 #include "../Model/NonlinearExpressions.h"
 #include "../Model/Problem.h"
+#include "../Model/Simplifications.h"
 #include "../Model/Terms.h"
 #include "../Model/Variables.h"
 
@@ -134,6 +137,12 @@ private:
 
     std::map<std::string, AuxiliaryVariablePtr> absoluteExpressionsAuxVariables;
 
+    // The auxiliary variables for the nonlinear terms in partitioned sums, without and with reversed signs
+    std::array<std::unordered_map<NonlinearExpressionPtr, AuxiliaryVariablePtr, NonlinearExpressionStructuralHasher,
+                   NonlinearExpressionStructuralEquality>,
+        2>
+        nonlinearSumAuxVariables;
+
     ProblemPtr reformulatedProblem;
 };
 } // namespace SHOT
\ No newline at end of file
@@ -142,9 +142,8 @@ void TaskSelectHyperplanePointsECP::run(std::vector<SolutionPoint> solPoints)
         addedHyperplanes++;
         hyperplaneAddedToConstraint.at(NCV.constraint->index) = true;
 
-        env->output->outputDebug(
-            fmt::format("         Added hyperplane for constraint {} to waiting list with deviation {}",
-                NCV.constraint->name, NCV.error));
+        env->output->outputDebug("         Added hyperplane for constraint {} to waiting list with deviation {}",
+            NCV.constraint->name, NCV.error);
     }
 
     std::vector<std::pair<Hyperplane, double>> hyperplanesCuttingAwayPrimals;
@@ -210,8 +209,8 @@ void TaskSelectHyperplanePointsECP::run(std::vector<SolutionPoint> solPoints)
             if(!cutsAwayPrimalSolution)
             {
                 env->output->outputDebug(
-                    fmt::format("         Added hyperplane for constraint {} to waiting list with deviation {}",
-                        NCV.constraint->name, NCV.error));
+                    "         Added hyperplane for constraint {} to waiting list with deviation {}",
+                    NCV.constraint->name, NCV.error);
 
                 env->dualSolver->addHyperplane(hyperplane);
                 hyperplaneAddedToConstraint.at(NCV.constraint->index) = true;
@@ -230,9 +229,9 @@ void TaskSelectHyperplanePointsECP::run(std::vector<SolutionPoint> solPoints)
             env->dualSolver->addHyperplane(HP.first);
             hyperplaneAddedToConstraint.at(HP.first.sourceConstraint->index) = true;
             addedHyperplanes++;
-            env->output->outputDebug(fmt::format("         Selected hyperplane cut for constraint {} that cuts away "
-                                                 "previous primal solution with error {}",
-                HP.first.sourceConstraint->index, HP.second));
+            env->output->outputDebug("         Selected hyperplane cut for constraint {} that cuts away "
+                "previous primal solution with error {}",
+                HP.first.sourceConstraint->index, HP.second);
 
             addedHyperplanes++;
 
@@ -13,6 +13,7 @@
 #include "../DualSolver.h"
 #include "../MIPSolver/IMIPSolver.h"
 #include "../Output.h"
+#include "../PrimalSolver.h"
 #include "../Results.h"
 #include "../Settings.h"
 #include "../Utilities.h"
@@ -22,6 +23,7 @@
 
 #include "TaskSelectHyperplanePointsECP.h"
 #include "../RootsearchMethod/IRootsearchMethod.h"
+#include "../RootsearchMethod/RootsearchPrefetcher.h"
 
 namespace SHOT
 {
@@ -166,9 +168,8 @@ void TaskSelectHyperplanePointsESH::run(std::vector<SolutionPoint> solPoints)
         try
         {
             env->timing->startTimer("DualCutGenerationRootSearch");
-            auto xNewc
-                = env->rootsearchMethod->findZero(env->dualSolver->interiorPts.at(j)->point, solPoints.at(i).point,
-                    rootMaxIter, rootTerminationTolerance, rootActiveConstraintTolerance, currentConstraint, true);
+            auto xNewc = findZero(j, solPoints.at(i).point, rootMaxIter, rootTerminationTolerance,
+                rootActiveConstraintTolerance, currentConstraint);
 
             env->timing->stopTimer("DualCutGenerationRootSearch");
             internalPoint = xNewc.first;
@@ -261,9 +262,8 @@ void TaskSelectHyperplanePointsESH::run(std::vector<SolutionPoint> solPoints)
             try
             {
                 env->timing->startTimer("DualCutGenerationRootSearch");
-                auto xNewc
-                    = env->rootsearchMethod->findZero(env->dualSolver->interiorPts.at(j)->point, solPoints.at(i).point,
-                        rootMaxIter, rootTerminationTolerance, rootActiveConstraintTolerance, currentConstraint, true);
+                auto xNewc = findZero(j, solPoints.at(i).point, rootMaxIter, rootTerminationTolerance,
+                    rootActiveConstraintTolerance, currentConstraint);
 
                 env->timing->stopTimer("DualCutGenerationRootSearch");
                 internalPoint = xNewc.first;
@@ -361,9 +361,8 @@ void TaskSelectHyperplanePointsESH::run(std::vector<SolutionPoint> solPoints)
             try
             {
                 env->timing->startTimer("DualCutGenerationRootSearch");
-                auto xNewc
-                    = env->rootsearchMethod->findZero(env->dualSolver->interiorPts.at(j)->point, solPoints.at(i).point,
-                        rootMaxIter, rootTerminationTolerance, rootActiveConstraintTolerance, currentConstraint, true);
+                auto xNewc = findZero(j, solPoints.at(i).point, rootMaxIter, rootTerminationTolerance,
+                    rootActiveConstraintTolerance, currentConstraint);
 
                 env->timing->stopTimer("DualCutGenerationRootSearch");
                 internalPoint = xNewc.first;
@@ -479,9 +478,9 @@ void TaskSelectHyperplanePointsESH::run(std::vector<SolutionPoint> solPoints)
             env->dualSolver->addHyperplane(HP.first);
             hyperplaneAddedToConstraint.at(HP.first.sourceConstraint->index) = true;
             addedHyperplanes++;
-            env->output->outputDebug(fmt::format("         Selected hyperplane cut for constraint {} that cuts away "
-                                                 "previous primal solution with error {}",
-                HP.first.sourceConstraint->index, HP.second));
+            env->output->outputDebug("         Selected hyperplane cut for constraint {} that cuts away "
+                "previous primal solution with error {}",
+                HP.first.sourceConstraint->index, HP.second);
 
             addedHyperplanes++;
 
@@ -498,6 +497,28 @@ void TaskSelectHyperplanePointsESH::run(std::vector<SolutionPoint> solPoints)
     env->timing->stopTimer("DualCutGenerationRootSearch");
 }
 
+std::pair<VectorDouble, VectorDouble> TaskSelectHyperplanePointsESH::findZero(int interiorPointIndex,
+    const VectorDouble& solutionPoint, int Nmax, double lambdaTol, double constrTol,
+    const std::vector<NumericConstraint*>& constraints)
+{
+    auto& interiorPoint = env->dualSolver->interiorPts.at(interiorPointIndex)->point;
+
+    if(env->dualSolver->rootsearchPrefetcher && constraints.size() == 1)
+    {
+        if(auto result = env->dualSolver->rootsearchPrefetcher->getResult(
+               interiorPoint, solutionPoint, constraints[0]->index))
+        {
+            env->primalSolver->addPrimalSolutionCandidate(result->first, E_PrimalSolutionSource::Rootsearch,
+                env->results->getCurrentIteration()->iterationNumber);
+
+            return (*result);
+        }
+    }
+
+    return (env->rootsearchMethod->findZero(
+        interiorPoint, solutionPoint, Nmax, lambdaTol, constrTol, constraints, true));
+}
+
 std::string TaskSelectHyperplanePointsESH::getType()
 {
     std::string type = typeid(this).name();
@@ -15,6 +15,7 @@ namespace SHOT
 {
 
 class Constraint;
+class NumericConstraint;
 class TaskSelectHyperplanePointsECP;
 
 class TaskSelectHyperplanePointsESH : public TaskBase
@@ -30,6 +31,10 @@ public:
 
 private:
     std::unique_ptr<TaskSelectHyperplanePointsECP> tSelectHPPts;
+
+    // Uses the root search performed while the MIP solver was running if there is one
+    std::pair<VectorDouble, VectorDouble> findZero(int interiorPointIndex, const VectorDouble& solutionPoint, int Nmax,
+        double lambdaTol, double constrTol, const std::vector<NumericConstraint*>& constraints);
     std::vector<Constraint*> nonlinearConstraints;
 };
 } // namespace SHOT
\ No newline at end of file
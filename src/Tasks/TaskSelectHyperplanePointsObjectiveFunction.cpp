@@ -143,7 +143,7 @@ void TaskSelectHyperplanePointsObjectiveFunction::run(std::vector<SolutionPoint>
             {
                 env->output->outputWarning(
                     "        Cannot find solution with root search for generating supporting objective hyperplane.");
-                env->output->outputDebug(fmt::format("        {}", e.what()));
+                env->output->outputDebug("        {}", e.what());
             }
         }
 
@@ -152,8 +152,8 @@ void TaskSelectHyperplanePointsObjectiveFunction::run(std::vector<SolutionPoint>
 
     if(numHyperplaneAdded > 0)
     {
-        env->output->outputDebug(fmt::format(
-            "        Added {} separating hyperplanes for objective function to waiting list.", numHyperplaneAdded));
+        env->output->outputDebug(
+            "        Added {} separating hyperplanes for objective function to waiting list.", numHyperplaneAdded);
     }
     else
     {
@@ -173,7 +173,7 @@ void TaskSelectHyperplanePointsObjectiveFunction::run(std::vector<SolutionPoint>
         }
 
         env->output->outputDebug(
-            fmt::format("        Added {} cutting planes for objective function to waiting list.", numHyperplaneAdded));
+            "        Added {} cutting planes for objective function to waiting list.", numHyperplaneAdded);
     }
 }
 
@@ -23,6 +23,8 @@
 #include "../Model/Problem.h"
 #include "../NLPSolver/INLPSolver.h"
 
+#include <thread>
+
 #include "../Tasks/TaskSelectHyperplanePointsESH.h"
 #include "../Tasks/TaskSelectHyperplanePointsECP.h"
 
@@ -66,6 +68,25 @@ TaskSelectPrimalCandidatesFromNLP::TaskSelectPrimalCandidatesFromNLP(Environment
 
         env->results->usedPrimalNLPSolver = ES_PrimalNLPSolver::Ipopt;
         NLPSolver = std::make_shared<NLPSolverIpoptRelaxed>(env, sourceProblem);
+        NLPSolverPool.push_back(NLPSolver);
+
+        int numberOfThreads = env->settings->getSetting<int>("FixedInteger.NumberOfThreads", "Primal");
+        auto linearSolver
+            = static_cast<ES_IpoptSolver>(env->settings->getSetting<int>("Ipopt.LinearSolver", "Subsolver"));
+
+        // MUMPS, which is also the default linear solver in most Ipopt builds, is not thread-safe
+        if(numberOfThreads > 1
+            && (linearSolver == ES_IpoptSolver::IpoptDefault || linearSolver == ES_IpoptSolver::mumps))
+        {
+            env->output->outputWarning(
+                "        Ipopt linear solver is not thread-safe, using one instance for fixed NLP problems.");
+            numberOfThreads = 1;
+        }
+
+        // Each Ipopt instance has its own problem and bounds, so they can be used concurrently
+        for(int i = 1; i < numberOfThreads; i++)
+            NLPSolverPool.push_back(std::make_shared<NLPSolverIpoptRelaxed>(env, sourceProblem));
+
         break;
     }
 #endif
@@ -81,6 +102,7 @@ TaskSelectPrimalCandidatesFromNLP::TaskSelectPrimalCandidatesFromNLP(Environment
         NLPSolver = std::make_shared<NLPSolverGAMS>(env,
             (std::dynamic_pointer_cast<ModelingSystemGAMS>(env->modelingSystem))->modelingObject,
             (std::dynamic_pointer_cast<ModelingSystemGAMS>(env->modelingSystem))->auditLicensing);
+        NLPSolverPool.push_back(NLPSolver);
 
         break;
     }
@@ -114,10 +136,33 @@ TaskSelectPrimalCandidatesFromNLP::TaskSelectPrimalCandidatesFromNLP(Environment
         }
     }
 
-    for(auto& V : sourceProblem->allVariables)
+    for(auto& S : NLPSolverPool)
+    {
+        for(auto& V : sourceProblem->allVariables)
+        {
+            S->updateVariableLowerBound(V->index, V->lowerBound);
+            S->updateVariableUpperBound(V->index, V->upperBound);
+        }
+    }
+
+    if(NLPSolverPool.size() > 1)
     {
-        NLPSolver->updateVariableLowerBound(V->index, V->lowerBound);
-        NLPSolver->updateVariableUpperBound(V->index, V->upperBound);
+        // The sparsity patterns are generated lazily, which is not safe to do from several threads, so all patterns
+        // used when evaluating the problem are generated here before any solver thread is started
+        sourceProblem->objectiveFunction->getGradientSparsityPattern();
+        sourceProblem->objectiveFunction->getHessianSparsityPattern();
+
+        for(auto& C : sourceProblem->numericConstraints)
+        {
+            C->getGradientSparsityPattern();
+            C->getHessianSparsityPattern();
+        }
+
+        sourceProblem->getConstraintsJacobianSparsityPattern();
+        sourceProblem->getConstraintsHessianSparsityPattern();
+        sourceProblem->getLagrangianHessianSparsityPattern();
+
+        env->output->outputDebug("        Using {} NLP solver instances for fixed NLP problems.", NLPSolverPool.size());
     }
 
     env->timing->stopTimer("PrimalBoundStrategyNLP");
@@ -172,37 +217,41 @@ bool TaskSelectPrimalCandidatesFromNLP::solveFixedNLP()
         return (false);
     }
 
-    int counter = 0;
+    auto& candidates = env->primalSolver->fixedPrimalNLPCandidates;
+    std::vector<FixedNLPJob> jobs(candidates.size());
 
-    for(auto& CAND : env->primalSolver->fixedPrimalNLPCandidates)
-    {
-        VectorDouble fixedVariableValues(discreteVariableIndexes.size());
-
-        int sizeOfVariableVector = sourceProblem->properties.numberOfVariables;
+    int sizeOfVariableVector = sourceProblem->properties.numberOfVariables;
 
-        // TODO: remove?
-        if(env->settings->getSetting<bool>("FixedInteger.UsePresolveBounds", "Primal"))
+    // TODO: remove?
+    if(env->settings->getSetting<bool>("FixedInteger.UsePresolveBounds", "Primal"))
+    {
+        env->output->outputDebug("         Updating variable bounds from MIP presolve.");
+        for(auto& V : env->reformulatedProblem->allVariables)
         {
-            env->output->outputDebug("         Updating variable bounds from MIP presolve.");
-            for(auto& V : env->reformulatedProblem->allVariables)
-            {
-                if(V->index > sizeOfVariableVector)
-                    continue;
+            if(V->index > sizeOfVariableVector)
+                continue;
 
+            for(auto& S : NLPSolverPool)
+            {
                 if(V->properties.hasUpperBoundBeenTightened)
                 {
-                    NLPSolver->updateVariableUpperBound(V->index, V->upperBound);
+                    S->updateVariableUpperBound(V->index, V->upperBound);
                 }
 
                 if(V->properties.hasLowerBoundBeenTightened)
                 {
-                    NLPSolver->updateVariableLowerBound(V->index, V->upperBound);
+                    S->updateVariableLowerBound(V->index, V->lowerBound);
                 }
             }
         }
+    }
+
+    for(size_t i = 0; i < candidates.size(); i++)
+    {
+        auto& CAND = candidates[i];
+        auto& job = jobs[i];
 
-        VectorInteger startingPointIndexes(sizeOfVariableVector);
-        VectorDouble startingPointValues(sizeOfVariableVector);
+        job.fixedVariableValues = VectorDouble(discreteVariableIndexes.size());
 
         // Sets the fixed values for discrete variables
         for(size_t k = 0; k < discreteVariableIndexes.size(); k++)
@@ -211,260 +260,335 @@ bool TaskSelectPrimalCandidatesFromNLP::solveFixedNLP()
 
             auto tmpSolPt = std::round(CAND.point.at(currVarIndex));
 
-            fixedVariableValues.at(k) = tmpSolPt;
-
-            // Sets the starting point to the fixed value
-            if(env->settings->getSetting<bool>("FixedInteger.Warmstart", "Primal"))
-            {
-                startingPointIndexes.at(currVarIndex) = currVarIndex;
-                startingPointValues.at(currVarIndex) = tmpSolPt;
-            }
+            job.fixedVariableValues.at(k) = tmpSolPt;
         }
 
         if(env->settings->getSetting<bool>("FixedInteger.Warmstart", "Primal"))
         {
-            env->output->outputDebug(
-                "         Setting warm start for continuous variable to candidate solution value.");
+            job.startingPointIndexes = VectorInteger(sizeOfVariableVector);
+            job.startingPointValues = VectorDouble(sizeOfVariableVector);
+
+            // Sets the starting point to the fixed value
+            for(size_t k = 0; k < discreteVariableIndexes.size(); k++)
+            {
+                int currVarIndex = discreteVariableIndexes.at(k);
+
+                job.startingPointIndexes.at(currVarIndex) = currVarIndex;
+                job.startingPointValues.at(currVarIndex) = job.fixedVariableValues.at(k);
+            }
 
             for(auto& V : sourceProblem->realVariables)
             {
-                startingPointIndexes.at(V->index) = V->index;
-                startingPointValues.at(V->index) = CAND.point.at(V->index);
+                job.startingPointIndexes.at(V->index) = V->index;
+                job.startingPointValues.at(V->index) = CAND.point.at(V->index);
             }
 
             if(env->settings->getSetting<bool>("Debug.Enable", "Output"))
             {
                 std::string filename = env->settings->getSetting<std::string>("Debug.Path", "Output")
-                    + "/primalnlp_warmstart" + std::to_string(currIter->iterationNumber) + "_" + std::to_string(counter)
+                    + "/primalnlp_warmstart" + std::to_string(currIter->iterationNumber) + "_" + std::to_string(i)
                     + ".txt";
 
-                Utilities::saveVariablePointVectorToFile(startingPointValues, variableNames, filename);
+                Utilities::saveVariablePointVectorToFile(job.startingPointValues, variableNames, filename);
             }
-
-            NLPSolver->setStartingPoint(startingPointIndexes, startingPointValues);
         }
 
-        NLPSolver->fixVariables(discreteVariableIndexes, fixedVariableValues);
-
         if(env->settings->getSetting<bool>("Debug.Enable", "Output"))
         {
-            std::string filename = env->settings->getSetting<std::string>("Debug.Path", "Output") + "/primalnlp"
-                + std::to_string(currIter->iterationNumber) + "_" + std::to_string(counter);
-            NLPSolver->saveProblemToFile(filename + ".txt");
-            NLPSolver->saveOptionsToFile(filename + ".osrl");
+            job.debugFilename = env->settings->getSetting<std::string>("Debug.Path", "Output") + "/primalnlp"
+                + std::to_string(currIter->iterationNumber) + "_" + std::to_string(i);
         }
+    }
 
-        auto solvestatus = NLPSolver->solveProblem();
+    size_t numberOfWorkers = std::min(NLPSolverPool.size(), jobs.size());
 
-        NLPSolver->unfixVariables();
-        env->solutionStatistics.numberOfProblemsFixedNLP++;
+    if(numberOfWorkers <= 1)
+    {
+        // Each result is handled before the next problem is solved, so that a new primal bound or integer cut is
+        // available for the following problems
+        for(size_t i = 0; i < candidates.size(); i++)
+        {
+            solveFixedNLPJob(NLPSolver, jobs[i]);
+            handleFixedNLPResult(candidates[i], jobs[i]);
+        }
 
-        std::string source = (sourceIsReformulatedProblem) ? "R" : "O";
+        NLPSolver->updateSolutionStatistics();
+    }
+    else
+    {
+        // Worker w always solves the jobs w, w + numberOfWorkers, ..., and the results are stored per job, so the
+        // results are handled below in candidate order regardless of which solve finishes first
+        std::vector<std::thread> workers;
+        workers.reserve(numberOfWorkers);
 
-        std::string sourceDesc;
-        switch(CAND.sourceType)
+        for(size_t w = 0; w < numberOfWorkers; w++)
         {
-        case E_PrimalNLPSource::FirstSolution:
-            env->output->outputDebug("         Source from candidate point is first MIP solution point.");
-            sourceDesc = "SOLPT-" + source;
-            break;
-        case E_PrimalNLPSource::FeasibleSolution:
-            env->output->outputDebug("         Source from candidate point is MIP solution pool.");
-            sourceDesc = "FEASP-" + source;
-            break;
-        case E_PrimalNLPSource::InfeasibleSolution:
-            env->output->outputDebug("         Source from candidate point is infeasible MIP solution.");
-            sourceDesc = "UNFEA-" + source;
-            break;
-        case E_PrimalNLPSource::SmallestDeviationSolution:
-            env->output->outputDebug(
-                "         Source from candidate point is MIP solution with smallest nonlinear error.");
-            sourceDesc = "SMDEV-" + source;
-            break;
-        case E_PrimalNLPSource::FirstSolutionNewDualBound:
-            env->output->outputDebug(
-                "         Source from candidate point is first MIP solution point which gave dual bound update.");
-            sourceDesc = "NEWDB-" + source;
-            break;
-        default:
-            break;
+            workers.emplace_back([this, w, numberOfWorkers, &jobs]() {
+                for(size_t i = w; i < jobs.size(); i += numberOfWorkers)
+                    solveFixedNLPJob(NLPSolverPool[w], jobs[i]);
+            });
         }
 
-        switch(solvestatus)
-        {
-        case E_NLPSolutionStatus::Optimal:
-            env->output->outputDebug(fmt::format(
-                "         Optimal solution {} found to fixed NLP problem.", NLPSolver->getObjectiveValue()));
-            break;
+        for(auto& W : workers)
+            W.join();
 
-        case E_NLPSolutionStatus::Feasible:
-            env->output->outputDebug(fmt::format(
-                "         Feasible solution {} found to fixed NLP problem.", NLPSolver->getObjectiveValue()));
-            break;
+        for(auto& S : NLPSolverPool)
+            S->updateSolutionStatistics();
 
-        case E_NLPSolutionStatus::Infeasible:
-            env->output->outputDebug("         Fixed NLP problem is infeasible.");
-            break;
+        for(size_t i = 0; i < candidates.size(); i++)
+            handleFixedNLPResult(candidates[i], jobs[i]);
+    }
 
-        case E_NLPSolutionStatus::Unbounded:
-            env->output->outputDebug("         Fixed NLP problem is unbounded.");
-            break;
+    return (true);
+}
 
-        case E_NLPSolutionStatus::TimeLimit:
-            env->output->outputDebug("         Time limit hit when solving fixed NLP problem.");
-            break;
+void TaskSelectPrimalCandidatesFromNLP::handleFixedNLPResult(
+    const PrimalFixedNLPCandidate& CAND, const FixedNLPJob& job)
+{
+    auto currIter = env->results->getCurrentIteration();
+    auto solvestatus = job.solutionStatus;
 
-        case E_NLPSolutionStatus::IterationLimit:
-            env->output->outputDebug("         Iteration limit hit when solving fixed NLP problem.");
-            break;
+    env->solutionStatistics.numberOfProblemsFixedNLP++;
 
-        case E_NLPSolutionStatus::Error:
-            env->output->outputDebug("         Error ocurred when solving fixed NLP problem.");
-            break;
+    std::string source = (sourceIsReformulatedProblem) ? "R" : "O";
 
-        default:
+    std::string sourceDesc;
+    switch(CAND.sourceType)
+    {
+    case E_PrimalNLPSource::FirstSolution:
+        env->output->outputDebug("         Source from candidate point is first MIP solution point.");
+        sourceDesc = "SOLPT-" + source;
+        break;
+    case E_PrimalNLPSource::FeasibleSolution:
+        env->output->outputDebug("         Source from candidate point is MIP solution pool.");
+        sourceDesc = "FEASP-" + source;
+        break;
+    case E_PrimalNLPSource::InfeasibleSolution:
+        env->output->outputDebug("         Source from candidate point is infeasible MIP solution.");
+        sourceDesc = "UNFEA-" + source;
+        break;
+    case E_PrimalNLPSource::SmallestDeviationSolution:
+        env->output->outputDebug(
+            "         Source from candidate point is MIP solution with smallest nonlinear error.");
+        sourceDesc = "SMDEV-" + source;
+        break;
+    case E_PrimalNLPSource::FirstSolutionNewDualBound:
+        env->output->outputDebug(
+            "         Source from candidate point is first MIP solution point which gave dual bound update.");
+        sourceDesc = "NEWDB-" + source;
+        break;
+    default:
+        break;
+    }
 
-            break;
-        }
+    switch(solvestatus)
+    {
+    case E_NLPSolutionStatus::Optimal:
+        env->output->outputDebug(
+            "         Optimal solution {} found to fixed NLP problem.", job.objectiveValue);
+        break;
 
-        if(solvestatus == E_NLPSolutionStatus::Feasible || solvestatus == E_NLPSolutionStatus::Optimal)
-        {
-            double tmpObj = NLPSolver->getObjectiveValue();
-            auto variableSolution = NLPSolver->getSolution();
+    case E_NLPSolutionStatus::Feasible:
+        env->output->outputDebug(
+            "         Feasible solution {} found to fixed NLP problem.", job.objectiveValue);
+        break;
 
-            if(env->settings->getSetting<bool>("FixedInteger.Frequency.Dynamic", "Primal"))
-            {
-                int iters = std::max(
-                    std::ceil(env->settings->getSetting<int>("FixedInteger.Frequency.Iteration", "Primal") * 0.98),
-                    originalNLPIter);
+    case E_NLPSolutionStatus::Infeasible:
+        env->output->outputDebug("         Fixed NLP problem is infeasible.");
+        break;
 
-                if(iters > std::max(0.1 * this->originalIterFrequency, 1.0))
-                    env->settings->updateSetting("FixedInteger.Frequency.Iteration", "Primal", iters);
+    case E_NLPSolutionStatus::Unbounded:
+        env->output->outputDebug("         Fixed NLP problem is unbounded.");
+        break;
 
-                double interval = std::max(
-                    0.9 * env->settings->getSetting<double>("FixedInteger.Frequency.Time", "Primal"), originalNLPTime);
+    case E_NLPSolutionStatus::TimeLimit:
+        env->output->outputDebug("         Time limit hit when solving fixed NLP problem.");
+        break;
 
-                if(interval > 0.1 * this->originalTimeFrequency)
-                    env->settings->updateSetting("FixedInteger.Frequency.Time", "Primal", interval);
+    case E_NLPSolutionStatus::IterationLimit:
+        env->output->outputDebug("         Iteration limit hit when solving fixed NLP problem.");
+        break;
 
-                env->output->outputDebug(fmt::format(
-                    "         Iteration frequency updated to {} and time frequency updated to {} ", iters, interval));
-            }
+    case E_NLPSolutionStatus::Cutoff:
+        env->output->outputDebug("         Fixed NLP problem terminated since it cannot improve on primal bound.");
+        break;
 
-            env->primalSolver->addPrimalSolutionCandidate(
-                variableSolution, E_PrimalSolutionSource::NLPFixedIntegers, currIter->iterationNumber);
+    case E_NLPSolutionStatus::Error:
+        env->output->outputDebug("         Error ocurred when solving fixed NLP problem.");
+        break;
 
-            if(sourceProblem->properties.numberOfNonlinearConstraints > 0
-                || sourceProblem->properties.numberOfQuadraticConstraints > 0)
-            {
-                auto mostDevConstr = sourceProblem->getMostDeviatingNonlinearOrQuadraticConstraint(variableSolution);
+    default:
+
+        break;
+    }
 
-                env->output->outputDebug(fmt::format("         Max error {} from nonlinear or quadratic constraint {}.",
-                    mostDevConstr->normalizedValue, mostDevConstr->constraint->name));
+    if(solvestatus == E_NLPSolutionStatus::Feasible || solvestatus == E_NLPSolutionStatus::Optimal)
+    {
+        double tmpObj = job.objectiveValue;
+        auto& variableSolution = job.variableSolution;
 
-                env->report->outputIterationDetail(env->solutionStatistics.numberOfProblemsFixedNLP,
-                    ("NLP" + sourceDesc), env->timing->getElapsedTime("Total"), currIter->numHyperplanesAdded,
-                    currIter->totNumHyperplanes, env->results->getCurrentDualBound(), env->results->getPrimalBound(),
-                    env->results->getAbsoluteGlobalObjectiveGap(), env->results->getRelativeGlobalObjectiveGap(),
-                    tmpObj, mostDevConstr->constraint->index, mostDevConstr->normalizedValue,
-                    E_IterationLineType::PrimalNLP);
-            }
-            else
-            {
-                env->report->outputIterationDetail(env->solutionStatistics.numberOfProblemsFixedNLP,
-                    ("NLP" + sourceDesc), env->timing->getElapsedTime("Total"), currIter->numHyperplanesAdded,
-                    currIter->totNumHyperplanes, env->results->getCurrentDualBound(), env->results->getPrimalBound(),
-                    env->results->getAbsoluteGlobalObjectiveGap(), env->results->getRelativeGlobalObjectiveGap(),
-                    tmpObj,
-                    -1, // Not shown
-                    0.0, // Not shown
-                    E_IterationLineType::PrimalNLP);
-            }
+        if(env->settings->getSetting<bool>("FixedInteger.Frequency.Dynamic", "Primal"))
+        {
+            int iters = std::max(
+                std::ceil(env->settings->getSetting<int>("FixedInteger.Frequency.Iteration", "Primal") * 0.98),
+                originalNLPIter);
 
-            // Add integer cut.
-            if(env->settings->getSetting<bool>("HyperplaneCuts.UseIntegerCuts", "Dual")
-                && sourceProblem->properties.numberOfDiscreteVariables > 0)
-                createIntegerCut(CAND.point);
+            if(iters > std::max(0.1 * this->originalIterFrequency, 1.0))
+                env->settings->updateSetting("FixedInteger.Frequency.Iteration", "Primal", iters);
 
-            if(env->settings->getSetting<bool>("FixedInteger.CreateInfeasibilityCut", "Primal"))
-                createInfeasibilityCut(variableSolution);
+            double interval = std::max(
+                0.9 * env->settings->getSetting<double>("FixedInteger.Frequency.Time", "Primal"), originalNLPTime);
+
+            if(interval > 0.1 * this->originalTimeFrequency)
+                env->settings->updateSetting("FixedInteger.Frequency.Time", "Primal", interval);
+
+            env->output->outputDebug(
+                "         Iteration frequency updated to {} and time frequency updated to {} ", iters, interval);
         }
-        else if(sourceProblem->properties.numberOfNonlinearConstraints > 0)
+
+        env->primalSolver->addPrimalSolutionCandidate(
+            variableSolution, E_PrimalSolutionSource::NLPFixedIntegers, currIter->iterationNumber);
+
+        if(sourceProblem->properties.numberOfNonlinearConstraints > 0
+            || sourceProblem->properties.numberOfQuadraticConstraints > 0)
         {
-            double tmpObj = NLPSolver->getObjectiveValue();
+            auto mostDevConstr = sourceProblem->getMostDeviatingNonlinearOrQuadraticConstraint(variableSolution);
 
-            // Utilize the solution point for adding a cutting plane / supporting hyperplane
+            env->output->outputDebug("         Max error {} from nonlinear or quadratic constraint {}.",
+                mostDevConstr->normalizedValue, mostDevConstr->constraint->name);
 
-            auto variableSolution = NLPSolver->getSolution();
+            env->report->outputIterationDetail(env->solutionStatistics.numberOfProblemsFixedNLP,
+                ("NLP" + sourceDesc), env->timing->getElapsedTime("Total"), currIter->numHyperplanesAdded,
+                currIter->totNumHyperplanes, env->results->getCurrentDualBound(), env->results->getPrimalBound(),
+                env->results->getAbsoluteGlobalObjectiveGap(), env->results->getRelativeGlobalObjectiveGap(),
+                tmpObj, mostDevConstr->constraint->index, mostDevConstr->normalizedValue,
+                E_IterationLineType::PrimalNLP);
+        }
+        else
+        {
+            env->report->outputIterationDetail(env->solutionStatistics.numberOfProblemsFixedNLP,
+                ("NLP" + sourceDesc), env->timing->getElapsedTime("Total"), currIter->numHyperplanesAdded,
+                currIter->totNumHyperplanes, env->results->getCurrentDualBound(), env->results->getPrimalBound(),
+                env->results->getAbsoluteGlobalObjectiveGap(), env->results->getRelativeGlobalObjectiveGap(),
+                tmpObj,
+                -1, // Not shown
+                0.0, // Not shown
+                E_IterationLineType::PrimalNLP);
+        }
 
-            if(variableSolution.size() > 0)
-            {
-                auto mostDevConstr = sourceProblem->getMaxNumericConstraintValue(
-                    variableSolution, sourceProblem->nonlinearConstraints);
-
-                if(env->settings->getSetting<bool>("FixedInteger.CreateInfeasibilityCut", "Primal"))
-                    createInfeasibilityCut(variableSolution);
-
-                env->report->outputIterationDetail(env->solutionStatistics.numberOfProblemsFixedNLP,
-                    ("NLP" + sourceDesc), env->timing->getElapsedTime("Total"), currIter->numHyperplanesAdded,
-                    currIter->totNumHyperplanes, env->results->getCurrentDualBound(), env->results->getPrimalBound(),
-                    env->results->getAbsoluteGlobalObjectiveGap(), env->results->getRelativeGlobalObjectiveGap(),
-                    tmpObj, mostDevConstr.constraint->index, mostDevConstr.normalizedValue,
-                    E_IterationLineType::PrimalNLP);
-            }
-            else
-            {
-                env->report->outputIterationDetail(env->solutionStatistics.numberOfProblemsFixedNLP,
-                    ("NLP" + sourceDesc), env->timing->getElapsedTime("Total"), currIter->numHyperplanesAdded,
-                    currIter->totNumHyperplanes, env->results->getCurrentDualBound(), env->results->getPrimalBound(),
-                    env->results->getAbsoluteGlobalObjectiveGap(), env->results->getRelativeGlobalObjectiveGap(), NAN,
-                    -1, NAN, E_IterationLineType::PrimalNLP);
-            }
+        // Add integer cut.
+        if(env->settings->getSetting<bool>("HyperplaneCuts.UseIntegerCuts", "Dual")
+            && sourceProblem->properties.numberOfDiscreteVariables > 0)
+            createIntegerCut(CAND.point);
 
-            if(env->settings->getSetting<bool>("FixedInteger.Frequency.Dynamic", "Primal"))
-            {
-                int iters
-                    = std::ceil(env->settings->getSetting<int>("FixedInteger.Frequency.Iteration", "Primal") * 1.02);
+        if(env->settings->getSetting<bool>("FixedInteger.CreateInfeasibilityCut", "Primal"))
+            createInfeasibilityCut(variableSolution);
+    }
+    else if(solvestatus == E_NLPSolutionStatus::Cutoff)
+    {
+        // The early termination does not prove that there is no better solution with these integer values, so no
+        // integer cut is added and the frequency is not changed
+        env->report->outputIterationDetail(env->solutionStatistics.numberOfProblemsFixedNLP, ("NLP" + sourceDesc),
+            env->timing->getElapsedTime("Total"), currIter->numHyperplanesAdded, currIter->totNumHyperplanes,
+            env->results->getCurrentDualBound(), env->results->getPrimalBound(),
+            env->results->getAbsoluteGlobalObjectiveGap(), env->results->getRelativeGlobalObjectiveGap(), NAN, -1,
+            NAN, E_IterationLineType::PrimalNLP);
+    }
+    else if(sourceProblem->properties.numberOfNonlinearConstraints > 0)
+    {
+        double tmpObj = job.objectiveValue;
 
-                if(iters < 10 * this->originalIterFrequency)
-                    env->settings->updateSetting("FixedInteger.Frequency.Iteration", "Primal", iters);
+        // Utilize the solution point for adding a cutting plane / supporting hyperplane
 
-                double interval = 1.1 * env->settings->getSetting<double>("FixedInteger.Frequency.Time", "Primal");
+        auto& variableSolution = job.variableSolution;
 
-                if(interval < 10 * this->originalTimeFrequency)
-                    env->settings->updateSetting("FixedInteger.Frequency.Time", "Primal", interval);
+        if(variableSolution.size() > 0)
+        {
+            auto mostDevConstr = sourceProblem->getMaxNumericConstraintValue(
+                variableSolution, sourceProblem->nonlinearConstraints);
 
-                env->output->outputDebug(fmt::format(
-                    "         Iteration frequency updated to {} and time frequency updated to {} ", iters, interval));
-            }
+            if(env->settings->getSetting<bool>("FixedInteger.CreateInfeasibilityCut", "Primal"))
+                createInfeasibilityCut(variableSolution);
 
-            // Add integer cut.
-            if(env->settings->getSetting<bool>("HyperplaneCuts.UseIntegerCuts", "Dual")
-                && sourceProblem->properties.numberOfDiscreteVariables > 0)
-                createIntegerCut(CAND.point);
+            env->report->outputIterationDetail(env->solutionStatistics.numberOfProblemsFixedNLP,
+                ("NLP" + sourceDesc), env->timing->getElapsedTime("Total"), currIter->numHyperplanesAdded,
+                currIter->totNumHyperplanes, env->results->getCurrentDualBound(), env->results->getPrimalBound(),
+                env->results->getAbsoluteGlobalObjectiveGap(), env->results->getRelativeGlobalObjectiveGap(),
+                tmpObj, mostDevConstr.constraint->index, mostDevConstr.normalizedValue,
+                E_IterationLineType::PrimalNLP);
         }
         else
         {
-            env->report->outputIterationDetail(env->solutionStatistics.numberOfProblemsFixedNLP, ("NLP" + sourceDesc),
-                env->timing->getElapsedTime("Total"), currIter->numHyperplanesAdded, currIter->totNumHyperplanes,
-                env->results->getCurrentDualBound(), env->results->getPrimalBound(),
-                env->results->getAbsoluteGlobalObjectiveGap(), env->results->getRelativeGlobalObjectiveGap(), NAN, -1,
-                NAN, E_IterationLineType::PrimalNLP);
-
-            // Add integer cut.
-            if(env->settings->getSetting<bool>("HyperplaneCuts.UseIntegerCuts", "Dual")
-                && sourceProblem->properties.numberOfDiscreteVariables > 0)
-                createIntegerCut(CAND.point);
+            env->report->outputIterationDetail(env->solutionStatistics.numberOfProblemsFixedNLP,
+                ("NLP" + sourceDesc), env->timing->getElapsedTime("Total"), currIter->numHyperplanesAdded,
+                currIter->totNumHyperplanes, env->results->getCurrentDualBound(), env->results->getPrimalBound(),
+                env->results->getAbsoluteGlobalObjectiveGap(), env->results->getRelativeGlobalObjectiveGap(), NAN,
+                -1, NAN, E_IterationLineType::PrimalNLP);
         }
 
-        env->solutionStatistics.numberOfIterationsWithoutNLPCallMIP = 0;
-        env->solutionStatistics.timeLastFixedNLPCall = env->timing->getElapsedTime("Total");
-        counter++;
+        if(env->settings->getSetting<bool>("FixedInteger.Frequency.Dynamic", "Primal"))
+        {
+            int iters
+                = std::ceil(env->settings->getSetting<int>("FixedInteger.Frequency.Iteration", "Primal") * 1.02);
+
+            if(iters < 10 * this->originalIterFrequency)
+                env->settings->updateSetting("FixedInteger.Frequency.Iteration", "Primal", iters);
+
+            double interval = 1.1 * env->settings->getSetting<double>("FixedInteger.Frequency.Time", "Primal");
 
-        env->primalSolver->usedPrimalNLPCandidates.push_back(CAND);
+            if(interval < 10 * this->originalTimeFrequency)
+                env->settings->updateSetting("FixedInteger.Frequency.Time", "Primal", interval);
+
+            env->output->outputDebug(
+                "         Iteration frequency updated to {} and time frequency updated to {} ", iters, interval);
+        }
+
+        // Add integer cut.
+        if(env->settings->getSetting<bool>("HyperplaneCuts.UseIntegerCuts", "Dual")
+            && sourceProblem->properties.numberOfDiscreteVariables > 0)
+            createIntegerCut(CAND.point);
+    }
+    else
+    {
+        env->report->outputIterationDetail(env->solutionStatistics.numberOfProblemsFixedNLP, ("NLP" + sourceDesc),
+            env->timing->getElapsedTime("Total"), currIter->numHyperplanesAdded, currIter->totNumHyperplanes,
+            env->results->getCurrentDualBound(), env->results->getPrimalBound(),
+            env->results->getAbsoluteGlobalObjectiveGap(), env->results->getRelativeGlobalObjectiveGap(), NAN, -1,
+            NAN, E_IterationLineType::PrimalNLP);
+
+        // Add integer cut.
+        if(env->settings->getSetting<bool>("HyperplaneCuts.UseIntegerCuts", "Dual")
+            && sourceProblem->properties.numberOfDiscreteVariables > 0)
+            createIntegerCut(CAND.point);
     }
 
-    return (true);
+    env->solutionStatistics.numberOfIterationsWithoutNLPCallMIP = 0;
+    env->solutionStatistics.timeLastFixedNLPCall = env->timing->getElapsedTime("Total");
+
+    env->primalSolver->addUsedFixedNLPCandidate(CAND);
+}
+
+void TaskSelectPrimalCandidatesFromNLP::solveFixedNLPJob(std::shared_ptr<INLPSolver> solver, FixedNLPJob& job)
+{
+    if(job.startingPointIndexes.size() > 0)
+    {
+        env->output->outputDebug("         Setting warm start for continuous variable to candidate solution value.");
+        solver->setStartingPoint(job.startingPointIndexes, job.startingPointValues);
+    }
+
+    solver->fixVariables(discreteVariableIndexes, job.fixedVariableValues);
+
+    if(job.debugFilename != "")
+    {
+        solver->saveProblemToFile(job.debugFilename + ".txt");
+        solver->saveOptionsToFile(job.debugFilename + ".osrl");
+    }
+
+    job.solutionStatus = solver->solveProblem();
+    job.objectiveValue = solver->getObjectiveValue();
+    job.variableSolution = solver->getSolution();
+
+    solver->unfixVariables();
 }
 
 void TaskSelectPrimalCandidatesFromNLP::createInfeasibilityCut(const VectorDouble variableSolution)
@@ -483,15 +607,7 @@ void TaskSelectPrimalCandidatesFromNLP::createInfeasibilityCut(const VectorDoubl
     if(!sourceIsReformulatedProblem) // Need to calculate values for the auxiliary variables in this
                                      // case
     {
-        for(auto& V : env->reformulatedProblem->auxiliaryVariables)
-        {
-            tmpSolPt.point.push_back(V->calculate(variableSolution));
-        }
-
-        if(env->reformulatedProblem->auxiliaryObjectiveVariable)
-        {
-            tmpSolPt.point.push_back(env->reformulatedProblem->auxiliaryObjectiveVariable->calculate(variableSolution));
-        }
+        env->reformulatedProblem->liftToReformulatedSpace(tmpSolPt.point);
     }
 
     std::vector<SolutionPoint> solutionPoints(1);
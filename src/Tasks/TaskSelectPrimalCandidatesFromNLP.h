@@ -30,13 +30,32 @@ public:
     std::string getType() override;
 
 private:
+    // The data needed to solve one fixed NLP problem and the result obtained from it
+    struct FixedNLPJob
+    {
+        VectorDouble fixedVariableValues;
+        VectorInteger startingPointIndexes;
+        VectorDouble startingPointValues;
+        std::string debugFilename;
+
+        E_NLPSolutionStatus solutionStatus = E_NLPSolutionStatus::Error;
+        double objectiveValue = NAN;
+        VectorDouble variableSolution;
+    };
+
     virtual bool solveFixedNLP();
 
+    void solveFixedNLPJob(std::shared_ptr<INLPSolver> solver, FixedNLPJob& job);
+    void handleFixedNLPResult(const PrimalFixedNLPCandidate& candidate, const FixedNLPJob& job);
+
     void createInfeasibilityCut(const VectorDouble point);
     void createIntegerCut(VectorDouble point);
 
     std::shared_ptr<INLPSolver> NLPSolver;
 
+    // Independent solver instances used for concurrent solves, the first one is NLPSolver
+    std::vector<std::shared_ptr<INLPSolver>> NLPSolverPool;
+
     VectorInteger discreteVariableIndexes;
     std::vector<VectorDouble> testedPoints;
     VectorDouble fixPoint;
@@ -65,8 +65,7 @@ void TaskSolveIteration::run()
         {
             env->dualSolver->useCutOff = true;
             env->dualSolver->cutOffToUse = env->settings->getSetting<double>("MIP.CutOff.InitialValue", "Dual");
-            env->output->outputDebug(
-                fmt::format("        Setting user-provided cutoff value to {}.", env->dualSolver->cutOffToUse));
+            env->output->outputDebug("        Setting user-provided cutoff value to {}.", env->dualSolver->cutOffToUse);
         }
 
         if(isMinimization)
@@ -103,7 +102,7 @@ void TaskSolveIteration::run()
             env->dualSolver->MIPSolver->updateVariableBound(
                 env->dualSolver->MIPSolver->getDualAuxiliaryObjectiveVariableIndex(), newLB, newUB);
             env->output->outputDebug(
-                fmt::format("        Bounds for nonlinear objective function updated to {} and {}", newLB, newUB));
+                "        Bounds for nonlinear objective function updated to {} and {}", newLB, newUB);
         }
     }
 
@@ -148,13 +147,13 @@ void TaskSolveIteration::run()
 
     currIter->solutionStatus = solStatus;
 
-    env->output->outputDebug(fmt::format("        Dual problem solved with return code: {}", (int)solStatus));
+    env->output->outputDebug("        Dual problem solved with return code: {}", (int)solStatus);
 
     auto sols = env->dualSolver->MIPSolver->getAllVariableSolutions();
 
     if(sols.size() > 0)
     {
-        env->output->outputDebug(fmt::format("        Number of solutions in solution pool: {} ", sols.size()));
+        env->output->outputDebug("        Number of solutions in solution pool: {} ", sols.size());
 
         if(env->settings->getSetting<bool>("Debug.Enable", "Output"))
         {
@@ -44,8 +44,7 @@ void TaskUpdateInteriorPoint::run()
     {
         auto tmpIP = std::make_shared<InteriorPoint>();
 
-        for(auto& VAR : env->reformulatedProblem->auxiliaryVariables)
-            tmpPrimalPoint.push_back(VAR->calculate(tmpPrimalPoint));
+        env->reformulatedProblem->liftToReformulatedSpace(tmpPrimalPoint);
 
         tmpIP->point = tmpPrimalPoint;
         assert((int)tmpIP->point.size() == env->reformulatedProblem->properties.numberOfVariables);
@@ -71,11 +70,7 @@ void TaskUpdateInteriorPoint::run()
     // Need to calculate the value for the point in the reformulated problem
     auto tmpIP = std::make_shared<InteriorPoint>();
 
-    for(auto& VAR : env->reformulatedProblem->auxiliaryVariables)
-        tmpPrimalPoint.push_back(VAR->calculate(tmpPrimalPoint));
-
-    if(env->reformulatedProblem->auxiliaryObjectiveVariable)
-        tmpPrimalPoint.push_back(env->reformulatedProblem->auxiliaryObjectiveVariable->calculate(tmpPrimalPoint));
+    env->reformulatedProblem->liftToReformulatedSpace(tmpPrimalPoint);
 
     tmpIP->point = tmpPrimalPoint;
     assert((int)tmpIP->point.size() == env->reformulatedProblem->properties.numberOfVariables);
@@ -129,11 +124,7 @@ void TaskUpdateInteriorPoint::run()
             tmpPrimalPoint.at(i) = (0.5 * tmpPrimalPoint.at(i) + 0.5 * env->dualSolver->interiorPts.at(0)->point.at(i));
         }
 
-        for(auto& VAR : env->reformulatedProblem->auxiliaryVariables)
-            tmpPrimalPoint.push_back(VAR->calculate(tmpPrimalPoint));
-
-        if(env->reformulatedProblem->auxiliaryObjectiveVariable)
-            tmpPrimalPoint.push_back(env->reformulatedProblem->auxiliaryObjectiveVariable->calculate(tmpPrimalPoint));
+        env->reformulatedProblem->liftToReformulatedSpace(tmpPrimalPoint);
 
         tmpIP->point = tmpPrimalPoint;
         assert((int)tmpIP->point.size() == env->reformulatedProblem->properties.numberOfVariables);
@@ -549,76 +549,6 @@ bool isInteger(double value)
     return (std::modf(value, &intpart) == 0.0);
 }
 
-SparseVariableVector combineSparseVariableVectors(const SparseVariableVector& first, const SparseVariableVector& second)
-{
-    SparseVariableVector result;
-
-    for(auto& G : first)
-    {
-        auto element = result.emplace(G.first, G.second);
-
-        if(!element.second)
-        {
-            // Element already exists for the variable
-            element.first->second += G.second;
-        }
-    }
-
-    for(auto& G : second)
-    {
-        auto element = result.emplace(G.first, G.second);
-
-        if(!element.second)
-        {
-            // Element already exists for the variable
-            element.first->second += G.second;
-        }
-    }
-
-    return result;
-}
-
-SparseVariableVector combineSparseVariableVectors(
-    const SparseVariableVector& first, const SparseVariableVector& second, const SparseVariableVector& third)
-{
-    SparseVariableVector result;
-
-    for(auto& G : first)
-    {
-        auto element = result.emplace(G.first, G.second);
-
-        if(!element.second)
-        {
-            // Element already exists for the variable
-            element.first->second += G.second;
-        }
-    }
-
-    for(auto& G : second)
-    {
-        auto element = result.emplace(G.first, G.second);
-
-        if(!element.second)
-        {
-            // Element already exists for the variable
-            element.first->second += G.second;
-        }
-    }
-
-    for(auto& G : third)
-    {
-        auto element = result.emplace(G.first, G.second);
-
-        if(!element.second)
-        {
-            // Element already exists for the variable
-            element.first->second += G.second;
-        }
-    }
-
-    return result;
-}
-
 SparseVariableMatrix combineSparseVariableMatrices(
     const SparseVariableMatrix& first, const SparseVariableMatrix& second)
 {
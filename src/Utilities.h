@@ -22,7 +22,6 @@ namespace SHOT
 {
 class Variable;
 using VariablePtr = std::shared_ptr<Variable>;
-using SparseVariableVector = std::map<VariablePtr, double>;
 using SparseVariableMatrix = std::map<std::pair<VariablePtr, VariablePtr>, double>;
 }
 
@@ -114,12 +113,6 @@ bool isAlmostEqual(double x, double y, const double epsilon);
 bool isInteger(double value);
 std::string trim(const std::string& str);
 
-SparseVariableVector combineSparseVariableVectors(
-    const SparseVariableVector& first, const SparseVariableVector& second);
-
-SparseVariableVector combineSparseVariableVectors(
-    const SparseVariableVector& first, const SparseVariableVector& second, const SparseVariableVector& third);
-
 SparseVariableMatrix combineSparseVariableMatrices(
     const SparseVariableMatrix& first, const SparseVariableMatrix& second);
 
@@ -237,6 +237,136 @@ bool IpoptTest2()
     return (passed);
 }
 
+// Gives access to the fixing of variables and the multipliers of the Ipopt problem
+class NLPSolverIpoptRelaxedWithMultipliers : public NLPSolverIpoptRelaxed
+{
+public:
+    NLPSolverIpoptRelaxedWithMultipliers(EnvironmentPtr envPtr, ProblemPtr source)
+        : INLPSolver(envPtr), NLPSolverIpoptRelaxed(envPtr, source)
+    {
+    }
+
+    using NLPSolverIpoptBase::fixVariables;
+
+    VectorDouble getConstraintMultipliers() { return (ipoptProblem->constraintMultipliers); }
+};
+
+bool IpoptTest3()
+{
+    bool passed = true;
+
+    std::unique_ptr<Solver> solver = std::make_unique<Solver>();
+    auto env = solver->getEnvironment();
+
+    SHOT::ProblemPtr problem = std::make_shared<SHOT::Problem>(env);
+
+    env->problem = problem;
+
+    /*
+     * min f(x,y,z) = (x-1)^2 + (y-2)^2 + z^2
+     *  s.t.
+     *       x + y + z >= 5
+     *       z^2 <= 4
+     *       -10 <= x, y <= 10
+     *       z in {0,1,2,3}
+     *
+     * With z fixed to 1, the second constraint only contains fixed variables and is removed in the reduced space. The
+     * solution is x = 1.5, y = 2.5 with objective value 1.5.
+     */
+
+    auto var_x = std::make_shared<SHOT::Variable>("x", 0, SHOT::E_VariableType::Real, -10.0, 10.0);
+    SHOT::ExpressionVariablePtr expressionVariable_x = std::make_shared<SHOT::ExpressionVariable>(var_x);
+
+    auto var_y = std::make_shared<SHOT::Variable>("y", 1, SHOT::E_VariableType::Real, -10.0, 10.0);
+    SHOT::ExpressionVariablePtr expressionVariable_y = std::make_shared<SHOT::ExpressionVariable>(var_y);
+
+    auto var_z = std::make_shared<SHOT::Variable>("z", 2, SHOT::E_VariableType::Integer, 0.0, 3.0);
+    SHOT::ExpressionVariablePtr expressionVariable_z = std::make_shared<SHOT::ExpressionVariable>(var_z);
+
+    SHOT::Variables variables = { var_x, var_y, var_z };
+    problem->add(variables);
+
+    SHOT::NonlinearObjectiveFunctionPtr objectiveFunction
+        = std::make_shared<SHOT::NonlinearObjectiveFunction>(SHOT::E_ObjectiveFunctionDirection::Minimize);
+
+    SHOT::NonlinearExpressionPtr exprSquaredX = std::make_shared<SHOT::ExpressionSquare>(
+        std::make_shared<SHOT::ExpressionSum>(expressionVariable_x,
+            std::make_shared<ExpressionNegate>(std::make_shared<SHOT::ExpressionConstant>(1.0))));
+    SHOT::NonlinearExpressionPtr exprSquaredY = std::make_shared<SHOT::ExpressionSquare>(
+        std::make_shared<SHOT::ExpressionSum>(expressionVariable_y,
+            std::make_shared<ExpressionNegate>(std::make_shared<SHOT::ExpressionConstant>(2.0))));
+    SHOT::NonlinearExpressionPtr exprSquaredZ = std::make_shared<SHOT::ExpressionSquare>(expressionVariable_z);
+
+    objectiveFunction->add(std::make_shared<SHOT::ExpressionSum>(
+        NonlinearExpressions({ exprSquaredX, exprSquaredY, exprSquaredZ })));
+    problem->add(objectiveFunction);
+
+    SHOT::LinearTerms linearTerms;
+    linearTerms.add(std::make_shared<LinearTerm>(1.0, var_x));
+    linearTerms.add(std::make_shared<LinearTerm>(1.0, var_y));
+    linearTerms.add(std::make_shared<LinearTerm>(1.0, var_z));
+    problem->add(std::make_shared<SHOT::LinearConstraint>(0, "linconstr", linearTerms, 5.0, SHOT_DBL_MAX));
+
+    SHOT::NonlinearExpressionPtr exprSquaredZ2 = std::make_shared<SHOT::ExpressionSquare>(expressionVariable_z);
+    problem->add(std::make_shared<SHOT::NonlinearConstraint>(1, "nlconstr", exprSquaredZ2, SHOT_DBL_MIN, 4.0));
+
+    std::cout << '\n';
+    std::cout << "Finalizing problem:\n";
+    problem->finalize();
+
+    std::cout << '\n';
+    std::cout << "Problem created:\n\n";
+    std::cout << problem << '\n';
+
+    std::vector<VectorDouble> solutions;
+    std::vector<VectorDouble> multipliers;
+
+    for(bool useReducedSpace : { false, true })
+    {
+        solver->updateSetting("Ipopt.ReducedSpace", "Subsolver", useReducedSpace);
+
+        auto NLPSolver = std::make_shared<NLPSolverIpoptRelaxedWithMultipliers>(env, problem);
+
+        NLPSolver->fixVariables(std::vector<int>({ 2 }), std::vector<double>({ 1.0 }));
+        NLPSolver->setStartingPoint(std::vector<int>({ 0, 1 }), std::vector<double>({ 0.0, 0.0 }));
+        NLPSolver->solveProblem();
+
+        std::cout << '\n';
+        std::cout << "The objective value " << (useReducedSpace ? "in the reduced space" : "in the full space")
+                  << " is: " << NLPSolver->getObjectiveValue() << std::endl;
+
+        if(std::abs(NLPSolver->getObjectiveValue() - 1.5) > 1e-5)
+            passed = false;
+
+        solutions.push_back(NLPSolver->getSolution());
+        multipliers.push_back(NLPSolver->getConstraintMultipliers());
+
+        std::cout << '\n';
+        std::cout << "The solution vector is:\n\n";
+        Utilities::displayVector(solutions.back());
+
+        std::cout << '\n';
+        std::cout << "The constraint multipliers are:\n\n";
+        Utilities::displayVector(multipliers.back());
+    }
+
+    for(size_t i = 0; i < 3; i++)
+    {
+        if(std::abs(solutions[0].at(i) - solutions[1].at(i)) > 1e-5)
+            passed = false;
+    }
+
+    // The multiplier of the removed constraint is zero in the reduced space, and the constraint is inactive in the full
+    // space
+    for(size_t i = 0; i < 2; i++)
+    {
+        if(std::abs(multipliers[0].at(i) - multipliers[1].at(i)) > 1e-5)
+            passed = false;
+    }
+
+    return (passed);
+}
+
 int IpoptTest(int argc, char* argv[])
 {
     int defaultchoice = 1;
@@ -266,6 +396,11 @@ int IpoptTest(int argc, char* argv[])
         passed = IpoptTest2();
         std::cout << "Finished test to solve 2D unconstrained problem using Ipopt." << std::endl;
         break;
+    case 3:
+        std::cout << "Starting test to solve fixed-integer NLP problem in the reduced space using Ipopt:" << std::endl;
+        passed = IpoptTest3();
+        std::cout << "Finished test to solve fixed-integer NLP problem in the reduced space using Ipopt." << std::endl;
+        break;
     default:
         passed = false;
         std::cout << "Test #" << choice << " does not exist!\n";
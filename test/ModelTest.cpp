@@ -10,13 +10,20 @@
 
 #include "../src/Solver.h"
 #include "../src/Environment.h"
+#include "../src/PrimalSolver.h"
+#include "../src/Results.h"
 #include "../src/Settings.h"
 
 #include "../src/Model/Variables.h"
 #include "../src/Model/Terms.h"
 #include "../src/Model/Constraints.h"
 #include "../src/Model/NonlinearExpressions.h"
+#include "../src/Model/Presolve.h"
 #include "../src/Model/Problem.h"
+#include "../src/Model/Simplifications.h"
+#include "../src/Model/Symmetry.h"
+
+#include "../src/NLPSolver/NLPWarmStartCache.h"
 
 #include "../src/Tasks/TaskReformulateProblem.h"
 
@@ -31,6 +38,21 @@ bool ModelTestCreateProblem();
 bool ModelTestCreateProblem2();
 bool ModelTestCreateProblem3();
 bool ModelTestConvexity();
+bool ModelTestTermDerivatives();
+bool ModelTestCompiledExpressions();
+bool ModelTestCachedExpressionBounds();
+bool ModelTestBoundTightening();
+bool ModelTestSharedExpressionSimplification();
+bool ModelTestAuxiliaryVariableProgram();
+bool ModelTestIndependentBlocks();
+bool ModelTestPresolve();
+bool ModelTestSymmetry();
+bool ModelTestPrimalSolutionCandidates();
+bool ModelTestKnownPoints();
+bool ModelTestExpressionTapes();
+bool ModelTestStructuralEquality();
+bool ModelTestWarmStartCache();
+bool ModelTestSparseVariableVector();
 
 bool TestReadProblem(const std::string& problemFile);
 bool TestRootsearch(const std::string& problemFile);
@@ -83,6 +105,51 @@ int ModelTest(int argc, char* argv[])
     case 9:
         passed = ModelTestConvexity();
         break;
+    case 10:
+        passed = ModelTestTermDerivatives();
+        break;
+    case 11:
+        passed = ModelTestCompiledExpressions();
+        break;
+    case 12:
+        passed = ModelTestCachedExpressionBounds();
+        break;
+    case 13:
+        passed = ModelTestBoundTightening();
+        break;
+    case 14:
+        passed = ModelTestSharedExpressionSimplification();
+        break;
+    case 15:
+        passed = ModelTestAuxiliaryVariableProgram();
+        break;
+    case 16:
+        passed = ModelTestIndependentBlocks();
+        break;
+    case 17:
+        passed = ModelTestPresolve();
+        break;
+    case 18:
+        passed = ModelTestSymmetry();
+        break;
+    case 19:
+        passed = ModelTestPrimalSolutionCandidates();
+        break;
+    case 20:
+        passed = ModelTestKnownPoints();
+        break;
+    case 21:
+        passed = ModelTestExpressionTapes();
+        break;
+    case 22:
+        passed = ModelTestStructuralEquality();
+        break;
+    case 23:
+        passed = ModelTestWarmStartCache();
+        break;
+    case 24:
+        passed = ModelTestSparseVariableVector();
+        break;
     default:
         passed = false;
         std::cout << "Test #" << choice << " does not exist!\n";
@@ -1062,5 +1129,1245 @@ bool ModelTestConvexity()
         break;
     }
 
+    // Block-diagonal quadratic form with the convex blocks x^2 - x*y + y^2 and z^2 + 2*z*w + w^2 (semidefinite)
+    auto var_z = std::make_shared<SHOT::Variable>("z", 2, SHOT::E_VariableType::Real, 0.0, 1.0);
+    auto var_w = std::make_shared<SHOT::Variable>("w", 3, SHOT::E_VariableType::Real, 0.0, 1.0);
+
+    SHOT::QuadraticTerms blockTerms;
+    blockTerms.add(std::make_shared<SHOT::QuadraticTerm>(1.0, var_x, var_x));
+    blockTerms.add(std::make_shared<SHOT::QuadraticTerm>(-1.0, var_x, var_y));
+    blockTerms.add(std::make_shared<SHOT::QuadraticTerm>(1.0, var_y, var_y));
+    blockTerms.add(std::make_shared<SHOT::QuadraticTerm>(1.0, var_z, var_z));
+    blockTerms.add(std::make_shared<SHOT::QuadraticTerm>(2.0, var_z, var_w));
+    blockTerms.add(std::make_shared<SHOT::QuadraticTerm>(1.0, var_w, var_w));
+
+    convexity = blockTerms.getConvexity();
+    std::cout << "\nBlock-diagonal quadratic terms" << blockTerms << " are "
+              << (convexity == E_Convexity::Convex ? "convex" : "not convex") << " (should be convex).\n";
+
+    if(convexity != E_Convexity::Convex)
+        passed = false;
+
+    // Adding the block -z^2 makes the second block indefinite
+    blockTerms.add(std::make_shared<SHOT::QuadraticTerm>(-2.0, var_z, var_z));
+
+    convexity = blockTerms.getConvexity();
+    std::cout << "Block-diagonal quadratic terms" << blockTerms << " are "
+              << (convexity == E_Convexity::Nonconvex ? "nonconvex" : "not nonconvex") << " (should be nonconvex).\n";
+
+    if(convexity != E_Convexity::Nonconvex)
+        passed = false;
+
+    return passed;
+}
+
+bool ModelTestTermDerivatives()
+{
+    bool passed = true;
+
+    auto var_x = std::make_shared<SHOT::Variable>("x", 0, SHOT::E_VariableType::Real, -10.0, 10.0);
+    auto var_y = std::make_shared<SHOT::Variable>("y", 1, SHOT::E_VariableType::Real, -10.0, 10.0);
+    auto var_z = std::make_shared<SHOT::Variable>("z", 2, SHOT::E_VariableType::Real, -10.0, 10.0);
+
+    // Monomial term 2*x*y*x*z, i.e. 2*x^2*y*z
+    SHOT::MonomialTerms monomialTerms;
+    monomialTerms.add(std::make_shared<SHOT::MonomialTerm>(2.0, SHOT::Variables { var_x, var_y, var_x, var_z }));
+
+    // Signomial term 3*x^2*y^(-1)*z^0.5
+    SHOT::SignomialTerms signomialTerms;
+    SHOT::SignomialElements elements { std::make_shared<SHOT::SignomialElement>(var_x, 2.0),
+        std::make_shared<SHOT::SignomialElement>(var_y, -1.0), std::make_shared<SHOT::SignomialElement>(var_z, 0.5) };
+    signomialTerms.add(std::make_shared<SHOT::SignomialTerm>(3.0, elements));
+
+    // The signomial kernels use log-space at the first point and prefix/suffix products at the second
+    std::vector<SHOT::VectorDouble> points = { { 1.5, 2.0, 4.0 }, { 0.0, -2.0, 4.0 } };
+
+    auto checkValue = [&](std::string description, double value, double realValue) {
+        std::cout << description << ": " << value << " (should be equal to " << realValue << ").\n";
+
+        if(std::abs(value - realValue) > 1e-8 * (1.0 + std::abs(realValue)))
+            passed = false;
+    };
+
+    for(auto& P : points)
+    {
+        double x = P[0], y = P[1], z = P[2];
+
+        std::cout << "\nCalculating derivatives of monomial term " << monomialTerms.at(0) << " at point (" << x
+                  << ", " << y << ", " << z << "):\n";
+
+        SHOT::VectorDouble denseGradient(3, 0.0);
+        monomialTerms.calculateGradient(P, denseGradient);
+        auto gradient = monomialTerms.calculateGradient(P);
+
+        checkValue("df/dx", denseGradient[0], 4.0 * x * y * z);
+        checkValue("df/dy", denseGradient[1], 2.0 * x * x * z);
+        checkValue("df/dz", denseGradient[2], 2.0 * x * x * y);
+        checkValue("df/dx (sparse)", gradient[var_x], 4.0 * x * y * z);
+
+        auto hessian = monomialTerms.calculateHessian(P);
+
+        checkValue("d2f/dx2", hessian[std::make_pair(var_x, var_x)], 4.0 * y * z);
+        checkValue("d2f/dxdy", hessian[std::make_pair(var_x, var_y)], 4.0 * x * z);
+        checkValue("d2f/dxdz", hessian[std::make_pair(var_x, var_z)], 4.0 * x * y);
+        checkValue("d2f/dydz", hessian[std::make_pair(var_y, var_z)], 2.0 * x * x);
+
+        std::cout << "\nCalculating derivatives of signomial term " << signomialTerms.at(0) << ":\n";
+
+        denseGradient.assign(3, 0.0);
+        signomialTerms.calculateGradient(P, denseGradient);
+
+        double sqrtz = std::sqrt(z);
+
+        checkValue("df/dx", denseGradient[0], 6.0 * x / y * sqrtz);
+        checkValue("df/dy", denseGradient[1], -3.0 * x * x / (y * y) * sqrtz);
+        checkValue("df/dz", denseGradient[2], 1.5 * x * x / (y * sqrtz));
+
+        hessian = signomialTerms.calculateHessian(P);
+
+        checkValue("d2f/dx2", hessian[std::make_pair(var_x, var_x)], 6.0 / y * sqrtz);
+        checkValue("d2f/dy2", hessian[std::make_pair(var_y, var_y)], 6.0 * x * x / (y * y * y) * sqrtz);
+        checkValue("d2f/dz2", hessian[std::make_pair(var_z, var_z)], -0.75 * x * x / (y * z * sqrtz));
+        checkValue("d2f/dxdy", hessian[std::make_pair(var_x, var_y)], -6.0 * x / (y * y) * sqrtz);
+        checkValue("d2f/dxdz", hessian[std::make_pair(var_x, var_z)], 3.0 * x / (y * sqrtz));
+        checkValue("d2f/dydz", hessian[std::make_pair(var_y, var_z)], -1.5 * x * x / (y * y * sqrtz));
+    }
+
+    return passed;
+}
+
+bool ModelTestCompiledExpressions()
+{
+    // Compares the compiled nonlinear expressions with the expression tree and the CppAD tape
+    bool passed = true;
+
+    std::unique_ptr<Solver> solver = std::make_unique<Solver>();
+    auto env = solver->getEnvironment();
+    env->settings->updateSetting("CodeGeneration.Use", "Model", true);
+
+    // The test can only be run where the compiler in the settings is available
+    auto compiler = env->settings->getSetting<std::string>("CodeGeneration.Compiler", "Model");
+
+    if(std::system((compiler + " --version > /dev/null 2>&1").c_str()) != 0)
+    {
+        std::cout << "The compiler " << compiler << " is not available, skipping the test.\n";
+        return (true);
+    }
+
+    SHOT::ProblemPtr problem = std::make_shared<SHOT::Problem>(env);
+    env->problem = problem;
+
+    auto var_x = std::make_shared<SHOT::Variable>("x", 0, SHOT::E_VariableType::Real, 0.1, 10.0);
+    auto var_y = std::make_shared<SHOT::Variable>("y", 1, SHOT::E_VariableType::Real, 0.1, 10.0);
+    auto var_z = std::make_shared<SHOT::Variable>("z", 2, SHOT::E_VariableType::Real, 0.1, 10.0);
+    problem->add(SHOT::Variables({ var_x, var_y, var_z }));
+
+    auto x = std::make_shared<SHOT::ExpressionVariable>(var_x);
+    auto y = std::make_shared<SHOT::ExpressionVariable>(var_y);
+    auto z = std::make_shared<SHOT::ExpressionVariable>(var_z);
+
+    auto objectiveFunction
+        = std::make_shared<SHOT::LinearObjectiveFunction>(SHOT::E_ObjectiveFunctionDirection::Minimize);
+    objectiveFunction->add(std::make_shared<SHOT::LinearTerm>(1.0, var_x));
+    problem->add(objectiveFunction);
+
+    SHOT::NonlinearExpressions terms;
+    terms.add(std::make_shared<SHOT::ExpressionProduct>(
+        SHOT::NonlinearExpressions({ x, y, std::make_shared<SHOT::ExpressionSin>(z) })));
+    terms.add(std::make_shared<SHOT::ExpressionDivide>(std::make_shared<SHOT::ExpressionExp>(y), x));
+    terms.add(std::make_shared<SHOT::ExpressionPower>(x, std::make_shared<SHOT::ExpressionConstant>(2.5)));
+    terms.add(std::make_shared<SHOT::ExpressionPower>(z, y));
+    terms.add(std::make_shared<SHOT::ExpressionLog>(std::make_shared<SHOT::ExpressionSquareRoot>(z)));
+    terms.add(std::make_shared<SHOT::ExpressionNegate>(std::make_shared<SHOT::ExpressionArcTan>(y)));
+    terms.add(std::make_shared<SHOT::ExpressionInvert>(std::make_shared<SHOT::ExpressionSquare>(z)));
+    terms.add(std::make_shared<SHOT::ExpressionAbs>(std::make_shared<SHOT::ExpressionCos>(x)));
+
+    auto nonlinearConstraint = std::make_shared<SHOT::NonlinearConstraint>(
+        0, "nlconstr", std::make_shared<SHOT::ExpressionSum>(terms), SHOT_DBL_MIN, 20.0);
+    problem->add(nonlinearConstraint);
+
+    problem->finalize();
+
+    if(nonlinearConstraint->compiledFunctionValue == nullptr || nonlinearConstraint->compiledGradient == nullptr)
+    {
+        std::cout << "The nonlinear expression was not compiled!\n";
+        return (false);
+    }
+
+    SHOT::VectorDouble point = { 1.5, 0.7, 2.3 };
+
+    double compiledValue = nonlinearConstraint->calculateFunctionValue(point);
+    auto compiledGradient = nonlinearConstraint->calculateGradient(point, true);
+
+    nonlinearConstraint->compiledFunctionValue = nullptr;
+    nonlinearConstraint->compiledGradient = nullptr;
+
+    double value = nonlinearConstraint->calculateFunctionValue(point);
+    auto gradient = nonlinearConstraint->calculateGradient(point, true);
+
+    std::cout << "Compiled value: " << compiledValue << " (should be equal to " << value << ").\n";
+
+    if(std::abs(compiledValue - value) > 1e-10)
+        passed = false;
+
+    for(auto const& G : gradient)
+    {
+        double compiledElement = compiledGradient[G.first];
+
+        std::cout << G.first->name << ": " << compiledElement << " (should be equal to " << G.second << ").\n";
+
+        if(std::abs(compiledElement - G.second) > 1e-10)
+            passed = false;
+    }
+
+    return passed;
+}
+
+bool ModelTestCachedExpressionBounds()
+{
+    // The cached bounds should be updated when a variable bound changes or when a child expression is replaced
+    bool passed = true;
+
+    auto var_x = std::make_shared<SHOT::Variable>("x", 0, SHOT::E_VariableType::Real, -1.0, 2.0);
+    auto var_y = std::make_shared<SHOT::Variable>("y", 1, SHOT::E_VariableType::Real, 1.0, 3.0);
+
+    auto x = std::make_shared<SHOT::ExpressionVariable>(var_x);
+    auto y = std::make_shared<SHOT::ExpressionVariable>(var_y);
+
+    auto square = std::make_shared<SHOT::ExpressionSquare>(x);
+    auto expression = std::make_shared<SHOT::ExpressionSum>(
+        std::make_shared<SHOT::ExpressionProduct>(x, y), std::make_shared<SHOT::ExpressionExp>(square));
+
+    auto isEqual = [](const Interval& first, const Interval& second)
+    { return (std::abs(first.l() - second.l()) < 1e-10 && std::abs(first.u() - second.u()) < 1e-10); };
+
+    auto bounds = expression->getBounds();
+    std::cout << "Bounds: " << bounds << " (should be equal to " << expression->calculateBounds() << ").\n";
+
+    if(!isEqual(bounds, expression->calculateBounds()) || !isEqual(bounds, expression->getBounds()))
+        passed = false;
+
+    var_x->tightenBounds(Interval(0.0, 1.0));
+    bounds = expression->getBounds();
+    std::cout << "Bounds after tightening x: " << bounds << " (should be equal to " << expression->calculateBounds()
+              << ").\n";
+
+    if(!isEqual(bounds, expression->calculateBounds()))
+        passed = false;
+
+    var_y->setUpperBound(2.0);
+    bounds = expression->getBounds();
+    std::cout << "Bounds after changing y: " << bounds << " (should be equal to " << expression->calculateBounds()
+              << ").\n";
+
+    if(!isEqual(bounds, expression->calculateBounds()))
+        passed = false;
+
+    square->child = y;
+    bounds = expression->getBounds();
+    std::cout << "Bounds after replacing child: " << bounds << " (should be equal to "
+              << expression->calculateBounds() << ").\n";
+
+    if(!isEqual(bounds, expression->calculateBounds()))
+        passed = false;
+
+    return passed;
+}
+
+bool ModelTestBoundTightening()
+{
+    // Feasibility-based bound tightening with forward-backward propagation on y + z <= 3 and x^2 + exp(z) <= 5
+    bool passed = true;
+
+    std::unique_ptr<Solver> solver = std::make_unique<Solver>();
+    auto env = solver->getEnvironment();
+    SHOT::ProblemPtr problem = std::make_shared<SHOT::Problem>(env);
+    env->problem = problem;
+
+    auto var_x = std::make_shared<SHOT::Variable>("x", 0, SHOT::E_VariableType::Real, -10.0, 10.0);
+    auto var_y = std::make_shared<SHOT::Variable>("y", 1, SHOT::E_VariableType::Real, 0.0, 10.0);
+    auto var_z = std::make_shared<SHOT::Variable>("z", 2, SHOT::E_VariableType::Real, 0.0, 10.0);
+    problem->add(SHOT::Variables({ var_x, var_y, var_z }));
+
+    auto objectiveFunction
+        = std::make_shared<SHOT::LinearObjectiveFunction>(SHOT::E_ObjectiveFunctionDirection::Minimize);
+    objectiveFunction->add(std::make_shared<SHOT::LinearTerm>(1.0, var_x));
+    problem->add(objectiveFunction);
+
+    auto linearConstraint = std::make_shared<SHOT::LinearConstraint>(0, "lconstr", SHOT_DBL_MIN, 3.0);
+    linearConstraint->add(std::make_shared<SHOT::LinearTerm>(1.0, var_y));
+    linearConstraint->add(std::make_shared<SHOT::LinearTerm>(1.0, var_z));
+    problem->add(linearConstraint);
+
+    auto expression = std::make_shared<SHOT::ExpressionSum>(
+        std::make_shared<SHOT::ExpressionSquare>(std::make_shared<SHOT::ExpressionVariable>(var_x)),
+        std::make_shared<SHOT::ExpressionExp>(std::make_shared<SHOT::ExpressionVariable>(var_z)));
+
+    auto nonlinearConstraint
+        = std::make_shared<SHOT::NonlinearConstraint>(1, "nlconstr", expression, SHOT_DBL_MIN, 5.0);
+    problem->add(nonlinearConstraint);
+
+    problem->finalize();
+
+    for(auto& V : problem->allVariables)
+        std::cout << V->name << ": [" << V->lowerBound << ", " << V->upperBound << "]\n";
+
+    if(std::abs(var_x->lowerBound + 2.0) > 1e-8 || std::abs(var_x->upperBound - 2.0) > 1e-8)
+        passed = false;
+
+    if(std::abs(var_y->upperBound - 3.0) > 1e-8)
+        passed = false;
+
+    if(std::abs(var_z->upperBound - std::log(5.0)) > 1e-8)
+        passed = false;
+
+    return passed;
+}
+
+bool ModelTestSharedExpressionSimplification()
+{
+    // Simplifying an expression should not change the nodes it shares with other expressions
+    bool passed = true;
+
+    auto var_x = std::make_shared<SHOT::Variable>("x", 0, SHOT::E_VariableType::Real, 0.0, 10.0);
+
+    auto constant = std::make_shared<SHOT::ExpressionConstant>(2.0);
+    auto sum = std::make_shared<SHOT::ExpressionSum>(
+        std::make_shared<SHOT::ExpressionVariable>(var_x), std::make_shared<SHOT::ExpressionConstant>(3.0));
+
+    auto negatedConstant = simplify(std::make_shared<SHOT::ExpressionNegate>(constant));
+    auto negatedSum = simplify(std::make_shared<SHOT::ExpressionNegate>(sum));
+
+    SHOT::VectorDouble point { 1.0 };
+
+    std::cout << "Negated constant: " << negatedConstant->calculate(point) << " (should be -2).\n";
+    std::cout << "Negated sum: " << negatedSum->calculate(point) << " (should be -4).\n";
+    std::cout << "Shared constant: " << constant->calculate(point) << " (should be 2).\n";
+    std::cout << "Shared sum: " << sum->calculate(point) << " (should be 4).\n";
+
+    if(std::abs(negatedConstant->calculate(point) + 2.0) > 1e-10
+        || std::abs(negatedSum->calculate(point) + 4.0) > 1e-10)
+        passed = false;
+
+    if(std::abs(constant->calculate(point) - 2.0) > 1e-10 || std::abs(sum->calculate(point) - 4.0) > 1e-10)
+        passed = false;
+
+    return passed;
+}
+
+bool ModelTestAuxiliaryVariableProgram()
+{
+    // Lifting with the compiled program should give the same values as calculating the auxiliary variables one by one
+    bool passed = true;
+
+    auto var_x = std::make_shared<SHOT::Variable>("x", 0, SHOT::E_VariableType::Real, -1.0, 2.0);
+    auto var_y = std::make_shared<SHOT::Variable>("y", 1, SHOT::E_VariableType::Real, 0.5, 3.0);
+
+    auto x = std::make_shared<SHOT::ExpressionVariable>(var_x);
+    auto y = std::make_shared<SHOT::ExpressionVariable>(var_y);
+
+    // aux_1 = 1 + 2x - xy + 3xy^2 + 0.5y^1.5 + x^2*exp(y) + log(y)/(y^2 + 1) + y^x
+    auto aux_1 = std::make_shared<SHOT::AuxiliaryVariable>("aux_1", 2, SHOT::E_VariableType::Real);
+    aux_1->constant = 1.0;
+    aux_1->linearTerms.add(std::make_shared<SHOT::LinearTerm>(2.0, var_x));
+    aux_1->quadraticTerms.add(std::make_shared<SHOT::QuadraticTerm>(-1.0, var_x, var_y));
+    aux_1->monomialTerms.add(std::make_shared<SHOT::MonomialTerm>(3.0, SHOT::Variables { var_x, var_y, var_y }));
+    aux_1->signomialTerms.add(std::make_shared<SHOT::SignomialTerm>(
+        0.5, SHOT::SignomialElements { std::make_shared<SHOT::SignomialElement>(var_y, 1.5) }));
+    aux_1->nonlinearExpression = std::make_shared<SHOT::ExpressionSum>(SHOT::NonlinearExpressions {
+        std::make_shared<SHOT::ExpressionProduct>(
+            std::make_shared<SHOT::ExpressionSquare>(x), std::make_shared<SHOT::ExpressionExp>(y)),
+        std::make_shared<SHOT::ExpressionDivide>(std::make_shared<SHOT::ExpressionLog>(y),
+            std::make_shared<SHOT::ExpressionSum>(std::make_shared<SHOT::ExpressionPower>(
+                                                      y, std::make_shared<SHOT::ExpressionConstant>(2.0)),
+                std::make_shared<SHOT::ExpressionConstant>(1.0))),
+        std::make_shared<SHOT::ExpressionPower>(y, x) });
+
+    // aux_2 = sqrt(aux_1^2) - sin(x), which depends on the previous auxiliary variable
+    auto aux_2 = std::make_shared<SHOT::AuxiliaryVariable>("aux_2", 3, SHOT::E_VariableType::Real);
+    aux_2->nonlinearExpression = std::make_shared<SHOT::ExpressionSum>(
+        std::make_shared<SHOT::ExpressionSquareRoot>(
+            std::make_shared<SHOT::ExpressionSquare>(std::make_shared<SHOT::ExpressionVariable>(aux_1))),
+        std::make_shared<SHOT::ExpressionNegate>(std::make_shared<SHOT::ExpressionSin>(x)));
+
+    SHOT::AuxiliaryVariables auxiliaryVariables { aux_1 };
+    SHOT::AuxiliaryVariableProgram program(auxiliaryVariables, aux_2);
+
+    std::cout << "Compiled " << program.getNumberOfInstructions() << " instructions.\n";
+
+    SHOT::VectorDouble point { 0.7, 1.3 };
+    program.lift(point);
+
+    SHOT::VectorDouble expectedPoint { 0.7, 1.3 };
+    expectedPoint.push_back(aux_1->calculate(expectedPoint));
+    expectedPoint.push_back(aux_2->calculate(expectedPoint));
+
+    std::cout << "Lifted point: " << point.at(2) << ", " << point.at(3) << " (should be equal to "
+              << expectedPoint.at(2) << ", " << expectedPoint.at(3) << ").\n";
+
+    if(point.size() != 4 || std::abs(point.at(2) - expectedPoint.at(2)) > 1e-10
+        || std::abs(point.at(3) - expectedPoint.at(3)) > 1e-10)
+        passed = false;
+
+    // A product with a zero factor is zero, as in ExpressionProduct
+    point = { 0.0, 1.3 };
+    program.lift(point);
+    expectedPoint = { 0.0, 1.3 };
+    expectedPoint.push_back(aux_1->calculate(expectedPoint));
+
+    if(std::abs(point.at(2) - expectedPoint.at(2)) > 1e-10)
+        passed = false;
+
+    SHOT::IntervalVector intervalVector { Interval(-1.0, 2.0), Interval(0.5, 3.0) };
+    program.lift(intervalVector);
+
+    SHOT::IntervalVector expectedIntervalVector { Interval(-1.0, 2.0), Interval(0.5, 3.0) };
+    expectedIntervalVector.push_back(aux_1->calculate(expectedIntervalVector));
+    expectedIntervalVector.push_back(aux_2->calculate(expectedIntervalVector));
+
+    auto isEqual = [](const Interval& first, const Interval& second)
+    { return (std::abs(first.l() - second.l()) < 1e-10 && std::abs(first.u() - second.u()) < 1e-10); };
+
+    std::cout << "Lifted intervals: " << intervalVector.at(2) << ", " << intervalVector.at(3)
+              << " (should be equal to " << expectedIntervalVector.at(2) << ", " << expectedIntervalVector.at(3)
+              << ").\n";
+
+    if(intervalVector.size() != 4 || !isEqual(intervalVector.at(2), expectedIntervalVector.at(2))
+        || !isEqual(intervalVector.at(3), expectedIntervalVector.at(3)))
+        passed = false;
+
+    return passed;
+}
+
+bool ModelTestIndependentBlocks()
+{
+    // With the binary variable b fixed, the constraints x + y <= 1, z^2 + b <= 2 and w + b <= 5 give the blocks {x, y},
+    // {z} and {w}, unless an objective term y*z joins the first two
+    bool passed = true;
+
+    std::unique_ptr<Solver> solver = std::make_unique<Solver>();
+    auto env = solver->getEnvironment();
+
+    auto createProblem = [&](bool hasBilinearObjectiveTerm)
+    {
+        SHOT::ProblemPtr problem = std::make_shared<SHOT::Problem>(env);
+
+        auto var_x = std::make_shared<SHOT::Variable>("x", 0, SHOT::E_VariableType::Real, 0.0, 10.0);
+        auto var_y = std::make_shared<SHOT::Variable>("y", 1, SHOT::E_VariableType::Real, 0.0, 10.0);
+        auto var_z = std::make_shared<SHOT::Variable>("z", 2, SHOT::E_VariableType::Real, -10.0, 10.0);
+        auto var_w = std::make_shared<SHOT::Variable>("w", 3, SHOT::E_VariableType::Real, 0.0, 10.0);
+        auto var_b = std::make_shared<SHOT::Variable>("b", 4, SHOT::E_VariableType::Binary, 0.0, 1.0);
+        problem->add(SHOT::Variables({ var_x, var_y, var_z, var_w, var_b }));
+
+        auto objectiveFunction
+            = std::make_shared<SHOT::QuadraticObjectiveFunction>(SHOT::E_ObjectiveFunctionDirection::Minimize);
+        objectiveFunction->add(std::make_shared<SHOT::LinearTerm>(1.0, var_x));
+        objectiveFunction->add(std::make_shared<SHOT::LinearTerm>(1.0, var_z));
+
+        if(hasBilinearObjectiveTerm)
+            objectiveFunction->add(std::make_shared<SHOT::QuadraticTerm>(1.0, var_y, var_z));
+
+        problem->add(objectiveFunction);
+
+        auto constraint1 = std::make_shared<SHOT::LinearConstraint>(0, "c1", SHOT_DBL_MIN, 1.0);
+        constraint1->add(std::make_shared<SHOT::LinearTerm>(1.0, var_x));
+        constraint1->add(std::make_shared<SHOT::LinearTerm>(1.0, var_y));
+        problem->add(constraint1);
+
+        auto constraint2 = std::make_shared<SHOT::QuadraticConstraint>(1, "c2", SHOT_DBL_MIN, 2.0);
+        constraint2->add(std::make_shared<SHOT::LinearTerm>(1.0, var_b));
+        constraint2->add(std::make_shared<SHOT::QuadraticTerm>(1.0, var_z, var_z));
+        problem->add(constraint2);
+
+        auto constraint3 = std::make_shared<SHOT::LinearConstraint>(2, "c3", SHOT_DBL_MIN, 5.0);
+        constraint3->add(std::make_shared<SHOT::LinearTerm>(1.0, var_w));
+        constraint3->add(std::make_shared<SHOT::LinearTerm>(1.0, var_b));
+        problem->add(constraint3);
+
+        problem->finalize();
+
+        return (problem);
+    };
+
+    SHOT::VectorDouble lowerBounds { 0.0, 0.0, -10.0, 0.0, 1.0 };
+    SHOT::VectorDouble upperBounds { 10.0, 10.0, 10.0, 10.0, 1.0 };
+
+    auto problem = createProblem(false);
+    auto blocks = problem->getIndependentBlocks(lowerBounds, upperBounds);
+
+    std::cout << "Number of blocks: " << blocks.size() << " (should be 3).\n";
+
+    if(blocks.size() != 3 || blocks[0].variableIndexes != SHOT::VectorInteger { 0, 1 }
+        || blocks[0].constraintIndexes != SHOT::VectorInteger { 0 }
+        || blocks[1].variableIndexes != SHOT::VectorInteger { 2 }
+        || blocks[1].constraintIndexes != SHOT::VectorInteger { 1 }
+        || blocks[2].variableIndexes != SHOT::VectorInteger { 3 }
+        || blocks[2].constraintIndexes != SHOT::VectorInteger { 2 })
+        passed = false;
+
+    // The objective of a block only has the terms with variables in the block
+    if(blocks.size() == 3)
+    {
+        SHOT::VectorDouble point { 1.0, 2.0, 3.0, 4.0, 1.0 };
+
+        for(size_t k = 0; k < blocks.size(); k++)
+        {
+            double blockObjectiveValue = problem->createBlockObjectiveFunction(blocks[k])->calculateValue(point);
+            double expectedValue = (k == 0) ? 1.0 : ((k == 1) ? 3.0 : 0.0);
+
+            std::cout << "Objective value of block " << k << ": " << blockObjectiveValue << " (should be "
+                      << expectedValue << ").\n";
+
+            if(std::abs(blockObjectiveValue - expectedValue) > 1e-10)
+                passed = false;
+        }
+    }
+
+    // Without fixing b, the last two blocks are connected through it
+    upperBounds[4] = 2.0;
+    blocks = problem->getIndependentBlocks(lowerBounds, upperBounds);
+    upperBounds[4] = 1.0;
+
+    std::cout << "Number of blocks with b not fixed: " << blocks.size() << " (should be 2).\n";
+
+    if(blocks.size() != 2)
+        passed = false;
+
+    problem = createProblem(true);
+    blocks = problem->getIndependentBlocks(lowerBounds, upperBounds);
+
+    std::cout << "Number of blocks with the objective term y*z: " << blocks.size() << " (should be 2).\n";
+
+    if(blocks.size() != 2 || blocks[0].variableIndexes != SHOT::VectorInteger { 0, 1, 2 }
+        || blocks[0].constraintIndexes != SHOT::VectorInteger { 0, 1 })
+        passed = false;
+
+    return passed;
+}
+
+bool ModelTestPresolve()
+{
+    bool passed = true;
+
+    std::unique_ptr<Solver> solver = std::make_unique<Solver>();
+    auto env = solver->getEnvironment();
+
+    SHOT::ProblemPtr problem = std::make_shared<SHOT::Problem>(env);
+
+    auto var_x0 = std::make_shared<SHOT::Variable>("x0", 0, SHOT::E_VariableType::Real, 0.0, 10.0);
+    auto var_x1 = std::make_shared<SHOT::Variable>("x1", 1, SHOT::E_VariableType::Real, 0.0, 10.0);
+    auto var_x2 = std::make_shared<SHOT::Variable>("x2", 2, SHOT::E_VariableType::Real, SHOT_DBL_MIN, SHOT_DBL_MAX);
+    auto var_x3 = std::make_shared<SHOT::Variable>("x3", 3, SHOT::E_VariableType::Real, 0.0, 4.0);
+    auto var_x4 = std::make_shared<SHOT::Variable>("x4", 4, SHOT::E_VariableType::Integer, 0.0, 10.0);
+    auto var_x5 = std::make_shared<SHOT::Variable>("x5", 5, SHOT::E_VariableType::Real, -10.0, 10.0);
+    auto var_x6 = std::make_shared<SHOT::Variable>("x6", 6, SHOT::E_VariableType::Real, 0.0, 5.0);
+    auto var_x7 = std::make_shared<SHOT::Variable>("x7", 7, SHOT::E_VariableType::Real, 3.0, 3.0);
+    problem->add(SHOT::Variables({ var_x0, var_x1, var_x2, var_x3, var_x4, var_x5, var_x6, var_x7 }));
+
+    auto objectiveFunction
+        = std::make_shared<SHOT::LinearObjectiveFunction>(SHOT::E_ObjectiveFunctionDirection::Minimize);
+    objectiveFunction->add(std::make_shared<SHOT::LinearTerm>(1.0, var_x0));
+    objectiveFunction->add(std::make_shared<SHOT::LinearTerm>(1.0, var_x1));
+    objectiveFunction->add(std::make_shared<SHOT::LinearTerm>(-1.0, var_x3));
+    objectiveFunction->add(std::make_shared<SHOT::LinearTerm>(1.0, var_x5));
+    objectiveFunction->add(std::make_shared<SHOT::LinearTerm>(1.0, var_x6));
+    problem->add(objectiveFunction);
+
+    auto addLinearConstraint = [&](int index, double valueLHS, double valueRHS,
+                                   std::vector<std::pair<double, SHOT::VariablePtr>> terms)
+    {
+        auto constraint
+            = std::make_shared<SHOT::LinearConstraint>(index, "c" + std::to_string(index), valueLHS, valueRHS);
+
+        for(auto& [coefficient, variable] : terms)
+            constraint->add(std::make_shared<SHOT::LinearTerm>(coefficient, variable));
+
+        problem->add(constraint);
+    };
+
+    // c1 is parallel to c0, c2 is redundant, c3 is a singleton, x2 is a free column singleton in c4, x3 is substituted
+    // with x4 + 1 from c5 and c8 is a singleton after the fixed variable x7 is removed. Then x6 is in no constraint and
+    // can be fixed to its lower bound.
+    addLinearConstraint(0, 1.0, SHOT_DBL_MAX, { { 1.0, var_x0 }, { 1.0, var_x1 } });
+    addLinearConstraint(1, 4.0, SHOT_DBL_MAX, { { 2.0, var_x0 }, { 2.0, var_x1 } });
+    addLinearConstraint(2, SHOT_DBL_MIN, 30.0, { { 1.0, var_x0 }, { 1.0, var_x1 }, { 1.0, var_x6 } });
+    addLinearConstraint(3, SHOT_DBL_MIN, 7.0, { { 3.0, var_x4 } });
+    addLinearConstraint(4, SHOT_DBL_MIN, 5.0, { { 1.0, var_x0 }, { 1.0, var_x1 }, { -1.0, var_x2 } });
+    addLinearConstraint(5, 1.0, 1.0, { { 1.0, var_x3 }, { -1.0, var_x4 } });
+    addLinearConstraint(6, SHOT_DBL_MIN, 8.0, { { 1.0, var_x0 }, { 1.0, var_x3 } });
+    addLinearConstraint(8, SHOT_DBL_MIN, 9.0, { { 1.0, var_x6 }, { 1.0, var_x7 } });
+
+    // The variables x0 and x5 are locked by the quadratic constraint
+    auto constraint7 = std::make_shared<SHOT::QuadraticConstraint>(7, "c7", SHOT_DBL_MIN, 50.0);
+    constraint7->add(std::make_shared<SHOT::LinearTerm>(1.0, var_x0));
+    constraint7->add(std::make_shared<SHOT::QuadraticTerm>(1.0, var_x5, var_x5));
+    problem->add(constraint7);
+
+    auto presolve = std::make_shared<SHOT::Presolve>(env, problem);
+    presolve->run();
+    problem->presolve = presolve;
+
+    // The constraints are written on the form <= when the problem is finalized
+    double mergedLHS = problem->linearConstraints[0]->valueLHS;
+    problem->finalize();
+
+    std::cout << problem << std::endl;
+
+    std::cout << "Number of removed constraints: " << presolve->numberOfRemovedConstraints << " (should be 6).\n";
+    std::cout << "Number of removed variables: " << presolve->numberOfRemovedVariables << " (should be 2).\n";
+    std::cout << "Number of fixed variables: " << presolve->numberOfFixedVariables << " (should be 1).\n";
+
+    if(presolve->numberOfRemovedConstraints != 6 || presolve->numberOfRemovedVariables != 2
+        || presolve->numberOfFixedVariables != 1 || problem->linearConstraints.size() != 2
+        || problem->numericConstraints.size() != 3)
+        passed = false;
+
+    for(size_t i = 0; i < problem->numericConstraints.size(); i++)
+    {
+        if(problem->numericConstraints[i]->index != (int)i)
+            passed = false;
+    }
+
+    // The merged constraint is x0 + x1 >= 2 and the singleton constraint gives the bound x4 <= 2
+    if(mergedLHS != 2.0 || var_x4->upperBound != 2.0 || var_x6->upperBound != 0.0)
+        passed = false;
+
+    // The objective is x0 + x1 - x4 + x5 - 1 after substituting x3
+    if(objectiveFunction->constant != -1.0 || objectiveFunction->linearTerms.size() != 4)
+        passed = false;
+
+    SHOT::VectorDouble point { 6.0, 2.0, 0.0, 0.0, 2.0, 0.0, 0.0, 3.0 };
+    problem->postsolve(point);
+
+    std::cout << "Postsolved values of x2 and x3: " << point[2] << " and " << point[3] << " (should be 3 and 3).\n";
+
+    if(point[2] != 3.0 || point[3] != 3.0)
+        passed = false;
+
+    return passed;
+}
+
+bool ModelTestSymmetry()
+{
+    // Two identical machines with the binary variables b0 and b1 and the production x0 and x1, which are symmetric
+    // unless the constraint x0 + z <= 8 is added. The free variables y0 and y1 are removed in presolve, and should not
+    // give any permutations.
+    bool passed = true;
+
+    std::unique_ptr<Solver> solver = std::make_unique<Solver>();
+    auto env = solver->getEnvironment();
+
+    auto createProblem = [&](bool isAsymmetric, bool isPresolved)
+    {
+        SHOT::ProblemPtr problem = std::make_shared<SHOT::Problem>(env);
+
+        auto var_b0 = std::make_shared<SHOT::Variable>("b0", 0, SHOT::E_VariableType::Binary, 0.0, 1.0);
+        auto var_b1 = std::make_shared<SHOT::Variable>("b1", 1, SHOT::E_VariableType::Binary, 0.0, 1.0);
+        auto var_x0 = std::make_shared<SHOT::Variable>("x0", 2, SHOT::E_VariableType::Real, 0.0, 10.0);
+        auto var_x1 = std::make_shared<SHOT::Variable>("x1", 3, SHOT::E_VariableType::Real, 0.0, 10.0);
+        auto var_z = std::make_shared<SHOT::Variable>("z", 4, SHOT::E_VariableType::Real, 0.0, 10.0);
+        problem->add(SHOT::Variables({ var_b0, var_b1, var_x0, var_x1, var_z }));
+
+        auto objectiveFunction
+            = std::make_shared<SHOT::LinearObjectiveFunction>(SHOT::E_ObjectiveFunctionDirection::Minimize);
+        objectiveFunction->add(std::make_shared<SHOT::LinearTerm>(2.0, var_b0));
+        objectiveFunction->add(std::make_shared<SHOT::LinearTerm>(2.0, var_b1));
+        objectiveFunction->add(std::make_shared<SHOT::LinearTerm>(1.0, var_x0));
+        objectiveFunction->add(std::make_shared<SHOT::LinearTerm>(1.0, var_x1));
+        objectiveFunction->add(std::make_shared<SHOT::LinearTerm>(1.0, var_z));
+        problem->add(objectiveFunction);
+
+        auto constraint0 = std::make_shared<SHOT::LinearConstraint>(0, "c0", SHOT_DBL_MIN, 0.0);
+        constraint0->add(std::make_shared<SHOT::LinearTerm>(1.0, var_x0));
+        constraint0->add(std::make_shared<SHOT::LinearTerm>(-10.0, var_b0));
+        problem->add(constraint0);
+
+        auto constraint1 = std::make_shared<SHOT::LinearConstraint>(1, "c1", SHOT_DBL_MIN, 0.0);
+        constraint1->add(std::make_shared<SHOT::LinearTerm>(1.0, var_x1));
+        constraint1->add(std::make_shared<SHOT::LinearTerm>(-10.0, var_b1));
+        problem->add(constraint1);
+
+        auto constraint2 = std::make_shared<SHOT::LinearConstraint>(2, "c2", 5.0, SHOT_DBL_MAX);
+        constraint2->add(std::make_shared<SHOT::LinearTerm>(1.0, var_x0));
+        constraint2->add(std::make_shared<SHOT::LinearTerm>(1.0, var_x1));
+        constraint2->add(std::make_shared<SHOT::LinearTerm>(1.0, var_z));
+        problem->add(constraint2);
+
+        SHOT::NonlinearExpressions squares;
+        squares.add(std::make_shared<SHOT::ExpressionPower>(
+            std::make_shared<SHOT::ExpressionVariable>(var_x0), std::make_shared<SHOT::ExpressionConstant>(2.0)));
+        squares.add(std::make_shared<SHOT::ExpressionPower>(
+            std::make_shared<SHOT::ExpressionVariable>(var_x1), std::make_shared<SHOT::ExpressionConstant>(2.0)));
+
+        auto constraint3 = std::make_shared<SHOT::NonlinearConstraint>(3, "c3", SHOT::LinearTerms(),
+            std::make_shared<SHOT::ExpressionSum>(squares), SHOT_DBL_MIN, 50.0);
+        problem->add(constraint3);
+
+        if(isAsymmetric)
+        {
+            auto constraint4 = std::make_shared<SHOT::LinearConstraint>(4, "c4", SHOT_DBL_MIN, 8.0);
+            constraint4->add(std::make_shared<SHOT::LinearTerm>(1.0, var_x0));
+            constraint4->add(std::make_shared<SHOT::LinearTerm>(1.0, var_z));
+            problem->add(constraint4);
+        }
+
+        if(isPresolved)
+        {
+            auto var_y0
+                = std::make_shared<SHOT::Variable>("y0", 5, SHOT::E_VariableType::Real, SHOT_DBL_MIN, SHOT_DBL_MAX);
+            auto var_y1
+                = std::make_shared<SHOT::Variable>("y1", 6, SHOT::E_VariableType::Real, SHOT_DBL_MIN, SHOT_DBL_MAX);
+            problem->add(SHOT::Variables({ var_y0, var_y1 }));
+
+            auto constraint4 = std::make_shared<SHOT::LinearConstraint>(4, "c4", SHOT_DBL_MIN, 1.0);
+            constraint4->add(std::make_shared<SHOT::LinearTerm>(1.0, var_x0));
+            constraint4->add(std::make_shared<SHOT::LinearTerm>(-1.0, var_y0));
+            problem->add(constraint4);
+
+            auto constraint5 = std::make_shared<SHOT::LinearConstraint>(5, "c5", SHOT_DBL_MIN, 1.0);
+            constraint5->add(std::make_shared<SHOT::LinearTerm>(1.0, var_x1));
+            constraint5->add(std::make_shared<SHOT::LinearTerm>(-1.0, var_y1));
+            problem->add(constraint5);
+
+            problem->presolve = std::make_shared<SHOT::Presolve>(env, problem);
+            problem->presolve->run();
+        }
+
+        problem->finalize();
+
+        return (problem);
+    };
+
+    auto symmetry = std::make_shared<SHOT::Symmetry>(env, createProblem(false, false));
+
+    if(!symmetry->detect())
+        passed = false;
+
+    auto orbits = symmetry->getOrbits();
+    auto pairs = symmetry->getSymmetryBreakingPairs();
+
+    std::cout << "Number of generators: " << symmetry->generators.size() << " (should be 1).\n";
+    std::cout << "Number of orbits: " << orbits.size() << " (should be 2).\n";
+
+    if(symmetry->generators.size() != 1 || symmetry->generators[0] != SHOT::VectorInteger { 1, 0, 3, 2, 4 })
+        passed = false;
+
+    if(orbits.size() != 2 || orbits[0] != SHOT::VectorInteger { 0, 1 } || orbits[1] != SHOT::VectorInteger { 2, 3 })
+        passed = false;
+
+    // Only the orbit of the binary variables is used, since both orbits are moved by the same generator
+    if(pairs.size() != 1 || pairs[0] != std::make_pair(0, 1))
+        passed = false;
+
+    symmetry = std::make_shared<SHOT::Symmetry>(env, createProblem(true, false));
+    symmetry->detect();
+
+    std::cout << "Number of generators in the asymmetric problem: " << symmetry->generators.size()
+              << " (should be 0).\n";
+
+    if(symmetry->generators.size() != 0 || symmetry->getSymmetryBreakingPairs().size() != 0)
+        passed = false;
+
+    symmetry = std::make_shared<SHOT::Symmetry>(env, createProblem(false, true));
+    symmetry->detect();
+    pairs = symmetry->getSymmetryBreakingPairs();
+
+    std::cout << "Number of generators in the presolved problem: " << symmetry->generators.size()
+              << " (should be 1).\n";
+
+    if(symmetry->generators.size() != 1 || pairs.size() != 1 || pairs[0] != std::make_pair(0, 1))
+        passed = false;
+
+    return passed;
+}
+
+bool ModelTestPrimalSolutionCandidates()
+{
+    // The same candidates are verified with one and with three threads, the accepted solutions should be the same and
+    // the candidates themselves should not be changed by the projection and rounding
+    bool passed = true;
+
+    std::vector<std::pair<double, double>> candidatePoints
+        = { { 3.0, 2.0 }, { 9.0, 0.0 }, { 12.0, 1.4 }, { 2.0, 3.01 }, { 7.5, 0.2 } };
+
+    auto checkCandidates = [&](int numberOfThreads)
+    {
+        std::unique_ptr<Solver> solver = std::make_unique<Solver>();
+        auto env = solver->getEnvironment();
+
+        env->settings->updateSetting("CandidateCheck.NumberOfThreads", "Primal", numberOfThreads);
+        env->settings->updateSetting("SaveNumberOfSolutions", "Output", 10);
+
+        SHOT::ProblemPtr problem = std::make_shared<SHOT::Problem>(env);
+
+        auto var_x0 = std::make_shared<SHOT::Variable>("x0", 0, SHOT::E_VariableType::Real, 0.0, 10.0);
+        auto var_x1 = std::make_shared<SHOT::Variable>("x1", 1, SHOT::E_VariableType::Integer, 0.0, 5.0);
+        problem->add(SHOT::Variables({ var_x0, var_x1 }));
+
+        auto objectiveFunction
+            = std::make_shared<SHOT::LinearObjectiveFunction>(SHOT::E_ObjectiveFunctionDirection::Minimize);
+        objectiveFunction->add(std::make_shared<SHOT::LinearTerm>(-1.0, var_x0));
+        objectiveFunction->add(std::make_shared<SHOT::LinearTerm>(-2.0, var_x1));
+        problem->add(objectiveFunction);
+
+        auto constraint = std::make_shared<SHOT::LinearConstraint>(0, "c0", SHOT_DBL_MIN, 8.0);
+        constraint->add(std::make_shared<SHOT::LinearTerm>(1.0, var_x0));
+        constraint->add(std::make_shared<SHOT::LinearTerm>(1.0, var_x1));
+        problem->add(constraint);
+
+        problem->finalize();
+        env->problem = problem;
+
+        std::vector<PrimalSolution> candidates;
+
+        for(auto& [x0, x1] : candidatePoints)
+        {
+            PrimalSolution candidate;
+            candidate.point = { x0, x1 };
+            candidate.objValue = -x0 - 2.0 * x1;
+            candidate.sourceType = E_PrimalSolutionSource::Rootsearch;
+            candidates.push_back(candidate);
+        }
+
+        env->primalSolver->primalSolutionCandidates = candidates;
+        auto& verifiedCandidates = env->primalSolver->primalSolutionCandidates;
+
+        // Verifies one candidate directly, the batch is then checked as it would be in the solver
+        env->primalSolver->checkPrimalSolutionPoint(verifiedCandidates[0]);
+
+        if(verifiedCandidates[0].point != candidates[0].point)
+            passed = false;
+
+        env->primalSolver->checkPrimalSolutionCandidates();
+
+        std::vector<std::pair<VectorDouble, double>> solutions;
+
+        for(auto& S : env->results->primalSolutions)
+            solutions.emplace_back(S.point, S.objValue);
+
+        return (solutions);
+    };
+
+    auto solutions = checkCandidates(1);
+    auto concurrentSolutions = checkCandidates(3);
+
+    std::cout << "Number of accepted candidates: " << solutions.size() << " (should be 3).\n";
+
+    // The rounded point (2, 3) is the best, followed by the rounded (7.5, 0) and (3, 2)
+    if(solutions.size() != 3 || solutions[0].first != VectorDouble { 2.0, 3.0 } || solutions[0].second != -8.0
+        || solutions[1].first != VectorDouble { 7.5, 0.0 } || solutions[2].first != VectorDouble { 3.0, 2.0 })
+        passed = false;
+
+    if(solutions != concurrentSolutions)
+    {
+        std::cout << "The candidates verified with three threads differ from the ones verified with one thread.\n";
+        passed = false;
+    }
+
+    return passed;
+}
+
+bool ModelTestKnownPoints()
+{
+    // Points are only considered to be known if they are equal, also when they are closer than the width used in the
+    // point keys, and equal fixed NLP candidates in the same batch are only solved once
+    bool passed = true;
+
+    std::unique_ptr<Solver> solver = std::make_unique<Solver>();
+    auto env = solver->getEnvironment();
+
+    env->settings->updateSetting("SaveNumberOfSolutions", "Output", 10);
+    env->settings->updateSetting("FixedInteger.OnlyUniqueIntegerCombinations", "Primal", false);
+
+    SHOT::ProblemPtr problem = std::make_shared<SHOT::Problem>(env);
+
+    auto var_x0 = std::make_shared<SHOT::Variable>("x0", 0, SHOT::E_VariableType::Real, 0.0, 10.0);
+    auto var_x1 = std::make_shared<SHOT::Variable>("x1", 1, SHOT::E_VariableType::Integer, 0.0, 5.0);
+    problem->add(SHOT::Variables({ var_x0, var_x1 }));
+
+    auto objectiveFunction
+        = std::make_shared<SHOT::LinearObjectiveFunction>(SHOT::E_ObjectiveFunctionDirection::Minimize);
+    objectiveFunction->add(std::make_shared<SHOT::LinearTerm>(1.0, var_x0));
+    objectiveFunction->add(std::make_shared<SHOT::LinearTerm>(1.0, var_x1));
+    problem->add(objectiveFunction);
+
+    problem->finalize();
+    env->problem = problem;
+    env->reformulatedProblem = problem;
+
+    auto addSolution = [&](double x0, double x1)
+    {
+        PrimalSolution solution;
+        solution.point = { x0, x1 };
+        solution.objValue = x0 + x1;
+        env->results->addPrimalSolution(solution);
+    };
+
+    addSolution(1.0, 2.0);
+    addSolution(1.0, 2.0);
+    addSolution(1.0 + 1e-9, 2.0);
+    addSolution(1.0 + 2e-9, 2.0);
+    addSolution(1.0 + 1e-9, 2.0);
+
+    std::cout << "Number of saved solutions: " << env->results->primalSolutions.size() << " (should be 3).\n";
+
+    if(env->results->primalSolutions.size() != 3)
+        passed = false;
+
+    env->primalSolver->addFixedNLPCandidate({ 1.0, 2.0 }, E_PrimalNLPSource::FirstSolution, 3.0, 1, PairIndexValue());
+    env->primalSolver->addFixedNLPCandidate({ 1.0, 2.0 }, E_PrimalNLPSource::FirstSolution, 3.0, 1, PairIndexValue());
+    env->primalSolver->addFixedNLPCandidate(
+        { 1.0 + 1e-9, 2.0 }, E_PrimalNLPSource::FirstSolution, 3.0, 1, PairIndexValue());
+
+    std::cout << "Number of fixed NLP candidates: " << env->primalSolver->fixedPrimalNLPCandidates.size()
+              << " (should be 2).\n";
+
+    if(env->primalSolver->fixedPrimalNLPCandidates.size() != 2)
+        passed = false;
+
+    // A candidate that has been solved is not added again in the next batch
+    for(auto& C : env->primalSolver->fixedPrimalNLPCandidates)
+        env->primalSolver->addUsedFixedNLPCandidate(C);
+
+    env->primalSolver->fixedPrimalNLPCandidates.clear();
+
+    env->primalSolver->addFixedNLPCandidate({ 1.0, 2.0 }, E_PrimalNLPSource::FirstSolution, 3.0, 2, PairIndexValue());
+    env->primalSolver->addFixedNLPCandidate({ 1.5, 2.0 }, E_PrimalNLPSource::FirstSolution, 3.5, 2, PairIndexValue());
+
+    if(env->primalSolver->fixedPrimalNLPCandidates.size() != 1
+        || env->primalSolver->fixedPrimalNLPCandidates[0].point != VectorDouble { 1.5, 2.0 })
+        passed = false;
+
+    return passed;
+}
+
+bool ModelTestExpressionTapes()
+{
+    // The gradients and Hessians calculated on the tape of each nonlinear expression should be the same as the ones
+    // from a single tape with all expressions over all nonlinear variables
+    bool passed = true;
+
+    std::unique_ptr<Solver> solver = std::make_unique<Solver>();
+    auto env = solver->getEnvironment();
+
+    SHOT::ProblemPtr problem = std::make_shared<SHOT::Problem>(env);
+    env->problem = problem;
+
+    auto var_x = std::make_shared<SHOT::Variable>("x", 0, SHOT::E_VariableType::Real, 0.1, 10.0);
+    auto var_y = std::make_shared<SHOT::Variable>("y", 1, SHOT::E_VariableType::Real, 0.1, 10.0);
+    auto var_z = std::make_shared<SHOT::Variable>("z", 2, SHOT::E_VariableType::Real, 0.1, 10.0);
+    problem->add(SHOT::Variables({ var_x, var_y, var_z }));
+
+    auto x = std::make_shared<SHOT::ExpressionVariable>(var_x);
+    auto y = std::make_shared<SHOT::ExpressionVariable>(var_y);
+    auto z = std::make_shared<SHOT::ExpressionVariable>(var_z);
+
+    auto objectiveFunction
+        = std::make_shared<SHOT::LinearObjectiveFunction>(SHOT::E_ObjectiveFunctionDirection::Minimize);
+    objectiveFunction->add(std::make_shared<SHOT::LinearTerm>(1.0, var_x));
+    problem->add(objectiveFunction);
+
+    // The expressions have different subsets of the variables
+    std::vector<SHOT::NonlinearExpressionPtr> expressions;
+
+    expressions.push_back(std::make_shared<SHOT::ExpressionSum>(
+        std::make_shared<SHOT::ExpressionProduct>(SHOT::NonlinearExpressions({ x, y })),
+        std::make_shared<SHOT::ExpressionExp>(z)));
+    expressions.push_back(std::make_shared<SHOT::ExpressionProduct>(SHOT::NonlinearExpressions({ y, y, z })));
+    expressions.push_back(std::make_shared<SHOT::ExpressionLog>(z));
+
+    std::vector<SHOT::NonlinearConstraintPtr> constraints;
+
+    for(size_t i = 0; i < expressions.size(); i++)
+    {
+        constraints.push_back(std::make_shared<SHOT::NonlinearConstraint>(
+            i, "c" + std::to_string(i), expressions[i], SHOT_DBL_MIN, 20.0));
+        problem->add(constraints.back());
+    }
+
+    problem->finalize();
+
+    SHOT::VectorDouble point = { 1.5, 0.7, 2.3 };
+
+    auto& tapeVariables = problem->factorableFunctionVariables;
+    size_t numberOfVariables = tapeVariables.size();
+
+    CppAD::Independent(tapeVariables);
+
+    std::vector<CppAD::AD<double>> dependentFunctions;
+
+    for(auto& E : expressions)
+        dependentFunctions.push_back(E->getFactorableFunction());
+
+    CppAD::ADFun<double> tape(tapeVariables, dependentFunctions);
+
+    SHOT::VectorDouble tapePoint(numberOfVariables);
+
+    for(auto& V : problem->nonlinearExpressionVariables)
+        tapePoint[V->properties.nonlinearVariableIndex] = point[V->index];
+
+    auto jacobian = tape.Jacobian(tapePoint);
+
+    for(size_t i = 0; i < constraints.size(); i++)
+    {
+        auto gradient = constraints[i]->calculateGradient(point, false);
+
+        for(auto& G : gradient)
+        {
+            double element = jacobian[i * numberOfVariables + G.first->properties.nonlinearVariableIndex];
+
+            std::cout << "d" << constraints[i]->name << "/d" << G.first->name << ": " << G.second
+                      << " (should be equal to " << element << ").\n";
+
+            if(std::abs(element - G.second) > 1e-10)
+                passed = false;
+        }
+
+        auto hessian = tape.Hessian(tapePoint, i);
+        double hessianSum = 0.0;
+
+        for(auto& [variables, value] : constraints[i]->calculateHessian(point, false))
+        {
+            double element = hessian[variables.first->properties.nonlinearVariableIndex * numberOfVariables
+                + variables.second->properties.nonlinearVariableIndex];
+
+            if(std::abs(element - value) > 1e-10)
+                passed = false;
+
+            hessianSum += std::abs(value);
+        }
+
+        // All nonzero elements in the upper triangle of the Hessian should be included
+        double tapeHessianSum = 0.0;
+
+        for(size_t j = 0; j < numberOfVariables; j++)
+        {
+            for(size_t k = j; k < numberOfVariables; k++)
+                tapeHessianSum += std::abs(hessian[j * numberOfVariables + k]);
+        }
+
+        std::cout << "Sum of Hessian elements of " << constraints[i]->name << ": " << hessianSum
+                  << " (should be equal to " << tapeHessianSum << ").\n";
+
+        if(std::abs(hessianSum - tapeHessianSum) > 1e-10)
+            passed = false;
+    }
+
+    return passed;
+}
+
+bool ModelTestStructuralEquality()
+{
+    // Expressions with the same tree should be equal and have the same hash also when they do not share nodes
+    bool passed = true;
+
+    auto var_x = std::make_shared<SHOT::Variable>("x", 0, SHOT::E_VariableType::Real, 0.0, 10.0);
+    auto var_y = std::make_shared<SHOT::Variable>("y", 1, SHOT::E_VariableType::Real, 0.0, 10.0);
+
+    auto createExpression = [](SHOT::VariablePtr first, SHOT::VariablePtr second, double constant) {
+        return (std::make_shared<SHOT::ExpressionSum>(
+            std::make_shared<SHOT::ExpressionExp>(std::make_shared<SHOT::ExpressionVariable>(first)),
+            std::make_shared<SHOT::ExpressionPower>(std::make_shared<SHOT::ExpressionVariable>(second),
+                std::make_shared<SHOT::ExpressionConstant>(constant))));
+    };
+
+    SHOT::NonlinearExpressionPtr expression = createExpression(var_x, var_y, 2.0);
+    SHOT::NonlinearExpressionPtr copy = createExpression(var_x, var_y, 2.0);
+    SHOT::NonlinearExpressionPtr otherConstant = createExpression(var_x, var_y, 3.0);
+    SHOT::NonlinearExpressionPtr otherVariables = createExpression(var_y, var_x, 2.0);
+
+    SHOT::NonlinearExpressionStructuralHasher hasher;
+    SHOT::NonlinearExpressionStructuralEquality isEqual;
+
+    if(!isEqual(expression, copy) || hasher(expression) != hasher(copy))
+    {
+        std::cout << "The copied expression was not identified as equal.\n";
+        passed = false;
+    }
+
+    if(isEqual(expression, otherConstant) || isEqual(expression, otherVariables))
+    {
+        std::cout << "Different expressions were identified as equal.\n";
+        passed = false;
+    }
+
+    std::unordered_map<SHOT::NonlinearExpressionPtr, int, SHOT::NonlinearExpressionStructuralHasher,
+        SHOT::NonlinearExpressionStructuralEquality>
+        expressions;
+
+    expressions.emplace(expression, 1);
+    expressions.emplace(copy, 2);
+    expressions.emplace(otherConstant, 3);
+    expressions.emplace(otherVariables, 4);
+
+    std::cout << "Number of different expressions: " << expressions.size() << " (should be 3).\n";
+
+    if(expressions.size() != 3 || expressions.at(copy) != 1)
+        passed = false;
+
     return passed;
-}
\ No newline at end of file
+}
+
+bool ModelTestWarmStartCache()
+{
+    // The nearest stored assignment should be found both when it shares a block with the new assignment and when the
+    // remaining entries have to be compared
+    bool passed = true;
+
+    auto createEntry = [](SHOT::VectorInteger assignment, double value) {
+        auto entry = std::make_shared<SHOT::NLPWarmStartCache::Entry>();
+        entry->assignment = assignment;
+        entry->variableValues = { value };
+        return (entry);
+    };
+
+    auto checkNearest = [&](SHOT::NLPWarmStartCache& cache, const SHOT::VectorInteger& assignment, size_t maxDistance,
+                            double expectedValue, size_t expectedDistance) {
+        size_t distance;
+        auto nearest = cache.findNearest(assignment, distance, maxDistance);
+
+        if(expectedValue < 0.0)
+        {
+            std::cout << "Expected no entry within distance " << maxDistance << ", "
+                      << (nearest ? "found one" : "found none") << ".\n";
+            return (nearest == nullptr);
+        }
+
+        if(!nearest)
+        {
+            std::cout << "Expected entry " << expectedValue << " at distance " << expectedDistance << ", found none.\n";
+            return (false);
+        }
+
+        std::cout << "Expected entry " << expectedValue << " at distance " << expectedDistance << ", found entry "
+                  << nearest->variableValues[0] << " at distance " << distance << ".\n";
+
+        return (nearest->variableValues[0] == expectedValue && distance == expectedDistance);
+    };
+
+    // The assignments of eight variables are split into four blocks of two
+    SHOT::NLPWarmStartCache cache(3, 4);
+
+    SHOT::VectorInteger zeros { 0, 0, 0, 0, 0, 0, 0, 0 };
+    cache.add(createEntry(zeros, 1.0));
+
+    // Exact hit
+    passed = checkNearest(cache, zeros, 0, 1.0, 0) && passed;
+
+    // Differs in the first block only, so it is found from the other blocks also when maxDistance < numberOfBlocks
+    passed = checkNearest(cache, { 1, 0, 0, 0, 0, 0, 0, 0 }, 1, 1.0, 1) && passed;
+
+    // Differs in all blocks, so the entry is not found from the block indexes
+    SHOT::VectorInteger allBlocksDiffer { 1, 0, 1, 0, 1, 0, 1, 0 };
+    passed = checkNearest(cache, allBlocksDiffer, 3, -1.0, 0) && passed;
+    passed = checkNearest(cache, allBlocksDiffer, 4, 1.0, 4) && passed;
+    passed = checkNearest(cache, allBlocksDiffer, SIZE_MAX, 1.0, 4) && passed;
+
+    // The distance limit
+    SHOT::VectorInteger fiveDiffer { 1, 1, 1, 0, 1, 0, 1, 0 };
+    passed = checkNearest(cache, fiveDiffer, 4, -1.0, 0) && passed;
+    passed = checkNearest(cache, fiveDiffer, 5, 1.0, 5) && passed;
+
+    // The closest of several entries
+    cache.add(createEntry({ 1, 1, 1, 1, 1, 1, 1, 1 }, 2.0));
+    cache.add(createEntry({ 1, 1, 1, 1, 0, 0, 0, 0 }, 3.0));
+    passed = checkNearest(cache, { 1, 1, 1, 0, 0, 0, 0, 0 }, SIZE_MAX, 3.0, 1) && passed;
+    passed = checkNearest(cache, { 0, 1, 1, 1, 1, 1, 1, 0 }, SIZE_MAX, 2.0, 2) && passed;
+
+    // An entry with the same assignment replaces the stored one
+    cache.add(createEntry({ 1, 1, 1, 1, 1, 1, 1, 1 }, 4.0));
+    passed = checkNearest(cache, { 1, 1, 1, 1, 1, 1, 1, 1 }, 0, 4.0, 0) && passed;
+
+    if(cache.size() != 3)
+    {
+        std::cout << "The cache has " << cache.size() << " entries (should be 3).\n";
+        passed = false;
+    }
+
+    // When the cache is full, the oldest entry is replaced
+    cache.add(createEntry({ 0, 0, 0, 0, 0, 1, 1, 1 }, 5.0));
+    passed = checkNearest(cache, zeros, 0, -1.0, 0) && passed;
+    passed = checkNearest(cache, zeros, SIZE_MAX, 5.0, 3) && passed;
+    passed = checkNearest(cache, { 1, 1, 1, 1, 0, 0, 0, 0 }, 0, 3.0, 0) && passed;
+
+    if(cache.size() != 3)
+    {
+        std::cout << "The cache has " << cache.size() << " entries (should be 3).\n";
+        passed = false;
+    }
+
+    return passed;
+}
+
+bool ModelTestSparseVariableVector()
+{
+    // The duplicates should be merged and the entries sorted on the variable index when compressing
+    bool passed = true;
+
+    auto var_x = std::make_shared<SHOT::Variable>("x", 0, SHOT::E_VariableType::Real, 0.0, 10.0);
+    auto var_y = std::make_shared<SHOT::Variable>("y", 1, SHOT::E_VariableType::Real, 0.0, 10.0);
+    auto var_z = std::make_shared<SHOT::Variable>("z", 2, SHOT::E_VariableType::Real, 0.0, 10.0);
+
+    auto checkElements = [](const SHOT::SparseVariableVector& vector,
+                             const std::vector<std::pair<SHOT::VariablePtr, double>>& expectedElements) {
+        std::cout << "Elements:";
+
+        for(auto& E : vector)
+            std::cout << " (" << E.first->name << ", " << E.second << ")";
+
+        std::cout << '\n';
+
+        if(vector.size() != expectedElements.size())
+            return (false);
+
+        return (std::equal(vector.begin(), vector.end(), expectedElements.begin()));
+    };
+
+    SHOT::SparseVariableVector first;
+    first.add(var_z, 1.0);
+    first.add(var_x, 2.0);
+    first.add(var_z, 3.0);
+
+    SHOT::SparseVariableVector second;
+    second.add(var_y, 4.0);
+    second.add(var_x, -2.0);
+
+    first.add(second);
+
+    if(first.size() != 5 || first[var_x] != 0.0 || first[var_z] != 4.0)
+    {
+        std::cout << "The uncompressed vector has the wrong elements.\n";
+        passed = false;
+    }
+
+    SHOT::SparseVariableVector compressed = first;
+    compressed.compress();
+
+    if(!checkElements(compressed, { { var_x, 0.0 }, { var_y, 4.0 }, { var_z, 4.0 } }))
+    {
+        std::cout << "The duplicates were not merged into sorted elements.\n";
+        passed = false;
+    }
+
+    // The value of x cancels out, so it is removed
+    first.compress(true);
+
+    if(!checkElements(first, { { var_y, 4.0 }, { var_z, 4.0 } }))
+    {
+        std::cout << "The zero element was not erased.\n";
+        passed = false;
+    }
+
+    // The positions used for merging are reset after each compression
+    first.add(var_x, 1.0);
+    first.add(var_y, 1.0);
+    first.compress(true);
+
+    if(!checkElements(first, { { var_x, 1.0 }, { var_y, 5.0 }, { var_z, 4.0 } }))
+    {
+        std::cout << "The vector was not compressed correctly a second time.\n";
+        passed = false;
+    }
+
+    return passed;
+}
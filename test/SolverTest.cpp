@@ -9,7 +9,9 @@
 */
 
 #include "../src/Solver.h"
+#include "../src/DualSolver.h"
 #include "../src/Environment.h"
+#include "../src/Output.h"
 #include "../src/Structs.h"
 #include "../src/Utilities.h"
 
@@ -26,6 +28,8 @@
 
 #include "../src/Tasks/TaskReformulateProblem.h"
 
+#include <fstream>
+
 using namespace SHOT;
 
 bool ReadProblem(std::string filename)
@@ -94,6 +98,79 @@ bool SolveProblem(std::string filename)
     return passed;
 }
 
+// Solves the problem after updating the settings with the given function, and checks that the primal solution found is
+// feasible in the original problem, i.e., after any reductions of the reformulated problem have been undone
+bool SolveProblemWithSettings(const std::string& problemFile, const std::function<void(Solver&)>& updateSettings,
+    E_ModelReturnStatus& status, PrimalSolution& solution)
+{
+    auto solver = std::make_unique<Solver>();
+    auto env = solver->getEnvironment();
+
+    updateSettings(*solver);
+
+    if(!solver->setProblem(problemFile))
+    {
+        std::cout << "Could not read problem " << problemFile << '\n';
+        return (false);
+    }
+
+    solver->solveProblem();
+    status = solver->getModelReturnStatus();
+
+    if(!solver->hasPrimalSolution())
+    {
+        std::cout << "No primal solution found\n";
+        return (false);
+    }
+
+    solution = solver->getPrimalSolution();
+    std::cout << "Objective value: " << solution.objValue << '\n';
+
+    double tolerance = 1e-5;
+
+    if(!env->problem->areVariableBoundsFulfilled(solution.point, tolerance)
+        || !env->problem->areNumericConstraintsFulfilled(solution.point, tolerance))
+    {
+        std::cout << "The primal solution is not feasible in the original problem\n";
+        return (false);
+    }
+
+    return (true);
+}
+
+// Solves the problem with two different sets of settings and checks that both terminate with the same status and
+// objective value
+bool CompareSolutions(const std::string& problemFile, const std::function<void(Solver&)>& firstSettings,
+    const std::function<void(Solver&)>& secondSettings)
+{
+    E_ModelReturnStatus firstStatus, secondStatus;
+    PrimalSolution firstSolution, secondSolution;
+
+    if(!SolveProblemWithSettings(problemFile, firstSettings, firstStatus, firstSolution))
+        return (false);
+
+    if(!SolveProblemWithSettings(problemFile, secondSettings, secondStatus, secondSolution))
+        return (false);
+
+    if(firstStatus != secondStatus)
+    {
+        std::cout << "The termination statuses differ\n";
+        return (false);
+    }
+
+    // Both solutions are only guaranteed to be within the default relative objective gap of the optimum
+    double tolerance = 1e-3 * std::max(1.0, std::abs(firstSolution.objValue));
+
+    if(std::abs(firstSolution.objValue - secondSolution.objValue) > tolerance)
+    {
+        std::cout << "The objective values " << firstSolution.objValue << " and " << secondSolution.objValue
+                  << " differ\n";
+        return (false);
+    }
+
+    return (true);
+}
+
 bool TestRootsearch(const std::string& problemFile)
 {
     bool passed = true;
@@ -214,6 +291,189 @@ bool TestGradient(const std::string& problemFile)
     return passed;
 }
 
+bool TestDefinedVariables(const std::string& problemFile)
+{
+    bool passed = true;
+
+    std::unique_ptr<Solver> solver = std::make_unique<Solver>();
+    auto env = solver->getEnvironment();
+
+    std::cout << "Reading problem:  " << problemFile << '\n';
+
+    // The problem is created directly by the modeling system since the dual solver is not needed
+    auto modelingSystem = std::make_shared<ModelingSystemAMPL>(env);
+    auto problem = std::make_shared<Problem>(env);
+
+    if(modelingSystem->createProblem(problem, problemFile) != E_ProblemCreationStatus::NormalCompletion)
+    {
+        std::cout << "Error while reading problem";
+        return (false);
+    }
+
+    std::cout << problem << "\n\n";
+
+    // The defined variable v = 2*x0 + exp(x0*x1) is used in both constraints c0: v + x0 <= 10 and c1: v - x1 <= 5
+    VectorDouble point { 1.0, 0.5 };
+    VectorDouble expectedValues { 3.0 + std::exp(0.5), 1.5 + std::exp(0.5) };
+
+    if(problem->nonlinearConstraints.size() != 2)
+    {
+        std::cout << "Expected two nonlinear constraints, found " << problem->nonlinearConstraints.size() << '\n';
+        return (false);
+    }
+
+    for(size_t i = 0; i < 2; i++)
+    {
+        double value = problem->numericConstraints[i]->calculateFunctionValue(point);
+        std::cout << "Value of constraint " << i << ": " << value << " (expected " << expectedValues[i] << ")\n";
+
+        if(std::abs(value - expectedValues[i]) > 1e-8)
+            passed = false;
+    }
+
+    // The nonlinear part of the defined variable should be the same node in both constraints
+    if(problem->nonlinearConstraints[0]->nonlinearExpression != problem->nonlinearConstraints[1]->nonlinearExpression)
+    {
+        std::cout << "The defined variable is not shared between the constraints\n";
+        passed = false;
+    }
+
+    return passed;
+}
+
+bool TestInteriorPoint(const std::string& problemFile)
+{
+    // The environment of the solve with the ESH cut strategy is kept to check the interior point
+    EnvironmentPtr env;
+
+    auto useECP = [](Solver& solver) {
+        solver.updateSetting("CutStrategy", "Dual", static_cast<int>(ES_HyperplaneCutStrategy::ECP));
+    };
+
+    auto useESH = [&](Solver& solver) {
+        solver.updateSetting("CutStrategy", "Dual", static_cast<int>(ES_HyperplaneCutStrategy::ESH));
+        env = solver.getEnvironment();
+    };
+
+    // The root searches towards the interior point should not give a different optimum than the cutting planes
+    if(!CompareSolutions(problemFile, useECP, useESH))
+        return (false);
+
+    if(env->dualSolver->interiorPts.size() == 0)
+    {
+        std::cout << "No interior point found by the minimax solver\n";
+        return (false);
+    }
+
+    auto interiorPoint = env->dualSolver->interiorPts[0];
+    auto maxDeviation = env->reformulatedProblem->getMaxNumericConstraintValue(
+        interiorPoint->point, env->reformulatedProblem->nonlinearConstraints);
+
+    std::cout << "Maximum constraint deviation in the interior point: " << maxDeviation.normalizedValue << '\n';
+
+    return (maxDeviation.normalizedValue < 0);
+}
+
+bool TestBoundTighteningOBBT(const std::string& problemFile)
+{
+    // The environment of the solve with bound tightening is kept to check the number of tightened bounds
+    EnvironmentPtr env;
+
+    auto useMultiTree = [](Solver& solver) {
+        solver.updateSetting("TreeStrategy", "Dual", static_cast<int>(ES_TreeStrategy::MultiTree));
+    };
+
+    auto useOBBT = [&](Solver& solver) {
+        useMultiTree(solver);
+        solver.updateSetting("BoundTightening.OptimizationBased.Use", "Model", true);
+        env = solver.getEnvironment();
+    };
+
+    // The tightened bounds should not cut off the optimal solution
+    if(!CompareSolutions(problemFile, useMultiTree, useOBBT))
+        return (false);
+
+    std::cout << "Number of bounds tightened: " << env->solutionStatistics.numberOfVariableBoundsTightenedOBBT << '\n';
+
+    return (env->solutionStatistics.numberOfVariableBoundsTightenedOBBT > 0);
+}
+
+// Stores the messages that reach the sink
+class MessageStoringSink : public spdlog::sinks::base_sink<std::mutex>
+{
+public:
+    VectorString messages;
+
+protected:
+    void sink_it_(const spdlog::details::log_msg& message) override
+    {
+        messages.emplace_back(message.payload.data(), message.payload.size());
+    }
+
+    void flush_() override {}
+};
+
+bool TestOutput()
+{
+    bool passed = true;
+
+    auto solver = std::make_unique<Solver>();
+    auto env = solver->getEnvironment();
+
+    auto consoleSink = std::make_shared<MessageStoringSink>();
+    env->output->setConsoleSink(consoleSink);
+    env->output->setLogLevels(E_LogLevel::Info, E_LogLevel::Info);
+
+    env->output->outputDebug("Debug message");
+    env->output->outputDebug("Debug message {}", 1);
+    env->output->outputTrace("Trace message {}", 2);
+    env->output->outputInfo("Info message {}", 3);
+
+    if(consoleSink->messages.size() != 1 || consoleSink->messages[0] != "Info message 3")
+    {
+        std::cout << "Expected only the info message in the sink, found " << consoleSink->messages.size()
+                  << " messages\n";
+        passed = false;
+    }
+
+    // The log file is written by a background thread, and all queued messages should be in it after flushing
+    std::string filename = "output_test.log";
+    env->output->setFileSink(filename);
+    env->output->setLogLevels(E_LogLevel::Info, E_LogLevel::Info);
+
+    int numberOfMessages = 20000;
+
+    for(int i = 0; i < numberOfMessages; i++)
+        env->output->outputInfo("File message {}", i);
+
+    env->output->outputDebug("Debug message {}", numberOfMessages);
+    env->output->flush();
+
+    std::ifstream file(filename);
+    std::string line;
+    int numberOfLines = 0;
+
+    while(std::getline(file, line))
+    {
+        if(line != fmt::format("File message {}", numberOfLines))
+        {
+            std::cout << "Unexpected line in log file: " << line << '\n';
+            passed = false;
+            break;
+        }
+
+        numberOfLines++;
+    }
+
+    if(numberOfLines != numberOfMessages)
+    {
+        std::cout << "Expected " << numberOfMessages << " lines in the log file, found " << numberOfLines << '\n';
+        passed = false;
+    }
+
+    return passed;
+}
+
 int SolverTest(int argc, char* argv[])
 {
     int defaultchoice = 1;
@@ -253,6 +513,89 @@ int SolverTest(int argc, char* argv[])
         passed = TestGradient("data/flay02h.osil");
         std::cout << "Finished test to evaluate gradients in OSiL file." << std::endl;
         break;
+    case 5:
+        std::cout << "Starting test to read defined variables in NL files:" << std::endl;
+        passed = TestDefinedVariables("data/shot_ex_defvar.nl");
+        std::cout << "Finished test to read defined variables in NL files." << std::endl;
+        break;
+    case 6:
+        std::cout << "Starting test to solve a MINLP problem with symmetry breaking constraints:" << std::endl;
+        passed = CompareSolutions(
+            "data/tls2.osil", [](Solver& solver) { solver.updateSetting("Symmetry.Use", "Model", false); },
+            [](Solver& solver) { solver.updateSetting("Symmetry.Use", "Model", true); });
+        std::cout << "Finished test to solve a MINLP problem with symmetry breaking constraints." << std::endl;
+        break;
+    case 7:
+        std::cout << "Starting test to solve MINLP problems with presolve:" << std::endl;
+        for(auto& problemFile : { "data/tls2.osil", "data/synthes1.osil", "data/flay02h.osil" })
+        {
+            passed = passed
+                && CompareSolutions(
+                    problemFile, [](Solver& solver) { solver.updateSetting("Presolve.Use", "Model", false); },
+                    [](Solver& solver) { solver.updateSetting("Presolve.Use", "Model", true); });
+        }
+        std::cout << "Finished test to solve MINLP problems with presolve." << std::endl;
+        break;
+    case 8:
+        std::cout << "Starting test to solve a MINLP problem with concurrent fixed-integer NLP problems:" << std::endl;
+        passed = CompareSolutions("data/synthes1.osil",
+            [](Solver& solver) { solver.updateSetting("FixedInteger.NumberOfThreads", "Primal", 1); },
+            [](Solver& solver) { solver.updateSetting("FixedInteger.NumberOfThreads", "Primal", 2); });
+        std::cout << "Finished test to solve a MINLP problem with concurrent fixed-integer NLP problems." << std::endl;
+        break;
+    case 9:
+        std::cout << "Starting test to write messages to the console and log file:" << std::endl;
+        passed = TestOutput();
+        std::cout << "Finished test to write messages to the console and log file." << std::endl;
+        break;
+    case 14:
+        std::cout << "Starting test to solve a MINLP problem with a minimax interior point:" << std::endl;
+        passed = TestInteriorPoint("data/flay02h.osil");
+        std::cout << "Finished test to solve a MINLP problem with a minimax interior point." << std::endl;
+        break;
+#ifdef HAS_IPOPT
+    case 10:
+        std::cout << "Starting test to solve a MINLP problem with Ipopt cutoff termination:" << std::endl;
+        passed = CompareSolutions("data/synthes1.osil",
+            [](Solver& solver) { solver.updateSetting("Ipopt.EarlyTermination.Use", "Subsolver", false); },
+            [](Solver& solver) { solver.updateSetting("Ipopt.EarlyTermination.Use", "Subsolver", true); });
+        std::cout << "Finished test to solve a MINLP problem with Ipopt cutoff termination." << std::endl;
+        break;
+    case 11:
+        std::cout << "Starting test to solve a MINLP problem with iteration budgets for Ipopt:" << std::endl;
+        passed = CompareSolutions("data/synthes1.osil",
+            [](Solver& solver) { solver.updateSetting("Ipopt.EarlyTermination.BudgetFactor", "Subsolver", 0.0); },
+            [](Solver& solver) { solver.updateSetting("Ipopt.EarlyTermination.BudgetFactor", "Subsolver", 2.0); });
+        std::cout << "Finished test to solve a MINLP problem with iteration budgets for Ipopt." << std::endl;
+        break;
+    case 12:
+        std::cout << "Starting test to solve a MINLP problem with limited-memory Hessians in Ipopt:" << std::endl;
+        passed = CompareSolutions("data/synthes1.osil",
+            [](Solver& solver) {
+                solver.updateSetting("Ipopt.HessianApproximation.Mode", "Subsolver",
+                    static_cast<int>(ES_IpoptHessianApproximation::Exact));
+            },
+            [](Solver& solver) {
+                solver.updateSetting("Ipopt.HessianApproximation.Mode", "Subsolver",
+                    static_cast<int>(ES_IpoptHessianApproximation::LimitedMemory));
+            });
+        std::cout << "Finished test to solve a MINLP problem with limited-memory Hessians in Ipopt." << std::endl;
+        break;
+#endif
+#ifdef HAS_CBC
+    case 13:
+        std::cout << "Starting test to solve a MINLP problem with optimization-based bound tightening:" << std::endl;
+        passed = TestBoundTighteningOBBT("data/synthes1.osil");
+        std::cout << "Finished test to solve a MINLP problem with optimization-based bound tightening." << std::endl;
+        break;
+    case 15:
+        std::cout << "Starting test to solve a MINLP problem with root searches while Cbc is running:" << std::endl;
+        passed = CompareSolutions("data/flay02h.osil",
+            [](Solver& solver) { solver.updateSetting("ESH.Rootsearch.Prefetch.NumberOfThreads", "Dual", 0); },
+            [](Solver& solver) { solver.updateSetting("ESH.Rootsearch.Prefetch.NumberOfThreads", "Dual", 2); });
+        std::cout << "Finished test to solve a MINLP problem with root searches while Cbc is running." << std::endl;
+        break;
+#endif
     default:
         passed = false;
         std::cout << "Test #" << choice << " does not exist!\n";
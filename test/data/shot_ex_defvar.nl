@@ -0,0 +1,39 @@
+g3 1 1 0	# problem shot_ex_defvar
+ 2 2 1 0 0	# vars, constraints, objectives, ranges, eqns
+ 2 0	# nonlinear constraints, objectives
+ 0 0	# network constraints: nonlinear, linear
+ 2 0 0	# nonlinear vars in constraints, objectives, both
+ 0 0 0 1	# linear network variables; functions; arith, flags
+ 0 0 0 0 0	# discrete variables: binary, integer, nonlinear (b,c,o)
+ 4 2	# nonzeros in Jacobian, gradients
+ 0 0	# max name lengths: constraints, variables
+ 0 1 0 0 0	# common exprs: b,c,o,c1,o1
+V2 1 0
+0 2
+o44
+o2
+v0
+v1
+C0
+v2
+C1
+v2
+O0 0
+n0
+r
+1 10
+1 5
+b
+0 0 10
+0 0 10
+k1
+2
+J0 2
+0 1
+1 0
+J1 2
+0 0
+1 -1
+G0 2
+0 1
+1 1